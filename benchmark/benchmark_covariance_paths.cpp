@@ -0,0 +1,89 @@
+/*
+ * Compares the closed-form paths for isotropic and diagonal position uncertainty against the general path
+ *
+ * Usage: benchmark_covariance_paths [pairs_num] [repetitions]
+ */
+#include <social_nav_utils/formation_space_intrusion.h>
+#include <social_nav_utils/formation_space_model.h>
+#include <social_nav_utils/personal_space_intrusion.h>
+#include <social_nav_utils/personal_space_model.h>
+
+#include "benchmark_utils.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace social_nav_utils;
+
+int main(int argc, char** argv) {
+	size_t pairs_num = argc > 1 ? std::atoi(argv[1]) : 100000;
+	size_t repetitions = argc > 2 ? std::atoi(argv[2]) : 10;
+
+	// person (or O-space) and robot placed randomly in a 10 x 10 m area
+	std::mt19937 gen(1234);
+	std::uniform_real_distribution<double> pos(0.0, 10.0);
+	std::uniform_real_distribution<double> yaw(-M_PI, M_PI);
+	std::vector<double> px(pairs_num), py(pairs_num), pyaw(pairs_num), rx(pairs_num), ry(pairs_num);
+	for (size_t i = 0; i < pairs_num; i++) {
+		px[i] = pos(gen);
+		py[i] = pos(gen);
+		pyaw[i] = yaw(gen);
+		rx[i] = pos(gen);
+		ry[i] = pos(gen);
+	}
+	std::vector<double> costs(pairs_num);
+	volatile double sink = 0.0;
+
+	std::printf("pairs: %zu\n", pairs_num);
+	std::printf("%-34s %12s %16s %10s\n", "variant", "time [ms]", "evals/s [M]", "speedup");
+	auto print = [&](const char* name, double t, double t_reference) {
+		std::printf("%-34s %12.3f %16.2f %10.2f\n", name, 1e3 * t, pairs_num / t / 1e6, t_reference / t);
+		for (double cost: costs) {
+			sink = sink + cost;
+		}
+	};
+
+	// (xx, yy) of the position covariance
+	const double covs[2][2] = {{0.05, 0.05}, {0.08, 0.03}};
+	const char* names[2] = {"isotropic", "diagonal"};
+	for (size_t c = 0; c < 2; c++) {
+		const double cov_xx = covs[c][0];
+		const double cov_yy = covs[c][1];
+		double t_psi_general = measure(repetitions, [&]() {
+			for (size_t i = 0; i < pairs_num; i++) {
+				PersonalSpaceModel model(px[i], py[i], pyaw[i], cov_xx, 0.0, 0.0, cov_yy, 2.0, 0.5, 1.0, true);
+				costs[i] = model.evaluate(rx[i], ry[i]);
+			}
+		});
+		print((std::string("PSI general, ") + names[c]).c_str(), t_psi_general, t_psi_general);
+		double t_psi_fast = measure(repetitions, [&]() {
+			for (size_t i = 0; i < pairs_num; i++) {
+				costs[i] = PersonalSpaceIntrusion::computePersonalSpaceGaussian(
+					px[i], py[i], pyaw[i], cov_xx, 0.0, 0.0, cov_yy, 2.0, 0.5, 1.0, rx[i], ry[i], true
+				);
+			}
+		});
+		print((std::string("PSI closed-form, ") + names[c]).c_str(), t_psi_fast, t_psi_general);
+
+		double t_fsi_general = measure(repetitions, [&]() {
+			for (size_t i = 0; i < pairs_num; i++) {
+				FormationSpaceModel model(px[i], py[i], pyaw[i], 0.25, 0.75, cov_xx, 0.0, cov_yy);
+				costs[i] = model.evaluate(rx[i], ry[i]);
+			}
+		});
+		print((std::string("FSI general, ") + names[c]).c_str(), t_fsi_general, t_fsi_general);
+		double t_fsi_fast = measure(repetitions, [&]() {
+			for (size_t i = 0; i < pairs_num; i++) {
+				costs[i] = FormationSpaceIntrusion::computeFormationSpaceGaussian(
+					px[i], py[i], pyaw[i], 0.25, 0.75, cov_xx, 0.0, cov_yy, rx[i], ry[i]
+				);
+			}
+		});
+		print((std::string("FSI closed-form, ") + names[c]).c_str(), t_fsi_fast, t_fsi_general);
+	}
+	return 0;
+}
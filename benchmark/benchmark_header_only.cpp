@@ -0,0 +1,129 @@
+/*
+ * Measures cost functions called from planner-like inner loops (candidate poses x humans).
+ *
+ * Compiled twice: `benchmark_header_only_library` calls functions compiled into the library,
+ * `benchmark_header_only_inline` uses the header-only mode (SOCIAL_NAV_UTILS_HEADER_ONLY), so the compiler
+ * sees the definitions. Compare the outputs of both executables.
+ *
+ * Usage: benchmark_header_only_{library,inline} [humans_num] [poses_num] [repetitions]
+ */
+#include <social_nav_utils/formation_space_intrusion.h>
+#include <social_nav_utils/heading_direction_disturbance.h>
+#include <social_nav_utils/passing_speed_comfort.h>
+#include <social_nav_utils/personal_space_intrusion.h>
+#include <social_nav_utils/social_scene.h>
+
+#include "benchmark_utils.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace social_nav_utils;
+
+int main(int argc, char** argv) {
+	size_t humans_num = argc > 1 ? std::atoi(argv[1]) : 50;
+	size_t poses_num = argc > 2 ? std::atoi(argv[2]) : 2000;
+	size_t repetitions = argc > 3 ? std::atoi(argv[3]) : 10;
+
+#ifdef SOCIAL_NAV_UTILS_HEADER_ONLY
+	std::printf("mode: header-only (inline)\n");
+#else
+	std::printf("mode: library\n");
+#endif
+
+	std::mt19937 gen(1234);
+	std::uniform_real_distribution<double> pos(0.0, 20.0);
+	std::uniform_real_distribution<double> yaw(-M_PI, M_PI);
+	std::uniform_real_distribution<double> pose(9.0, 11.0);
+
+	std::vector<double> hx(humans_num), hy(humans_num), hyaw(humans_num);
+	SocialScene scene;
+	for (size_t i = 0; i < humans_num; i++) {
+		hx[i] = pos(gen);
+		hy[i] = pos(gen);
+		hyaw[i] = yaw(gen);
+		SocialScene::HumanState human;
+		human.x = hx[i];
+		human.y = hy[i];
+		human.yaw = hyaw[i];
+		human.cov_xx = 0.05;
+		human.cov_yy = 0.05;
+		human.ps_var_front = 2.0;
+		human.ps_var_rear = 0.5;
+		human.ps_var_side = 1.0;
+		scene.addHuman(human);
+	}
+	std::vector<double> px(poses_num), py(poses_num), pyaw(poses_num);
+	for (size_t j = 0; j < poses_num; j++) {
+		px[j] = pose(gen);
+		py[j] = pose(gen);
+		pyaw[j] = yaw(gen);
+	}
+	const double evals = static_cast<double>(humans_num * poses_num);
+	// accumulated to keep the computations observable
+	volatile double sink = 0.0;
+
+	double t_psi = measure(repetitions, [&]() {
+		double sum = 0.0;
+		for (size_t i = 0; i < humans_num; i++) {
+			for (size_t j = 0; j < poses_num; j++) {
+				sum += PersonalSpaceIntrusion::computePersonalSpaceGaussian(
+					hx[i], hy[i], hyaw[i], 0.05, 0.0, 0.0, 0.05, 2.0, 0.5, 1.0, px[j], py[j]
+				);
+			}
+		}
+		sink = sink + sum;
+	});
+	double t_fsi = measure(repetitions, [&]() {
+		double sum = 0.0;
+		for (size_t i = 0; i < humans_num; i++) {
+			for (size_t j = 0; j < poses_num; j++) {
+				sum += FormationSpaceIntrusion::computeFormationSpaceGaussian(
+					hx[i], hy[i], hyaw[i], 1.0, 0.5, 0.05, 0.0, 0.05, px[j], py[j]
+				);
+			}
+		}
+		sink = sink + sum;
+	});
+	double t_hdd = measure(repetitions, [&]() {
+		double sum = 0.0;
+		for (size_t i = 0; i < humans_num; i++) {
+			for (size_t j = 0; j < poses_num; j++) {
+				sum += HeadingDirectionDisturbance::computeDirectionDisturbance(
+					hx[i], hy[i], hyaw[i], 0.05, 0.0, 0.05, px[j], py[j], pyaw[j], 0.28
+				);
+			}
+		}
+		sink = sink + sum;
+	});
+	double t_psc = measure(repetitions, [&]() {
+		double sum = 0.0;
+		for (size_t i = 0; i < humans_num; i++) {
+			for (size_t j = 0; j < poses_num; j++) {
+				double distance = std::hypot(px[j] - hx[i], py[j] - hy[i]);
+				sum += PassingSpeedComfort::computeSpeedComfort(distance, 1.0);
+			}
+		}
+		sink = sink + sum;
+	});
+	double t_scene = measure(repetitions, [&]() {
+		double sum = 0.0;
+		for (size_t i = 0; i < humans_num; i++) {
+			for (size_t j = 0; j < poses_num; j++) {
+				sum += scene.computePersonalSpaceIntrusion(i, px[j], py[j], true);
+			}
+		}
+		sink = sink + sum;
+	});
+
+	std::printf("humans: %zu, poses: %zu, repetitions: %zu\n", humans_num, poses_num, repetitions);
+	std::printf("%-56s %10.2f ns/eval\n", "PersonalSpaceIntrusion::computePersonalSpaceGaussian", t_psi / evals * 1e9);
+	std::printf("%-56s %10.2f ns/eval\n", "FormationSpaceIntrusion::computeFormationSpaceGaussian", t_fsi / evals * 1e9);
+	std::printf("%-56s %10.2f ns/eval\n", "HeadingDirectionDisturbance::computeDirectionDisturbance", t_hdd / evals * 1e9);
+	std::printf("%-56s %10.2f ns/eval\n", "PassingSpeedComfort::computeSpeedComfort", t_psc / evals * 1e9);
+	std::printf("%-56s %10.2f ns/eval\n", "SocialScene::computePersonalSpaceIntrusion", t_scene / evals * 1e9);
+	return 0;
+}
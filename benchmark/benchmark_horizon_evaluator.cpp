@@ -0,0 +1,107 @@
+/*
+ * Compares scoring of candidate robot trajectories against humans extrapolated over a horizon: rebuilding
+ * the personal space models at each step versus the prediction shared by all trajectories
+ *
+ * Usage: benchmark_horizon_evaluator [humans_num] [trajectories_num] [steps_num] [repetitions]
+ */
+#include <social_nav_utils/horizon_evaluator.h>
+#include <social_nav_utils/personal_space_model.h>
+
+#include "benchmark_utils.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace social_nav_utils;
+
+int main(int argc, char** argv) {
+	size_t humans_num = argc > 1 ? std::atoi(argv[1]) : 20;
+	size_t trajectories_num = argc > 2 ? std::atoi(argv[2]) : 500;
+	size_t steps_num = argc > 3 ? std::atoi(argv[3]) : 20;
+	size_t repetitions = argc > 4 ? std::atoi(argv[4]) : 10;
+
+	std::mt19937 gen(1234);
+	std::uniform_real_distribution<double> pos(0.0, 10.0);
+	std::uniform_real_distribution<double> vel(-1.0, 1.0);
+	std::uniform_real_distribution<double> yaw(-M_PI, M_PI);
+	HumanArray humans;
+	for (size_t i = 0; i < humans_num; i++) {
+		SocialScene::HumanState human;
+		human.x = pos(gen);
+		human.y = pos(gen);
+		human.yaw = yaw(gen);
+		human.vx = vel(gen);
+		human.vy = vel(gen);
+		human.cov_xx = 0.05;
+		human.cov_yy = 0.05;
+		human.ps_var_front = 2.0;
+		human.ps_var_rear = 0.5;
+		human.ps_var_side = 1.0;
+		humans.add(human);
+	}
+	// trajectories: straight lines from the same start with various velocities
+	std::vector<double> poses_x(trajectories_num * steps_num), poses_y(trajectories_num * steps_num);
+	for (size_t j = 0; j < trajectories_num; j++) {
+		double vx = vel(gen);
+		double vy = vel(gen);
+		for (size_t k = 0; k < steps_num; k++) {
+			poses_x[j * steps_num + k] = 5.0 + vx * 0.1 * k;
+			poses_y[j * steps_num + k] = 5.0 + vy * 0.1 * k;
+		}
+	}
+
+	HorizonEvaluator::Parameters params;
+	params.dt = 0.1;
+	params.cov_growth_xx = 0.2;
+	params.cov_growth_yy = 0.2;
+	params.unify_asymmetry_scale = true;
+	std::vector<double> costs(steps_num);
+	volatile double sink = 0.0;
+
+	double t_rebuild = measure(repetitions, [&]() {
+		for (size_t j = 0; j < trajectories_num; j++) {
+			double total = 0.0;
+			for (size_t k = 0; k < steps_num; k++) {
+				double t = k * params.dt;
+				for (size_t i = 0; i < humans_num; i++) {
+					PersonalSpaceModel model(
+						humans.x()[i] + humans.vx()[i] * t,
+						humans.y()[i] + humans.vy()[i] * t,
+						humans.yaw()[i],
+						humans.covXX()[i] + params.cov_growth_xx * t,
+						humans.covXY()[i] + params.cov_growth_xy * t,
+						humans.covXY()[i] + params.cov_growth_xy * t,
+						humans.covYY()[i] + params.cov_growth_yy * t,
+						humans.psVarFront()[i],
+						humans.psVarRear()[i],
+						humans.psVarSide()[i],
+						params.unify_asymmetry_scale
+					);
+					total += model.evaluate(poses_x[j * steps_num + k], poses_y[j * steps_num + k]);
+				}
+			}
+			sink = sink + total;
+		}
+	});
+
+	HorizonEvaluator evaluator(params);
+	double t_horizon = measure(repetitions, [&]() {
+		evaluator.predict(humans, steps_num);
+		for (size_t j = 0; j < trajectories_num; j++) {
+			sink = sink + evaluator.evaluate(
+				poses_x.data() + j * steps_num,
+				poses_y.data() + j * steps_num,
+				costs.data()
+			);
+		}
+	});
+
+	std::printf("humans: %zu, trajectories: %zu, steps: %zu\n", humans_num, trajectories_num, steps_num);
+	std::printf("%-24s %12s %10s\n", "variant", "time [ms]", "speedup");
+	std::printf("%-24s %12.3f %10.2f\n", "models rebuilt", 1e3 * t_rebuild, 1.0);
+	std::printf("%-24s %12.3f %10.2f\n", "horizon evaluator", 1e3 * t_horizon, t_rebuild / t_horizon);
+	return 0;
+}
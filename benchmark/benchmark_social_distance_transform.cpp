@@ -0,0 +1,144 @@
+/*
+ * Compares computation of the cost-to-go over a grid of social costs: Dijkstra's algorithm with a binary heap,
+ * the raster sweeps of the distance transform and its repair after a single human has moved
+ *
+ * Usage: benchmark_social_distance_transform [size] [humans_num] [repetitions]
+ */
+#include <social_nav_utils/personal_space_model.h>
+#include <social_nav_utils/social_distance_transform.h>
+
+#include "benchmark_utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace social_nav_utils;
+
+struct Human {
+	double x;
+	double y;
+	double yaw;
+};
+
+/// Human's personal space is cut off at 3 sigmas; the support spans `radius` cells around the human
+static constexpr double RADIUS = 1.5;
+
+static void rasterize(const std::vector<Human>& humans, size_t size, double resolution, std::vector<double>& costs) {
+	GaussianCutoff cutoff(3.0);
+	std::fill(costs.begin(), costs.end(), 0.0);
+	for (const auto& human: humans) {
+		PersonalSpaceModel model(human.x, human.y, human.yaw, 0.01, 0.0, 0.0, 0.01, 0.2, 0.05, 0.1);
+		double scale = 1.0 / model.getMax();
+		for (size_t row = 0; row < size; row++) {
+			double y = (row + 0.5) * resolution;
+			if (std::abs(y - human.y) > RADIUS) {
+				continue;
+			}
+			for (size_t col = 0; col < size; col++) {
+				double x = (col + 0.5) * resolution;
+				costs[row * size + col] = std::max(costs[row * size + col], scale * model.evaluate(x, y, cutoff));
+			}
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t size = argc > 1 ? std::atoi(argv[1]) : 400;
+	size_t humans_num = argc > 2 ? std::atoi(argv[2]) : 30;
+	size_t repetitions = argc > 3 ? std::atoi(argv[3]) : 10;
+
+	SocialDistanceTransform::Parameters params;
+	const double extent = size * params.resolution;
+	std::mt19937 gen(1234);
+	std::uniform_real_distribution<double> pos(RADIUS, extent - RADIUS);
+	std::uniform_real_distribution<double> yaw(-M_PI, M_PI);
+	std::vector<Human> humans(humans_num);
+	for (auto& human: humans) {
+		human = {pos(gen), pos(gen), yaw(gen)};
+	}
+	std::vector<double> costs(size * size);
+	rasterize(humans, size, params.resolution, costs);
+	// a human steps by 0.2 m, the union of its supports is repaired
+	std::vector<Human> humans_moved = humans;
+	humans_moved[0].x += 0.2;
+	std::vector<double> costs_moved(size * size);
+	rasterize(humans_moved, size, params.resolution, costs_moved);
+	const double margin = RADIUS + 0.2;
+	auto toCell = [&](double coord) {
+		return static_cast<size_t>(std::min(std::max(coord / params.resolution, 0.0), static_cast<double>(size)));
+	};
+	size_t col_begin = toCell(humans[0].x - margin);
+	size_t col_end = toCell(humans[0].x + margin) + 1;
+	size_t row_begin = toCell(humans[0].y - margin);
+	size_t row_end = toCell(humans[0].y + margin) + 1;
+	const size_t goal_col = size / 10;
+	const size_t goal_row = size / 2;
+
+	std::vector<double> distances(size * size);
+	using Entry = std::pair<double, size_t>;
+	std::vector<Entry> storage;
+	storage.reserve(size * size);
+	double t_dijkstra = measure(repetitions, [&]() {
+		std::fill(distances.begin(), distances.end(), std::numeric_limits<double>::infinity());
+		std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue(std::greater<Entry>(), std::move(storage));
+		distances[goal_row * size + goal_col] = 0.0;
+		queue.push({0.0, goal_row * size + goal_col});
+		while (!queue.empty()) {
+			auto [distance, cell] = queue.top();
+			queue.pop();
+			if (distance > distances[cell]) {
+				continue;
+			}
+			int col = static_cast<int>(cell % size);
+			int row = static_cast<int>(cell / size);
+			double traversal = 1.0 + params.social_weight * costs[cell];
+			for (int dy = -1; dy <= 1; dy++) {
+				for (int dx = -1; dx <= 1; dx++) {
+					int ncol = col + dx;
+					int nrow = row + dy;
+					if ((dx == 0 && dy == 0) || ncol < 0 || nrow < 0 || ncol >= int(size) || nrow >= int(size)) {
+						continue;
+					}
+					size_t neighbor = nrow * size + ncol;
+					double length = (dx != 0 && dy != 0) ? M_SQRT2 : 1.0;
+					double next = distance + 0.5 * params.resolution * length
+						* (traversal + 1.0 + params.social_weight * costs[neighbor]);
+					if (next < distances[neighbor]) {
+						distances[neighbor] = next;
+						queue.push({next, neighbor});
+					}
+				}
+			}
+		}
+	});
+
+	SocialDistanceTransform transform(size, size, params);
+	double t_sweeps = measure(repetitions, [&]() {
+		transform.compute(costs.data(), goal_col, goal_row);
+	});
+	size_t sweeps_num = transform.getSweepsNum();
+
+	// each repetition moves the human there and back, so the time is halved
+	double t_update = 0.5 * measure(repetitions, [&]() {
+		transform.update(costs_moved.data(), col_begin, row_begin, col_end, row_end);
+		transform.update(costs.data(), col_begin, row_begin, col_end, row_end);
+	});
+	transform.update(costs_moved.data(), col_begin, row_begin, col_end, row_end);
+	size_t repaired_num = transform.getRepairedNum();
+
+	std::printf("grid: %zux%zu, humans: %zu, sweeps: %zu, repaired cells: %zu\n",
+		size, size, humans_num, sweeps_num, repaired_num);
+	std::printf("%-24s %12s %10s\n", "variant", "time [ms]", "speedup");
+	std::printf("%-24s %12.3f %10.2f\n", "dijkstra", 1e3 * t_dijkstra, 1.0);
+	std::printf("%-24s %12.3f %10.2f\n", "sweeps", 1e3 * t_sweeps, t_dijkstra / t_sweeps);
+	std::printf("%-24s %12.3f %10.2f\n", "repair", 1e3 * t_update, t_dijkstra / t_update);
+	return 0;
+}
@@ -0,0 +1,92 @@
+/*
+ * Compares throughput of the cache-blocked kernel against naive loops in crowd scenarios
+ *
+ * Usage: benchmark_tiled_kernel [humans_num] [poses_num] [repetitions]
+ */
+#include <social_nav_utils/personal_space_intrusion.h>
+#include <social_nav_utils/personal_space_model.h>
+#include <social_nav_utils/tiled_kernel.h>
+
+#include "benchmark_utils.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace social_nav_utils;
+
+int main(int argc, char** argv) {
+	size_t humans_num = argc > 1 ? std::atoi(argv[1]) : 300;
+	size_t poses_num = argc > 2 ? std::atoi(argv[2]) : 400;
+	size_t repetitions = argc > 3 ? std::atoi(argv[3]) : 10;
+
+	// crowd in a 20 x 20 m hall, candidate poses around the robot
+	std::mt19937 gen(1234);
+	std::uniform_real_distribution<double> pos(0.0, 20.0);
+	std::uniform_real_distribution<double> yaw(-M_PI, M_PI);
+	std::uniform_real_distribution<double> pose(9.0, 11.0);
+
+	std::vector<double> hx(humans_num), hy(humans_num), hyaw(humans_num);
+	std::vector<PersonalSpaceModel> models;
+	std::vector<const PersonalSpaceModel*> model_ptrs;
+	models.reserve(humans_num);
+	for (size_t i = 0; i < humans_num; i++) {
+		hx[i] = pos(gen);
+		hy[i] = pos(gen);
+		hyaw[i] = yaw(gen);
+		models.emplace_back(hx[i], hy[i], hyaw[i], 0.05, 0.0, 0.0, 0.05, 2.0, 0.5, 1.0);
+		model_ptrs.push_back(&models.back());
+	}
+	std::vector<double> px(poses_num), py(poses_num);
+	for (size_t j = 0; j < poses_num; j++) {
+		px[j] = pose(gen);
+		py[j] = pose(gen);
+	}
+	std::vector<double> costs(humans_num * poses_num);
+
+	double t_static = measure(repetitions, [&]() {
+		for (size_t i = 0; i < humans_num; i++) {
+			for (size_t j = 0; j < poses_num; j++) {
+				costs[i * poses_num + j] = PersonalSpaceIntrusion::computePersonalSpaceGaussian(
+					hx[i], hy[i], hyaw[i], 0.05, 0.0, 0.0, 0.05, 2.0, 0.5, 1.0, px[j], py[j]
+				);
+			}
+		}
+	});
+	double t_humans_outer = measure(repetitions, [&]() {
+		for (size_t i = 0; i < humans_num; i++) {
+			for (size_t j = 0; j < poses_num; j++) {
+				costs[i * poses_num + j] = models[i].evaluate(px[j], py[j]);
+			}
+		}
+	});
+	double t_poses_outer = measure(repetitions, [&]() {
+		for (size_t j = 0; j < poses_num; j++) {
+			for (size_t i = 0; i < humans_num; i++) {
+				costs[i * poses_num + j] = models[i].evaluate(px[j], py[j]);
+			}
+		}
+	});
+	double t_tiled = measure(repetitions, [&]() {
+		TiledKernel::fillPersonalSpace(
+			model_ptrs.data(), humans_num, px.data(), py.data(), poses_num, costs.data(), poses_num
+		);
+	});
+
+	double evaluations = static_cast<double>(humans_num * poses_num);
+	std::printf(
+		"humans: %zu, poses: %zu, tile: %zu x %zu\n",
+		humans_num, poses_num, TiledKernel::TILE_ENTITIES, TiledKernel::TILE_POSES
+	);
+	std::printf("%-28s %12s %16s %10s\n", "variant", "time [ms]", "evals/s [M]", "speedup");
+	auto print = [&](const char* name, double t) {
+		std::printf("%-28s %12.3f %16.2f %10.2f\n", name, 1e3 * t, evaluations / t / 1e6, t_static / t);
+	};
+	print("static function per pair", t_static);
+	print("models, humans outer loop", t_humans_outer);
+	print("models, poses outer loop", t_poses_outer);
+	print("tiled kernel", t_tiled);
+	return 0;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+/**
+ * Utilities shared by the benchmark executables
+ */
+
+#include <chrono>
+#include <cstddef>
+
+namespace social_nav_utils {
+
+/**
+ * @brief Measures the mean duration of a call
+ *
+ * @param repetitions number of calls
+ * @param fun callable without arguments
+ * @return double mean duration of a single call [s]
+ */
+template <typename Tfun>
+double measure(size_t repetitions, Tfun fun) {
+	auto start = std::chrono::steady_clock::now();
+	for (size_t r = 0; r < repetitions; r++) {
+		fun();
+	}
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double>(end - start).count() / repetitions;
+}
+
+} // namespace social_nav_utils
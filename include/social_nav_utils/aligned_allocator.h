@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace social_nav_utils {
+
+/// Alignment of buffers processed in batches; equal to the size of a cache line (and of an AVX-512 register)
+static constexpr size_t BATCH_ALIGNMENT = 64;
+
+/**
+ * @brief Standard allocator returning memory aligned to @ref ALIGNMENT bytes
+ *
+ * Makes the beginning of each buffer suitable for aligned vector loads and prevents sharing cache lines
+ * between buffers.
+ */
+template <typename T, size_t ALIGNMENT = BATCH_ALIGNMENT>
+class AlignedAllocator {
+public:
+	static_assert(ALIGNMENT >= alignof(T), "Alignment must not be weaker than the natural alignment of the type");
+	static_assert((ALIGNMENT & (ALIGNMENT - 1)) == 0, "Alignment must be a power of 2");
+
+	typedef T value_type;
+
+	template <typename U>
+	struct rebind {
+		typedef AlignedAllocator<U, ALIGNMENT> other;
+	};
+
+	AlignedAllocator() noexcept = default;
+
+	template <typename U>
+	AlignedAllocator(const AlignedAllocator<U, ALIGNMENT>& /* other */) noexcept {}
+
+	T* allocate(size_t n) {
+		return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(ALIGNMENT)));
+	}
+
+	void deallocate(T* ptr, size_t /* n */) noexcept {
+		::operator delete(ptr, std::align_val_t(ALIGNMENT));
+	}
+
+	template <typename U>
+	bool operator==(const AlignedAllocator<U, ALIGNMENT>& /* other */) const noexcept {
+		return true;
+	}
+
+	template <typename U>
+	bool operator!=(const AlignedAllocator<U, ALIGNMENT>& /* other */) const noexcept {
+		return false;
+	}
+};
+
+/// Vector whose storage is aligned to @ref BATCH_ALIGNMENT bytes
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+} // namespace social_nav_utils
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <social_nav_utils/relative_location.h>
+
+#include <cmath>
+#include <cstddef>
+
+namespace social_nav_utils {
+
+/**
+ * @brief Bivariate asymmetrical Gaussian according to Kirby with coefficients precomputed for a single person
+ *
+ * The coefficients of the exponent (a, b, c of Algorithm A.1 from Kirby, 2010) depend only on the orientation
+ * and variances, so they are computed once for the head and the rear variance. Then, each evaluation costs
+ * a dot product (front/rear selection, see @ref RelativeLocationClassifier), the quadratic form and a single `exp`.
+ * Results are equivalent to @ref calculateGaussianAsymmetrical.
+ *
+ * Reference: Kirby, 2010 PhD thesis "Social Robot Navigation" (p. 166)
+ * @url https://www.ri.cmu.edu/pub_files/2010/5/rk_thesis.pdf
+ */
+class AsymmetricGaussianModel {
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * For parameters description, refer to the @ref calculateGaussianAsymmetrical
+	 */
+	AsymmetricGaussianModel(
+		double x_center,
+		double y_center,
+		double yaw,
+		double variance_h,
+		double variance_r,
+		double variance_s
+	):
+		rel_loc_(x_center, y_center, yaw),
+		x_center_(x_center),
+		y_center_(y_center)
+	{
+		front_ = computeCoefficients(variance_h, variance_s);
+		rear_ = computeCoefficients(variance_r, variance_s);
+	}
+
+	/// Computes a value of the Gaussian at the given position (1.0 at the center)
+	inline double evaluate(double x, double y) const {
+		double dx = x - x_center_;
+		double dy = y - y_center_;
+		const Coefficients& k = rel_loc_.isFront(x, y) ? front_ : rear_;
+		return std::exp(-(k.a * dx * dx + 2.0 * k.b * dx * dy + k.c * dy * dy));
+	}
+
+	/**
+	 * @brief Batch version of @ref evaluate
+	 *
+	 * @param x x coordinates of the positions
+	 * @param y y coordinates of the positions
+	 * @param num number of positions
+	 * @param values output, @ref num elements
+	 */
+	void evaluate(const double* x, const double* y, size_t num, double* values) const {
+		const double hx = rel_loc_.getHeadingX();
+		const double hy = rel_loc_.getHeadingY();
+		for (size_t i = 0; i < num; i++) {
+			double dx = x[i] - x_center_;
+			double dy = y[i] - y_center_;
+			const Coefficients& k = (dx * hx + dy * hy) >= 0.0 ? front_ : rear_;
+			values[i] = std::exp(-(k.a * dx * dx + 2.0 * k.b * dx * dy + k.c * dy * dy));
+		}
+	}
+
+	/**
+	 * @brief Computes values of the Gaussian at the centers of all cells of a grid
+	 *
+	 * The grid is row-major; cell (col, row) is stored at `values[row * width + col]` and its center is located at
+	 * `(origin_x + (col + 0.5) * resolution, origin_y + (row + 0.5) * resolution)`. Terms that depend only
+	 * on the row are computed once per row.
+	 *
+	 * @param origin_x x coordinate of the grid corner
+	 * @param origin_y y coordinate of the grid corner
+	 * @param resolution size of a grid cell
+	 * @param width number of columns of the grid
+	 * @param height number of rows of the grid
+	 * @param values output, `width * height` elements
+	 */
+	void evaluateGrid(
+		double origin_x,
+		double origin_y,
+		double resolution,
+		size_t width,
+		size_t height,
+		double* values
+	) const {
+		const double hx = rel_loc_.getHeadingX();
+		const double hy = rel_loc_.getHeadingY();
+		const double dx_begin = origin_x + 0.5 * resolution - x_center_;
+		for (size_t row = 0; row < height; row++) {
+			const double dy = origin_y + (row + 0.5) * resolution - y_center_;
+			const double dot_y = dy * hy;
+			// terms of the quadratic form that depend on dy only
+			const double front_by = 2.0 * front_.b * dy;
+			const double front_cy = front_.c * dy * dy;
+			const double rear_by = 2.0 * rear_.b * dy;
+			const double rear_cy = rear_.c * dy * dy;
+			double* output = values + row * width;
+			for (size_t col = 0; col < width; col++) {
+				const double dx = dx_begin + col * resolution;
+				const bool front = (dx * hx + dot_y) >= 0.0;
+				const double exp_arg = front
+					? (front_.a * dx + front_by) * dx + front_cy
+					: (rear_.a * dx + rear_by) * dx + rear_cy;
+				output[col] = std::exp(-exp_arg);
+			}
+		}
+	}
+
+	inline double getCenterX() const {
+		return x_center_;
+	}
+
+	inline double getCenterY() const {
+		return y_center_;
+	}
+
+	inline const RelativeLocationClassifier& getClassifier() const {
+		return rel_loc_;
+	}
+
+protected:
+	/// Coefficients of the exponent: a * dx^2 + 2 * b * dx * dy + c * dy^2
+	struct Coefficients {
+		double a;
+		double b;
+		double c;
+	};
+
+	/// Computes coefficients for the variance along the heading and the side variance
+	inline Coefficients computeCoefficients(double variance, double variance_s) const {
+		const double cos_yaw = rel_loc_.getHeadingX();
+		const double sin_yaw = rel_loc_.getHeadingY();
+		const double cos_yaw_sq = cos_yaw * cos_yaw;
+		const double sin_yaw_sq = sin_yaw * sin_yaw;
+		const double sin_2yaw = 2.0 * sin_yaw * cos_yaw;
+		Coefficients k;
+		k.a = cos_yaw_sq / (2.0 * variance) + sin_yaw_sq / (2.0 * variance_s);
+		k.b = sin_2yaw   / (4.0 * variance) - sin_2yaw   / (4.0 * variance_s);
+		k.c = sin_yaw_sq / (2.0 * variance) + cos_yaw_sq / (2.0 * variance_s);
+		return k;
+	}
+
+	RelativeLocationClassifier rel_loc_;
+	double x_center_;
+	double y_center_;
+	Coefficients front_;
+	Coefficients rear_;
+};
+
+} // namespace social_nav_utils
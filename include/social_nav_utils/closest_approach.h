@@ -0,0 +1,263 @@
+#pragma once
+
+#include <social_nav_utils/entity_arrays.h>
+#include <social_nav_utils/math/core.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace social_nav_utils {
+
+/**
+ * @brief Closest point of approach (CPA) of 2 agents moving with constant velocities
+ *
+ * With the relative position `p` and the relative velocity `v` of the other agent w.r.t. the ego, the separation
+ * `|p + v * t|` is minimized at `t = -(p^T * v) / (v^T * v)`. The time is clamped to [0, horizon], so agents
+ * moving apart have their closest approach now. Agents with equal velocities keep the current separation;
+ * then, the time is 0 as well.
+ *
+ * The Mahalanobis variant weights the separation by the covariance `C` of the other agent's position, i.e.,
+ * minimizes `(p + v * t)^T * C^(-1) * (p + v * t)`, which gives `t = -(p^T * C^(-1) * v) / (v^T * C^(-1) * v)`.
+ * The miss distance is then expressed in standard deviations of the position along the miss direction.
+ *
+ * For many agents, see the batch versions @ref compute and @ref computeMahalanobis (raw columns or a @ref HumanArray).
+ */
+class ClosestApproach {
+public:
+	/**
+	 * @brief Constructor that performs all computations
+	 *
+	 * @param position_ego
+	 * @param velocity_ego
+	 * @param position_other
+	 * @param velocity_other
+	 * @param horizon upper bound of the time of the closest approach [s]
+	 */
+	ClosestApproach(
+		const Vector2d& position_ego,
+		const Vector2d& velocity_ego,
+		const Vector2d& position_other,
+		const Vector2d& velocity_other,
+		double horizon = INFINITY
+	):
+		mahalanobis_(NAN)
+	{
+		Vector2d p = position_other - position_ego;
+		Vector2d v = velocity_other - velocity_ego;
+		time_ = clampTime(computeTime(p.transpose() * v, v.squaredNorm()), horizon);
+		miss_ = p + v * time_;
+		distance_ = std::sqrt(miss_.squaredNorm());
+	}
+
+	/**
+	 * @brief Constructor of the Mahalanobis variant
+	 *
+	 * @param cov_other covariance matrix of the other agent's position; must be positive definite
+	 *
+	 * For other parameters description, refer to the main constructor
+	 */
+	ClosestApproach(
+		const Vector2d& position_ego,
+		const Vector2d& velocity_ego,
+		const Vector2d& position_other,
+		const Vector2d& velocity_other,
+		const Matrix2d& cov_other,
+		double horizon = INFINITY
+	) {
+		Vector2d p = position_other - position_ego;
+		Vector2d v = velocity_other - velocity_ego;
+		Matrix2d cov_inv = cov_other.inverse();
+		Vector2d cov_inv_v = cov_inv * v;
+		time_ = clampTime(computeTime(p.transpose() * cov_inv_v, v.transpose() * cov_inv_v), horizon);
+		miss_ = p + v * time_;
+		distance_ = std::sqrt(miss_.squaredNorm());
+		mahalanobis_ = std::sqrt(miss_.transpose() * cov_inv * miss_);
+	}
+
+	/// Time until the closest approach [s]
+	inline double getTime() const {
+		return time_;
+	}
+
+	/// Separation of agents at the closest approach (miss distance)
+	inline double getDistance() const {
+		return distance_;
+	}
+
+	/// Position of the other agent relative to the ego at the closest approach
+	inline const Vector2d& getMissVector() const {
+		return miss_;
+	}
+
+	/// Mahalanobis miss distance; NaN unless the covariance was given
+	inline double getMahalanobisDistance() const {
+		return mahalanobis_;
+	}
+
+	/**
+	 * @brief Batch version computing closest approaches of the ego and many other agents
+	 *
+	 * Other agents are given as columns, e.g., of a @ref HumanArray. The loop is branch-free, so the compiler
+	 * vectorizes it (as long as `sqrt` does not have to set `errno`, e.g., with `-fno-math-errno`).
+	 *
+	 * @param x_ego
+	 * @param y_ego
+	 * @param vx_ego
+	 * @param vy_ego
+	 * @param x x coordinates of other agents
+	 * @param y y coordinates of other agents
+	 * @param vx x components of velocities of other agents
+	 * @param vy y components of velocities of other agents
+	 * @param num number of other agents
+	 * @param horizon upper bound of the time of the closest approach [s]
+	 * @param time output, @ref num elements: time until the closest approach
+	 * @param distance output, @ref num elements: miss distance
+	 */
+	static void compute(
+		double x_ego,
+		double y_ego,
+		double vx_ego,
+		double vy_ego,
+		const double* x,
+		const double* y,
+		const double* vx,
+		const double* vy,
+		size_t num,
+		double horizon,
+		double* time,
+		double* distance
+	) {
+		for (size_t i = 0; i < num; i++) {
+			double px = x[i] - x_ego;
+			double py = y[i] - y_ego;
+			double qx = vx[i] - vx_ego;
+			double qy = vy[i] - vy_ego;
+			double t = clampTime(computeTime(px * qx + py * qy, qx * qx + qy * qy), horizon);
+			double mx = px + qx * t;
+			double my = py + qy * t;
+			time[i] = t;
+			distance[i] = std::sqrt(mx * mx + my * my);
+		}
+	}
+
+	/**
+	 * @brief Batch version of the Mahalanobis variant
+	 *
+	 * @param cov_xx variances of x coordinates of other agents
+	 * @param cov_xy covariances of coordinates of other agents
+	 * @param cov_yy variances of y coordinates of other agents
+	 * @param mahalanobis output, @ref num elements: Mahalanobis miss distance
+	 *
+	 * For other parameters description, refer to @ref compute
+	 */
+	static void computeMahalanobis(
+		double x_ego,
+		double y_ego,
+		double vx_ego,
+		double vy_ego,
+		const double* x,
+		const double* y,
+		const double* vx,
+		const double* vy,
+		const double* cov_xx,
+		const double* cov_xy,
+		const double* cov_yy,
+		size_t num,
+		double horizon,
+		double* time,
+		double* distance,
+		double* mahalanobis
+	) {
+		for (size_t i = 0; i < num; i++) {
+			double px = x[i] - x_ego;
+			double py = y[i] - y_ego;
+			double qx = vx[i] - vx_ego;
+			double qy = vy[i] - vy_ego;
+			// adjugate of the covariance; the determinant cancels out in the time and is applied once to the distance
+			double inv_xx = cov_yy[i];
+			double inv_xy = -cov_xy[i];
+			double inv_yy = cov_xx[i];
+			double inv_qx = inv_xx * qx + inv_xy * qy;
+			double inv_qy = inv_xy * qx + inv_yy * qy;
+			double t = clampTime(computeTime(px * inv_qx + py * inv_qy, qx * inv_qx + qy * inv_qy), horizon);
+			double mx = px + qx * t;
+			double my = py + qy * t;
+			double det = cov_xx[i] * cov_yy[i] - cov_xy[i] * cov_xy[i];
+			time[i] = t;
+			distance[i] = std::sqrt(mx * mx + my * my);
+			mahalanobis[i] = std::sqrt((inv_xx * mx * mx + 2.0 * inv_xy * mx * my + inv_yy * my * my) / det);
+		}
+	}
+
+	/**
+	 * @brief Batch version for the humans stored in a @ref HumanArray
+	 *
+	 * @param humans other agents; positions and velocities are taken from their columns
+	 * @param time output, @ref HumanArray::size elements: time until the closest approach
+	 * @param distance output, @ref HumanArray::size elements: miss distance
+	 *
+	 * For other parameters description, refer to the raw-columns overload of @ref compute
+	 */
+	static void compute(
+		double x_ego,
+		double y_ego,
+		double vx_ego,
+		double vy_ego,
+		const HumanArray& humans,
+		double horizon,
+		double* time,
+		double* distance
+	) {
+		compute(
+			x_ego, y_ego, vx_ego, vy_ego,
+			humans.x(), humans.y(), humans.vx(), humans.vy(), humans.size(),
+			horizon, time, distance
+		);
+	}
+
+	/**
+	 * @brief Batch version of the Mahalanobis variant for the humans stored in a @ref HumanArray
+	 *
+	 * Covariances of the positions are taken from the covariance columns of @ref humans.
+	 *
+	 * For parameters description, refer to the raw-columns overload of @ref computeMahalanobis
+	 */
+	static void computeMahalanobis(
+		double x_ego,
+		double y_ego,
+		double vx_ego,
+		double vy_ego,
+		const HumanArray& humans,
+		double horizon,
+		double* time,
+		double* distance,
+		double* mahalanobis
+	) {
+		computeMahalanobis(
+			x_ego, y_ego, vx_ego, vy_ego,
+			humans.x(), humans.y(), humans.vx(), humans.vy(),
+			humans.covXX(), humans.covXY(), humans.covYY(), humans.size(),
+			horizon, time, distance, mahalanobis
+		);
+	}
+
+protected:
+	/// Unclamped time of the closest approach given `p^T * W * v` and `v^T * W * v` for a positive definite `W`
+	static inline double computeTime(double pv, double vv) {
+		// for equal velocities both products are 0, so the bounded denominator yields 0 without a branch
+		return -pv / std::max(vv, std::numeric_limits<double>::min());
+	}
+
+	static inline double clampTime(double time, double horizon) {
+		return std::min(std::max(time, 0.0), horizon);
+	}
+
+	double time_;
+	double distance_;
+	Vector2d miss_;
+	double mahalanobis_;
+};
+
+} // namespace social_nav_utils
@@ -0,0 +1,17 @@
+#pragma once
+
+/**
+ * Header-only mode
+ *
+ * By default, cost functions, their models and @ref SocialScene are compiled into the library. With
+ * `SOCIAL_NAV_UTILS_HEADER_ONLY` defined (see the CMake option of the same name), the public headers include
+ * the implementations from `impl/` as inline functions, so the compiler may inline them into the calling loops
+ * and hoist the work that does not change between calls. The library then provides the remaining components only.
+ *
+ * The macro must be defined consistently for the library and all code including its headers.
+ */
+#ifdef SOCIAL_NAV_UTILS_HEADER_ONLY
+#define SOCIAL_NAV_UTILS_INLINE inline
+#else
+#define SOCIAL_NAV_UTILS_INLINE
+#endif
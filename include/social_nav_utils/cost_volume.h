@@ -0,0 +1,138 @@
+#pragma once
+
+#include <social_nav_utils/aligned_allocator.h>
+#include <social_nav_utils/entity_arrays.h>
+#include <social_nav_utils/formation_space_model.h>
+#include <social_nav_utils/gaussian_cutoff.h>
+#include <social_nav_utils/half_float.h>
+#include <social_nav_utils/personal_space_model.h>
+#include <social_nav_utils/tiled_kernel.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace social_nav_utils {
+
+/**
+ * @brief Spatio-temporal (x, y, t) volume of social costs for planners searching in space-time
+ *
+ * The volume consists of time slices (slice `k` at time `k * dt`), each being a grid of costs. Humans are predicted
+ * with a constant velocity model and a linearly growing position covariance (see @ref HorizonEvaluator); groups
+ * (O-spaces) are static. Costs of entities are normalized (see @ref PersonalSpaceIntrusion::normalize
+ * and @ref FormationSpaceIntrusion::normalize) and reduced with @ref Parameters::reduction.
+ *
+ * Each slice builds the model of each predicted human once and evaluates it within its bounding box only:
+ * a box covers the ellipse of @ref Parameters::sigmas standard deviations, beyond which the cost is zero
+ * (see @ref GaussianCutoff). Groups are static, so their layer is rasterized once and shared by all slices.
+ *
+ * Storage is compact: costs are encoded either as 8-bit values (saturated at 1, quantization step of 1/255;
+ * note that sums and the rear part of a non-unified personal space may exceed 1) or as half precision floats
+ * (see @ref encodeHalf). Slices are stored one after another (slice-major, then
+ * row-major), each aligned to a cache line, so a planner expanding the search slice by slice streams through
+ * contiguous memory; cell (col, row) of slice `k` is stored at `getSlice*(k)[row * width + col]`.
+ */
+class CostVolume {
+public:
+	/// Format of stored costs
+	enum class Encoding {
+		/// `round(min(cost, 1) * 255)`
+		UINT8,
+		/// IEEE 754 half precision
+		HALF
+	};
+
+	struct Parameters {
+		Parameters();
+
+		/// Grid: center of cell (col, row) is `(origin_x + (col + 0.5) * resolution, origin_y + (row + 0.5) * resolution)`
+		double origin_x;
+		double origin_y;
+		double resolution;
+		size_t width;
+		size_t height;
+		/// Time between consecutive slices [s]
+		double dt;
+		/// Number of slices; slice 0 corresponds to the current time
+		size_t slices_num;
+		/// Growth rate of the human position covariance [m^2/s]
+		double cov_growth_xx;
+		double cov_growth_xy;
+		double cov_growth_yy;
+		/// Number of standard deviations of the support of each Gaussian
+		double sigmas;
+		/// See @ref PersonalSpaceIntrusion::computePersonalSpaceGaussian
+		bool unify_asymmetry_scale;
+		CostReduction reduction;
+		Encoding encoding;
+	};
+
+	/// Allocates the volume; throws std::invalid_argument if the parameters are invalid
+	explicit CostVolume(const Parameters& params);
+
+	/**
+	 * @brief Rasterizes all slices of the volume
+	 *
+	 * All storage is allocated by the constructor, so rasterization does not allocate.
+	 *
+	 * @param humans current states of humans (positions, orientations, velocities, position covariances
+	 * and personal space variances are used)
+	 * @param groups states of O-spaces
+	 */
+	void rasterize(const HumanArray& humans, const GroupArray& groups);
+
+	/// Returns the decoded cost of the cell
+	double getCost(size_t slice, size_t row, size_t col) const;
+
+	/// Returns encoded costs of the slice; valid for @ref Encoding::UINT8 only (nullptr otherwise)
+	const uint8_t* getSliceUint8(size_t slice) const;
+
+	/// Returns encoded costs of the slice; valid for @ref Encoding::HALF only (nullptr otherwise)
+	const uint16_t* getSliceHalf(size_t slice) const;
+
+	/// Number of bytes between the beginnings of consecutive slices
+	inline size_t getSliceStride() const {
+		return slice_stride_;
+	}
+
+	inline const Parameters& getParameters() const {
+		return params_;
+	}
+
+	/// Size of the storage [bytes]
+	inline size_t getMemorySize() const {
+		return data_.size();
+	}
+
+protected:
+	/// Cells covered by the bounding box of a Gaussian; empty if @ref col_begin >= @ref col_end
+	struct CellRange {
+		size_t col_begin;
+		size_t col_end;
+		size_t row_begin;
+		size_t row_end;
+	};
+
+	/// Computes cells covered by the k-sigma ellipse of a Gaussian centered at (x, y)
+	CellRange computeCellRange(double x, double y, double half_extent_x, double half_extent_y) const;
+
+	/// Accumulates normalized costs of the model into the @ref layer within the range of cells
+	template <typename Tmodel>
+	void rasterizeModel(const Tmodel& model, const CellRange& range, float* layer) const;
+
+	/// Encodes costs of the @ref layer into the slice
+	void encodeSlice(const float* layer, size_t slice);
+
+	Parameters params_;
+	GaussianCutoff cutoff_;
+	size_t cells_num_;
+	size_t slice_stride_;
+
+	/// Encoded slices
+	AlignedVector<uint8_t> data_;
+	/// Costs of static groups shared by all slices
+	AlignedVector<float> groups_layer_;
+	/// Costs of the slice being rasterized
+	AlignedVector<float> slice_layer_;
+};
+
+} // namespace social_nav_utils
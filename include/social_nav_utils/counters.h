@@ -0,0 +1,117 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace social_nav_utils {
+
+/// Events recorded by the hot-path counters
+enum class CounterEvent : size_t {
+	/// Calls to @ref PersonalSpaceIntrusion::computePersonalSpaceGaussian
+	PERSONAL_SPACE_CALLS = 0,
+	/// Calls to @ref FormationSpaceIntrusion::computeFormationSpaceGaussian
+	FORMATION_SPACE_CALLS,
+	/// Calls to @ref HeadingDirectionDisturbance::computeDirectionDisturbance
+	HEADING_DIRECTION_CALLS,
+	/// Calls to @ref PassingSpeedComfort::computeSpeedComfort
+	PASSING_SPEED_COMFORT_CALLS,
+	/// Ellipse fits performed with @ref EllipseFitting
+	ELLIPSE_FITTING_CALLS,
+	/// Ellipse fits that ended with a fallback method, see @ref EllipseFitting::usedFallback
+	ELLIPSE_FITTING_FALLBACK,
+	/// Computations of @ref LinesIntersection
+	LINES_INTERSECTION_CALLS,
+	/// Computations of @ref LinesIntersection that did not find an intersection (NaN result)
+	LINES_INTERSECTION_NAN,
+	/// Inversions of near-singular 2x2 matrices (including covariance matrices of Gaussians)
+	MATRIX_INVERSE_NEAR_SINGULAR,
+	/// Gaussians returned as exact zeros due to a @ref GaussianCutoff
+	GAUSSIAN_CUTOFF,
+	/// Calls to @ref PersonalSpaceIntrusion::computePersonalSpaceGaussian that took the isotropic uncertainty path
+	PERSONAL_SPACE_ISOTROPIC,
+	/// Calls to @ref PersonalSpaceIntrusion::computePersonalSpaceGaussian that took the diagonal uncertainty path
+	PERSONAL_SPACE_DIAGONAL,
+	/// Calls to @ref FormationSpaceIntrusion::computeFormationSpaceGaussian that took the isotropic uncertainty path
+	FORMATION_SPACE_ISOTROPIC,
+	/// Calls to @ref FormationSpaceIntrusion::computeFormationSpaceGaussian that took the diagonal uncertainty path
+	FORMATION_SPACE_DIAGONAL,
+	/// Number of events, not an event itself
+	EVENTS_NUM
+};
+
+/**
+ * @brief Low-overhead, thread-local event counters aggregated on demand
+ *
+ * Each thread increments its own counters (no contention, no locked instructions). Values of all threads,
+ * including the ones that already finished, are summed up by @ref aggregate.
+ *
+ * Library code records events with the @ref SOCIAL_NAV_UTILS_COUNT macro that compiles to nothing unless
+ * `SOCIAL_NAV_UTILS_ENABLE_COUNTERS` is defined (see the CMake option of the same name).
+ */
+class Counters {
+public:
+	static constexpr size_t EVENTS_NUM = static_cast<size_t>(CounterEvent::EVENTS_NUM);
+
+	/// Values of all counters, indexed with @ref CounterEvent
+	typedef std::array<uint64_t, EVENTS_NUM> Snapshot;
+
+	/// Relative threshold of |det| below which a 2x2 matrix is treated as near-singular
+	static constexpr double NEAR_SINGULAR_THRESHOLD = 1e-12;
+
+	/// Increments the counter of the calling thread
+	static inline void increment(CounterEvent event) {
+		auto& value = local().values[static_cast<size_t>(event)];
+		// only the owner thread modifies the value, thus no read-modify-write instruction is needed
+		value.store(value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+	/// Sums up counters of all threads (since the last @ref reset)
+	static Snapshot aggregate();
+
+	/// Returns value of a single aggregated counter
+	static uint64_t aggregate(CounterEvent event);
+
+	/// Resets aggregated values to zero
+	static void reset();
+
+	/// Returns a human-readable name of the event
+	static const char* getName(CounterEvent event);
+
+	/// Checks whether a 2x2 matrix given by its determinant and elements is near-singular
+	static inline bool isNearSingular(double det, double m11, double m12, double m21, double m22) {
+		double magnitude = std::max(std::abs(m11 * m22), std::abs(m12 * m21));
+		return std::abs(det) <= NEAR_SINGULAR_THRESHOLD * magnitude;
+	}
+
+protected:
+	/// Counters of a single thread, registered for aggregation during the lifetime of the thread
+	struct ThreadCounters {
+		ThreadCounters();
+		~ThreadCounters();
+
+		std::array<std::atomic<uint64_t>, EVENTS_NUM> values;
+	};
+
+	static inline ThreadCounters& local() {
+		static thread_local ThreadCounters counters;
+		return counters;
+	}
+};
+
+} // namespace social_nav_utils
+
+#ifdef SOCIAL_NAV_UTILS_ENABLE_COUNTERS
+/// Records an occurrence of the @ref CounterEvent
+#define SOCIAL_NAV_UTILS_COUNT(event) \
+	::social_nav_utils::Counters::increment(::social_nav_utils::CounterEvent::event)
+/// Records an occurrence of the @ref CounterEvent if condition is true; condition is not evaluated when disabled
+#define SOCIAL_NAV_UTILS_COUNT_IF(condition, event) \
+	do { if (condition) { SOCIAL_NAV_UTILS_COUNT(event); } } while (false)
+#else
+#define SOCIAL_NAV_UTILS_COUNT(event) ((void)0)
+#define SOCIAL_NAV_UTILS_COUNT_IF(condition, event) ((void)0)
+#endif
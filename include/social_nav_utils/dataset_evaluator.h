@@ -0,0 +1,102 @@
+#pragma once
+
+#include <social_nav_utils/passing_event_detector.h>
+#include <social_nav_utils/social_scene.h>
+#include <social_nav_utils/trajectory_dataset.h>
+#include <social_nav_utils/work_stealing_pool.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace social_nav_utils {
+
+/**
+ * @brief Computes per-episode aggregates of social metrics over a @ref TrajectoryDataset using all cores
+ *
+ * Each frame of an episode is loaded into a @ref SocialScene (agents become humans, agents sharing a group
+ * identifier become groups whose O-space is fitted to the members). The following per-frame samples are taken:
+ * - personal space intrusion: maximum over humans (normalized),
+ * - formation space intrusion: maximum over groups (normalized),
+ * - heading direction disturbance: maximum over humans (normalized),
+ * - passing speed comfort: comfort of the human closest to the robot.
+ *
+ * Frames without the relevant entities do not contribute to the metric. Additionally, passings of the robot and
+ * each agent are detected (see @ref detectPassingEvents) and the comfort is sampled once per passing.
+ */
+class DatasetEvaluator {
+public:
+	/// Number of episodes evaluated in parallel before the results are passed to the consumer
+	static constexpr size_t BATCH_EPISODES = 256;
+
+	/// Parameters of the models that are not stored in the dataset
+	struct Parameters {
+		Parameters();
+
+		/// Template of each human; position, orientation and velocity are taken from the dataset
+		SocialScene::HumanState human;
+		/// Template of the robot; position, orientation and velocity are taken from the dataset
+		SocialScene::RobotState robot;
+		/// Uncertainty of the O-space center positions
+		double group_cov_xx;
+		double group_cov_xy;
+		double group_cov_yy;
+		/// See @ref PersonalSpaceIntrusion::computePersonalSpaceGaussian
+		bool unify_asymmetry_scale;
+		/// Detection of passings for @ref EpisodeMetrics::passing_events
+		PassingEventDetector::Parameters passing;
+	};
+
+	/// Statistics of per-frame samples of a metric
+	struct Summary {
+		/// Number of frames that contributed; other fields are NaN if 0
+		size_t samples = 0;
+		double mean = NAN;
+		double min = NAN;
+		double max = NAN;
+
+		void add(double sample);
+	};
+
+	struct EpisodeMetrics {
+		int64_t id = 0;
+		size_t frames_num = 0;
+		Summary personal_space;
+		Summary formation_space;
+		Summary heading_direction;
+		Summary passing_comfort;
+		/// Comfort at the closest approach of each passing
+		Summary passing_events;
+	};
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param params parameters of the models
+	 * @param threads_num number of threads (including the calling one); 0 selects the number of hardware threads
+	 */
+	explicit DatasetEvaluator(const Parameters& params = Parameters(), size_t threads_num = 0);
+
+	inline size_t getThreadsNum() const {
+		return pool_.getThreadsNum();
+	}
+
+	/// Computes metrics of a single episode in the calling thread
+	EpisodeMetrics evaluateEpisode(const TrajectoryEpisode& episode) const;
+
+	/**
+	 * @brief Computes metrics of all episodes of the dataset
+	 *
+	 * Episodes are evaluated in parallel in batches of @ref BATCH_EPISODES. Results are passed to @ref consumer
+	 * in the order of episodes (from the calling thread), and pages of processed episodes are released,
+	 * so the memory footprint does not depend on the size of the dataset.
+	 */
+	void evaluate(const TrajectoryDataset& dataset, const std::function<void(const EpisodeMetrics&)>& consumer);
+
+protected:
+	Parameters params_;
+	WorkStealingPool pool_;
+};
+
+} // namespace social_nav_utils
@@ -3,6 +3,7 @@
 #include <eigen3/Eigen/Core>
 
 #include<array>
+#include<memory_resource>
 #include<vector>
 
 namespace social_nav_utils {
@@ -29,8 +30,16 @@ public:
 	 */
 	static constexpr auto MARGIN_ALGEBRAIC_VALID = 1.0;
 
-	/// Performs ellipse fitting to the points given by @ref x and @ref y
-	EllipseFitting(const std::vector<double>& x, const std::vector<double>& y);
+	/**
+	 * @brief Performs ellipse fitting to the points given by @ref x and @ref y
+	 *
+	 * @param memory resource for temporaries of the computations, e.g., a @ref MemoryArena reset once per cycle
+	 */
+	EllipseFitting(
+		const std::vector<double>& x,
+		const std::vector<double>& y,
+		std::pmr::memory_resource* memory = std::pmr::get_default_resource()
+	);
 
 	inline double getCenterX() const {
 		return params_.at(0);
@@ -66,13 +75,21 @@ protected:
 	 * @copyright (C) 2018 Gopiraj @ https://github.com/gopiraj15
 	 * https://github.com/gopiraj15/OpenCV-journey/blob/master/TaubinEllipseFit.cpp
 	 */
-	bool fitTaubin(const std::vector<double>& x, const std::vector<double>& y);
+	bool fitTaubin(
+		const std::vector<double>& x,
+		const std::vector<double>& y,
+		std::pmr::memory_resource* memory = std::pmr::get_default_resource()
+	);
 
 	/// Performs heuristic ellipse creation around a single point
 	bool fitFallbackSingle(double x, double y);
 
 	/// Performs heuristic ellipse fitting once main solver returns bad results
-	bool fitFallbackMultiple(const std::vector<double>& x, const std::vector<double>& y);
+	bool fitFallbackMultiple(
+		const std::vector<double>& x,
+		const std::vector<double>& y,
+		std::pmr::memory_resource* memory = std::pmr::get_default_resource()
+	);
 
 	/**
 	 * Converts The Conic in the form [A B C D E F] into an Ellipse of the form [centrex centrey axea axeb angle]
@@ -80,7 +97,7 @@ protected:
 	 * @copyright (C) 2018 Gopiraj @ https://github.com/gopiraj15
 	 * https://github.com/gopiraj15/OpenCV-journey/blob/master/TaubinEllipseFit.cpp
 	 */
-	Eigen::MatrixXd convertConicToParametric(const Eigen::MatrixXd& par);
+	Eigen::Matrix<double, 5, 1> convertConicToParametric(const Eigen::Matrix<double, 6, 1>& par);
 
 	/**
 	 * @brief Computes projection of @ref v1 onto @ref v2
@@ -0,0 +1,300 @@
+#pragma once
+
+#include <social_nav_utils/aligned_allocator.h>
+#include <social_nav_utils/social_scene.h>
+
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+
+namespace social_nav_utils {
+
+/**
+ * @brief Structure-of-arrays storage of a fixed number of double columns sharing a single aligned buffer
+ *
+ * Each column starts at a @ref BATCH_ALIGNMENT boundary. Removing elements keeps the allocated storage,
+ * so refilling the array each frame does not allocate once the capacity has been reached.
+ */
+class ColumnArray {
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param defaults values of newly created elements, one per column
+	 * @param columns_num number of columns
+	 */
+	ColumnArray(const double* defaults, size_t columns_num);
+
+	inline size_t size() const {
+		return size_;
+	}
+
+	inline size_t capacity() const {
+		return capacity_;
+	}
+
+	/// Removes all elements (keeps allocated storage)
+	void clear();
+
+	/// Ensures that @ref capacity elements fit without reallocation
+	void reserve(size_t capacity);
+
+	/// Changes the number of elements, new elements are set to the defaults
+	void resize(size_t size);
+
+	inline double* column(size_t column) {
+		assert(column < columns_num_);
+		return data_.data() + column * capacity_;
+	}
+
+	inline const double* column(size_t column) const {
+		assert(column < columns_num_);
+		return data_.data() + column * capacity_;
+	}
+
+protected:
+	/// Number of doubles that fill the alignment
+	static constexpr size_t CAPACITY_STEP = BATCH_ALIGNMENT / sizeof(double);
+
+	const double* defaults_;
+	size_t columns_num_;
+	size_t size_;
+	size_t capacity_;
+	AlignedVector<double> data_;
+};
+
+/**
+ * @brief Structure-of-arrays container of human states, the batch counterpart of @ref SocialScene::HumanState
+ *
+ * Typical usage: @ref resize to the number of humans in the frame, then fill the columns (unset columns keep
+ * the defaults of @ref SocialScene::HumanState). Alternatively, @ref clear and @ref add each human.
+ */
+class HumanArray {
+public:
+	enum Column {
+		X = 0,
+		Y,
+		YAW,
+		VX,
+		VY,
+		COV_XX,
+		COV_XY,
+		COV_YY,
+		PS_VAR_FRONT,
+		PS_VAR_REAR,
+		PS_VAR_SIDE,
+		OCCUPANCY_RADIUS,
+		FOV,
+		COLUMNS_NUM
+	};
+
+	HumanArray();
+
+	inline size_t size() const {
+		return columns_.size();
+	}
+
+	inline void clear() {
+		columns_.clear();
+	}
+
+	inline void reserve(size_t capacity) {
+		columns_.reserve(capacity);
+	}
+
+	inline void resize(size_t size) {
+		columns_.resize(size);
+	}
+
+	/// Appends a human, returns its index
+	size_t add(const SocialScene::HumanState& human);
+
+	/// Sets all elements to the given state (e.g., a template whose position is then overwritten column-wise)
+	void fill(const SocialScene::HumanState& human);
+
+	inline void set(size_t index, const SocialScene::HumanState& human) {
+		if (index >= size()) {
+			throw std::out_of_range("Index of the human exceeds the size of the array");
+		}
+		x()[index] = human.x;
+		y()[index] = human.y;
+		yaw()[index] = human.yaw;
+		vx()[index] = human.vx;
+		vy()[index] = human.vy;
+		covXX()[index] = human.cov_xx;
+		covXY()[index] = human.cov_xy;
+		covYY()[index] = human.cov_yy;
+		psVarFront()[index] = human.ps_var_front;
+		psVarRear()[index] = human.ps_var_rear;
+		psVarSide()[index] = human.ps_var_side;
+		occupancyRadius()[index] = human.occupancy_radius;
+		fov()[index] = human.fov;
+	}
+
+	inline SocialScene::HumanState get(size_t index) const {
+		if (index >= size()) {
+			throw std::out_of_range("Index of the human exceeds the size of the array");
+		}
+		SocialScene::HumanState human;
+		human.x = x()[index];
+		human.y = y()[index];
+		human.yaw = yaw()[index];
+		human.vx = vx()[index];
+		human.vy = vy()[index];
+		human.cov_xx = covXX()[index];
+		human.cov_xy = covXY()[index];
+		human.cov_yy = covYY()[index];
+		human.ps_var_front = psVarFront()[index];
+		human.ps_var_rear = psVarRear()[index];
+		human.ps_var_side = psVarSide()[index];
+		human.occupancy_radius = occupancyRadius()[index];
+		human.fov = fov()[index];
+		return human;
+	}
+
+	inline double* column(Column column) {
+		return columns_.column(column);
+	}
+
+	inline const double* column(Column column) const {
+		return columns_.column(column);
+	}
+
+	inline double* x() { return column(X); }
+	inline const double* x() const { return column(X); }
+	inline double* y() { return column(Y); }
+	inline const double* y() const { return column(Y); }
+	inline double* yaw() { return column(YAW); }
+	inline const double* yaw() const { return column(YAW); }
+	inline double* vx() { return column(VX); }
+	inline const double* vx() const { return column(VX); }
+	inline double* vy() { return column(VY); }
+	inline const double* vy() const { return column(VY); }
+	inline double* covXX() { return column(COV_XX); }
+	inline const double* covXX() const { return column(COV_XX); }
+	inline double* covXY() { return column(COV_XY); }
+	inline const double* covXY() const { return column(COV_XY); }
+	inline double* covYY() { return column(COV_YY); }
+	inline const double* covYY() const { return column(COV_YY); }
+	inline double* psVarFront() { return column(PS_VAR_FRONT); }
+	inline const double* psVarFront() const { return column(PS_VAR_FRONT); }
+	inline double* psVarRear() { return column(PS_VAR_REAR); }
+	inline const double* psVarRear() const { return column(PS_VAR_REAR); }
+	inline double* psVarSide() { return column(PS_VAR_SIDE); }
+	inline const double* psVarSide() const { return column(PS_VAR_SIDE); }
+	inline double* occupancyRadius() { return column(OCCUPANCY_RADIUS); }
+	inline const double* occupancyRadius() const { return column(OCCUPANCY_RADIUS); }
+	inline double* fov() { return column(FOV); }
+	inline const double* fov() const { return column(FOV); }
+
+protected:
+	ColumnArray columns_;
+};
+
+/**
+ * @brief Structure-of-arrays container of O-space states, the batch counterpart of @ref SocialScene::GroupState
+ *
+ * See @ref HumanArray for the typical usage.
+ */
+class GroupArray {
+public:
+	enum Column {
+		X = 0,
+		Y,
+		ORIENTATION,
+		VARIANCE_X,
+		VARIANCE_Y,
+		COV_XX,
+		COV_XY,
+		COV_YY,
+		COLUMNS_NUM
+	};
+
+	GroupArray();
+
+	inline size_t size() const {
+		return columns_.size();
+	}
+
+	inline void clear() {
+		columns_.clear();
+	}
+
+	inline void reserve(size_t capacity) {
+		columns_.reserve(capacity);
+	}
+
+	inline void resize(size_t size) {
+		columns_.resize(size);
+	}
+
+	/// Appends a group, returns its index
+	size_t add(const SocialScene::GroupState& group);
+
+	/// Sets all elements to the given state
+	void fill(const SocialScene::GroupState& group);
+
+	inline void set(size_t index, const SocialScene::GroupState& group) {
+		if (index >= size()) {
+			throw std::out_of_range("Index of the group exceeds the size of the array");
+		}
+		x()[index] = group.x;
+		y()[index] = group.y;
+		orientation()[index] = group.orientation;
+		varianceX()[index] = group.variance_x;
+		varianceY()[index] = group.variance_y;
+		covXX()[index] = group.cov_xx;
+		covXY()[index] = group.cov_xy;
+		covYY()[index] = group.cov_yy;
+	}
+
+	inline SocialScene::GroupState get(size_t index) const {
+		if (index >= size()) {
+			throw std::out_of_range("Index of the group exceeds the size of the array");
+		}
+		SocialScene::GroupState group;
+		group.x = x()[index];
+		group.y = y()[index];
+		group.orientation = orientation()[index];
+		group.variance_x = varianceX()[index];
+		group.variance_y = varianceY()[index];
+		group.cov_xx = covXX()[index];
+		group.cov_xy = covXY()[index];
+		group.cov_yy = covYY()[index];
+		return group;
+	}
+
+	inline double* column(Column column) {
+		return columns_.column(column);
+	}
+
+	inline const double* column(Column column) const {
+		return columns_.column(column);
+	}
+
+	inline double* x() { return column(X); }
+	inline const double* x() const { return column(X); }
+	inline double* y() { return column(Y); }
+	inline const double* y() const { return column(Y); }
+	inline double* orientation() { return column(ORIENTATION); }
+	inline const double* orientation() const { return column(ORIENTATION); }
+	inline double* varianceX() { return column(VARIANCE_X); }
+	inline const double* varianceX() const { return column(VARIANCE_X); }
+	inline double* varianceY() { return column(VARIANCE_Y); }
+	inline const double* varianceY() const { return column(VARIANCE_Y); }
+	inline double* covXX() { return column(COV_XX); }
+	inline const double* covXX() const { return column(COV_XX); }
+	inline double* covXY() { return column(COV_XY); }
+	inline const double* covXY() const { return column(COV_XY); }
+	inline double* covYY() { return column(COV_YY); }
+	inline const double* covYY() const { return column(COV_YY); }
+
+protected:
+	ColumnArray columns_;
+};
+
+} // namespace social_nav_utils
+
+#ifdef SOCIAL_NAV_UTILS_HEADER_ONLY
+#include <social_nav_utils/impl/entity_arrays.h>
+#endif
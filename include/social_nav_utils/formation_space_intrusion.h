@@ -1,5 +1,7 @@
 #pragma once
 
+#include <social_nav_utils/gaussian_cutoff.h>
+
 namespace social_nav_utils {
 
 class FormationSpaceIntrusion {
@@ -38,6 +40,10 @@ public:
 	/**
 	 * @brief Computes value of a Gaussian (given by method parameters) at given position
 	 *
+	 * Position uncertainty without correlation (`pos_center_variance_xyyx` equal to 0) is handled by an exact
+	 * closed-form path, see @ref computeFormationSpaceGaussianDiagonal. Hits are counted with
+	 * the `FORMATION_SPACE_ISOTROPIC` and `FORMATION_SPACE_DIAGONAL` counters.
+	 *
 	 * @param ospace_pos_x
 	 * @param ospace_pos_y
 	 * @param ospace_orientation
@@ -65,7 +71,78 @@ public:
 		double robot_pos_y
 	);
 
+	/**
+	 * @brief @ref computeFormationSpaceGaussian with a support cutoff, returns exact zero beyond it
+	 *
+	 * The k-sigma criterion is checked against the distance between the robot and the O-space center before
+	 * any matrix is built. See @ref GaussianCutoff for the maximum error.
+	 */
+	static double computeFormationSpaceGaussian(
+		double ospace_pos_x,
+		double ospace_pos_y,
+		double ospace_orientation,
+		double ospace_variance_x,
+		double ospace_variance_y,
+		double pos_center_variance_xx,
+		double pos_center_variance_xyyx,
+		double pos_center_variance_yy,
+		double robot_pos_x,
+		double robot_pos_y,
+		const GaussianCutoff& cutoff
+	);
+
+	/**
+	 * @brief Computes a natural logarithm of @ref computeFormationSpaceGaussian (log-density)
+	 *
+	 * Handy when costs are summed in the log domain, as `exp` is not evaluated at all
+	 */
+	static double computeFormationSpaceGaussianLog(
+		double ospace_pos_x,
+		double ospace_pos_y,
+		double ospace_orientation,
+		double ospace_variance_x,
+		double ospace_variance_y,
+		double pos_center_variance_xx,
+		double pos_center_variance_xyyx,
+		double pos_center_variance_yy,
+		double robot_pos_x,
+		double robot_pos_y
+	);
+
+	/// Computes a squared Mahalanobis distance of the robot from the O-space center
+	static double computeFormationSpaceMahalanobisSquared(
+		double ospace_pos_x,
+		double ospace_pos_y,
+		double ospace_orientation,
+		double ospace_variance_x,
+		double ospace_variance_y,
+		double pos_center_variance_xx,
+		double pos_center_variance_xyyx,
+		double pos_center_variance_yy,
+		double robot_pos_x,
+		double robot_pos_y
+	);
+
 protected:
+	/**
+	 * @brief Closed-form @ref computeFormationSpaceGaussian for a diagonal covariance of the position uncertainty
+	 *
+	 * With isotropic uncertainty (`pos_center_variance_xx == pos_center_variance_yy`), the summed covariance
+	 * is diagonal in the O-space frame, so the quadratic form is evaluated there directly. Otherwise, the summed
+	 * covariance is assembled elementwise and inverted in closed form. Both paths are exact.
+	 */
+	static double computeFormationSpaceGaussianDiagonal(
+		double ospace_pos_x,
+		double ospace_pos_y,
+		double ospace_orientation,
+		double ospace_variance_x,
+		double ospace_variance_y,
+		double pos_center_variance_xx,
+		double pos_center_variance_yy,
+		double robot_pos_x,
+		double robot_pos_y
+	);
+
 	double intrusion_scale_;
 
 	double ospace_pos_x_;
@@ -81,3 +158,7 @@ protected:
 };
 
 } // namespace social_nav_utils
+
+#ifdef SOCIAL_NAV_UTILS_HEADER_ONLY
+#include <social_nav_utils/impl/formation_space_intrusion.h>
+#endif
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <social_nav_utils/gaussian_model.h>
+
+namespace social_nav_utils {
+
+/**
+ * @brief Precomputed model of the O-space of a single F-formation
+ *
+ * Stores rotated and summed covariance matrix of the O-space along with its inverse. Evaluation at a given position
+ * of the robot is equivalent to @ref FormationSpaceIntrusion::computeFormationSpaceGaussian.
+ */
+class FormationSpaceModel {
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * For parameters description, refer to the @ref FormationSpaceIntrusion::computeFormationSpaceGaussian
+	 */
+	FormationSpaceModel(
+		double ospace_pos_x,
+		double ospace_pos_y,
+		double ospace_orientation,
+		double ospace_variance_x,
+		double ospace_variance_y,
+		double pos_center_variance_xx,
+		double pos_center_variance_xyyx,
+		double pos_center_variance_yy
+	);
+
+	/// Computes value of a Gaussian modelling the O-space at the given position of the robot
+	inline double evaluate(double robot_pos_x, double robot_pos_y) const {
+		return gaussian_.evaluate(robot_pos_x, robot_pos_y);
+	}
+
+	/// Computes value of a Gaussian modelling the O-space, exact zero beyond the @ref cutoff
+	inline double evaluate(double robot_pos_x, double robot_pos_y, const GaussianCutoff& cutoff) const {
+		return gaussian_.evaluate(robot_pos_x, robot_pos_y, cutoff);
+	}
+
+	/// Computes a natural logarithm of @ref evaluate (log-density)
+	inline double evaluateLog(double robot_pos_x, double robot_pos_y) const {
+		return gaussian_.evaluateLog(robot_pos_x, robot_pos_y);
+	}
+
+	/// Computes a squared Mahalanobis distance of the robot from the O-space center
+	inline double computeMahalanobisSquared(double robot_pos_x, double robot_pos_y) const {
+		return gaussian_.computeQuadraticForm(robot_pos_x, robot_pos_y);
+	}
+
+	/**
+	 * Returns the worst case value for the current arrangement, i.e., the value at the O-space center
+	 *
+	 * Equivalent to the value used in @ref FormationSpaceIntrusion::normalize
+	 */
+	inline double getMax() const {
+		return gaussian_.getNormalization();
+	}
+
+	/// Returns a logarithm of @ref getMax
+	inline double getMaxLog() const {
+		return gaussian_.getLogNormalization();
+	}
+
+	inline double getPositionX() const {
+		return gaussian_.getMeanX();
+	}
+
+	inline double getPositionY() const {
+		return gaussian_.getMeanY();
+	}
+
+	inline const GaussianModel& getGaussian() const {
+		return gaussian_;
+	}
+
+protected:
+	GaussianModel gaussian_;
+};
+
+} // namespace social_nav_utils
+
+#ifdef SOCIAL_NAV_UTILS_HEADER_ONLY
+#include <social_nav_utils/impl/formation_space_model.h>
+#endif
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+
+namespace social_nav_utils {
+
+/**
+ * @brief Support cutoff of a Gaussian: values beyond the cutoff are returned as exact zeros
+ *
+ * Two criteria are available (when both are given, a value is zeroed once either of them holds):
+ * - k-sigma: zero once the squared Mahalanobis distance from the mean exceeds k^2. The maximum absolute error
+ *   is then `peak * exp(-k^2 / 2)`, where `peak` is the value at the mean, e.g., 3.7e-06 * peak for k = 5
+ *   and 2.3e-11 * peak for k = 7. This criterion is checked with a squared Euclidean distance bound first
+ *   (the largest eigenvalue of a covariance matrix does not exceed its trace), so far from the mean neither
+ *   inverse, determinant nor `exp` are computed.
+ * - value floor: zero once the value drops below the floor, so the maximum absolute error is the floor itself.
+ *   The floor is compared with the evaluated value, after the k-sigma check.
+ *
+ * See @ref getMaxError.
+ */
+class GaussianCutoff {
+public:
+	/**
+	 * @brief Constructor; defaults disable the cutoff
+	 *
+	 * @param sigmas number of standard deviations (Mahalanobis distance) where the support ends
+	 * @param value_floor values below the floor are zeroed
+	 */
+	explicit GaussianCutoff(
+		double sigmas = std::numeric_limits<double>::infinity(),
+		double value_floor = 0.0
+	):
+		sigmas_(sigmas),
+		mahalanobis_sq_max_(sigmas * sigmas),
+		value_floor_(value_floor)
+	{}
+
+	/// Creates k-sigma cutoff
+	static GaussianCutoff fromSigmas(double sigmas) {
+		return GaussianCutoff(sigmas);
+	}
+
+	/// Creates cutoff that zeroes values smaller than the floor
+	static GaussianCutoff fromFloor(double value_floor) {
+		return GaussianCutoff(std::numeric_limits<double>::infinity(), value_floor);
+	}
+
+	inline bool isEnabled() const {
+		return std::isfinite(sigmas_) || value_floor_ > 0.0;
+	}
+
+	inline double getSigmas() const {
+		return sigmas_;
+	}
+
+	inline double getValueFloor() const {
+		return value_floor_;
+	}
+
+	/**
+	 * @brief Cheap check of the k-sigma criterion that only needs a squared Euclidean distance from the mean
+	 *
+	 * @param distance_sq squared Euclidean distance from the mean
+	 * @param variance_bound upper bound of the largest eigenvalue of the covariance matrix (e.g., its trace)
+	 * @return true if the squared Mahalanobis distance certainly exceeds the cutoff
+	 */
+	inline bool isBeyondDistance(double distance_sq, double variance_bound) const {
+		return distance_sq > mahalanobis_sq_max_ * variance_bound;
+	}
+
+	/// Returns the squared Mahalanobis distance of the k-sigma criterion
+	inline double getMahalanobisSquaredMax() const {
+		return mahalanobis_sq_max_;
+	}
+
+	/**
+	 * @brief Returns the maximum absolute error introduced by the cutoff
+	 *
+	 * @param peak value of the Gaussian at the mean
+	 */
+	inline double getMaxError(double peak) const {
+		return std::fmax(peak * std::exp(-0.5 * mahalanobis_sq_max_), std::fmax(value_floor_, 0.0));
+	}
+
+protected:
+	double sigmas_;
+	double mahalanobis_sq_max_;
+	double value_floor_;
+};
+
+} // namespace social_nav_utils
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <social_nav_utils/math/core.h>
+#include <social_nav_utils/counters.h>
+#include <social_nav_utils/gaussian_cutoff.h>
+
+#include <cmath>
+
+namespace social_nav_utils {
+
+/**
+ * @brief Bivariate Gaussian with precomputed inverse of the covariance matrix and normalization factor
+ *
+ * Handy when the same Gaussian is evaluated at multiple positions - only the quadratic form and a single `exp`
+ * are computed per evaluation. Results are equivalent to @ref calculateGaussian called with 2D arguments.
+ *
+ * Construction involves a single `sqrt`; the logarithm of the normalization factor needed by the log domain
+ * outputs is derived on demand, so models built per call do not pay for it. @ref computeQuadraticForm involves
+ * no transcendental functions at all.
+ */
+class GaussianModel {
+public:
+	GaussianModel(): GaussianModel(0.0, 0.0, Matrix2d(1.0, 0.0, 0.0, 1.0)) {}
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param mean_x x coordinate of the mean
+	 * @param mean_y y coordinate of the mean
+	 * @param cov covariance matrix
+	 */
+	GaussianModel(double mean_x, double mean_y, const Matrix2d& cov):
+		mean_x_(mean_x),
+		mean_y_(mean_y)
+	{
+		double det = cov.determinant();
+		SOCIAL_NAV_UTILS_COUNT_IF(
+			Counters::isNearSingular(det, cov(0, 0), cov(0, 1), cov(1, 0), cov(1, 1)),
+			MATRIX_INVERSE_NEAR_SINGULAR
+		);
+		cov_inv_xx_ = +cov(1, 1) / det;
+		cov_inv_xy_ = -cov(0, 1) / det;
+		cov_inv_yx_ = -cov(1, 0) / det;
+		cov_inv_yy_ = +cov(0, 0) / det;
+		// (2 * pi)^(-n/2) * det^(-1/2), where n = 2
+		normalization_ = 1.0 / (2.0 * M_PI * std::sqrt(det));
+	}
+
+	/// Computes a value of the Gaussian at the given position
+	inline double evaluate(double x, double y) const {
+		return normalization_ * std::exp(-0.5 * computeQuadraticForm(x, y));
+	}
+
+	/**
+	 * @brief Computes a value of the Gaussian at the given position, exact zero beyond the @ref cutoff
+	 *
+	 * The k-sigma criterion is decided by the quadratic form, so `exp` is skipped for positions beyond it;
+	 * the value floor is compared with the value itself (as in @ref calculateGaussian)
+	 */
+	inline double evaluate(double x, double y, const GaussianCutoff& cutoff) const {
+		return evaluateScaled(x, y, cutoff, 1.0);
+	}
+
+	/// Computes a value of the Gaussian multiplied by @ref scale, exact zero beyond the @ref cutoff
+	inline double evaluateScaled(double x, double y, const GaussianCutoff& cutoff, double scale) const {
+		double quadform = computeQuadraticForm(x, y);
+		if (quadform > cutoff.getMahalanobisSquaredMax()) {
+			SOCIAL_NAV_UTILS_COUNT(GAUSSIAN_CUTOFF);
+			return 0.0;
+		}
+		double value = scale * normalization_ * std::exp(-0.5 * quadform);
+		if (value < cutoff.getValueFloor()) {
+			SOCIAL_NAV_UTILS_COUNT(GAUSSIAN_CUTOFF);
+			return 0.0;
+		}
+		return value;
+	}
+
+	/// Computes a natural logarithm of the Gaussian at the given position (log-density); a single `log`
+	inline double evaluateLog(double x, double y) const {
+		return getLogNormalization() - 0.5 * computeQuadraticForm(x, y);
+	}
+
+	/// Computes a quadratic form (x - mean)^T * cov^(-1) * (x - mean), i.e., squared Mahalanobis distance
+	inline double computeQuadraticForm(double x, double y) const {
+		double dx = x - mean_x_;
+		double dy = y - mean_y_;
+		return dx * (cov_inv_xx_ * dx + cov_inv_xy_ * dy) + dy * (cov_inv_yx_ * dx + cov_inv_yy_ * dy);
+	}
+
+	/// Returns a value of the Gaussian at the mean (the maximum value)
+	inline double getNormalization() const {
+		return normalization_;
+	}
+
+	/// Returns a logarithm of @ref getNormalization (computed on demand)
+	inline double getLogNormalization() const {
+		return std::log(normalization_);
+	}
+
+	/// Returns inverse of the covariance matrix
+	inline Matrix2d getCovarianceInverse() const {
+		return Matrix2d(cov_inv_xx_, cov_inv_xy_, cov_inv_yx_, cov_inv_yy_);
+	}
+
+	inline double getMeanX() const {
+		return mean_x_;
+	}
+
+	inline double getMeanY() const {
+		return mean_y_;
+	}
+
+protected:
+	double mean_x_;
+	double mean_y_;
+	double cov_inv_xx_;
+	double cov_inv_xy_;
+	double cov_inv_yx_;
+	double cov_inv_yy_;
+	double normalization_;
+};
+
+} // namespace social_nav_utils
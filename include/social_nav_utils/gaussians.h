@@ -5,10 +5,14 @@
 // may prevent compilation errors calling to matrix.inverse()
 #include <eigen3/Eigen/LU>
 
+#include <memory_resource>
+
 // custom classes for linear algebra with API similar to Eigen
 #include <social_nav_utils/math/core.h>
 
 // used in template functions
+#include <social_nav_utils/counters.h>
+#include <social_nav_utils/gaussian_cutoff.h>
 #include <social_nav_utils/relative_location.h>
 
 namespace social_nav_utils {
@@ -20,6 +24,26 @@ namespace social_nav_utils {
  */
 double calculateGaussian(double x, double mean, double variance, bool normalize = false);
 
+/**
+ * @brief @ref calculateGaussian with a support cutoff, returns exact zero beyond it
+ *
+ * See @ref GaussianCutoff for the maximum error
+ */
+double calculateGaussian(double x, double mean, double variance, bool normalize, const GaussianCutoff& cutoff);
+
+/**
+ * @brief Computes a natural logarithm of @ref calculateGaussian (log-density)
+ *
+ * Intended for summation of costs in the log domain, where `exp` of @ref calculateGaussian would be undone anyway
+ */
+double calculateGaussianLog(double x, double mean, double variance, bool normalize = false);
+
+/**
+ * @brief Computes a squared Mahalanobis distance of @ref x from the @ref mean, i.e., the exponent of
+ * @ref calculateGaussian multiplied by -2
+ */
+double calculateMahalanobisSquared(double x, double mean, double variance);
+
 /**
  * Computes value of univariate Gaussian PDF but includes wrapped regions of bell curve (shifted -2pi and +2pi)
  *
@@ -33,6 +57,7 @@ double calculateGaussianAngle(double x, double mean, double variance, bool norma
  *
  * Note that this method does not account for scale, no matter of variance, the value in the center will be 1.0,
  * so in fact this is not a Distribution.
+ * When the same Gaussian is evaluated at many positions, use @ref AsymmetricGaussianModel.
  *
  * Reference: Algorithm A.1 from Kirby, 2010 PhD thesis "Social Robot Navigation" (p. 166)
  * @url https://www.ri.cmu.edu/pub_files/2010/5/rk_thesis.pdf
@@ -53,11 +78,60 @@ double calculateGaussianAsymmetrical(
  */
 double calculateGaussian(const Eigen::VectorXd& x, const Eigen::VectorXd& mean, const Eigen::MatrixXd& cov);
 
+/**
+ * @brief @ref calculateGaussian template specialization with a support cutoff
+ */
+double calculateGaussian(
+	const Eigen::VectorXd& x,
+	const Eigen::VectorXd& mean,
+	const Eigen::MatrixXd& cov,
+	const GaussianCutoff& cutoff
+);
+
+/**
+ * @brief @ref calculateGaussian template specialization with a support cutoff
+ */
+double calculateGaussian(const Vector2d& x, const Vector2d& mean, const Matrix2d& cov, const GaussianCutoff& cutoff);
+
+/**
+ * @brief @ref calculateGaussian for Eigen types with temporaries allocated from the given memory resource
+ *
+ * The covariance matrix is factorized in place (Cholesky) in a buffer obtained from @ref memory, so no
+ * dynamic Eigen temporaries are created. Intended for a per-cycle arena (see @ref MemoryArena).
+ * Falls back to the generic computation if @ref cov is not positive definite.
+ */
+double calculateGaussian(
+	const Eigen::VectorXd& x,
+	const Eigen::VectorXd& mean,
+	const Eigen::MatrixXd& cov,
+	std::pmr::memory_resource* memory
+);
+
 /**
  * @brief @ref calculateGaussian template specialization
  */
 double calculateGaussian(const Vector2d& x, const Vector2d& mean, const Matrix2d& cov);
 
+/**
+ * @brief @ref calculateGaussianLog template specialization
+ */
+double calculateGaussianLog(const Eigen::VectorXd& x, const Eigen::VectorXd& mean, const Eigen::MatrixXd& cov);
+
+/**
+ * @brief @ref calculateGaussianLog template specialization
+ */
+double calculateGaussianLog(const Vector2d& x, const Vector2d& mean, const Matrix2d& cov);
+
+/**
+ * @brief @ref calculateMahalanobisSquared template specialization
+ */
+double calculateMahalanobisSquared(const Eigen::VectorXd& x, const Eigen::VectorXd& mean, const Eigen::MatrixXd& cov);
+
+/**
+ * @brief @ref calculateMahalanobisSquared template specialization
+ */
+double calculateMahalanobisSquared(const Vector2d& x, const Vector2d& mean, const Matrix2d& cov);
+
 /**
  * @brief @ref calculateGaussianAsymmetrical template specialization
  */
@@ -70,6 +144,38 @@ double calculateGaussianAsymmetrical(
 	bool unify_cov_scale = false
 );
 
+/**
+ * @brief @ref calculateGaussianAsymmetrical for Eigen types with temporaries allocated from the given memory resource
+ */
+double calculateGaussianAsymmetrical(
+	const Eigen::VectorXd& x,
+	const Eigen::VectorXd& mean,
+	double mean_orientation,
+	const Eigen::MatrixXd& cov_front,
+	const Eigen::MatrixXd& cov_rear,
+	bool unify_cov_scale,
+	std::pmr::memory_resource* memory
+);
+
+/**
+ * @brief Computes a squared Mahalanobis distance (x - mean)^T * cov^(-1) * (x - mean)
+ *
+ * This is the quadratic form in the exponent of a multivariate Gaussian; it involves no transcendental functions
+ *
+ * @tparam Tvec Eigen::VectorXd or social_nav_utils::Vector2d
+ * @tparam Tmat Eigen::MatrixXd or social_nav_utils::Matrix2d
+ */
+template <typename Tvec, typename Tmat>
+double calculateMahalanobisSquared(const Tvec& x, const Tvec& mean, const Tmat& cov) {
+	return (x - mean).transpose() * cov.inverse() * (x - mean);
+}
+
+/// @ref calculateMahalanobisSquared for 2D types, evaluated with the quadratic form kernel (see @ref Matrix2Inverse)
+template <typename T>
+T calculateMahalanobisSquared(const Vector2<T>& x, const Vector2<T>& mean, const Matrix2<T>& cov) {
+	return cov.inverseLazy().quadraticForm(x - mean);
+}
+
 /**
  * @brief Computes a value of Gaussian described with mean vector and covariance matrix
  *
@@ -87,21 +193,71 @@ double calculateGaussianAsymmetrical(
 template <typename Tvec, typename Tmat>
 double calculateGaussian(const Tvec& x, const Tvec& mean, const Tmat& cov, double n) {
 	double sqrt2pi = std::sqrt(2 * M_PI);
-	double quadform  = (x - mean).transpose() * cov.inverse() * (x - mean);
+	double quadform = calculateMahalanobisSquared(x, mean, cov);
 	double norm = std::pow(sqrt2pi, -n) * std::pow(cov.determinant(), -0.5);
 	return norm * exp(-0.5 * quadform);
 }
 
+/**
+ * @brief Computes a value of Gaussian described with mean vector and covariance matrix, zeroed beyond the cutoff
+ *
+ * Far from the mean, the k-sigma criterion of the cutoff is decided by the squared Euclidean distance
+ * (the largest eigenvalue of @ref cov does not exceed its trace), so neither inverse, determinant nor `exp`
+ * are computed then.
+ *
+ * @tparam Tvec Eigen::VectorXd or social_nav_utils::Vector2d
+ * @tparam Tmat Eigen::MatrixXd or social_nav_utils::Matrix2d
+ * @param n dimensionality of the problem
+ * @param cutoff support of the Gaussian, see @ref GaussianCutoff for the maximum error
+ */
+template <typename Tvec, typename Tmat>
+double calculateGaussian(const Tvec& x, const Tvec& mean, const Tmat& cov, double n, const GaussianCutoff& cutoff) {
+	if (cutoff.isBeyondDistance((x - mean).squaredNorm(), cov.trace())) {
+		SOCIAL_NAV_UTILS_COUNT(GAUSSIAN_CUTOFF);
+		return 0.0;
+	}
+	double quadform = calculateMahalanobisSquared(x, mean, cov);
+	if (quadform > cutoff.getMahalanobisSquaredMax()) {
+		SOCIAL_NAV_UTILS_COUNT(GAUSSIAN_CUTOFF);
+		return 0.0;
+	}
+	double sqrt2pi = std::sqrt(2 * M_PI);
+	double norm = std::pow(sqrt2pi, -n) * std::pow(cov.determinant(), -0.5);
+	double gaussian = norm * exp(-0.5 * quadform);
+	if (gaussian < cutoff.getValueFloor()) {
+		SOCIAL_NAV_UTILS_COUNT(GAUSSIAN_CUTOFF);
+		return 0.0;
+	}
+	return gaussian;
+}
+
+/**
+ * @brief Computes a natural logarithm of a Gaussian described with mean vector and covariance matrix
+ *
+ * @tparam Tvec Eigen::VectorXd or social_nav_utils::Vector2d
+ * @tparam Tmat Eigen::MatrixXd or social_nav_utils::Matrix2d
+ * @param n dimensionality of the problem
+ * @return double logarithm of the value computed by @ref calculateGaussian
+ */
+template <typename Tvec, typename Tmat>
+double calculateGaussianLog(const Tvec& x, const Tvec& mean, const Tmat& cov, double n) {
+	double quadform = calculateMahalanobisSquared(x, mean, cov);
+	return -0.5 * (n * std::log(2 * M_PI) + std::log(cov.determinant()) + quadform);
+}
+
 /**
  * @brief Computes a value of asymmetrical Gaussian described with a mean (at least 2 elem.) and 2 covariance matrices
  *
- * Evaluates whether x is located in front of the mean and selects appropriate covariance matrix to compute PDF
+ * Evaluates whether x is located in front of the mean (a dot product with the heading unit vector) and selects
+ * appropriate covariance matrix to compute PDF. No trigonometric functions are evaluated, so the heading vector
+ * of a mean shared by many evaluations is computed once by the caller.
  *
  * @tparam Tvec Eigen::VectorXd or social_nav_utils::Vector2d
  * @tparam Tmat Eigen::MatrixXd or social_nav_utils::Matrix2d
  * @param x vector for whom the PDF is computed for
  * @param mean mean of the Gaussian
- * @param mean_orientation 'orientation' of the mean of the Gaussian (assuming that x does not contain this info)
+ * @param heading_x x component of the heading unit vector of the mean, i.e., cosine of its 'orientation'
+ * @param heading_y y component of the heading unit vector of the mean, i.e., sine of its 'orientation'
  * @param cov_front covariance matrix for the front case
  * @param cov_rear covariance matrix for the rear case
  * @param unify_cov_scale adjusts scale of the output to avoid a step when front/rear covariances strongly differ
@@ -111,15 +267,16 @@ template <typename Tvec, typename Tmat>
 double calculateGaussianAsymmetrical(
 	const Tvec& x,
 	const Tvec& mean,
-	double mean_orientation,
+	double heading_x,
+	double heading_y,
 	const Tmat& cov_front,
 	const Tmat& cov_rear,
 	bool unify_cov_scale = false
 ) {
 	// select covariance according to geometrical arrangement of x and mean
-	RelativeLocation rel_loc(mean(0), mean(1), mean_orientation, x(0), x(1));
+	bool is_front = ((x(0) - mean(0)) * heading_x + (x(1) - mean(1)) * heading_y) >= 0.0;
 	Tmat cov;
-	if (rel_loc.isFront()) {
+	if (is_front) {
 		cov = cov_front;
 	} else {
 		cov = cov_rear;
@@ -131,11 +288,51 @@ double calculateGaussianAsymmetrical(
 		double maxfront = calculateGaussian(mean, mean, cov_front);
 		double maxrear = calculateGaussian(mean, mean, cov_rear);
 		// scale will affect only distribution with bigger variance
-		double maxcurr = rel_loc.isFront() ? maxfront : maxrear;
+		double maxcurr = is_front ? maxfront : maxrear;
 		scale = std::max(maxrear, maxfront) / maxcurr;
 	}
 
 	return scale * calculateGaussian(x, mean, cov);
 }
 
+/**
+ * @brief Computes a value of asymmetrical Gaussian described with a mean (at least 2 elem.) and 2 covariance matrices
+ *
+ * Evaluates cosine and sine of @p mean_orientation on each call; see the overload taking the heading vector
+ * for evaluations sharing the mean.
+ *
+ * @tparam Tvec Eigen::VectorXd or social_nav_utils::Vector2d
+ * @tparam Tmat Eigen::MatrixXd or social_nav_utils::Matrix2d
+ * @param x vector for whom the PDF is computed for
+ * @param mean mean of the Gaussian
+ * @param mean_orientation 'orientation' of the mean of the Gaussian (assuming that x does not contain this info)
+ * @param cov_front covariance matrix for the front case
+ * @param cov_rear covariance matrix for the rear case
+ * @param unify_cov_scale adjusts scale of the output to avoid a step when front/rear covariances strongly differ
+ * @return double
+ */
+template <typename Tvec, typename Tmat>
+double calculateGaussianAsymmetrical(
+	const Tvec& x,
+	const Tvec& mean,
+	double mean_orientation,
+	const Tmat& cov_front,
+	const Tmat& cov_rear,
+	bool unify_cov_scale = false
+) {
+	return calculateGaussianAsymmetrical(
+		x,
+		mean,
+		std::cos(mean_orientation),
+		std::sin(mean_orientation),
+		cov_front,
+		cov_rear,
+		unify_cov_scale
+	);
+}
+
 } // namespace social_nav_utils
+
+#ifdef SOCIAL_NAV_UTILS_HEADER_ONLY
+#include <social_nav_utils/impl/gaussians.h>
+#endif
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace social_nav_utils {
+
+/**
+ * @brief Converts a single precision value into IEEE 754 half precision (binary16) bits
+ *
+ * Rounds to the nearest even value. Values beyond the half range become infinities, NaN stays NaN.
+ * Used for compact storage only; arithmetic is performed in single or double precision.
+ */
+inline uint16_t encodeHalf(float value) {
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	uint32_t sign = (bits >> 16) & 0x8000u;
+	uint32_t abs = bits & 0x7fffffffu;
+
+	// infinity and NaN (quiet NaN is kept quiet)
+	if (abs >= 0x7f800000u) {
+		return static_cast<uint16_t>(sign | 0x7c00u | (abs > 0x7f800000u ? 0x0200u : 0u));
+	}
+	// rounds to a value larger than 65504, the largest finite half
+	if (abs >= 0x477ff000u) {
+		return static_cast<uint16_t>(sign | 0x7c00u);
+	}
+	// normal half: exponent rebiased from 127 to 15, mantissa rounded from 23 to 10 bits
+	if (abs >= 0x38800000u) {
+		uint32_t half = (abs - 0x38000000u) >> 13;
+		uint32_t remainder = abs & 0x1fffu;
+		if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) {
+			// carry into the exponent yields the next binade, as expected
+			half++;
+		}
+		return static_cast<uint16_t>(sign | half);
+	}
+	// below half of the smallest subnormal half
+	if (abs < 0x33000000u) {
+		return static_cast<uint16_t>(sign);
+	}
+	// subnormal half: value = mantissa * 2^-24
+	uint32_t exponent = abs >> 23;
+	uint32_t mantissa = (abs & 0x7fffffu) | 0x800000u;
+	uint32_t shift = 126u - exponent;
+	uint32_t half = mantissa >> shift;
+	uint32_t remainder = mantissa & ((1u << shift) - 1u);
+	uint32_t halfway = 1u << (shift - 1u);
+	if (remainder > halfway || (remainder == halfway && (half & 1u))) {
+		half++;
+	}
+	return static_cast<uint16_t>(sign | half);
+}
+
+/// Converts IEEE 754 half precision (binary16) bits into a single precision value (exactly)
+inline float decodeHalf(uint16_t half) {
+	uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+	uint32_t exponent = (half >> 10) & 0x1fu;
+	uint32_t mantissa = half & 0x3ffu;
+	uint32_t bits;
+	if (exponent == 0x1fu) {
+		bits = sign | 0x7f800000u | (mantissa << 13);
+	} else if (exponent != 0u) {
+		bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+	} else if (mantissa == 0u) {
+		bits = sign;
+	} else {
+		float value = std::ldexp(static_cast<float>(mantissa), -24);
+		return sign ? -value : value;
+	}
+	float value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+} // namespace social_nav_utils
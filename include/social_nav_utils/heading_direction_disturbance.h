@@ -1,5 +1,6 @@
 #pragma once
 
+#include <social_nav_utils/gaussian_cutoff.h>
 #include <social_nav_utils/math/core.h>
 
 namespace social_nav_utils {
@@ -15,6 +16,9 @@ namespace social_nav_utils {
  * Disturbance is modelled by a Gaussian function. Its values are computed by arguments given in domain of angles.
  * For further details check `dirCross` concept (location of the intersection point of i and j direction rays
  * in relation to the i centre) in `hubero_local_planner`. Here, `i` is the person and `j` is the robot.
+ *
+ * Only the current intersection of direction rays is considered; for the time-to-closest-approach and the miss
+ * distance of agents moving with constant velocities, see @ref ClosestApproach.
  */
 class HeadingDirectionDisturbance {
 public:
@@ -112,6 +116,86 @@ public:
 		double occupancy_model_radius = OCCUPANCY_MODEL_RADIUS_DEFAULT
 	);
 
+	/**
+	 * @brief @ref computeDirectionDisturbance with a support cutoff, returns exact zero beyond it
+	 *
+	 * The k-sigma criterion is checked against the distance between the intersection point and the 'ego' center
+	 * before the Gaussian is evaluated. See @ref GaussianCutoff for the maximum error.
+	 */
+	static double computeDirectionDisturbance(
+		double x_ego,
+		double y_ego,
+		double yaw_ego,
+		double cov_xx_ego,
+		double cov_xy_ego,
+		double cov_yy_ego,
+		double x_other,
+		double y_other,
+		double yaw_other,
+		double occupancy_model_radius,
+		const GaussianCutoff& cutoff
+	);
+
+	/**
+	 * @brief Computes a natural logarithm of @ref computeDirectionDisturbance (log-density)
+	 *
+	 * Returns -infinity when direction axes do not intersect (the direction factor is zero then)
+	 */
+	static double computeDirectionDisturbanceLog(
+		double x_ego,
+		double y_ego,
+		double yaw_ego,
+		double cov_xx_ego,
+		double cov_xy_ego,
+		double cov_yy_ego,
+		double x_other,
+		double y_other,
+		double yaw_other,
+		double occupancy_model_radius = OCCUPANCY_MODEL_RADIUS_DEFAULT
+	);
+
+	/**
+	 * @brief Computes a squared Mahalanobis distance of the direction intersection point from the 'ego' center
+	 *
+	 * Returns +infinity when direction axes do not intersect
+	 */
+	static double computeDirectionMahalanobisSquared(
+		double x_ego,
+		double y_ego,
+		double yaw_ego,
+		double cov_xx_ego,
+		double cov_xy_ego,
+		double cov_yy_ego,
+		double x_other,
+		double y_other,
+		double yaw_other,
+		double occupancy_model_radius = OCCUPANCY_MODEL_RADIUS_DEFAULT
+	);
+
+	/**
+	 * @brief Finds the point where the heading ray of 'other' crosses the line that passes through the 'ego' center
+	 * perpendicularly to the direction connecting both agents
+	 *
+	 * @return false if there is no intersection (e.g., direction axes are parallel); then, coordinates are NaNs
+	 */
+	static bool computeDirectionIntersection(
+		double x_ego,
+		double y_ego,
+		double x_other,
+		double y_other,
+		double yaw_other,
+		double& x_intsec,
+		double& y_intsec
+	);
+
+	/// Computes covariance matrix of the direction factor, i.e., of the occupancy model and position uncertainty
+	static Matrix2d computeDirectionCovariance(
+		double cov_xx_ego,
+		double cov_xy_ego,
+		double cov_yy_ego,
+		double occupancy_model_radius = OCCUPANCY_MODEL_RADIUS_DEFAULT
+	);
+
 	/// Computes scale of the FOV factor of the disturbance
 	static double computeFovScale(double relative_location_angle, double fov_ego = FOV_DEFAULT);
 
@@ -143,3 +227,7 @@ protected:
 };
 
 } // namespace social_nav_utils
+
+#ifdef SOCIAL_NAV_UTILS_HEADER_ONLY
+#include <social_nav_utils/impl/heading_direction_disturbance.h>
+#endif
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <social_nav_utils/entity_arrays.h>
+#include <social_nav_utils/tiled_kernel.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace social_nav_utils {
+
+/**
+ * @brief Evaluates personal space intrusion along a robot trajectory against humans predicted over a time horizon
+ *
+ * Humans are predicted with a constant velocity model: at step `k` (time `t = k * dt`), the mean position is
+ * `p + v * t` and the position covariance grows linearly, `C(t) = C + G * t`, where `G` is given by
+ * @ref Parameters. Orientations of humans do not change.
+ *
+ * The prediction is computed once per cycle (@ref predict) and shared by all candidate trajectories
+ * (@ref evaluate). Terms that depend only on the human (rotated personal space covariances, heading) are computed
+ * once per human, terms that depend only on the step (covariance growth) once per step. Then, for each human
+ * and step, the summed covariances are inverted in closed form, so evaluation of a trajectory costs a single
+ * quadratic form and `exp` per human and step. Costs are equivalent to @ref PersonalSpaceModel built for
+ * the predicted state (see @ref PersonalSpaceIntrusion::computePersonalSpaceGaussian).
+ */
+class HorizonEvaluator {
+public:
+	struct Parameters {
+		Parameters();
+
+		/// Time between consecutive steps of the horizon [s]
+		double dt;
+		/// Growth rate of the position covariance [m^2/s]
+		double cov_growth_xx;
+		double cov_growth_xy;
+		double cov_growth_yy;
+		/// See @ref PersonalSpaceIntrusion::computePersonalSpaceGaussian
+		bool unify_asymmetry_scale;
+		/// See @ref PersonalSpaceIntrusion::normalize; the maximum of the predicted model is used at each step
+		bool normalize;
+	};
+
+	explicit HorizonEvaluator(const Parameters& params = Parameters());
+
+	/**
+	 * @brief Predicts the humans over the horizon
+	 *
+	 * Storage is reused between calls, so the prediction does not allocate once the number of humans and steps
+	 * has been reached.
+	 *
+	 * @param humans current states of humans (positions, orientations, velocities, position covariances
+	 * and personal space variances are used)
+	 * @param steps_num number of steps of the horizon; step 0 corresponds to the current time
+	 */
+	void predict(const HumanArray& humans, size_t steps_num);
+
+	/**
+	 * @brief Scores a trajectory of the robot
+	 *
+	 * @param poses_x x coordinates of the robot at consecutive steps, @ref getStepsNum elements
+	 * @param poses_y y coordinates of the robot at consecutive steps, @ref getStepsNum elements
+	 * @param costs output, @ref getStepsNum elements: costs of the humans at each step reduced with @ref reduction
+	 * @param reduction operation applied to costs of all humans at a step
+	 * @return sum of @ref costs
+	 */
+	double evaluate(
+		const double* poses_x,
+		const double* poses_y,
+		double* costs,
+		CostReduction reduction = CostReduction::SUM
+	) const;
+
+	/// Predicted x coordinate of the human at the step
+	inline double getPredictedX(size_t step, size_t human) const {
+		return predictions_[step * humans_num_ + human].x;
+	}
+
+	/// Predicted y coordinate of the human at the step
+	inline double getPredictedY(size_t step, size_t human) const {
+		return predictions_[step * humans_num_ + human].y;
+	}
+
+	inline size_t getStepsNum() const {
+		return steps_num_;
+	}
+
+	inline size_t getHumansNum() const {
+		return humans_num_;
+	}
+
+	inline const Parameters& getParameters() const {
+		return params_;
+	}
+
+protected:
+	/// Predicted personal space model of a human at a step
+	struct Prediction {
+		double x;
+		double y;
+		/// Heading unit vector for the front/rear selection
+		double heading_x;
+		double heading_y;
+		/// Inverse of the summed covariance (front); the off-diagonal element is doubled
+		double front_xx;
+		double front_xy2;
+		double front_yy;
+		/// Multiplier of the front Gaussian: normalization, asymmetry scale and (optionally) inverse of the maximum
+		double front_scale;
+		double rear_xx;
+		double rear_xy2;
+		double rear_yy;
+		double rear_scale;
+	};
+
+	/// Terms of a human shared by all steps
+	struct HumanTerms {
+		double heading_x;
+		double heading_y;
+		/// Rotated personal space covariances summed with the initial position covariance (symmetric)
+		double front_xx;
+		double front_xy;
+		double front_yy;
+		double rear_xx;
+		double rear_xy;
+		double rear_yy;
+	};
+
+	Parameters params_;
+	size_t steps_num_;
+	size_t humans_num_;
+	/// Step-major: predictions of all humans at step 0, then at step 1, ...
+	std::vector<Prediction> predictions_;
+	std::vector<HumanTerms> terms_;
+};
+
+} // namespace social_nav_utils
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <social_nav_utils/config.h>
+#include <social_nav_utils/entity_arrays.h>
+#include <social_nav_utils/social_scene.h>
+
+namespace social_nav_utils {
+
+SOCIAL_NAV_UTILS_INLINE size_t SocialScene::addHumans(const HumanArray& humans) {
+	size_t first = humans_.size();
+	humans_.reserve(first + humans.size());
+	for (size_t i = 0; i < humans.size(); i++) {
+		addHuman(humans.get(i));
+	}
+	return first;
+}
+
+SOCIAL_NAV_UTILS_INLINE size_t SocialScene::addGroups(const GroupArray& groups) {
+	size_t first = groups_.size();
+	groups_.reserve(first + groups.size());
+	for (size_t i = 0; i < groups.size(); i++) {
+		addGroup(groups.get(i));
+	}
+	return first;
+}
+
+} // namespace social_nav_utils
@@ -0,0 +1,263 @@
+#pragma once
+
+#include <social_nav_utils/config.h>
+#include <social_nav_utils/formation_space_intrusion.h>
+
+#include <social_nav_utils/formation_space_model.h>
+#include <social_nav_utils/counters.h>
+#include <social_nav_utils/profiling.h>
+#include <social_nav_utils/recording.h>
+
+#include <cmath>
+
+namespace social_nav_utils {
+
+SOCIAL_NAV_UTILS_INLINE FormationSpaceIntrusion::FormationSpaceIntrusion(
+	double ospace_pos_x,
+	double ospace_pos_y,
+	double ospace_orientation,
+	double ospace_variance_x,
+	double ospace_variance_y,
+	double pos_center_variance_xx,
+	double pos_center_variance_xyyx,
+	double pos_center_variance_yy,
+	double robot_pos_x,
+	double robot_pos_y
+):
+	intrusion_scale_(NAN),
+	ospace_pos_x_(ospace_pos_x),
+	ospace_pos_y_(ospace_pos_y),
+	ospace_orientation_(ospace_orientation),
+	ospace_variance_x_(ospace_variance_x),
+	ospace_variance_y_(ospace_variance_y),
+	pos_center_variance_xx_(pos_center_variance_xx),
+	pos_center_variance_xyyx_(pos_center_variance_xyyx),
+	pos_center_variance_yy_(pos_center_variance_yy),
+	robot_pos_x_(robot_pos_x),
+	robot_pos_y_(robot_pos_y)
+{
+	SOCIAL_NAV_UTILS_PROFILE_SCOPE(FORMATION_SPACE_INTRUSION);
+	intrusion_scale_ = computeFormationSpaceGaussian(
+		ospace_pos_x_,
+		ospace_pos_y_,
+		ospace_orientation_,
+		ospace_variance_x_,
+		ospace_variance_y_,
+		pos_center_variance_xx_,
+		pos_center_variance_xyyx_,
+		pos_center_variance_yy_,
+		robot_pos_x_,
+		robot_pos_y_
+	);
+}
+
+SOCIAL_NAV_UTILS_INLINE void FormationSpaceIntrusion::normalize() {
+	SOCIAL_NAV_UTILS_PROFILE_SCOPE(FORMATION_SPACE_INTRUSION_NORMALIZE);
+	// find max of Gaussian knowing the current arrangement and certainty - compute gaussian at mean position
+	double intrusion_max = computeFormationSpaceGaussian(
+		ospace_pos_x_,
+		ospace_pos_y_,
+		ospace_orientation_,
+		ospace_variance_x_,
+		ospace_variance_y_,
+		pos_center_variance_xx_,
+		pos_center_variance_xyyx_,
+		pos_center_variance_yy_,
+		ospace_pos_x_,
+		ospace_pos_y_
+	);
+	intrusion_scale_ /= intrusion_max;
+}
+
+SOCIAL_NAV_UTILS_INLINE double FormationSpaceIntrusion::computeFormationSpaceGaussian(
+	double ospace_pos_x,
+	double ospace_pos_y,
+	double ospace_orientation,
+	double ospace_variance_x,
+	double ospace_variance_y,
+	double pos_center_variance_xx,
+	double pos_center_variance_xyyx,
+	double pos_center_variance_yy,
+	double robot_pos_x,
+	double robot_pos_y
+) {
+	SOCIAL_NAV_UTILS_PROFILE_SCOPE(FORMATION_SPACE_GAUSSIAN);
+	SOCIAL_NAV_UTILS_COUNT(FORMATION_SPACE_CALLS);
+	double gaussian = NAN;
+	if (pos_center_variance_xyyx == 0.0) {
+		gaussian = computeFormationSpaceGaussianDiagonal(
+			ospace_pos_x,
+			ospace_pos_y,
+			ospace_orientation,
+			ospace_variance_x,
+			ospace_variance_y,
+			pos_center_variance_xx,
+			pos_center_variance_yy,
+			robot_pos_x,
+			robot_pos_y
+		);
+	} else {
+		FormationSpaceModel model(
+			ospace_pos_x,
+			ospace_pos_y,
+			ospace_orientation,
+			ospace_variance_x,
+			ospace_variance_y,
+			pos_center_variance_xx,
+			pos_center_variance_xyyx,
+			pos_center_variance_yy
+		);
+		gaussian = model.evaluate(robot_pos_x, robot_pos_y);
+	}
+	SOCIAL_NAV_UTILS_RECORD(
+		FORMATION_SPACE_GAUSSIAN,
+		gaussian,
+		ospace_pos_x,
+		ospace_pos_y,
+		ospace_orientation,
+		ospace_variance_x,
+		ospace_variance_y,
+		pos_center_variance_xx,
+		pos_center_variance_xyyx,
+		pos_center_variance_yy,
+		robot_pos_x,
+		robot_pos_y
+	);
+	return gaussian;
+}
+
+SOCIAL_NAV_UTILS_INLINE double FormationSpaceIntrusion::computeFormationSpaceGaussian(
+	double ospace_pos_x,
+	double ospace_pos_y,
+	double ospace_orientation,
+	double ospace_variance_x,
+	double ospace_variance_y,
+	double pos_center_variance_xx,
+	double pos_center_variance_xyyx,
+	double pos_center_variance_yy,
+	double robot_pos_x,
+	double robot_pos_y,
+	const GaussianCutoff& cutoff
+) {
+	SOCIAL_NAV_UTILS_PROFILE_SCOPE(FORMATION_SPACE_GAUSSIAN);
+	SOCIAL_NAV_UTILS_COUNT(FORMATION_SPACE_CALLS);
+	// rotation does not change the trace of the summed covariance
+	double variance_bound = ospace_variance_x + ospace_variance_y + pos_center_variance_xx + pos_center_variance_yy;
+	double dx = robot_pos_x - ospace_pos_x;
+	double dy = robot_pos_y - ospace_pos_y;
+	if (cutoff.isBeyondDistance(dx * dx + dy * dy, variance_bound)) {
+		SOCIAL_NAV_UTILS_COUNT(GAUSSIAN_CUTOFF);
+		return 0.0;
+	}
+	FormationSpaceModel model(
+		ospace_pos_x,
+		ospace_pos_y,
+		ospace_orientation,
+		ospace_variance_x,
+		ospace_variance_y,
+		pos_center_variance_xx,
+		pos_center_variance_xyyx,
+		pos_center_variance_yy
+	);
+	return model.evaluate(robot_pos_x, robot_pos_y, cutoff);
+}
+
+SOCIAL_NAV_UTILS_INLINE double FormationSpaceIntrusion::computeFormationSpaceGaussianDiagonal(
+	double ospace_pos_x,
+	double ospace_pos_y,
+	double ospace_orientation,
+	double ospace_variance_x,
+	double ospace_variance_y,
+	double pos_center_variance_xx,
+	double pos_center_variance_yy,
+	double robot_pos_x,
+	double robot_pos_y
+) {
+	const double cos_orient = std::cos(ospace_orientation);
+	const double sin_orient = std::sin(ospace_orientation);
+	const double dx = robot_pos_x - ospace_pos_x;
+	const double dy = robot_pos_y - ospace_pos_y;
+
+	double quadform = NAN;
+	double det = NAN;
+	if (pos_center_variance_xx == pos_center_variance_yy) {
+		SOCIAL_NAV_UTILS_COUNT(FORMATION_SPACE_ISOTROPIC);
+		// isotropic covariance is invariant to rotation, so the sum is diagonal in the O-space frame
+		const double along = dx * cos_orient + dy * sin_orient;
+		const double across = dy * cos_orient - dx * sin_orient;
+		const double var_along = ospace_variance_x + pos_center_variance_xx;
+		const double var_across = ospace_variance_y + pos_center_variance_xx;
+		quadform = along * along / var_along + across * across / var_across;
+		det = var_along * var_across;
+	} else {
+		SOCIAL_NAV_UTILS_COUNT(FORMATION_SPACE_DIAGONAL);
+		// R * diag(var_x, var_y) * R^T + diag(cov_xx, cov_yy), expanded
+		const double cos_sq = cos_orient * cos_orient;
+		const double sin_sq = sin_orient * sin_orient;
+		const double sin_cos = cos_orient * sin_orient;
+		const double cov_xx = pos_center_variance_xx + ospace_variance_x * cos_sq + ospace_variance_y * sin_sq;
+		const double cov_xy = (ospace_variance_x - ospace_variance_y) * sin_cos;
+		const double cov_yy = pos_center_variance_yy + ospace_variance_x * sin_sq + ospace_variance_y * cos_sq;
+		det = cov_xx * cov_yy - cov_xy * cov_xy;
+		SOCIAL_NAV_UTILS_COUNT_IF(
+			Counters::isNearSingular(det, cov_xx, cov_xy, cov_xy, cov_yy),
+			MATRIX_INVERSE_NEAR_SINGULAR
+		);
+		quadform = (cov_yy * dx * dx - 2.0 * cov_xy * dx * dy + cov_xx * dy * dy) / det;
+	}
+	return std::exp(-0.5 * quadform) / (2.0 * M_PI * std::sqrt(det));
+}
+
+SOCIAL_NAV_UTILS_INLINE double FormationSpaceIntrusion::computeFormationSpaceGaussianLog(
+	double ospace_pos_x,
+	double ospace_pos_y,
+	double ospace_orientation,
+	double ospace_variance_x,
+	double ospace_variance_y,
+	double pos_center_variance_xx,
+	double pos_center_variance_xyyx,
+	double pos_center_variance_yy,
+	double robot_pos_x,
+	double robot_pos_y
+) {
+	SOCIAL_NAV_UTILS_COUNT(FORMATION_SPACE_CALLS);
+	FormationSpaceModel model(
+		ospace_pos_x,
+		ospace_pos_y,
+		ospace_orientation,
+		ospace_variance_x,
+		ospace_variance_y,
+		pos_center_variance_xx,
+		pos_center_variance_xyyx,
+		pos_center_variance_yy
+	);
+	return model.evaluateLog(robot_pos_x, robot_pos_y);
+}
+
+SOCIAL_NAV_UTILS_INLINE double FormationSpaceIntrusion::computeFormationSpaceMahalanobisSquared(
+	double ospace_pos_x,
+	double ospace_pos_y,
+	double ospace_orientation,
+	double ospace_variance_x,
+	double ospace_variance_y,
+	double pos_center_variance_xx,
+	double pos_center_variance_xyyx,
+	double pos_center_variance_yy,
+	double robot_pos_x,
+	double robot_pos_y
+) {
+	SOCIAL_NAV_UTILS_COUNT(FORMATION_SPACE_CALLS);
+	FormationSpaceModel model(
+		ospace_pos_x,
+		ospace_pos_y,
+		ospace_orientation,
+		ospace_variance_x,
+		ospace_variance_y,
+		pos_center_variance_xx,
+		pos_center_variance_xyyx,
+		pos_center_variance_yy
+	);
+	return model.computeMahalanobisSquared(robot_pos_x, robot_pos_y);
+}
+
+} // namespace social_nav_utils
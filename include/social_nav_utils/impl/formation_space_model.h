@@ -0,0 +1,42 @@
+#pragma once
+
+#include <social_nav_utils/config.h>
+#include <social_nav_utils/formation_space_model.h>
+
+#include <social_nav_utils/math/core.h>
+
+namespace social_nav_utils {
+
+SOCIAL_NAV_UTILS_INLINE FormationSpaceModel::FormationSpaceModel(
+	double ospace_pos_x,
+	double ospace_pos_y,
+	double ospace_orientation,
+	double ospace_variance_x,
+	double ospace_variance_y,
+	double pos_center_variance_xx,
+	double pos_center_variance_xyyx,
+	double pos_center_variance_yy
+) {
+	// create matrix for covariance rotation
+	Rotation2Dd rot(ospace_orientation);
+
+	// create covariance matrix of the personal zone model
+	Matrix2d cov_fsi_init(
+		ospace_variance_x, 0.0,
+		0.0, ospace_variance_y
+	);
+
+	// rotate covariance matrix
+	Matrix2d cov_fsi = rot.congruence(cov_fsi_init);
+
+	// create covariance matrix of the position estimation uncertainty
+	Matrix2d cov_pos(
+		pos_center_variance_xx, pos_center_variance_xyyx,
+		pos_center_variance_xyyx, pos_center_variance_yy
+	);
+
+	// resultant covariance matrices (variances summed up)
+	gaussian_ = GaussianModel(ospace_pos_x, ospace_pos_y, cov_pos + cov_fsi);
+}
+
+} // namespace social_nav_utils
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <social_nav_utils/config.h>
+#include <social_nav_utils/gaussians.h>
+
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include <math.h>
+
+namespace social_nav_utils {
+
+SOCIAL_NAV_UTILS_INLINE double calculateGaussian(double x, double mean, double variance, bool normalize) {
+	double scale = 1.0;
+	// with normalization, maximum possible value will be 1.0; otherwise, it depends on the value of variance
+	if (!normalize) {
+		scale = 1.0 / (std::sqrt(variance) * std::sqrt(2 * M_PI));
+	}
+	return scale * std::exp(-std::pow(x - mean, 2) / (2.0 * variance));
+}
+
+SOCIAL_NAV_UTILS_INLINE double calculateGaussian(
+	double x,
+	double mean,
+	double variance,
+	bool normalize,
+	const GaussianCutoff& cutoff
+) {
+	// in 1D, the squared distance bound is exact
+	if (cutoff.isBeyondDistance((x - mean) * (x - mean), variance)) {
+		SOCIAL_NAV_UTILS_COUNT(GAUSSIAN_CUTOFF);
+		return 0.0;
+	}
+	double gaussian = calculateGaussian(x, mean, variance, normalize);
+	if (gaussian < cutoff.getValueFloor()) {
+		SOCIAL_NAV_UTILS_COUNT(GAUSSIAN_CUTOFF);
+		return 0.0;
+	}
+	return gaussian;
+}
+
+SOCIAL_NAV_UTILS_INLINE double calculateGaussianLog(double x, double mean, double variance, bool normalize) {
+	double log_scale = 0.0;
+	if (!normalize) {
+		log_scale = -0.5 * std::log(2 * M_PI * variance);
+	}
+	return log_scale - 0.5 * calculateMahalanobisSquared(x, mean, variance);
+}
+
+SOCIAL_NAV_UTILS_INLINE double calculateMahalanobisSquared(double x, double mean, double variance) {
+	return (x - mean) * (x - mean) / variance;
+}
+
+SOCIAL_NAV_UTILS_INLINE double calculateGaussianAngle(double x, double mean, double variance, bool normalize) {
+	double gaussian1 = calculateGaussian(x, mean             , variance, normalize);
+	double gaussian2 = calculateGaussian(x, mean - 2.0 * M_PI, variance, normalize);
+	double gaussian3 = calculateGaussian(x, mean + 2.0 * M_PI, variance, normalize);
+	return std::max(std::max(gaussian1, gaussian2), gaussian3);
+}
+
+SOCIAL_NAV_UTILS_INLINE double calculateGaussianAsymmetrical(
+	double x,
+	double y,
+	double x_center,
+	double y_center,
+	double yaw,
+	double variance_h,
+	double variance_r,
+	double variance_s
+) {
+	double sigma_h = std::sqrt(variance_h);
+	double sigma_r = std::sqrt(variance_r);
+	double sigma_s = std::sqrt(variance_s);
+
+	// front/rear selection with a dot product against the heading unit vector (trigonometric functions
+	// of yaw are reused below)
+	RelativeLocationClassifier rel_loc(x_center, y_center, yaw);
+	double sigma = (rel_loc.isFront(x, y) ? sigma_h : sigma_r);
+
+	// save values used multiple times in computations;
+	// squared cosine/sine of theta (yaw angle)
+	double cos_yaw = rel_loc.getHeadingX();
+	double sin_yaw = rel_loc.getHeadingY();
+	double cos_yaw_sq = cos_yaw * cos_yaw;
+	double sin_yaw_sq = sin_yaw * sin_yaw;
+	double sin_2yaw = 2.0 * sin_yaw * cos_yaw;
+	double sigma_sq = std::pow(sigma, 2);
+	double sigma_s_sq = std::pow(sigma_s, 2);
+
+	double a = cos_yaw_sq / (2.0 * sigma_sq) + sin_yaw_sq / (2.0 * sigma_s_sq);
+	double b = sin_2yaw   / (4.0 * sigma_sq) - sin_2yaw   / (4.0 * sigma_s_sq);
+	double c = sin_yaw_sq / (2.0 * sigma_sq) + cos_yaw_sq / (2.0 * sigma_s_sq);
+
+	double exp_arg_a = a * (std::pow(x - x_center, 2));
+	double exp_arg_b = 2.0 * b * (x - x_center) * (y - y_center);
+	double exp_arg_c = c * std::pow(y - y_center, 2);
+	return std::exp(-(exp_arg_a + exp_arg_b + exp_arg_c));
+}
+
+SOCIAL_NAV_UTILS_INLINE double calculateGaussian(const Eigen::VectorXd& x, const Eigen::VectorXd& mean, const Eigen::MatrixXd& cov) {
+	return calculateGaussian(x, mean, cov, x.rows());
+}
+
+SOCIAL_NAV_UTILS_INLINE double calculateGaussian(
+	const Eigen::VectorXd& x,
+	const Eigen::VectorXd& mean,
+	const Eigen::MatrixXd& cov,
+	const GaussianCutoff& cutoff
+) {
+	return calculateGaussian(x, mean, cov, x.rows(), cutoff);
+}
+
+SOCIAL_NAV_UTILS_INLINE double calculateGaussian(
+	const Vector2d& x,
+	const Vector2d& mean,
+	const Matrix2d& cov,
+	const GaussianCutoff& cutoff
+) {
+	return calculateGaussian(x, mean, cov, 2.0, cutoff);
+}
+
+SOCIAL_NAV_UTILS_INLINE double calculateGaussian(
+	const Eigen::VectorXd& x,
+	const Eigen::VectorXd& mean,
+	const Eigen::MatrixXd& cov,
+	std::pmr::memory_resource* memory
+) {
+	const Eigen::Index n = x.rows();
+	std::pmr::vector<double> storage(n * n + n, memory);
+	Eigen::Map<Eigen::MatrixXd> chol(storage.data(), n, n);
+	Eigen::Map<Eigen::VectorXd> diff(storage.data() + n * n, n);
+	chol = cov;
+	diff = x - mean;
+
+	// cov = L * L^T, so the quadratic form is the squared norm of L^-1 * (x - mean) and det(cov) = prod(diag(L))^2
+	Eigen::LLT<Eigen::Ref<Eigen::MatrixXd>> llt(chol);
+	if (llt.info() != Eigen::Success) {
+		return calculateGaussian(x, mean, cov);
+	}
+	llt.matrixL().solveInPlace(diff);
+	double quadform = diff.squaredNorm();
+	double det_sqrt = chol.diagonal().prod();
+	double norm = std::pow(2.0 * M_PI, -0.5 * n) / det_sqrt;
+	return norm * std::exp(-0.5 * quadform);
+}
+
+SOCIAL_NAV_UTILS_INLINE double calculateGaussian(const Vector2d& x, const Vector2d& mean, const Matrix2d& cov) {
+	return calculateGaussian(x, mean, cov, 2.0);
+}
+
+SOCIAL_NAV_UTILS_INLINE double calculateGaussianLog(const Eigen::VectorXd& x, const Eigen::VectorXd& mean, const Eigen::MatrixXd& cov) {
+	return calculateGaussianLog(x, mean, cov, x.rows());
+}
+
+SOCIAL_NAV_UTILS_INLINE double calculateGaussianLog(const Vector2d& x, const Vector2d& mean, const Matrix2d& cov) {
+	return calculateGaussianLog(x, mean, cov, 2.0);
+}
+
+SOCIAL_NAV_UTILS_INLINE double calculateMahalanobisSquared(
+	const Eigen::VectorXd& x,
+	const Eigen::VectorXd& mean,
+	const Eigen::MatrixXd& cov
+) {
+	return calculateMahalanobisSquared<Eigen::VectorXd, Eigen::MatrixXd>(x, mean, cov);
+}
+
+SOCIAL_NAV_UTILS_INLINE double calculateMahalanobisSquared(const Vector2d& x, const Vector2d& mean, const Matrix2d& cov) {
+	// the generic templates call this overload, so the kernel is selected here
+	return cov.inverseLazy().quadraticForm(x - mean);
+}
+
+SOCIAL_NAV_UTILS_INLINE double calculateGaussianAsymmetrical(
+	const Eigen::VectorXd& x,
+	const Eigen::VectorXd& mean,
+	double mean_orientation,
+	const Eigen::MatrixXd& cov_front,
+	const Eigen::MatrixXd& cov_rear,
+	bool unify_cov_scale
+) {
+	// can't tell if front or rear for 1D
+	assert(x.size() > 1);
+	return calculateGaussianAsymmetrical<Eigen::VectorXd, Eigen::MatrixXd>(
+		x,
+		mean,
+		mean_orientation,
+		cov_front,
+		cov_rear,
+		unify_cov_scale
+	);
+}
+
+SOCIAL_NAV_UTILS_INLINE double calculateGaussianAsymmetrical(
+	const Eigen::VectorXd& x,
+	const Eigen::VectorXd& mean,
+	double mean_orientation,
+	const Eigen::MatrixXd& cov_front,
+	const Eigen::MatrixXd& cov_rear,
+	bool unify_cov_scale,
+	std::pmr::memory_resource* memory
+) {
+	assert(x.size() > 1);
+	// covariance is selected by reference, the generic version copies it
+	RelativeLocationClassifier rel_loc(mean(0), mean(1), mean_orientation);
+	bool is_front = rel_loc.isFront(x(0), x(1));
+	const Eigen::MatrixXd& cov = is_front ? cov_front : cov_rear;
+
+	double scale = 1.0;
+	if (unify_cov_scale) {
+		double maxfront = calculateGaussian(mean, mean, cov_front, memory);
+		double maxrear = calculateGaussian(mean, mean, cov_rear, memory);
+		double maxcurr = is_front ? maxfront : maxrear;
+		scale = std::max(maxrear, maxfront) / maxcurr;
+	}
+
+	return scale * calculateGaussian(x, mean, cov, memory);
+}
+
+} // namespace social_nav_utils
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <social_nav_utils/config.h>
+#include <social_nav_utils/passing_speed_comfort.h>
+
+#include <social_nav_utils/counters.h>
+#include <social_nav_utils/profiling.h>
+#include <social_nav_utils/recording.h>
+
+#include <cmath>
+
+namespace social_nav_utils {
+
+SOCIAL_NAV_UTILS_INLINE PassingSpeedComfort::PassingSpeedComfort(double distance, double robot_speed) {
+	SOCIAL_NAV_UTILS_PROFILE_SCOPE(PASSING_SPEED_COMFORT);
+	comfort_ = computeSpeedComfort(distance, robot_speed);
+}
+
+SOCIAL_NAV_UTILS_INLINE double PassingSpeedComfort::computeSpeedComfort(double distance, double speed) {
+	SOCIAL_NAV_UTILS_PROFILE_SCOPE(PASSING_SPEED_COMFORT_COMPUTE);
+	SOCIAL_NAV_UTILS_COUNT(PASSING_SPEED_COMFORT_CALLS);
+	/*
+	 * Authors of "The effect of robot speed on comfortable passing distances" did not established a full model
+	 * representing comfort as a function of speed and distance for the passing scenario. Thus, an approximation
+	 * of their results was designed.
+	 *
+	 * Namely, 2 exponential models for closer and further passing distances were defined based on their results (Fig. 7)
+	 */
+	double comfort = NAN;
+	if (distance <= CLOSE_DIST_THRESHOLD) {
+		comfort = computeComfortClose(speed);
+	} else if (distance >= FAR_DIST_THRESHOLD) {
+		comfort = computeComfortFar(speed);
+	} else {
+		// mixture of models for distances between CLOSE_DIST_THRESHOLD and FAR_DIST_THRESHOLD
+		double close_factor = computeCloseWeight(distance);
+		comfort = close_factor * computeComfortClose(speed) + (1.0 - close_factor) * computeComfortFar(speed);
+	}
+	SOCIAL_NAV_UTILS_RECORD(PASSING_SPEED_COMFORT, comfort, distance, speed);
+	return comfort;
+}
+
+} // namespace social_nav_utils
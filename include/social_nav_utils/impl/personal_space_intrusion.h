@@ -0,0 +1,341 @@
+#pragma once
+
+#include <social_nav_utils/config.h>
+#include <social_nav_utils/personal_space_intrusion.h>
+
+#include <social_nav_utils/personal_space_model.h>
+#include <social_nav_utils/counters.h>
+#include <social_nav_utils/profiling.h>
+#include <social_nav_utils/recording.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace social_nav_utils {
+
+SOCIAL_NAV_UTILS_INLINE PersonalSpaceIntrusion::PersonalSpaceIntrusion(
+	double person_pos_x,
+	double person_pos_y,
+	double person_orient_yaw,
+	double person_pos_cov_xx,
+	double person_pos_cov_xy,
+	double person_pos_cov_yx,
+	double person_pos_cov_yy,
+	double person_ps_var_front,
+	double person_ps_var_rear,
+	double person_ps_var_side,
+	double robot_pos_x,
+	double robot_pos_y,
+	bool unify_asymmetry_scale
+):
+	intrusion_scale_(NAN),
+	person_pos_x_(person_pos_x),
+	person_pos_y_(person_pos_y),
+	person_orient_yaw_(person_orient_yaw),
+	person_pos_cov_xx_(person_pos_cov_xx),
+	person_pos_cov_xy_(person_pos_cov_xy),
+	person_pos_cov_yx_(person_pos_cov_yx),
+	person_pos_cov_yy_(person_pos_cov_yy),
+	person_ps_var_front_(person_ps_var_front),
+	person_ps_var_rear_(person_ps_var_rear),
+	person_ps_var_side_(person_ps_var_side),
+	robot_pos_x_(robot_pos_x),
+	robot_pos_y_(robot_pos_y),
+	unify_asymmetry_scale_(unify_asymmetry_scale)
+{
+	SOCIAL_NAV_UTILS_PROFILE_SCOPE(PERSONAL_SPACE_INTRUSION);
+	intrusion_scale_ = computePersonalSpaceGaussian(
+		person_pos_x_,
+		person_pos_y_,
+		person_orient_yaw_,
+		person_pos_cov_xx_,
+		person_pos_cov_xy_,
+		person_pos_cov_yx_,
+		person_pos_cov_yy_,
+		person_ps_var_front_,
+		person_ps_var_rear_,
+		person_ps_var_side_,
+		robot_pos_x_,
+		robot_pos_y_,
+		unify_asymmetry_scale_
+	);
+}
+
+SOCIAL_NAV_UTILS_INLINE void PersonalSpaceIntrusion::normalize() {
+	SOCIAL_NAV_UTILS_PROFILE_SCOPE(PERSONAL_SPACE_INTRUSION_NORMALIZE);
+	// find max of Gaussian knowing the current arrangement and certainty - compute gaussian at mean position
+	double intrusion_max = computePersonalSpaceGaussian(
+		person_pos_x_,
+		person_pos_y_,
+		person_orient_yaw_,
+		person_pos_cov_xx_,
+		person_pos_cov_xy_,
+		person_pos_cov_yx_,
+		person_pos_cov_yy_,
+		person_ps_var_front_,
+		person_ps_var_rear_,
+		person_ps_var_side_,
+		person_pos_x_,
+		person_pos_y_,
+		unify_asymmetry_scale_
+	);
+	intrusion_scale_ /= intrusion_max;
+}
+
+SOCIAL_NAV_UTILS_INLINE double PersonalSpaceIntrusion::computePersonalSpaceGaussian(
+	double person_pos_x,
+	double person_pos_y,
+	double person_orient_yaw,
+	double person_pos_cov_xx,
+	double person_pos_cov_xy,
+	double person_pos_cov_yx,
+	double person_pos_cov_yy,
+	double person_ps_var_front,
+	double person_ps_var_rear,
+	double person_ps_var_side,
+	double robot_pos_x,
+	double robot_pos_y,
+	bool unify_asymmetry_scale
+) {
+	SOCIAL_NAV_UTILS_PROFILE_SCOPE(PERSONAL_SPACE_GAUSSIAN);
+	SOCIAL_NAV_UTILS_COUNT(PERSONAL_SPACE_CALLS);
+	double gaussian = NAN;
+	if (person_pos_cov_xy == 0.0 && person_pos_cov_yx == 0.0) {
+		gaussian = computePersonalSpaceGaussianDiagonal(
+			person_pos_x,
+			person_pos_y,
+			person_orient_yaw,
+			person_pos_cov_xx,
+			person_pos_cov_yy,
+			person_ps_var_front,
+			person_ps_var_rear,
+			person_ps_var_side,
+			robot_pos_x,
+			robot_pos_y,
+			unify_asymmetry_scale
+		);
+	} else {
+		// only the Gaussian selected by the relative location is assembled: R * diag(var_heading, var_side) * R^T + cov_p
+		const double heading_x = std::cos(person_orient_yaw);
+		const double heading_y = std::sin(person_orient_yaw);
+		const double dx = robot_pos_x - person_pos_x;
+		const double dy = robot_pos_y - person_pos_y;
+		const bool is_front = (dx * heading_x + dy * heading_y) >= 0.0;
+		const double var_heading = is_front ? person_ps_var_front : person_ps_var_rear;
+		const double cos_sq = heading_x * heading_x;
+		const double sin_sq = heading_y * heading_y;
+		const double sin_cos = heading_x * heading_y;
+		const double cov_xx = person_pos_cov_xx + var_heading * cos_sq + person_ps_var_side * sin_sq;
+		const double cov_xy = person_pos_cov_xy + (var_heading - person_ps_var_side) * sin_cos;
+		const double cov_yx = person_pos_cov_yx + (var_heading - person_ps_var_side) * sin_cos;
+		const double cov_yy = person_pos_cov_yy + var_heading * sin_sq + person_ps_var_side * cos_sq;
+		double det = cov_xx * cov_yy - cov_xy * cov_yx;
+		SOCIAL_NAV_UTILS_COUNT_IF(
+			Counters::isNearSingular(det, cov_xx, cov_xy, cov_yx, cov_yy),
+			MATRIX_INVERSE_NEAR_SINGULAR
+		);
+		const double quadform = (cov_yy * dx * dx - (cov_xy + cov_yx) * dx * dy + cov_xx * dy * dy) / det;
+		// the other Gaussian only contributes its maximum (see computePersonalSpaceGaussianDiagonal)
+		if (unify_asymmetry_scale) {
+			const double var_other = is_front ? person_ps_var_rear : person_ps_var_front;
+			const double cov_xx_other = person_pos_cov_xx + var_other * cos_sq + person_ps_var_side * sin_sq;
+			const double cov_xy_other = person_pos_cov_xy + (var_other - person_ps_var_side) * sin_cos;
+			const double cov_yx_other = person_pos_cov_yx + (var_other - person_ps_var_side) * sin_cos;
+			const double cov_yy_other = person_pos_cov_yy + var_other * sin_sq + person_ps_var_side * cos_sq;
+			det = std::min(det, cov_xx_other * cov_yy_other - cov_xy_other * cov_yx_other);
+		}
+		gaussian = std::exp(-0.5 * quadform) / (2.0 * M_PI * std::sqrt(det));
+	}
+	SOCIAL_NAV_UTILS_RECORD(
+		PERSONAL_SPACE_GAUSSIAN,
+		gaussian,
+		person_pos_x,
+		person_pos_y,
+		person_orient_yaw,
+		person_pos_cov_xx,
+		person_pos_cov_xy,
+		person_pos_cov_yx,
+		person_pos_cov_yy,
+		person_ps_var_front,
+		person_ps_var_rear,
+		person_ps_var_side,
+		robot_pos_x,
+		robot_pos_y,
+		unify_asymmetry_scale ? 1.0 : 0.0
+	);
+	return gaussian;
+}
+
+SOCIAL_NAV_UTILS_INLINE double PersonalSpaceIntrusion::computePersonalSpaceGaussian(
+	double person_pos_x,
+	double person_pos_y,
+	double person_orient_yaw,
+	double person_pos_cov_xx,
+	double person_pos_cov_xy,
+	double person_pos_cov_yx,
+	double person_pos_cov_yy,
+	double person_ps_var_front,
+	double person_ps_var_rear,
+	double person_ps_var_side,
+	double robot_pos_x,
+	double robot_pos_y,
+	bool unify_asymmetry_scale,
+	const GaussianCutoff& cutoff
+) {
+	SOCIAL_NAV_UTILS_PROFILE_SCOPE(PERSONAL_SPACE_GAUSSIAN);
+	SOCIAL_NAV_UTILS_COUNT(PERSONAL_SPACE_CALLS);
+	// rotation does not change the trace of the summed covariance; the bigger of front/rear variances covers both
+	double variance_bound = person_pos_cov_xx + person_pos_cov_yy
+		+ std::max(person_ps_var_front, person_ps_var_rear) + person_ps_var_side;
+	double dx = robot_pos_x - person_pos_x;
+	double dy = robot_pos_y - person_pos_y;
+	if (cutoff.isBeyondDistance(dx * dx + dy * dy, variance_bound)) {
+		SOCIAL_NAV_UTILS_COUNT(GAUSSIAN_CUTOFF);
+		return 0.0;
+	}
+	PersonalSpaceModel model(
+		person_pos_x,
+		person_pos_y,
+		person_orient_yaw,
+		person_pos_cov_xx,
+		person_pos_cov_xy,
+		person_pos_cov_yx,
+		person_pos_cov_yy,
+		person_ps_var_front,
+		person_ps_var_rear,
+		person_ps_var_side,
+		unify_asymmetry_scale
+	);
+	return model.evaluate(robot_pos_x, robot_pos_y, cutoff);
+}
+
+SOCIAL_NAV_UTILS_INLINE double PersonalSpaceIntrusion::computePersonalSpaceGaussianDiagonal(
+	double person_pos_x,
+	double person_pos_y,
+	double person_orient_yaw,
+	double person_pos_cov_xx,
+	double person_pos_cov_yy,
+	double person_ps_var_front,
+	double person_ps_var_rear,
+	double person_ps_var_side,
+	double robot_pos_x,
+	double robot_pos_y,
+	bool unify_asymmetry_scale
+) {
+	const double heading_x = std::cos(person_orient_yaw);
+	const double heading_y = std::sin(person_orient_yaw);
+	const double dx = robot_pos_x - person_pos_x;
+	const double dy = robot_pos_y - person_pos_y;
+	// front/rear selection consistent with the RelativeLocationClassifier
+	const bool is_front = (dx * heading_x + dy * heading_y) >= 0.0;
+	const double var_heading = is_front ? person_ps_var_front : person_ps_var_rear;
+	const double var_heading_other = is_front ? person_ps_var_rear : person_ps_var_front;
+
+	double quadform = NAN;
+	double det = NAN;
+	double det_other = NAN;
+	if (person_pos_cov_xx == person_pos_cov_yy) {
+		SOCIAL_NAV_UTILS_COUNT(PERSONAL_SPACE_ISOTROPIC);
+		// isotropic covariance is invariant to rotation, so the sum is diagonal in the person's frame
+		const double along = dx * heading_x + dy * heading_y;
+		const double across = dy * heading_x - dx * heading_y;
+		const double var_along = var_heading + person_pos_cov_xx;
+		const double var_across = person_ps_var_side + person_pos_cov_xx;
+		quadform = along * along / var_along + across * across / var_across;
+		det = var_along * var_across;
+		det_other = (var_heading_other + person_pos_cov_xx) * var_across;
+	} else {
+		SOCIAL_NAV_UTILS_COUNT(PERSONAL_SPACE_DIAGONAL);
+		// R * diag(var_heading, var_side) * R^T + diag(cov_xx, cov_yy), expanded
+		const double cos_sq = heading_x * heading_x;
+		const double sin_sq = heading_y * heading_y;
+		const double sin_cos = heading_x * heading_y;
+		const double cov_xx = person_pos_cov_xx + var_heading * cos_sq + person_ps_var_side * sin_sq;
+		const double cov_xy = (var_heading - person_ps_var_side) * sin_cos;
+		const double cov_yy = person_pos_cov_yy + var_heading * sin_sq + person_ps_var_side * cos_sq;
+		det = cov_xx * cov_yy - cov_xy * cov_xy;
+		SOCIAL_NAV_UTILS_COUNT_IF(
+			Counters::isNearSingular(det, cov_xx, cov_xy, cov_xy, cov_yy),
+			MATRIX_INVERSE_NEAR_SINGULAR
+		);
+		quadform = (cov_yy * dx * dx - 2.0 * cov_xy * dx * dy + cov_xx * dy * dy) / det;
+		if (unify_asymmetry_scale) {
+			const double cov_xx_other = person_pos_cov_xx + var_heading_other * cos_sq + person_ps_var_side * sin_sq;
+			const double cov_xy_other = (var_heading_other - person_ps_var_side) * sin_cos;
+			const double cov_yy_other = person_pos_cov_yy + var_heading_other * sin_sq + person_ps_var_side * cos_sq;
+			det_other = cov_xx_other * cov_yy_other - cov_xy_other * cov_xy_other;
+		}
+	}
+	/*
+	 * With unified asymmetry scale, the selected Gaussian is scaled to the bigger of both maximums,
+	 * i.e., the one with the smaller determinant
+	 */
+	if (unify_asymmetry_scale) {
+		det = std::min(det, det_other);
+	}
+	return std::exp(-0.5 * quadform) / (2.0 * M_PI * std::sqrt(det));
+}
+
+SOCIAL_NAV_UTILS_INLINE double PersonalSpaceIntrusion::computePersonalSpaceGaussianLog(
+	double person_pos_x,
+	double person_pos_y,
+	double person_orient_yaw,
+	double person_pos_cov_xx,
+	double person_pos_cov_xy,
+	double person_pos_cov_yx,
+	double person_pos_cov_yy,
+	double person_ps_var_front,
+	double person_ps_var_rear,
+	double person_ps_var_side,
+	double robot_pos_x,
+	double robot_pos_y,
+	bool unify_asymmetry_scale
+) {
+	SOCIAL_NAV_UTILS_COUNT(PERSONAL_SPACE_CALLS);
+	PersonalSpaceModel model(
+		person_pos_x,
+		person_pos_y,
+		person_orient_yaw,
+		person_pos_cov_xx,
+		person_pos_cov_xy,
+		person_pos_cov_yx,
+		person_pos_cov_yy,
+		person_ps_var_front,
+		person_ps_var_rear,
+		person_ps_var_side,
+		unify_asymmetry_scale
+	);
+	return model.evaluateLog(robot_pos_x, robot_pos_y);
+}
+
+SOCIAL_NAV_UTILS_INLINE double PersonalSpaceIntrusion::computePersonalSpaceMahalanobisSquared(
+	double person_pos_x,
+	double person_pos_y,
+	double person_orient_yaw,
+	double person_pos_cov_xx,
+	double person_pos_cov_xy,
+	double person_pos_cov_yx,
+	double person_pos_cov_yy,
+	double person_ps_var_front,
+	double person_ps_var_rear,
+	double person_ps_var_side,
+	double robot_pos_x,
+	double robot_pos_y
+) {
+	SOCIAL_NAV_UTILS_COUNT(PERSONAL_SPACE_CALLS);
+	PersonalSpaceModel model(
+		person_pos_x,
+		person_pos_y,
+		person_orient_yaw,
+		person_pos_cov_xx,
+		person_pos_cov_xy,
+		person_pos_cov_yx,
+		person_pos_cov_yy,
+		person_ps_var_front,
+		person_ps_var_rear,
+		person_ps_var_side
+	);
+	return model.computeMahalanobisSquared(robot_pos_x, robot_pos_y);
+}
+
+} // namespace social_nav_utils
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <social_nav_utils/config.h>
+#include <social_nav_utils/personal_space_model.h>
+
+#include <social_nav_utils/math/core.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace social_nav_utils {
+
+SOCIAL_NAV_UTILS_INLINE PersonalSpaceModel::PersonalSpaceModel(
+	double person_pos_x,
+	double person_pos_y,
+	double person_orient_yaw,
+	double person_pos_cov_xx,
+	double person_pos_cov_xy,
+	double person_pos_cov_yx,
+	double person_pos_cov_yy,
+	double person_ps_var_front,
+	double person_ps_var_rear,
+	double person_ps_var_side,
+	bool unify_asymmetry_scale
+):
+	rel_loc_(person_pos_x, person_pos_y, person_orient_yaw),
+	scale_front_(1.0),
+	scale_rear_(1.0)
+{
+	// create matrix for covariance rotation
+	Rotation2Dd rot(person_orient_yaw);
+
+	// create human position uncertainty matrix
+	Matrix2d cov_p(
+		person_pos_cov_xx, person_pos_cov_xy,
+		person_pos_cov_yx, person_pos_cov_yy
+	);
+
+	// create covariance matrices of the personal zone model
+	Matrix2d cov_psi_init_front(person_ps_var_front, 0.0, 0.0, person_ps_var_side);
+	Matrix2d cov_psi_init_rear(person_ps_var_rear, 0.0, 0.0, person_ps_var_side);
+
+	// rotate covariance matrices
+	Matrix2d cov_psi_front = rot.congruence(cov_psi_init_front);
+	Matrix2d cov_psi_rear = rot.congruence(cov_psi_init_rear);
+
+	// resultant covariance matrices (variances summed up)
+	gaussian_front_ = GaussianModel(person_pos_x, person_pos_y, cov_p + cov_psi_front);
+	gaussian_rear_ = GaussianModel(person_pos_x, person_pos_y, cov_p + cov_psi_rear);
+
+	/*
+	 * Perfect Gaussians in terms of mathematical description have a bump across the center axis due to different
+	 * variances (thus maximums). With `unify_asymmetry_scale`, the Gaussian with higher variance is prolonged
+	 * in the upper direction according to the second one's maximum (in the mean pose)
+	 */
+	if (unify_asymmetry_scale) {
+		double max_front = gaussian_front_.getNormalization();
+		double max_rear = gaussian_rear_.getNormalization();
+		scale_front_ = std::max(max_front, max_rear) / max_front;
+		scale_rear_ = std::max(max_front, max_rear) / max_rear;
+	}
+}
+
+} // namespace social_nav_utils
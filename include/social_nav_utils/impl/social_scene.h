@@ -0,0 +1,162 @@
+#pragma once
+
+#include <social_nav_utils/config.h>
+#include <social_nav_utils/social_scene.h>
+
+#include <social_nav_utils/ellipse_fitting.h>
+#include <social_nav_utils/passing_speed_comfort.h>
+#include <social_nav_utils/relative_location.h>
+
+#include <cmath>
+
+namespace social_nav_utils {
+
+SOCIAL_NAV_UTILS_INLINE SocialScene::SocialScene(bool unify_asymmetry_scale):
+	unify_asymmetry_scale_(unify_asymmetry_scale)
+{}
+
+SOCIAL_NAV_UTILS_INLINE void SocialScene::clear() {
+	humans_.clear();
+	groups_.clear();
+	arena_.reset();
+}
+
+SOCIAL_NAV_UTILS_INLINE void SocialScene::setRobot(const RobotState& robot) {
+	robot_ = robot;
+}
+
+SOCIAL_NAV_UTILS_INLINE size_t SocialScene::addHuman(const HumanState& human) {
+	PersonalSpaceModel personal_space(
+		human.x,
+		human.y,
+		human.yaw,
+		human.cov_xx,
+		human.cov_xy,
+		human.cov_xy,
+		human.cov_yy,
+		human.ps_var_front,
+		human.ps_var_rear,
+		human.ps_var_side,
+		unify_asymmetry_scale_
+	);
+	GaussianModel direction(
+		human.x,
+		human.y,
+		HeadingDirectionDisturbance::computeDirectionCovariance(
+			human.cov_xx,
+			human.cov_xy,
+			human.cov_yy,
+			human.occupancy_radius
+		)
+	);
+	double fov_scale_max = HeadingDirectionDisturbance::computeFovScale(0.0, human.fov);
+	humans_.push_back(HumanEntry{human, personal_space, direction, fov_scale_max});
+	return humans_.size() - 1;
+}
+
+SOCIAL_NAV_UTILS_INLINE size_t SocialScene::addGroup(const GroupState& group) {
+	FormationSpaceModel formation_space(
+		group.x,
+		group.y,
+		group.orientation,
+		group.variance_x,
+		group.variance_y,
+		group.cov_xx,
+		group.cov_xy,
+		group.cov_yy
+	);
+	groups_.push_back(GroupEntry{group, formation_space});
+	return groups_.size() - 1;
+}
+
+SOCIAL_NAV_UTILS_INLINE size_t SocialScene::addGroup(
+	const std::vector<double>& members_x,
+	const std::vector<double>& members_y,
+	double pos_center_variance_xx,
+	double pos_center_variance_xyyx,
+	double pos_center_variance_yy
+) {
+	EllipseFitting ellipse(members_x, members_y, &arena_);
+
+	GroupState group;
+	group.x = ellipse.getCenterX();
+	group.y = ellipse.getCenterY();
+	group.orientation = ellipse.getOrientation();
+	// 2-sigma rule applied to the semi-axes
+	group.variance_x = std::pow(ellipse.getSemiAxisMajor() / HeadingDirectionDisturbance::SIGMA_RULE_NUM, 2);
+	group.variance_y = std::pow(ellipse.getSemiAxisMinor() / HeadingDirectionDisturbance::SIGMA_RULE_NUM, 2);
+	group.cov_xx = pos_center_variance_xx;
+	group.cov_xy = pos_center_variance_xyyx;
+	group.cov_yy = pos_center_variance_yy;
+	return addGroup(group);
+}
+
+SOCIAL_NAV_UTILS_INLINE double SocialScene::computePersonalSpaceIntrusion(size_t human, double x, double y, bool normalize) const {
+	const auto& model = humans_.at(human).personal_space;
+	double intrusion = model.evaluate(x, y);
+	if (normalize) {
+		intrusion /= model.getMax();
+	}
+	return intrusion;
+}
+
+SOCIAL_NAV_UTILS_INLINE double SocialScene::computePersonalSpaceIntrusion(size_t human, bool normalize) const {
+	return computePersonalSpaceIntrusion(human, robot_.x, robot_.y, normalize);
+}
+
+SOCIAL_NAV_UTILS_INLINE double SocialScene::computeFormationSpaceIntrusion(size_t group, double x, double y, bool normalize) const {
+	const auto& model = groups_.at(group).formation_space;
+	double intrusion = model.evaluate(x, y);
+	if (normalize) {
+		intrusion /= model.getMax();
+	}
+	return intrusion;
+}
+
+SOCIAL_NAV_UTILS_INLINE double SocialScene::computeFormationSpaceIntrusion(size_t group, bool normalize) const {
+	return computeFormationSpaceIntrusion(group, robot_.x, robot_.y, normalize);
+}
+
+SOCIAL_NAV_UTILS_INLINE double SocialScene::computeHeadingDirectionDisturbance(size_t human, bool normalize) const {
+	const auto& entry = humans_.at(human);
+	const auto& state = entry.state;
+
+	double direction_scale = 0.0;
+	double x_intsec = NAN;
+	double y_intsec = NAN;
+	bool intersects = HeadingDirectionDisturbance::computeDirectionIntersection(
+		state.x,
+		state.y,
+		robot_.x,
+		robot_.y,
+		robot_.yaw,
+		x_intsec,
+		y_intsec
+	);
+	if (intersects) {
+		direction_scale = entry.direction.evaluate(x_intsec, y_intsec);
+	}
+
+	RelativeLocation rel_loc(state.x, state.y, state.yaw, robot_.x, robot_.y);
+	double fov_scale = HeadingDirectionDisturbance::computeFovScale(rel_loc.getAngle(), state.fov);
+	double speed_scale = HeadingDirectionDisturbance::computeSpeedScale(robot_.vx, robot_.vy);
+	double distance_scale = HeadingDirectionDisturbance::computeDistScale(state.x, state.y, robot_.x, robot_.y);
+
+	if (normalize) {
+		// the worst case is the 'other' heading straight into the center of the 'ego', i.e., the mean of the Gaussian
+		direction_scale /= entry.direction.getNormalization();
+		fov_scale /= entry.fov_scale_max;
+		speed_scale /= robot_.max_speed;
+		distance_scale /= robot_.circumradius + state.occupancy_radius;
+	}
+	return direction_scale * fov_scale * speed_scale / distance_scale;
+}
+
+SOCIAL_NAV_UTILS_INLINE double SocialScene::computePassingSpeedComfort(size_t human) const {
+	const auto& state = humans_.at(human).state;
+	double distance = std::hypot(robot_.x - state.x, robot_.y - state.y);
+	double speed = std::hypot(robot_.vx, robot_.vy);
+	return PassingSpeedComfort::computeSpeedComfort(distance, speed);
+}
+
+} // namespace social_nav_utils
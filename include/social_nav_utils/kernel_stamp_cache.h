@@ -0,0 +1,191 @@
+#pragma once
+
+#include <social_nav_utils/tiled_kernel.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace social_nav_utils {
+
+/**
+ * @brief Discretized personal space kernels precomputed for quantized orientations, stamped onto cost grids
+ *
+ * When the personal space variances (front/rear/side) are shared by all humans, the kernel of each human
+ * differs only by the position, orientation and position uncertainty. The cache stores a stamp (a square
+ * grid of samples at the costmap resolution) for each of @ref Parameters::yaw_bins orientations and each
+ * level of the isotropic position uncertainty. Stamping a human takes the stamp of the nearest orientation
+ * and level and shifts it by the sub-cell offset of the human position with bilinear interpolation, so no
+ * Gaussian is evaluated at runtime.
+ *
+ * Errors w.r.t. @ref PersonalSpaceModel::evaluate come from:
+ * - orientation quantization: at most half of the bin width (2.5 deg for 72 bins),
+ * - position uncertainty: the covariance is replaced by the nearest level of an isotropic one with the same trace,
+ * - bilinear interpolation: proportional to the squared resolution divided by the smallest variance,
+ * - truncation: stamps end at @ref Parameters::sigmas standard deviations along the major axis,
+ *   see @ref GaussianCutoff::getMaxError.
+ *
+ * The cache can be saved to a file that is memory-mapped on load, so tables do not have to be recomputed
+ * at each start. File layout (native byte order, sections aligned to 8 bytes):
+ * - magic (@ref MAGIC) and the header with parameters and the stamp radius,
+ * - levels of the position variance, then peak values of each level (doubles),
+ * - stamps (floats), ordered by level, orientation bin, row and column,
+ * - magic again.
+ */
+class KernelStampCache {
+public:
+	static constexpr char MAGIC[9] = "SNUKST01";
+
+	/// Parameters shared by all humans
+	struct Parameters {
+		/// See @ref PersonalSpaceIntrusion::computePersonalSpaceGaussian
+		double var_front = 0.0;
+		double var_rear = 0.0;
+		double var_side = 0.0;
+		bool unify_asymmetry_scale = false;
+		/// Size of a grid cell [m]
+		double resolution = 0.05;
+		/// Number of orientation bins covering the full angle
+		size_t yaw_bins = 72;
+		/// Extent of stamps in standard deviations (along the axis with the largest variance)
+		double sigmas = 4.0;
+		/// Variances of the isotropic position uncertainty that stamps are computed for
+		std::vector<double> position_variances = {0.0};
+	};
+
+	/// Computes all stamps, throws std::invalid_argument if parameters are not valid
+	explicit KernelStampCache(const Parameters& params);
+
+	/// Maps the cache file into memory, throws std::runtime_error if it could not be mapped or is not valid
+	explicit KernelStampCache(const std::string& path);
+
+	~KernelStampCache();
+
+	KernelStampCache(const KernelStampCache&) = delete;
+	KernelStampCache& operator=(const KernelStampCache&) = delete;
+
+	KernelStampCache(KernelStampCache&& other) noexcept;
+	KernelStampCache& operator=(KernelStampCache&& other) noexcept;
+
+	/**
+	 * @brief Loads the cache from the file if it matches the parameters, otherwise computes it and saves it to the file
+	 *
+	 * Failure to save the file is not an error (the computed cache is returned anyway)
+	 */
+	static KernelStampCache loadOrCreate(const std::string& path, const Parameters& params);
+
+	/// Writes the cache to the file, throws std::runtime_error if it could not be written
+	void save(const std::string& path) const;
+
+	/// Returns true if stamps were computed for the same parameters
+	bool isCompatible(const Parameters& params) const;
+
+	/// Returns true if stamps are read from a memory-mapped file
+	inline bool isMapped() const {
+		return mapped_data_ != nullptr;
+	}
+
+	inline const Parameters& getParameters() const {
+		return params_;
+	}
+
+	/// Number of cells between the center and the edge of a stamp
+	inline size_t getRadius() const {
+		return radius_;
+	}
+
+	/// Number of samples along each side of a stamp
+	inline size_t getSide() const {
+		return side_;
+	}
+
+	/// Returns the index of the orientation bin nearest to the yaw
+	size_t getYawBin(double yaw) const;
+
+	/// Returns the index of the position variance level nearest to the isotropic equivalent of the covariance
+	size_t getLevel(double cov_xx, double cov_yy) const;
+
+	/**
+	 * @brief Returns samples of a stamp (row-major, @ref getSide x @ref getSide)
+	 *
+	 * Sample (row, col) holds the kernel value at offset `((col - radius) * resolution, (row - radius) * resolution)`
+	 * from the human position
+	 */
+	const float* getStamp(size_t level, size_t yaw_bin) const;
+
+	/// Returns the value of the kernel at the human position for the level (see @ref PersonalSpaceModel::getMax)
+	inline double getPeak(size_t level) const {
+		return peaks_[level];
+	}
+
+	/**
+	 * @brief Stamps personal space of a human onto a cost grid
+	 *
+	 * The grid is row-major with the same resolution as the cache; cell (col, row) is stored at
+	 * `grid[row * width + col]` and its center is located at
+	 * `(origin_x + (col + 0.5) * resolution, origin_y + (row + 0.5) * resolution)`. Parts of the stamp outside
+	 * the grid are clipped.
+	 *
+	 * @param person_pos_x
+	 * @param person_pos_y
+	 * @param person_orient_yaw
+	 * @param person_pos_cov_xx
+	 * @param person_pos_cov_yy
+	 * @param grid cost grid
+	 * @param width number of columns of the grid
+	 * @param height number of rows of the grid
+	 * @param origin_x x coordinate of the grid corner
+	 * @param origin_y y coordinate of the grid corner
+	 * @param reduction how the kernel is combined with the costs already stored in the grid
+	 * @param normalize see @ref PersonalSpaceIntrusion::normalize
+	 */
+	void stamp(
+		double person_pos_x,
+		double person_pos_y,
+		double person_orient_yaw,
+		double person_pos_cov_xx,
+		double person_pos_cov_yy,
+		double* grid,
+		size_t width,
+		size_t height,
+		double origin_x,
+		double origin_y,
+		CostReduction reduction = CostReduction::MAX,
+		bool normalize = false
+	) const;
+
+protected:
+	/// Fixed-size part of the file that follows the magic
+	struct Header {
+		double var_front;
+		double var_rear;
+		double var_side;
+		double resolution;
+		double sigmas;
+		uint64_t unify_asymmetry_scale;
+		uint64_t yaw_bins;
+		uint64_t levels_num;
+		uint64_t radius;
+	};
+
+	/// Returns the number of floats stored in all stamps
+	size_t computeStampsSize() const;
+
+	/// Releases the mapping (if any)
+	void unmap();
+
+	Parameters params_;
+	size_t radius_;
+	size_t side_;
+	std::vector<double> peaks_;
+	/// Storage of stamps computed in the constructor (empty if mapped)
+	std::vector<float> storage_;
+	/// Points either to @ref storage_ or into the mapped file
+	const float* stamps_;
+
+	const uint8_t* mapped_data_;
+	size_t mapped_size_;
+};
+
+} // namespace social_nav_utils
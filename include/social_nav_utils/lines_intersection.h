@@ -1,5 +1,7 @@
 #pragma once
 
+#include <social_nav_utils/counters.h>
+
 #include <vector>
 #include <stdexcept>
 #include <math.h>
@@ -32,15 +34,34 @@ public:
 		if (l1x.size() < 2 || l1y.size() < 2 || l2x.size() < 2 || l2y.size() < 2) {
 			throw std::runtime_error("Not enough input data to find intersection point");
 		}
+		compute(l1x.at(0), l1y.at(0), l1x.at(1), l1y.at(1), l2x.at(0), l2y.at(0), l2x.at(1), l2y.at(1));
+	}
+
+	/**
+	 * @brief Constructor that performs all computations without any temporary containers
+	 *
+	 * Line 1 is given by the points (x1, y1) and (x2, y2), line 2 by the points (x3, y3) and (x4, y4)
+	 */
+	LinesIntersection(double x1, double y1, double x2, double y2, double x3, double y3, double x4, double y4):
+		xi_(NAN),
+		yi_(NAN)
+	{
+		compute(x1, y1, x2, y2, x3, y3, x4, y4);
+	}
 
-		double x1 = l1x.at(0);
-		double y1 = l1y.at(0);
-		double x2 = l1x.at(1);
-		double y2 = l1y.at(1);
-		double x3 = l2x.at(0);
-		double y3 = l2y.at(0);
-		double x4 = l2x.at(1);
-		double y4 = l2y.at(1);
+	/// Returns interection point's x coordinate (NaN if no interesction)
+	double getX() const {
+		return xi_;
+	}
+
+	/// Returns interection point's y coordinate (NaN if no interesction)
+	double getY() const {
+		return yi_;
+	}
+
+protected:
+	void compute(double x1, double y1, double x2, double y2, double x3, double y3, double x4, double y4) {
+		SOCIAL_NAV_UTILS_COUNT(LINES_INTERSECTION_CALLS);
 
 		// Line segments intersect parameters
 		double u = ((x1-x3)*(y1-y2) - (y1-y3)*(x1-x2)) / ((x1-x2)*(y3-y4)-(y1-y2)*(x3-x4));
@@ -55,19 +76,9 @@ public:
 
 		xi_ = NAN;
 		yi_ = NAN;
+		SOCIAL_NAV_UTILS_COUNT(LINES_INTERSECTION_NAN);
 	}
 
-	/// Returns interection point's x coordinate (NaN if no interesction)
-	double getX() const {
-		return xi_;
-	}
-
-	/// Returns interection point's y coordinate (NaN if no interesction)
-	double getY() const {
-		return yi_;
-	}
-
-protected:
 	double xi_;
 	double yi_;
 };
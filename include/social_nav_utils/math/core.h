@@ -6,3 +6,4 @@
 #include <social_nav_utils/math/row_vector.h>
 #include <social_nav_utils/math/vector3.h>
 #include <social_nav_utils/math/row_vector3.h>
+#include <social_nav_utils/math/expressions.h>
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <social_nav_utils/math/matrix.h>
+#include <social_nav_utils/math/vector.h>
+#include <social_nav_utils/math/row_vector.h>
+
+#include <cassert>
+#include <cstddef>
+
+/*
+ * Lazy expression nodes for chains of operations with an inverse of a matrix that are typical for Gaussian models,
+ * e.g., `r.transpose() * C.inverseLazy() * e` (bilinear form). Eager operations (e.g., @ref Matrix2::inverse)
+ * return plain matrices, so the nodes are opt-in.
+ *
+ * Intermediate operations return nodes that only store their (small) operands by value, so it is safe to keep
+ * them in `auto` variables. The whole chain is evaluated once its last operand is known, without forming
+ * the inverse explicitly. Each node converts implicitly to the matrix or vector that the eager computation
+ * would produce.
+ *
+ * `C.inverseLazy().quadraticForm(d)` evaluates `d^T * C^(-1) * d` (squared Mahalanobis distance) and
+ * @ref Rotation2D::congruence evaluates `R * C * R^T` (rotation of a covariance matrix); both keep the result
+ * exact for symmetric `C`.
+ */
+
+namespace social_nav_utils {
+
+/**
+ * @brief Inverse of a @ref Matrix2 computed from the adjugate only when needed
+ */
+template <typename T>
+class Matrix2Inverse {
+public:
+	constexpr explicit Matrix2Inverse(const Matrix2<T>& mat) noexcept: mat_(mat) {}
+
+	constexpr Matrix2<T> eval() const noexcept {
+		const T det_inv = T(1) / mat_.determinant();
+		return Matrix2<T>(
+			+mat_(1, 1) * det_inv,
+			-mat_(0, 1) * det_inv,
+			-mat_(1, 0) * det_inv,
+			+mat_(0, 0) * det_inv
+		);
+	}
+
+	constexpr operator Matrix2<T>() const noexcept {
+		return eval();
+	}
+
+	/// Element of the adjugate divided by the determinant
+	constexpr T operator()(size_t row, size_t col) const noexcept {
+		return (row == col ? mat_(1 - row, 1 - col) : -mat_(row, col)) / mat_.determinant();
+	}
+
+	/// Solves the linear system instead of multiplying by the inverse
+	template <typename Tvec>
+	constexpr Vector2<T> operator*(const Vector2<Tvec>& vec) const noexcept {
+		const T det_inv = T(1) / mat_.determinant();
+		return Vector2<T>(
+			(mat_(1, 1) * vec(0) - mat_(0, 1) * vec(1)) * det_inv,
+			(mat_(0, 0) * vec(1) - mat_(1, 0) * vec(0)) * det_inv
+		);
+	}
+
+	constexpr Matrix2<T> operator*(const Matrix2<T>& other) const noexcept {
+		return eval() * other;
+	}
+
+	/**
+	 * @brief Evaluates the quadratic form `d^T * C^(-1) * d`, e.g., a squared Mahalanobis distance
+	 *
+	 * Needs only the sum of the off-diagonal elements of `C`, so the result does not depend on the order
+	 * of the symmetric elements.
+	 */
+	template <typename Tvec>
+	constexpr T quadraticForm(const Vector2<Tvec>& vec) const noexcept {
+		return (
+			mat_(1, 1) * vec(0) * vec(0)
+			- (mat_(0, 1) + mat_(1, 0)) * vec(0) * vec(1)
+			+ mat_(0, 0) * vec(1) * vec(1)
+		) / mat_.determinant();
+	}
+
+	/// Matrix that is inverted
+	constexpr const Matrix2<T>& getInverted() const noexcept {
+		return mat_;
+	}
+
+protected:
+	Matrix2<T> mat_;
+};
+
+/**
+ * @brief Product of a row vector and an inverse of a matrix, i.e., `r^T * C^(-1)`
+ *
+ * Multiplication by a column vector `e` yields `r^T * C^(-1) * e` with a single division by the determinant.
+ */
+template <typename T>
+class RowVector2InverseProduct {
+public:
+	constexpr RowVector2InverseProduct(const RowVector2<T>& row, const Matrix2<T>& mat) noexcept:
+		row_(row),
+		mat_(mat)
+	{}
+
+	constexpr RowVector2<T> eval() const noexcept {
+		const T det_inv = T(1) / mat_.determinant();
+		return RowVector2<T>(
+			(row_(0) * mat_(1, 1) - row_(1) * mat_(1, 0)) * det_inv,
+			(row_(1) * mat_(0, 0) - row_(0) * mat_(0, 1)) * det_inv
+		);
+	}
+
+	constexpr operator RowVector2<T>() const noexcept {
+		return eval();
+	}
+
+	constexpr T operator()(size_t index) const noexcept {
+		return (index == 0
+			? row_(0) * mat_(1, 1) - row_(1) * mat_(1, 0)
+			: row_(1) * mat_(0, 0) - row_(0) * mat_(0, 1)
+		) / mat_.determinant();
+	}
+
+	/**
+	 * @brief Evaluates the bilinear form `r^T * C^(-1) * e`
+	 *
+	 * For `r == e`, prefer @ref Matrix2Inverse::quadraticForm.
+	 */
+	template <typename Tvec>
+	constexpr T operator*(const Vector2<Tvec>& vec) const noexcept {
+		return (
+			row_(0) * (mat_(1, 1) * vec(0) - mat_(0, 1) * vec(1))
+			+ row_(1) * (mat_(0, 0) * vec(1) - mat_(1, 0) * vec(0))
+		) / mat_.determinant();
+	}
+
+protected:
+	RowVector2<T> row_;
+	Matrix2<T> mat_;
+};
+
+} // namespace social_nav_utils
@@ -1,52 +1,75 @@
 #pragma once
 
 #include <social_nav_utils/math/vector.h>
+#include <social_nav_utils/counters.h>
 
 #include <cassert>
 #include <cstddef>
 #include <cmath>
+#include <type_traits>
 
 namespace social_nav_utils {
 
-// forward declaration due to a circular dependency
+// forward declarations due to circular dependencies
 template <typename T>
 class Rotation2D;
 
-// Custom classes since Eigen carries too big computational burden
 template <typename T>
-class Matrix2 {
+class Matrix2Inverse;
+
+/**
+ * @brief Custom classes since Eigen carries too big computational burden
+ *
+ * Row-major storage aligned to the size of the whole matrix, so it can be loaded with a single SIMD instruction
+ * (e.g., AVX for doubles). Trivially copyable and standard-layout (see the static assertions below).
+ */
+template <typename T>
+class alignas(4 * sizeof(T)) Matrix2 {
 public:
 	// for direct access to storage elements (avoidance of `operator()`)
 	friend class Vector2<T>;
 	friend class RowVector2<T>;
 	friend class Rotation2D<T>;
 
-	Matrix2():
+	constexpr Matrix2() noexcept:
 		Matrix2(T(), T(), T(), T())
 	{}
 
-	Matrix2(T m11, T m12, T m21, T m22):
+	constexpr Matrix2(T m11, T m12, T m21, T m22) noexcept:
 		m_{{m11, m12}, {m21, m22}}
 	{}
 
-	T determinant() const {
+	constexpr T determinant() const noexcept {
 		return m_[0][0] * m_[1][1] - m_[0][1] * m_[1][0];
 	}
 
-	Matrix2<T> transpose() const {
+	constexpr T trace() const noexcept {
+		return m_[0][0] + m_[1][1];
+	}
+
+	constexpr Matrix2<T> transpose() const noexcept {
 		return Matrix2<T>(m_[0][0], m_[1][0], m_[0][1], m_[1][1]);
 	}
 
-	Matrix2<T> inverse() const {
-		return Matrix2<T>(
-			+m_[1][1] / (m_[0][0] * m_[1][1] - m_[0][1] * m_[1][0]),
-			-m_[0][1] / (m_[0][0] * m_[1][1] - m_[0][1] * m_[1][0]),
-			-m_[1][0] / (m_[0][0] * m_[1][1] - m_[0][1] * m_[1][0]),
-			+m_[0][0] / (m_[0][0] * m_[1][1] - m_[0][1] * m_[1][0])
+	/// Not `constexpr` due to the (optional) counters
+	Matrix2<T> inverse() const noexcept {
+		return inverseLazy().eval();
+	}
+
+	/**
+	 * @brief Returns a lazy inverse (see math/expressions.h) that converts to Matrix2
+	 *
+	 * Products with vectors (e.g., `d.transpose() * C.inverseLazy() * d`) are evaluated without forming the inverse
+	 */
+	Matrix2Inverse<T> inverseLazy() const noexcept {
+		SOCIAL_NAV_UTILS_COUNT_IF(
+			Counters::isNearSingular(determinant(), m_[0][0], m_[0][1], m_[1][0], m_[1][1]),
+			MATRIX_INVERSE_NEAR_SINGULAR
 		);
+		return Matrix2Inverse<T>(*this);
 	}
 
-	Matrix2<T> operator*(const Matrix2<T>& other) const {
+	constexpr Matrix2<T> operator*(const Matrix2<T>& other) const noexcept {
 		return Matrix2<T>(
 			other.m_[0][0] * m_[0][0] + other.m_[1][0] * m_[0][1],
 			other.m_[0][1] * m_[0][0] + other.m_[1][1] * m_[0][1],
@@ -55,16 +78,21 @@ public:
 		);
 	}
 
+	constexpr Matrix2<T> operator*(const Matrix2Inverse<T>& other) const noexcept {
+		return *this * other.eval();
+	}
+
 	template <typename Tvec>
-	Vector2<T> operator*(const Vector2<Tvec>& vec) const {
+	constexpr Vector2<T> operator*(const Vector2<Tvec>& vec) const noexcept {
 		return Vector2<T>(
 			m_[0][0] * vec.v_[0] + m_[0][1] * vec.v_[1],
 			m_[1][0] * vec.v_[0] + m_[1][1] * vec.v_[1]
 		);
 	}
 
-	template <typename Tmult>
-	Matrix2<T> operator*(const Tmult& mult) const {
+	/// Product with a scalar; matrices derived from Matrix2 (e.g., @ref Rotation2D) use the matrix product
+	template <typename Tmult, typename = std::enable_if_t<!std::is_base_of<Matrix2<T>, Tmult>::value>>
+	constexpr Matrix2<T> operator*(const Tmult& mult) const noexcept {
 		return Matrix2<T>(
 			mult * m_[0][0],
 			mult * m_[0][1],
@@ -73,7 +101,7 @@ public:
 		);
 	}
 
-	Matrix2<T> operator+(const Matrix2<T>& other) const {
+	constexpr Matrix2<T> operator+(const Matrix2<T>& other) const noexcept {
 		return Matrix2<T>(
 			m_[0][0] + other.m_[0][0],
 			m_[0][1] + other.m_[0][1],
@@ -82,7 +110,7 @@ public:
 		);
 	}
 
-	Matrix2<T> operator-(const Matrix2<T>& other) const {
+	constexpr Matrix2<T> operator-(const Matrix2<T>& other) const noexcept {
 		return Matrix2<T>(
 			m_[0][0] - other.m_[0][0],
 			m_[0][1] - other.m_[0][1],
@@ -91,14 +119,14 @@ public:
 		);
 	}
 
-	T operator()(size_t row, size_t col) const {
+	constexpr T operator()(size_t row, size_t col) const noexcept {
 		assert(row < 2);
 		assert(col < 2);
 		return m_[row][col];
 	}
 
 	template <typename Tang>
-	static Matrix2<Tang> rotationMatrix(const Tang& angle) {
+	static Matrix2<Tang> rotationMatrix(const Tang& angle) noexcept {
 		return Matrix2<Tang>(
 			std::cos(angle), -std::sin(angle),
 			std::sin(angle),  std::cos(angle)
@@ -112,4 +140,16 @@ protected:
 typedef Matrix2<double> Matrix2d;
 typedef Matrix2<float> Matrix2f;
 
+static_assert(std::is_trivially_copyable<Matrix2d>::value, "Matrix2d must be trivially copyable");
+static_assert(std::is_standard_layout<Matrix2d>::value, "Matrix2d must be standard-layout");
+static_assert(sizeof(Matrix2d) == 4 * sizeof(double), "Matrix2d must not be padded");
+static_assert(alignof(Matrix2d) == 4 * sizeof(double), "Matrix2d must be aligned to its size");
+static_assert(std::is_trivially_copyable<Matrix2f>::value, "Matrix2f must be trivially copyable");
+static_assert(std::is_standard_layout<Matrix2f>::value, "Matrix2f must be standard-layout");
+static_assert(sizeof(Matrix2f) == 4 * sizeof(float), "Matrix2f must not be padded");
+static_assert(alignof(Matrix2f) == 4 * sizeof(float), "Matrix2f must be aligned to its size");
+
 } // namespace social_nav_utils
+
+// lazy nodes returned by some of the operations
+#include <social_nav_utils/math/expressions.h>
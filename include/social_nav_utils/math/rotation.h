@@ -3,6 +3,7 @@
 #include <social_nav_utils/math/matrix.h>
 
 #include <cmath>
+#include <type_traits>
 
 namespace social_nav_utils {
 
@@ -15,25 +16,42 @@ public:
 	friend class Vector2<T>;
 	friend class RowVector2<T>;
 
-	Rotation2D(T angle = T()):
+	// not `constexpr` since trigonometric functions are not
+	Rotation2D(T angle = T()) noexcept:
 		Matrix2<T>(
 			std::cos(angle), -std::sin(angle),
 			std::sin(angle),  std::cos(angle)
 		)
 	{}
 
-	Rotation2D(const Matrix2<T>& mat):
+	constexpr Rotation2D(const Matrix2<T>& mat) noexcept:
 		Rotation2D(mat.m_[0][0], mat.m_[0][1], mat.m_[1][0], mat.m_[1][1])
 	{}
 
 	// Returning Rotation2D here disallows executing, e.g., R * MAT * R.inverse()
-	Matrix2<T> inverse() const {
+	constexpr Matrix2<T> inverse() const noexcept {
 		return this->transpose();
 	}
 
+	/**
+	 * @brief Computes `R * mat * R^T` (e.g., rotation of a covariance matrix) in a single pass
+	 *
+	 * Reuses the squares of the cosine and sine; the result is exactly symmetric for symmetric @ref mat.
+	 */
+	constexpr Matrix2<T> congruence(const Matrix2<T>& mat) const noexcept {
+		const T c = this->m_[0][0];
+		const T s = this->m_[1][0];
+		return Matrix2<T>(
+			c * c * mat(0, 0) - c * s * (mat(0, 1) + mat(1, 0)) + s * s * mat(1, 1),
+			c * s * (mat(0, 0) - mat(1, 1)) + c * c * mat(0, 1) - s * s * mat(1, 0),
+			c * s * (mat(0, 0) - mat(1, 1)) + c * c * mat(1, 0) - s * s * mat(0, 1),
+			s * s * mat(0, 0) + c * s * (mat(0, 1) + mat(1, 0)) + c * c * mat(1, 1)
+		);
+	}
+
 protected:
 	// to prevent creating strange objects
-	Rotation2D(T m11, T m12, T m21, T m22):
+	constexpr Rotation2D(T m11, T m12, T m21, T m22) noexcept:
 		Matrix2<T>(m11, m12, m21, m22)
 	{}
 };
@@ -41,4 +59,11 @@ protected:
 typedef Rotation2D<double> Rotation2Dd;
 typedef Rotation2D<float> Rotation2Df;
 
+static_assert(std::is_trivially_copyable<Rotation2Dd>::value, "Rotation2Dd must be trivially copyable");
+static_assert(std::is_standard_layout<Rotation2Dd>::value, "Rotation2Dd must be standard-layout");
+static_assert(sizeof(Rotation2Dd) == sizeof(Matrix2d), "Rotation2Dd must not extend the storage of Matrix2d");
+static_assert(std::is_trivially_copyable<Rotation2Df>::value, "Rotation2Df must be trivially copyable");
+static_assert(std::is_standard_layout<Rotation2Df>::value, "Rotation2Df must be standard-layout");
+static_assert(sizeof(Rotation2Df) == sizeof(Matrix2f), "Rotation2Df must not extend the storage of Matrix2f");
+
 } // namespace social_nav_utils
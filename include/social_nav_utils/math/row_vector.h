@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include <cstddef>
+#include <type_traits>
 
 namespace social_nav_utils {
 
@@ -12,44 +13,55 @@ class Vector2;
 template <typename T>
 class Matrix2;
 
+template <typename T>
+class Matrix2Inverse;
+
+template <typename T>
+class RowVector2InverseProduct;
+
 /**
  * @brief Class handling row vectors
  */
 template <typename T>
-class RowVector2 {
+class alignas(2 * sizeof(T)) RowVector2 {
 public:
 	// for direct access to storage elements (avoidance of `operator()`)
 	friend class Vector2<T>;
 	friend class Matrix2<T>;
 
-	RowVector2(): RowVector2(T(), T()) {}
+	constexpr RowVector2() noexcept: RowVector2(T(), T()) {}
 
-	RowVector2(T v1, T v2): v_{v1, v2} {}
+	constexpr RowVector2(T v1, T v2) noexcept: v_{v1, v2} {}
 
-	Vector2<T> transpose() const {
+	constexpr Vector2<T> transpose() const noexcept {
 		return Vector2<T>(v_[0], v_[1]);
 	}
 
 	template <typename Tmat>
-	RowVector2<T> operator*(const Matrix2<Tmat>& matrix) const {
+	constexpr RowVector2<T> operator*(const Matrix2<Tmat>& matrix) const noexcept {
 		return RowVector2<T>(
 			matrix.m_[0][0] * v_[0] + matrix.m_[1][0] * v_[1],
 			matrix.m_[0][1] * v_[0] + matrix.m_[1][1] * v_[1]
 		);
 	}
 
+	/// Lazy product; evaluated at once when multiplied by a column vector (e.g., a squared Mahalanobis distance)
+	constexpr RowVector2InverseProduct<T> operator*(const Matrix2Inverse<T>& inverse) const noexcept {
+		return RowVector2InverseProduct<T>(*this, inverse.getInverted());
+	}
+
 	template <typename Tvec>
-	T operator*(const Vector2<Tvec>& other) const {
+	constexpr T operator*(const Vector2<Tvec>& other) const noexcept {
 		return static_cast<T>(other.v_[0] * v_[0] + other.v_[1] * v_[1]);
 	}
 
 	template <typename Tmult>
-	RowVector2<T> operator*(const Tmult& mult) const {
+	constexpr RowVector2<T> operator*(const Tmult& mult) const noexcept {
 		return RowVector2<T>(mult * v_[0], mult * v_[1]);
 	}
 
 	template <typename Trvec>
-	RowVector2<T> operator+(const RowVector2<Trvec>& other) const {
+	constexpr RowVector2<T> operator+(const RowVector2<Trvec>& other) const noexcept {
 		return RowVector2<T>(
 			v_[0] + other.v_[0],
 			v_[1] + other.v_[1]
@@ -57,7 +69,7 @@ public:
 	}
 
 	template <typename Tvec>
-	Matrix2<T> operator+(const Vector2<Tvec>& other) const {
+	constexpr Matrix2<T> operator+(const Vector2<Tvec>& other) const noexcept {
 		return Matrix2<T>(
 			v_[0] + other.v_[0], v_[1] + other.v_[0],
 			v_[0] + other.v_[1], v_[1] + other.v_[1]
@@ -65,7 +77,7 @@ public:
 	}
 
 	template <typename Trvec>
-	RowVector2<T> operator-(const RowVector2<Trvec>& other) const {
+	constexpr RowVector2<T> operator-(const RowVector2<Trvec>& other) const noexcept {
 		return RowVector2<T>(
 			v_[0] - other.v_[0],
 			v_[1] - other.v_[1]
@@ -73,14 +85,14 @@ public:
 	}
 
 	template <typename Tvec>
-	Matrix2<T> operator-(const Vector2<Tvec>& other) const {
+	constexpr Matrix2<T> operator-(const Vector2<Tvec>& other) const noexcept {
 		return Matrix2<T>(
 			v_[0] - other.v_[0], v_[1] - other.v_[0],
 			v_[0] - other.v_[1], v_[1] - other.v_[1]
 		);
 	}
 
-	T operator()(size_t index) const {
+	constexpr T operator()(size_t index) const noexcept {
 		assert(index < 2);
 		return v_[index];
 	}
@@ -92,4 +104,13 @@ protected:
 typedef RowVector2<double> RowVector2d;
 typedef RowVector2<float> RowVector2f;
 
+static_assert(std::is_trivially_copyable<RowVector2d>::value, "RowVector2d must be trivially copyable");
+static_assert(std::is_standard_layout<RowVector2d>::value, "RowVector2d must be standard-layout");
+static_assert(sizeof(RowVector2d) == 2 * sizeof(double), "RowVector2d must not be padded");
+static_assert(alignof(RowVector2d) == 2 * sizeof(double), "RowVector2d must be aligned to its size");
+static_assert(std::is_trivially_copyable<RowVector2f>::value, "RowVector2f must be trivially copyable");
+static_assert(std::is_standard_layout<RowVector2f>::value, "RowVector2f must be standard-layout");
+static_assert(sizeof(RowVector2f) == 2 * sizeof(float), "RowVector2f must not be padded");
+static_assert(alignof(RowVector2f) == 2 * sizeof(float), "RowVector2f must be aligned to its size");
+
 } // namespace social_nav_utils
@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include <cstddef>
+#include <type_traits>
 
 namespace social_nav_utils {
 
@@ -9,14 +10,18 @@ namespace social_nav_utils {
  * @brief Class handling 3-element row vectors
  */
 template <typename T>
-class RowVector3 {
+class alignas(4 * sizeof(T)) RowVector3 {
 public:
-	RowVector3(): RowVector3(T(), T(), T()) {}
+	// for direct access to storage elements of vectors with other element types
+	template <typename>
+	friend class RowVector3;
 
-	RowVector3(T v1, T v2, T v3): v_{v1, v2, v3} {}
+	constexpr RowVector3() noexcept: RowVector3(T(), T(), T()) {}
+
+	constexpr RowVector3(T v1, T v2, T v3) noexcept: v_{v1, v2, v3, T()} {}
 
 	template <typename Tvec>
-	RowVector3<T> operator+(const RowVector3<Tvec>& other) {
+	constexpr RowVector3<T> operator+(const RowVector3<Tvec>& other) const noexcept {
 		return RowVector3<T>(
 			v_[0] + other.v_[0],
 			v_[1] + other.v_[1],
@@ -25,7 +30,7 @@ public:
 	}
 
 	template <typename Tvec>
-	RowVector3<T> operator-(const RowVector3<Tvec>& other) {
+	constexpr RowVector3<T> operator-(const RowVector3<Tvec>& other) const noexcept {
 		return RowVector3<T>(
 			v_[0] - other.v_[0],
 			v_[1] - other.v_[1],
@@ -33,16 +38,26 @@ public:
 		);
 	}
 
-	T operator()(size_t index) const {
+	constexpr T operator()(size_t index) const noexcept {
 		assert(index < 3);
 		return v_[index];
 	}
 
 protected:
-	T v_[3];
+	/// The last element only pads the storage to the alignment; it is always zero, so raw copies are deterministic
+	T v_[4];
 };
 
 typedef RowVector3<double> RowVector3d;
 typedef RowVector3<float> RowVector3f;
 
+static_assert(std::is_trivially_copyable<RowVector3d>::value, "RowVector3d must be trivially copyable");
+static_assert(std::is_standard_layout<RowVector3d>::value, "RowVector3d must be standard-layout");
+static_assert(sizeof(RowVector3d) == 4 * sizeof(double), "RowVector3d must be padded to 4 elements");
+static_assert(alignof(RowVector3d) == 4 * sizeof(double), "RowVector3d must be aligned to its size");
+static_assert(std::is_trivially_copyable<RowVector3f>::value, "RowVector3f must be trivially copyable");
+static_assert(std::is_standard_layout<RowVector3f>::value, "RowVector3f must be standard-layout");
+static_assert(sizeof(RowVector3f) == 4 * sizeof(float), "RowVector3f must be padded to 4 elements");
+static_assert(alignof(RowVector3f) == 4 * sizeof(float), "RowVector3f must be aligned to its size");
+
 } // namespace social_nav_utils
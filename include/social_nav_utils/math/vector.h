@@ -4,6 +4,7 @@
 
 #include <cassert>
 #include <cstddef>
+#include <type_traits>
 
 namespace social_nav_utils {
 
@@ -15,22 +16,26 @@ class Matrix2;
  * @brief Class handling typical column vectors
  */
 template <typename T>
-class Vector2 {
+class alignas(2 * sizeof(T)) Vector2 {
 public:
 	// for direct access to storage elements (avoidance of `operator()`)
 	friend class RowVector2<T>;
 	friend class Matrix2<T>;
 
-	Vector2(): Vector2(T(), T()) {}
+	constexpr Vector2() noexcept: Vector2(T(), T()) {}
 
-	Vector2(T v1, T v2): v_{v1, v2} {}
+	constexpr Vector2(T v1, T v2) noexcept: v_{v1, v2} {}
 
-	RowVector2<T> transpose() const {
+	constexpr RowVector2<T> transpose() const noexcept {
 		return RowVector2<T>(v_[0], v_[1]);
 	}
 
+	constexpr T squaredNorm() const noexcept {
+		return v_[0] * v_[0] + v_[1] * v_[1];
+	}
+
 	template <typename Trvec>
-	Matrix2<T> operator*(const RowVector2<Trvec>& other) const {
+	constexpr Matrix2<T> operator*(const RowVector2<Trvec>& other) const noexcept {
 		return Matrix2<T>(
 			v_[0] * other.v_[0], v_[0] * other.v_[1],
 			v_[1] * other.v_[0], v_[1] * other.v_[1]
@@ -38,11 +43,11 @@ public:
 	}
 
 	template <typename Tmult>
-	Vector2<T> operator*(const Tmult& mult) const {
+	constexpr Vector2<T> operator*(const Tmult& mult) const noexcept {
 		return Vector2<T>(mult * v_[0], mult * v_[1]);
 	}
 
-	Vector2<T> operator+(const Vector2<T>& other) const {
+	constexpr Vector2<T> operator+(const Vector2<T>& other) const noexcept {
 		return Vector2<T>(
 			v_[0] + other.v_[0],
 			v_[1] + other.v_[1]
@@ -50,14 +55,14 @@ public:
 	}
 
 	template <typename Trvec>
-	Matrix2<T> operator+(const RowVector2<Trvec>& other) const {
+	constexpr Matrix2<T> operator+(const RowVector2<Trvec>& other) const noexcept {
 		return Matrix2<T>(
 			v_[0] + other.v_[0], v_[0] + other.v_[1],
 			v_[1] + other.v_[0], v_[1] + other.v_[1]
 		);
 	}
 
-	Vector2<T> operator-(const Vector2<T>& other) const {
+	constexpr Vector2<T> operator-(const Vector2<T>& other) const noexcept {
 		return Vector2<T>(
 			v_[0] - other.v_[0],
 			v_[1] - other.v_[1]
@@ -65,14 +70,14 @@ public:
 	}
 
 	template <typename Trvec>
-	Matrix2<T> operator-(const RowVector2<Trvec>& other) const {
+	constexpr Matrix2<T> operator-(const RowVector2<Trvec>& other) const noexcept {
 		return Matrix2<T>(
 			v_[0] - other.v_[0], v_[0] - other.v_[1],
 			v_[1] - other.v_[0], v_[1] - other.v_[1]
 		);
 	}
 
-	T operator()(size_t index) const {
+	constexpr T operator()(size_t index) const noexcept {
 		assert(index < 2);
 		return v_[index];
 	}
@@ -84,4 +89,13 @@ protected:
 typedef Vector2<double> Vector2d;
 typedef Vector2<float> Vector2f;
 
+static_assert(std::is_trivially_copyable<Vector2d>::value, "Vector2d must be trivially copyable");
+static_assert(std::is_standard_layout<Vector2d>::value, "Vector2d must be standard-layout");
+static_assert(sizeof(Vector2d) == 2 * sizeof(double), "Vector2d must not be padded");
+static_assert(alignof(Vector2d) == 2 * sizeof(double), "Vector2d must be aligned to its size");
+static_assert(std::is_trivially_copyable<Vector2f>::value, "Vector2f must be trivially copyable");
+static_assert(std::is_standard_layout<Vector2f>::value, "Vector2f must be standard-layout");
+static_assert(sizeof(Vector2f) == 2 * sizeof(float), "Vector2f must not be padded");
+static_assert(alignof(Vector2f) == 2 * sizeof(float), "Vector2f must be aligned to its size");
+
 } // namespace social_nav_utils
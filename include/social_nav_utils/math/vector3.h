@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include <cstddef>
+#include <type_traits>
 
 namespace social_nav_utils {
 
@@ -9,14 +10,18 @@ namespace social_nav_utils {
  * @brief Class handling typical 3-element column vectors
  */
 template <typename T>
-class Vector3 {
+class alignas(4 * sizeof(T)) Vector3 {
 public:
-	Vector3(): Vector3(T(), T(), T()) {}
+	// for direct access to storage elements of vectors with other element types
+	template <typename>
+	friend class Vector3;
 
-	Vector3(T v1, T v2, T v3): v_{v1, v2, v3} {}
+	constexpr Vector3() noexcept: Vector3(T(), T(), T()) {}
+
+	constexpr Vector3(T v1, T v2, T v3) noexcept: v_{v1, v2, v3, T()} {}
 
 	template <typename Tvec>
-	Vector3<T> operator+(const Vector3<Tvec>& other) {
+	constexpr Vector3<T> operator+(const Vector3<Tvec>& other) const noexcept {
 		return Vector3<T>(
 			v_[0] + other.v_[0],
 			v_[1] + other.v_[1],
@@ -25,7 +30,7 @@ public:
 	}
 
 	template <typename Tvec>
-	Vector3<T> operator-(const Vector3<Tvec>& other) {
+	constexpr Vector3<T> operator-(const Vector3<Tvec>& other) const noexcept {
 		return Vector3<T>(
 			v_[0] - other.v_[0],
 			v_[1] - other.v_[1],
@@ -33,16 +38,26 @@ public:
 		);
 	}
 
-	T operator()(size_t index) const {
+	constexpr T operator()(size_t index) const noexcept {
 		assert(index < 3);
 		return v_[index];
 	}
 
 protected:
-	T v_[3];
+	/// The last element only pads the storage to the alignment; it is always zero, so raw copies are deterministic
+	T v_[4];
 };
 
 typedef Vector3<double> Vector3d;
 typedef Vector3<float> Vector3f;
 
+static_assert(std::is_trivially_copyable<Vector3d>::value, "Vector3d must be trivially copyable");
+static_assert(std::is_standard_layout<Vector3d>::value, "Vector3d must be standard-layout");
+static_assert(sizeof(Vector3d) == 4 * sizeof(double), "Vector3d must be padded to 4 elements");
+static_assert(alignof(Vector3d) == 4 * sizeof(double), "Vector3d must be aligned to its size");
+static_assert(std::is_trivially_copyable<Vector3f>::value, "Vector3f must be trivially copyable");
+static_assert(std::is_standard_layout<Vector3f>::value, "Vector3f must be standard-layout");
+static_assert(sizeof(Vector3f) == 4 * sizeof(float), "Vector3f must be padded to 4 elements");
+static_assert(alignof(Vector3f) == 4 * sizeof(float), "Vector3f must be aligned to its size");
+
 } // namespace social_nav_utils
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace social_nav_utils {
+
+/**
+ * @brief Bump allocator for short-lived temporaries, rewound once per cycle (e.g., per frame)
+ *
+ * Allocations are carved sequentially from blocks obtained from the upstream resource; deallocation is a no-op.
+ * @ref reset makes the whole memory available again but keeps the blocks, so once the arena has grown to
+ * the peak demand of a cycle, the following cycles do not touch the upstream allocator (e.g., glibc malloc)
+ * at all. This avoids lock contention of the global heap between threads.
+ *
+ * Not thread-safe, each thread should use its own arena.
+ */
+class MemoryArena: public std::pmr::memory_resource {
+public:
+	/// Default size of a block requested from the upstream resource
+	static constexpr size_t BLOCK_SIZE_DEFAULT = 64 * 1024;
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param block_size size of blocks requested from @ref upstream (allocations that do not fit get dedicated blocks)
+	 * @param upstream resource that provides the blocks
+	 */
+	explicit MemoryArena(
+		size_t block_size = BLOCK_SIZE_DEFAULT,
+		std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()
+	);
+
+	~MemoryArena() override;
+
+	MemoryArena(const MemoryArena&) = delete;
+	MemoryArena& operator=(const MemoryArena&) = delete;
+
+	MemoryArena(MemoryArena&& other) noexcept;
+	MemoryArena& operator=(MemoryArena&& other) noexcept;
+
+	/// Makes all memory available again; everything allocated before must no longer be used
+	void reset();
+
+	/// Returns all blocks to the upstream resource
+	void release();
+
+	/// Number of bytes allocated since the last @ref reset (including alignment padding)
+	inline size_t getBytesUsed() const {
+		return bytes_used_;
+	}
+
+	/// Maximum of @ref getBytesUsed observed so far
+	inline size_t getBytesUsedPeak() const {
+		return bytes_used_peak_;
+	}
+
+	/// Total size of blocks obtained from the upstream resource
+	inline size_t getBytesReserved() const {
+		return bytes_reserved_;
+	}
+
+	inline size_t getBlocksNum() const {
+		return blocks_.size();
+	}
+
+protected:
+	struct Block {
+		char* data;
+		size_t size;
+	};
+
+	void* do_allocate(size_t bytes, size_t alignment) override;
+
+	/// Memory is reclaimed by @ref reset only
+	void do_deallocate(void* /* ptr */, size_t /* bytes */, size_t /* alignment */) override {}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+		return this == &other;
+	}
+
+	/// Tries to carve the allocation from the current block, returns nullptr if it does not fit
+	void* allocateFromCurrent(size_t bytes, size_t alignment);
+
+	size_t block_size_;
+	std::pmr::memory_resource* upstream_;
+	std::vector<Block> blocks_;
+	/// Index of the block that allocations are carved from
+	size_t current_;
+	/// Offset of the first free byte in the current block
+	size_t offset_;
+	size_t bytes_used_;
+	size_t bytes_used_peak_;
+	size_t bytes_reserved_;
+};
+
+} // namespace social_nav_utils
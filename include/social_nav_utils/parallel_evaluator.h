@@ -0,0 +1,221 @@
+#pragma once
+
+#include <social_nav_utils/entity_arrays.h>
+#include <social_nav_utils/social_scene.h>
+#include <social_nav_utils/tiled_kernel.h>
+#include <social_nav_utils/work_stealing_pool.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace social_nav_utils {
+
+/**
+ * @brief Evaluates social costs of many candidate poses against all entities of a @ref SocialScene in parallel
+ *
+ * Cost matrix (entities x poses) is split into tiles that are executed on a @ref WorkStealingPool.
+ * Each tile is evaluated with the cache-blocked @ref TiledKernel.
+ * Entities are given either by a @ref SocialScene or directly by a @ref HumanArray / @ref GroupArray (models are then
+ * built in storage reused between calls). All results are written into caller-provided buffers. Reductions over entities are computed for each pose
+ * in the order of entity indices, so results do not depend on the number of threads or tile sizes.
+ */
+class ParallelEvaluator {
+public:
+	/// Default number of entities (humans or groups) in a single tile
+	static constexpr size_t TILE_ENTITIES_DEFAULT = 16;
+	/// Default number of poses in a single tile
+	static constexpr size_t TILE_POSES_DEFAULT = 256;
+
+	/// Operation applied to costs of all entities to obtain a single cost of a pose
+	using Reduction = CostReduction;
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param threads_num number of threads (including the calling one); 0 selects the number of hardware threads
+	 * @param tile_entities number of entities (rows of the cost matrix) in a single task
+	 * @param tile_poses number of poses (columns of the cost matrix) in a single task
+	 */
+	explicit ParallelEvaluator(
+		size_t threads_num = 0,
+		size_t tile_entities = TILE_ENTITIES_DEFAULT,
+		size_t tile_poses = TILE_POSES_DEFAULT
+	);
+
+	inline size_t getThreadsNum() const {
+		return pool_.getThreadsNum();
+	}
+
+	/**
+	 * @brief Computes personal space intrusion of each human at each pose
+	 *
+	 * @param scene scene with precomputed models of humans
+	 * @param poses_x x coordinates of the candidate poses
+	 * @param poses_y y coordinates of the candidate poses
+	 * @param poses_num number of candidate poses
+	 * @param costs row-major output matrix of size `scene.getHumansNum() * poses_num`, row per human
+	 * @param normalize see @ref PersonalSpaceIntrusion::normalize
+	 */
+	void computePersonalSpaceMatrix(
+		const SocialScene& scene,
+		const double* poses_x,
+		const double* poses_y,
+		size_t poses_num,
+		double* costs,
+		bool normalize = false
+	);
+
+	/// Computes reduction of personal space intrusions of all humans, @ref costs has @ref poses_num elements
+	void computePersonalSpaceReduced(
+		const SocialScene& scene,
+		const double* poses_x,
+		const double* poses_y,
+		size_t poses_num,
+		double* costs,
+		Reduction reduction = Reduction::SUM,
+		bool normalize = false
+	);
+
+	/// Computes formation space intrusion of each group at each pose, see @ref computePersonalSpaceMatrix
+	void computeFormationSpaceMatrix(
+		const SocialScene& scene,
+		const double* poses_x,
+		const double* poses_y,
+		size_t poses_num,
+		double* costs,
+		bool normalize = false
+	);
+
+	/// Computes reduction of formation space intrusions of all groups, @ref costs has @ref poses_num elements
+	void computeFormationSpaceReduced(
+		const SocialScene& scene,
+		const double* poses_x,
+		const double* poses_y,
+		size_t poses_num,
+		double* costs,
+		Reduction reduction = Reduction::SUM,
+		bool normalize = false
+	);
+
+	/**
+	 * @brief Computes personal space intrusion of each human of the array at each pose
+	 *
+	 * See @ref computePersonalSpaceMatrix for the remaining parameters
+	 *
+	 * @param humans states of humans, row `i` of @ref costs corresponds to the i-th human
+	 * @param unify_asymmetry_scale see @ref PersonalSpaceIntrusion::computePersonalSpaceGaussian
+	 */
+	void computePersonalSpaceMatrix(
+		const HumanArray& humans,
+		const double* poses_x,
+		const double* poses_y,
+		size_t poses_num,
+		double* costs,
+		bool normalize = false,
+		bool unify_asymmetry_scale = false
+	);
+
+	/// Computes reduction of personal space intrusions of all humans of the array, see @ref computePersonalSpaceMatrix
+	void computePersonalSpaceReduced(
+		const HumanArray& humans,
+		const double* poses_x,
+		const double* poses_y,
+		size_t poses_num,
+		double* costs,
+		Reduction reduction = Reduction::SUM,
+		bool normalize = false,
+		bool unify_asymmetry_scale = false
+	);
+
+	/// Computes formation space intrusion of each group of the array at each pose, see @ref computePersonalSpaceMatrix
+	void computeFormationSpaceMatrix(
+		const GroupArray& groups,
+		const double* poses_x,
+		const double* poses_y,
+		size_t poses_num,
+		double* costs,
+		bool normalize = false
+	);
+
+	/// Computes reduction of formation space intrusions of all groups of the array, see @ref computePersonalSpaceMatrix
+	void computeFormationSpaceReduced(
+		const GroupArray& groups,
+		const double* poses_x,
+		const double* poses_y,
+		size_t poses_num,
+		double* costs,
+		Reduction reduction = Reduction::SUM,
+		bool normalize = false
+	);
+
+protected:
+	/// Collects pointers to the models of the scene into @ref personal_space_ptrs_
+	void collectPersonalSpaceModels(const SocialScene& scene);
+
+	/// Collects pointers to the models of the scene into @ref formation_space_ptrs_
+	void collectFormationSpaceModels(const SocialScene& scene);
+
+	/// Builds the models into @ref personal_space_models_ and collects pointers to them
+	void buildPersonalSpaceModels(const HumanArray& humans, bool unify_asymmetry_scale);
+
+	/// Builds the models into @ref formation_space_models_ and collects pointers to them
+	void buildFormationSpaceModels(const GroupArray& groups);
+
+	/// Evaluates the cost matrix of the models given by @ref personal_space_ptrs_
+	void runPersonalSpaceMatrix(
+		const double* poses_x,
+		const double* poses_y,
+		size_t poses_num,
+		double* costs,
+		bool normalize
+	);
+
+	/// Evaluates the reduction of costs of the models given by @ref personal_space_ptrs_
+	void runPersonalSpaceReduced(
+		const double* poses_x,
+		const double* poses_y,
+		size_t poses_num,
+		double* costs,
+		Reduction reduction,
+		bool normalize
+	);
+
+	/// Evaluates the cost matrix of the models given by @ref formation_space_ptrs_
+	void runFormationSpaceMatrix(
+		const double* poses_x,
+		const double* poses_y,
+		size_t poses_num,
+		double* costs,
+		bool normalize
+	);
+
+	/// Evaluates the reduction of costs of the models given by @ref formation_space_ptrs_
+	void runFormationSpaceReduced(
+		const double* poses_x,
+		const double* poses_y,
+		size_t poses_num,
+		double* costs,
+		Reduction reduction,
+		bool normalize
+	);
+
+	/**
+	 * @brief Splits the (entities x poses) matrix into tiles and executes @ref fun for each of them
+	 *
+	 * @ref fun arguments: first entity, end entity, first pose, end pose
+	 */
+	template <typename Tfun>
+	void runTiles(size_t entities_num, size_t poses_num, size_t tile_entities, const Tfun& fun);
+
+	WorkStealingPool pool_;
+	size_t tile_entities_;
+	size_t tile_poses_;
+
+	// storage reused between calls
+	std::vector<PersonalSpaceModel> personal_space_models_;
+	std::vector<FormationSpaceModel> formation_space_models_;
+	std::vector<const PersonalSpaceModel*> personal_space_ptrs_;
+	std::vector<const FormationSpaceModel*> formation_space_ptrs_;
+};
+
+} // namespace social_nav_utils
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <social_nav_utils/trajectory_dataset.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace social_nav_utils {
+
+/**
+ * @brief Detects passings (closest approaches) of the robot and a single human while streaming over their trajectories
+ *
+ * Samples of both trajectories are processed one by one, in chronological order, and only the state of the current
+ * approach is kept, so the memory does not depend on the length of trajectories. Between consecutive samples,
+ * both agents are assumed to move linearly, thus the closest approach is found within the segment rather than
+ * at the samples only.
+ *
+ * The separation is tracked with a hysteresis: an approach ends once the separation grows by at least
+ * @ref Parameters::distance_hysteresis above its minimum, and the next one starts once the separation drops by
+ * the same value below its maximum. Each approach with the minimum separation not exceeding
+ * @ref Parameters::distance_max is reported as a single @ref Event, scored with @ref PassingSpeedComfort.
+ */
+class PassingEventDetector {
+public:
+	struct Parameters {
+		Parameters();
+
+		/// Approaches with a larger minimum separation [m] are not considered passings
+		double distance_max;
+		/// Change of the separation [m] that ends the approach (or the receding); filters out noise of trajectories
+		double distance_hysteresis;
+	};
+
+	/// State at the closest approach
+	struct Event {
+		double time = 0.0;
+		/// Separation of the robot and the human centers [m]
+		double distance = 0.0;
+		double robot_speed = 0.0;
+		/// See @ref PassingSpeedComfort::computeSpeedComfort
+		double comfort = 0.0;
+	};
+
+	explicit PassingEventDetector(const Parameters& params = Parameters());
+
+	/**
+	 * @brief Processes the next sample of trajectories
+	 *
+	 * @param time timestamp [s], must not be lower than the previous one
+	 * @param robot_x
+	 * @param robot_y
+	 * @param robot_vx
+	 * @param robot_vy
+	 * @param human_x
+	 * @param human_y
+	 * @return true if a passing was completed with this sample; it is available via @ref getEvent
+	 */
+	bool update(
+		double time,
+		double robot_x,
+		double robot_y,
+		double robot_vx,
+		double robot_vy,
+		double human_x,
+		double human_y
+	);
+
+	/**
+	 * @brief Ends the trajectories
+	 *
+	 * The pending approach is reported if its minimum was reached before the last sample (the separation has
+	 * already been growing) even though it has not grown by the hysteresis yet. The detector is reset afterwards.
+	 *
+	 * @return true if a passing was completed; it is available via @ref getEvent
+	 */
+	bool finish();
+
+	/// Forgets the state, so the next sample starts new trajectories
+	void reset();
+
+	/// Returns the last completed passing
+	inline const Event& getEvent() const {
+		return event_;
+	}
+
+	inline const Parameters& getParameters() const {
+		return params_;
+	}
+
+protected:
+	/// Finds the closest approach on the segment between the previous and the given sample
+	Event computeClosestApproach(
+		double time,
+		double rel_x,
+		double rel_y,
+		double robot_vx,
+		double robot_vy
+	) const;
+
+	/// Stores the minimum as the completed passing
+	void emit();
+
+	Parameters params_;
+
+	/// Whether any sample was processed since the reset
+	bool started_;
+	/// Whether the separation is expected to decrease (the minimum is tracked) or to increase (the maximum is tracked)
+	bool approaching_;
+	/// Closest approach of the current approach
+	Event min_;
+	/// Maximum separation while receding
+	double max_distance_;
+
+	/// Previous sample: time, relative position of the human and velocity of the robot
+	double prev_time_;
+	double prev_rel_x_;
+	double prev_rel_y_;
+	double prev_robot_vx_;
+	double prev_robot_vy_;
+	double prev_distance_;
+
+	Event event_;
+};
+
+/**
+ * @brief Detects passings of the robot and each agent of the episode
+ *
+ * Frames are processed in order with one @ref PassingEventDetector per agent, so the memory depends on the number
+ * of agents only. Trajectories of an agent that is missing in some frames are split into separate parts.
+ *
+ * @param episode episode of the dataset
+ * @param params parameters of detectors
+ * @param consumer called for each passing with the agent identifier, in order of completion
+ */
+void detectPassingEvents(
+	const TrajectoryEpisode& episode,
+	const PassingEventDetector::Parameters& params,
+	const std::function<void(int64_t, const PassingEventDetector::Event&)>& consumer
+);
+
+} // namespace social_nav_utils
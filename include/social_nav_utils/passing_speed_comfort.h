@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cmath>
+
 namespace social_nav_utils {
 
 /**
@@ -9,6 +11,11 @@ namespace social_nav_utils {
  */
 class PassingSpeedComfort {
 public:
+	/// Distance [m] up to which the comfort is given by @ref computeComfortClose
+	static constexpr double CLOSE_DIST_THRESHOLD = 0.6;
+	/// Distance [m] from which the comfort is given by @ref computeComfortFar
+	static constexpr double FAR_DIST_THRESHOLD = 0.8;
+
 	/**
 	 * @brief Constructor
 	 *
@@ -24,11 +31,43 @@ public:
 	/**
 	 * This method bases on results from:
 	 * Neggers et al. "The effect of robot speed on comfortable passing distances" (2022)
+	 *
+	 * Between @ref CLOSE_DIST_THRESHOLD and @ref FAR_DIST_THRESHOLD, outputs of the close and far models
+	 * are linearly blended. For many queries, see @ref PassingSpeedComfortTable.
 	 */
 	static double computeSpeedComfort(double distance, double robot_speed);
 
+	/// Fitted model of the comfort for close passing distances (up to @ref CLOSE_DIST_THRESHOLD)
+	static inline double computeComfortClose(double robot_speed) {
+		return computeExp2(6.023, -0.2822, -0.9639, -3.905, robot_speed);
+	}
+
+	/// Fitted model of the comfort for far passing distances (from @ref FAR_DIST_THRESHOLD)
+	static inline double computeComfortFar(double robot_speed) {
+		return computeExp2(8.385, -0.2633, -3.759, -2.304, robot_speed);
+	}
+
+	/**
+	 * @brief Returns weight of the close model in the blend of models
+	 *
+	 * 1 up to @ref CLOSE_DIST_THRESHOLD, then linearly decreasing to 0 at @ref FAR_DIST_THRESHOLD
+	 */
+	static inline double computeCloseWeight(double distance) {
+		double weight = (FAR_DIST_THRESHOLD - distance) / (FAR_DIST_THRESHOLD - CLOSE_DIST_THRESHOLD);
+		return weight < 0.0 ? 0.0 : (weight > 1.0 ? 1.0 : weight);
+	}
+
 protected:
+	/// Based on Matlab's `exp2` model
+	static inline double computeExp2(double a, double b, double c, double d, double x) {
+		return a * std::exp(b * x) + c * std::exp(d * x);
+	}
+
 	double comfort_;
 };
 
 } // namespace social_nav_utils
+
+#ifdef SOCIAL_NAV_UTILS_HEADER_ONLY
+#include <social_nav_utils/impl/passing_speed_comfort.h>
+#endif
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <social_nav_utils/passing_speed_comfort.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace social_nav_utils {
+
+/**
+ * @brief Lookup table of @ref PassingSpeedComfort::computeSpeedComfort over (distance, speed) with bilinear interpolation
+ *
+ * The comfort is constant w.r.t. the distance outside of the blending range and linear inside it, so the distance
+ * axis has nodes at @ref PassingSpeedComfort::CLOSE_DIST_THRESHOLD and @ref PassingSpeedComfort::FAR_DIST_THRESHOLD
+ * only (distances beyond them are clamped) and interpolation along this axis is exact. Along the speed axis,
+ * nodes are spaced uniformly by `h` in [0, @ref getSpeedMax]; speeds outside of the range (and NaN) are clamped.
+ *
+ * Interpolation error within the speed range does not exceed `h^2 / 8 * max|f''|`, where the second derivative
+ * of both fitted `exp2` models is bounded by `|a * b^2| + |c * d^2|` (20.5 for the far model), i.e., `2.6 * h^2`:
+ * 2.6e-04 for the default `h` of 0.01 m/s (comfort spans approx. 0-7). The actual maximum error is measured
+ * when the table is built, see @ref getMaxError.
+ */
+class PassingSpeedComfortTable {
+public:
+	static constexpr double SPEED_MAX_DEFAULT = 3.0;
+	static constexpr double SPEED_RESOLUTION_DEFAULT = 0.01;
+
+	/**
+	 * @brief Builds the table
+	 *
+	 * @param speed_max upper bound of the speed range [m/s]
+	 * @param speed_resolution spacing of speed nodes [m/s]
+	 */
+	explicit PassingSpeedComfortTable(
+		double speed_max = SPEED_MAX_DEFAULT,
+		double speed_resolution = SPEED_RESOLUTION_DEFAULT
+	);
+
+	/// Returns the table with default parameters, built once (at the first call)
+	static const PassingSpeedComfortTable& getDefault();
+
+	/// Approximates @ref PassingSpeedComfort::computeSpeedComfort
+	inline double evaluate(double distance, double robot_speed) const {
+		// NaN is mapped to 0 as well, so the index is always valid
+		double index = std::min(std::max(0.0, robot_speed), speed_max_) * speed_scale_;
+		// the last node repeats the previous one, so the speed_max_ itself maps to a valid cell
+		size_t cell = static_cast<size_t>(index);
+		double frac = index - static_cast<double>(cell);
+		double close = close_[cell] + frac * close_slope_[cell];
+		double far = far_[cell] + frac * far_slope_[cell];
+		return far + PassingSpeedComfort::computeCloseWeight(distance) * (close - far);
+	}
+
+	/**
+	 * @brief Batch version of @ref evaluate
+	 *
+	 * The loop is branch-free, so it is vectorized by the compiler (table lookups become gathers where available)
+	 *
+	 * @param distance distances between centers of the robot and the humans
+	 * @param robot_speed speeds of the robot
+	 * @param num number of queries
+	 * @param comfort output, @ref num elements
+	 */
+	void evaluate(const double* distance, const double* robot_speed, size_t num, double* comfort) const;
+
+	/// Maximum absolute difference from the analytic model measured at the construction (within the speed range)
+	inline double getMaxError() const {
+		return max_error_;
+	}
+
+	inline double getSpeedMax() const {
+		return speed_max_;
+	}
+
+	inline double getSpeedResolution() const {
+		return speed_resolution_;
+	}
+
+	/// Number of speed nodes
+	inline size_t getNodesNum() const {
+		return close_.size() - 1;
+	}
+
+protected:
+	double speed_max_;
+	double speed_resolution_;
+	/// Inverse of the @ref speed_resolution_
+	double speed_scale_;
+	/// Values of close/far models at speed nodes and differences to the next node (per cell)
+	std::vector<double> close_;
+	std::vector<double> close_slope_;
+	std::vector<double> far_;
+	std::vector<double> far_slope_;
+	double max_error_;
+};
+
+} // namespace social_nav_utils
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <social_nav_utils/gaussian_cutoff.h>
+
 namespace social_nav_utils {
 
 class PersonalSpaceIntrusion {
@@ -43,6 +45,12 @@ public:
 	 *
 	 * Includes pose uncertainty of the human
 	 *
+	 * Position uncertainty without correlation (`person_pos_cov_xy` and `person_pos_cov_yx` equal to 0, e.g.,
+	 * isotropic as reported by most trackers) is handled by an exact closed-form path, see
+	 * @ref computePersonalSpaceGaussianDiagonal. Hits are counted with the `PERSONAL_SPACE_ISOTROPIC`
+	 * and `PERSONAL_SPACE_DIAGONAL` counters. Correlated uncertainty assembles only the Gaussian selected
+	 * by the relative location as well.
+	 *
 	 * @param person_pos_x
 	 * @param person_pos_y
 	 * @param person_orient_yaw
@@ -74,7 +82,92 @@ public:
 		bool unify_asymmetry_scale = false
 	);
 
+	/**
+	 * @brief @ref computePersonalSpaceGaussian with a support cutoff, returns exact zero beyond it
+	 *
+	 * The k-sigma criterion is checked against the distance between the robot and the person before
+	 * any matrix is built. See @ref GaussianCutoff for the maximum error.
+	 */
+	static double computePersonalSpaceGaussian(
+		double person_pos_x,
+		double person_pos_y,
+		double person_orient_yaw,
+		double person_pos_cov_xx,
+		double person_pos_cov_xy,
+		double person_pos_cov_yx,
+		double person_pos_cov_yy,
+		double person_ps_var_front,
+		double person_ps_var_rear,
+		double person_ps_var_side,
+		double robot_pos_x,
+		double robot_pos_y,
+		bool unify_asymmetry_scale,
+		const GaussianCutoff& cutoff
+	);
+
+	/**
+	 * @brief Computes a natural logarithm of @ref computePersonalSpaceGaussian (log-density)
+	 *
+	 * Handy when costs are summed in the log domain, as `exp` is not evaluated at all
+	 */
+	static double computePersonalSpaceGaussianLog(
+		double person_pos_x,
+		double person_pos_y,
+		double person_orient_yaw,
+		double person_pos_cov_xx,
+		double person_pos_cov_xy,
+		double person_pos_cov_yx,
+		double person_pos_cov_yy,
+		double person_ps_var_front,
+		double person_ps_var_rear,
+		double person_ps_var_side,
+		double robot_pos_x,
+		double robot_pos_y,
+		bool unify_asymmetry_scale = false
+	);
+
+	/**
+	 * @brief Computes a squared Mahalanobis distance of the robot from the person according to the Gaussian
+	 * selected in @ref computePersonalSpaceGaussian (i.e., the scale of the asymmetry is not included)
+	 */
+	static double computePersonalSpaceMahalanobisSquared(
+		double person_pos_x,
+		double person_pos_y,
+		double person_orient_yaw,
+		double person_pos_cov_xx,
+		double person_pos_cov_xy,
+		double person_pos_cov_yx,
+		double person_pos_cov_yy,
+		double person_ps_var_front,
+		double person_ps_var_rear,
+		double person_ps_var_side,
+		double robot_pos_x,
+		double robot_pos_y
+	);
+
 protected:
+	/**
+	 * @brief Closed-form @ref computePersonalSpaceGaussian for a diagonal covariance of the position uncertainty
+	 *
+	 * With isotropic uncertainty (`person_pos_cov_xx == person_pos_cov_yy`), the summed covariance is diagonal
+	 * in the person's frame, so the quadratic form is evaluated there directly. Otherwise, the summed covariance
+	 * is assembled elementwise and inverted in closed form. Both paths are exact; neither rotation matrices nor
+	 * a @ref PersonalSpaceModel are constructed and only the Gaussian selected by the relative location is computed.
+	 */
+	static double computePersonalSpaceGaussianDiagonal(
+		double person_pos_x,
+		double person_pos_y,
+		double person_orient_yaw,
+		double person_pos_cov_xx,
+		double person_pos_cov_yy,
+		double person_ps_var_front,
+		double person_ps_var_rear,
+		double person_ps_var_side,
+		double robot_pos_x,
+		double robot_pos_y,
+		bool unify_asymmetry_scale
+	);
+
 	double intrusion_scale_;
 
 	double person_pos_x_;
@@ -93,3 +186,7 @@ protected:
 };
 
 } // namespace social_nav_utils
+
+#ifdef SOCIAL_NAV_UTILS_HEADER_ONLY
+#include <social_nav_utils/impl/personal_space_intrusion.h>
+#endif
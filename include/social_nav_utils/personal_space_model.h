@@ -0,0 +1,131 @@
+#pragma once
+
+#include <social_nav_utils/gaussian_model.h>
+#include <social_nav_utils/relative_location.h>
+
+#include <cmath>
+
+namespace social_nav_utils {
+
+/**
+ * @brief Precomputed model of the personal space of a single person
+ *
+ * Stores everything that depends only on the person - rotated and summed covariance matrices (front and rear),
+ * their inverses and the heading unit vector. Evaluation at a given position of the robot is equivalent
+ * to @ref PersonalSpaceIntrusion::computePersonalSpaceGaussian.
+ */
+class PersonalSpaceModel {
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * For parameters description, refer to the @ref PersonalSpaceIntrusion::computePersonalSpaceGaussian
+	 */
+	PersonalSpaceModel(
+		double person_pos_x,
+		double person_pos_y,
+		double person_orient_yaw,
+		double person_pos_cov_xx,
+		double person_pos_cov_xy,
+		double person_pos_cov_yx,
+		double person_pos_cov_yy,
+		double person_ps_var_front,
+		double person_ps_var_rear,
+		double person_ps_var_side,
+		bool unify_asymmetry_scale = false
+	);
+
+	/// Computes value of a Gaussian modelling the personal space at the given position of the robot
+	inline double evaluate(double robot_pos_x, double robot_pos_y) const {
+		if (rel_loc_.isFront(robot_pos_x, robot_pos_y)) {
+			return scale_front_ * gaussian_front_.evaluate(robot_pos_x, robot_pos_y);
+		}
+		return scale_rear_ * gaussian_rear_.evaluate(robot_pos_x, robot_pos_y);
+	}
+
+	/// Computes value of a Gaussian modelling the personal space, exact zero beyond the @ref cutoff
+	inline double evaluate(double robot_pos_x, double robot_pos_y, const GaussianCutoff& cutoff) const {
+		if (rel_loc_.isFront(robot_pos_x, robot_pos_y)) {
+			return gaussian_front_.evaluateScaled(robot_pos_x, robot_pos_y, cutoff, scale_front_);
+		}
+		return gaussian_rear_.evaluateScaled(robot_pos_x, robot_pos_y, cutoff, scale_rear_);
+	}
+
+	/// Computes a natural logarithm of @ref evaluate (log-density); a single `log` of the scaled peak
+	inline double evaluateLog(double robot_pos_x, double robot_pos_y) const {
+		if (rel_loc_.isFront(robot_pos_x, robot_pos_y)) {
+			return std::log(scale_front_ * gaussian_front_.getNormalization())
+				- 0.5 * gaussian_front_.computeQuadraticForm(robot_pos_x, robot_pos_y);
+		}
+		return std::log(scale_rear_ * gaussian_rear_.getNormalization())
+			- 0.5 * gaussian_rear_.computeQuadraticForm(robot_pos_x, robot_pos_y);
+	}
+
+	/// Computes a squared Mahalanobis distance of the robot from the person (w.r.t. the Gaussian selected by the location)
+	inline double computeMahalanobisSquared(double robot_pos_x, double robot_pos_y) const {
+		if (rel_loc_.isFront(robot_pos_x, robot_pos_y)) {
+			return gaussian_front_.computeQuadraticForm(robot_pos_x, robot_pos_y);
+		}
+		return gaussian_rear_.computeQuadraticForm(robot_pos_x, robot_pos_y);
+	}
+
+	/**
+	 * Returns the worst case value for the current arrangement, i.e., the value at the person's position
+	 *
+	 * Equivalent to the value used in @ref PersonalSpaceIntrusion::normalize
+	 */
+	inline double getMax() const {
+		return scale_front_ * gaussian_front_.getNormalization();
+	}
+
+	/// Returns a logarithm of @ref getMax
+	inline double getMaxLog() const {
+		return std::log(getMax());
+	}
+
+	inline double getPositionX() const {
+		return gaussian_front_.getMeanX();
+	}
+
+	inline double getPositionY() const {
+		return gaussian_front_.getMeanY();
+	}
+
+	inline const RelativeLocationClassifier& getClassifier() const {
+		return rel_loc_;
+	}
+
+	/// Returns Gaussian evaluated when the robot is located in front of the person
+	inline const GaussianModel& getGaussianFront() const {
+		return gaussian_front_;
+	}
+
+	/// Returns Gaussian evaluated when the robot is located behind the person
+	inline const GaussianModel& getGaussianRear() const {
+		return gaussian_rear_;
+	}
+
+	/// Returns multiplier of the @ref getGaussianFront values
+	inline double getScaleFront() const {
+		return scale_front_;
+	}
+
+	/// Returns multiplier of the @ref getGaussianRear values
+	inline double getScaleRear() const {
+		return scale_rear_;
+	}
+
+protected:
+	RelativeLocationClassifier rel_loc_;
+	GaussianModel gaussian_front_;
+	GaussianModel gaussian_rear_;
+	/// Adjusts scale of the output to avoid a step when front/rear covariances strongly differ
+	double scale_front_;
+	double scale_rear_;
+};
+
+} // namespace social_nav_utils
+
+#ifdef SOCIAL_NAV_UTILS_HEADER_ONLY
+#include <social_nav_utils/impl/personal_space_model.h>
+#endif
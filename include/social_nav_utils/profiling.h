@@ -0,0 +1,169 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace social_nav_utils {
+
+/// Library entry points whose latency is measured
+enum class ProfiledFunction : size_t {
+	PERSONAL_SPACE_INTRUSION = 0,
+	PERSONAL_SPACE_INTRUSION_NORMALIZE,
+	PERSONAL_SPACE_GAUSSIAN,
+	FORMATION_SPACE_INTRUSION,
+	FORMATION_SPACE_INTRUSION_NORMALIZE,
+	FORMATION_SPACE_GAUSSIAN,
+	HEADING_DIRECTION_DISTURBANCE,
+	HEADING_DIRECTION_DISTURBANCE_NORMALIZE,
+	HEADING_DIRECTION_DIRECTION,
+	HEADING_DIRECTION_FOV,
+	HEADING_DIRECTION_SPEED,
+	HEADING_DIRECTION_DIST,
+	PASSING_SPEED_COMFORT,
+	PASSING_SPEED_COMFORT_COMPUTE,
+	ELLIPSE_FITTING,
+	/// Number of functions, not a function itself
+	FUNCTIONS_NUM
+};
+
+/**
+ * @brief Lock-free latency histogram with logarithmic buckets, similar to HDR histograms
+ *
+ * Values below @ref LINEAR_BUCKETS nanoseconds are stored exactly. Larger values are stored in buckets
+ * whose width is 1/16 of the power of 2 they belong to, so the relative error of percentiles is below 1/16.
+ * Multiple threads may record values concurrently.
+ */
+class LatencyHistogram {
+public:
+	static constexpr size_t LINEAR_BUCKETS = 32;
+	static constexpr size_t SUB_BUCKETS = 16;
+	static constexpr size_t BUCKETS_NUM = LINEAR_BUCKETS + (64 - 5) * SUB_BUCKETS;
+
+	LatencyHistogram();
+
+	/// Records a single latency measurement [ns]
+	void record(uint64_t nanoseconds);
+
+	/// Removes all measurements; should not be called concurrently with @ref record
+	void reset();
+
+	uint64_t getCount() const;
+
+	/// Returns minimum recorded latency [ns] (0 if empty)
+	uint64_t getMin() const;
+
+	/// Returns maximum recorded latency [ns]
+	uint64_t getMax() const;
+
+	/// Returns mean latency [ns] (0 if empty)
+	double getMean() const;
+
+	/**
+	 * @brief Returns latency [ns] below which @ref percentile percent of measurements fall
+	 *
+	 * @param percentile value in range [0, 100]
+	 */
+	uint64_t getPercentile(double percentile) const;
+
+	/// Maps latency to the bucket index
+	static size_t toBucket(uint64_t nanoseconds);
+
+	/// Returns the highest latency that is stored in the bucket
+	static uint64_t fromBucket(size_t bucket);
+
+protected:
+	std::array<std::atomic<uint64_t>, BUCKETS_NUM> buckets_;
+	std::atomic<uint64_t> count_;
+	std::atomic<uint64_t> sum_;
+	std::atomic<uint64_t> min_;
+	std::atomic<uint64_t> max_;
+};
+
+/**
+ * @brief Collects latencies of library entry points and, optionally, per-frame Chrome traces
+ *
+ * Latencies are recorded by @ref ScopedTimer objects placed in the library code with
+ * the @ref SOCIAL_NAV_UTILS_PROFILE_SCOPE macro. The macro compiles to nothing unless
+ * `SOCIAL_NAV_UTILS_ENABLE_PROFILING` is defined (see the CMake option of the same name).
+ *
+ * Tracing: after @ref enableTrace, events recorded between @ref startFrame and @ref finishFrame are written
+ * to a JSON file in the Chrome trace event format (to be opened with chrome://tracing or Perfetto).
+ */
+class Profiler {
+public:
+	static constexpr size_t FUNCTIONS_NUM = static_cast<size_t>(ProfiledFunction::FUNCTIONS_NUM);
+
+	static LatencyHistogram& getHistogram(ProfiledFunction function);
+
+	/// Returns a human-readable name of the function
+	static const char* getName(ProfiledFunction function);
+
+	/// Removes measurements from all histograms
+	static void reset();
+
+	/// Returns a table with count, mean, p50, p99 and max latencies of all functions that were called
+	static std::string getReport();
+
+	/// Enables tracing; trace files are named `frame_<number>.json` and stored in @ref output_directory
+	static void enableTrace(const std::string& output_directory);
+
+	static void disableTrace();
+
+	static bool isTraceEnabled();
+
+	/// Drops trace events collected so far and starts a new frame
+	static void startFrame();
+
+	/**
+	 * @brief Writes trace events collected since @ref startFrame into a file
+	 *
+	 * @return false if tracing is disabled or the file could not be written
+	 */
+	static bool finishFrame();
+
+	/// Returns path of the file written by the last successful @ref finishFrame
+	static std::string getLastTracePath();
+
+	/// Records a single measurement; used by @ref ScopedTimer
+	static void record(
+		ProfiledFunction function,
+		std::chrono::steady_clock::time_point start,
+		std::chrono::steady_clock::time_point end
+	);
+};
+
+/// Measures time elapsed between construction and destruction and records it in the @ref Profiler
+class ScopedTimer {
+public:
+	explicit ScopedTimer(ProfiledFunction function):
+		function_(function),
+		start_(std::chrono::steady_clock::now())
+	{}
+
+	~ScopedTimer() {
+		Profiler::record(function_, start_, std::chrono::steady_clock::now());
+	}
+
+	ScopedTimer(const ScopedTimer&) = delete;
+	ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+protected:
+	ProfiledFunction function_;
+	std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace social_nav_utils
+
+#ifdef SOCIAL_NAV_UTILS_ENABLE_PROFILING
+/// Measures latency of the enclosing scope as the @ref ProfiledFunction
+#define SOCIAL_NAV_UTILS_PROFILE_SCOPE(function) \
+	::social_nav_utils::ScopedTimer social_nav_utils_scoped_timer_( \
+		::social_nav_utils::ProfiledFunction::function \
+	)
+#else
+#define SOCIAL_NAV_UTILS_PROFILE_SCOPE(function) ((void)0)
+#endif
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace social_nav_utils {
+
+/// Types of library calls stored in the binary log
+enum class RecordType : uint8_t {
+	/// Inputs: arguments of @ref PersonalSpaceIntrusion::computePersonalSpaceGaussian (bool as 0/1), output: Gaussian
+	PERSONAL_SPACE_GAUSSIAN = 0,
+	/// Inputs: arguments of @ref FormationSpaceIntrusion::computeFormationSpaceGaussian, output: Gaussian
+	FORMATION_SPACE_GAUSSIAN,
+	/// Inputs: arguments of @ref HeadingDirectionDisturbance::computeDirectionDisturbance, output: scale
+	HEADING_DIRECTION_DIRECTION,
+	/// Inputs: arguments of @ref HeadingDirectionDisturbance::computeFovScale, output: scale
+	HEADING_DIRECTION_FOV,
+	/// Inputs: arguments of @ref HeadingDirectionDisturbance::computeSpeedScale, output: scale
+	HEADING_DIRECTION_SPEED,
+	/// Inputs: arguments of @ref HeadingDirectionDisturbance::computeDistScale, output: scale
+	HEADING_DIRECTION_DIST,
+	/// Inputs: arguments of @ref PassingSpeedComfort::computeSpeedComfort, output: comfort
+	PASSING_SPEED_COMFORT,
+	/// Inputs: x coordinates followed by y coordinates, outputs: 5 ellipse parameters and fallback flag (0/1)
+	ELLIPSE_FITTING,
+	/// Number of types, not a type itself
+	TYPES_NUM
+};
+
+/// Single call of a library function
+struct Record {
+	RecordType type;
+	std::vector<double> inputs;
+	std::vector<double> outputs;
+};
+
+/**
+ * @brief Writes inputs and outputs of library calls into a compact binary log
+ *
+ * Layout of the file: 8-byte magic (@ref MAGIC) followed by records. Each record consists of the type (1 byte),
+ * number of inputs and outputs (4 bytes each), then inputs and outputs stored as doubles. Native byte order is used.
+ *
+ * Library functions record their calls only when compiled with `SOCIAL_NAV_UTILS_ENABLE_RECORDING`
+ * (see the CMake option of the same name) and after @ref start was called. Calls from multiple threads are
+ * serialized in the order of their completion.
+ */
+class Recorder {
+public:
+	static constexpr char MAGIC[9] = "SNUREC01";
+
+	/// Starts recording to the file (truncates it), returns false if the file could not be opened
+	static bool start(const std::string& path);
+
+	/**
+	 * @brief Flushes and closes the log
+	 *
+	 * @return false if any record could not be written (e.g., the disk is full) or the log could not be closed;
+	 * the log is incomplete then, recording stops at the first failed write
+	 */
+	static bool stop();
+
+	static bool isActive();
+
+	/// Appends a record to the log if recording is active
+	static void write(RecordType type, const std::vector<double>& inputs, const std::vector<double>& outputs);
+
+	/// @ref write overload for the fixed number of arguments
+	static void write(RecordType type, std::initializer_list<double> inputs, std::initializer_list<double> outputs);
+};
+
+/// Sequentially reads records from a binary log written by @ref Recorder
+class RecordReader {
+public:
+	/// Opens the log, throws std::runtime_error if the file does not exist or is not a valid log
+	explicit RecordReader(const std::string& path);
+
+	~RecordReader();
+
+	RecordReader(const RecordReader&) = delete;
+	RecordReader& operator=(const RecordReader&) = delete;
+
+	/**
+	 * @brief Reads the next record, returns false at the end of the log
+	 *
+	 * Throws std::runtime_error if the log is truncated or the numbers of values do not match the record type
+	 */
+	bool next(Record& record);
+
+protected:
+	std::FILE* file_;
+	/// Size of the log file [B]
+	long size_;
+};
+
+/**
+ * @brief Executes the library function described by the record with its recorded inputs
+ *
+ * @param record call to replay
+ * @param outputs values computed by the current build, in the same layout as @ref Record::outputs
+ */
+void replayRecord(const Record& record, std::vector<double>& outputs);
+
+/// Returns a human-readable name of the record type
+const char* getRecordTypeName(RecordType type);
+
+} // namespace social_nav_utils
+
+#ifdef SOCIAL_NAV_UTILS_ENABLE_RECORDING
+/// Records a library call that returns a single value @ref output; remaining arguments are inputs of the call
+#define SOCIAL_NAV_UTILS_RECORD(type, output, ...) \
+	do { \
+		if (::social_nav_utils::Recorder::isActive()) { \
+			::social_nav_utils::Recorder::write(::social_nav_utils::RecordType::type, {__VA_ARGS__}, {output}); \
+		} \
+	} while (false)
+#else
+#define SOCIAL_NAV_UTILS_RECORD(type, output, ...) ((void)0)
+#endif
@@ -4,6 +4,10 @@
 
 #include <angles/angles.h>
 
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
 namespace social_nav_utils {
 
 /**
@@ -34,11 +38,79 @@ public:
 
 	/// @brief Check whether 'other' object is located in front of the ego compared to yaw (direction) of the ego
 	inline bool isFront() const {
-		return std::abs(getAngle() <= M_PI_2);
+		return std::abs(getAngle()) <= M_PI_2;
 	}
 
 protected:
 	double rel_loc_angle_;
 };
 
+/**
+ * @brief Trigonometry-free counterpart of @ref RelativeLocation
+ *
+ * The heading unit vector of the 'ego' is computed once, in the constructor. Then, each classification of 'other'
+ * costs a single dot product (front/rear) and a single cross product (left/right), instead of `atan2` and
+ * angle normalization. Results are consistent with @ref RelativeLocation::isFront and
+ * @ref RelativeLocation::isLeftSide.
+ */
+class RelativeLocationClassifier {
+public:
+	/// Bit set in the classification mask when 'other' is located in front of the ego
+	static constexpr uint8_t MASK_FRONT = 0x01;
+	/// Bit set in the classification mask when 'other' is located on the left side of the ego
+	static constexpr uint8_t MASK_LEFT = 0x02;
+
+	RelativeLocationClassifier(double x_ego, double y_ego, double yaw_ego):
+		x_ego_(x_ego),
+		y_ego_(y_ego),
+		heading_x_(std::cos(yaw_ego)),
+		heading_y_(std::sin(yaw_ego))
+	{}
+
+	/// Returns x component of the ego's heading unit vector, i.e., cosine of ego's yaw
+	inline double getHeadingX() const {
+		return heading_x_;
+	}
+
+	/// Returns y component of the ego's heading unit vector, i.e., sine of ego's yaw
+	inline double getHeadingY() const {
+		return heading_y_;
+	}
+
+	/// @brief Check whether 'other' object is located in front of the ego compared to yaw (direction) of the ego
+	inline bool isFront(double x_other, double y_other) const {
+		return ((x_other - x_ego_) * heading_x_ + (y_other - y_ego_) * heading_y_) >= 0.0;
+	}
+
+	/// @brief Check whether 'other' object is located on the left side compared to yaw (direction) of ego
+	inline bool isLeftSide(double x_other, double y_other) const {
+		return (heading_x_ * (y_other - y_ego_) - heading_y_ * (x_other - x_ego_)) >= 0.0;
+	}
+
+	/// Returns a mask composed of @ref MASK_FRONT and @ref MASK_LEFT bits describing location of the 'other'
+	inline uint8_t classify(double x_other, double y_other) const {
+		return (isFront(x_other, y_other) ? MASK_FRONT : 0) | (isLeftSide(x_other, y_other) ? MASK_LEFT : 0);
+	}
+
+	/**
+	 * @brief Batch version of @ref classify
+	 *
+	 * @param x_other x coordinates of the 'other' objects
+	 * @param y_other y coordinates of the 'other' objects
+	 * @param num number of 'other' objects
+	 * @param masks output, @ref num masks of consecutive 'other' objects
+	 */
+	void classify(const double* x_other, const double* y_other, size_t num, uint8_t* masks) const {
+		for (size_t i = 0; i < num; i++) {
+			masks[i] = classify(x_other[i], y_other[i]);
+		}
+	}
+
+protected:
+	double x_ego_;
+	double y_ego_;
+	double heading_x_;
+	double heading_y_;
+};
+
 } // namespace social_nav_utils
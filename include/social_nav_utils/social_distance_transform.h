@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace social_nav_utils {
+
+/**
+ * @brief Cost-to-go (weighted distance) field to a goal over a grid of social costs, e.g., for global planner heuristics
+ *
+ * Each cell has a traversal cost of `1 + social_weight * cost`, where `cost` is taken from a grid of social costs
+ * (e.g., rasterized personal and O-space intrusions, see @ref KernelStampCache, @ref AsymmetricGaussianModel
+ * or @ref CostVolume); cells whose cost reaches @ref Parameters::lethal_cost are not traversable. Moving between
+ * 8-connected neighbors costs the length of the move times the mean traversal cost of both cells, so the field
+ * is the exact shortest path distance (the same as Dijkstra's algorithm gives).
+ *
+ * @ref compute evaluates the field with raster sweeps (Gauss-Seidel iterations of the Bellman equation)
+ * alternating forward and backward orders. Each sweep streams through rows and relaxes each cell from its 4
+ * neighbors already visited in that order, so no priority queue is needed; sweeps are repeated until none
+ * of them changes the field, which takes a few sweeps unless the costs form a maze.
+ *
+ * @ref update repairs the field after the costs have changed within a rectangle only (e.g., the union of boxes
+ * around old and new positions of humans who moved): cells whose shortest paths pass through the rectangle
+ * are invalidated and recomputed from the valid boundary with a local Dijkstra's wavefront, so the cost
+ * of the repair depends on the affected area instead of the whole grid.
+ */
+class SocialDistanceTransform {
+public:
+	struct Parameters {
+		Parameters();
+
+		/// Size of a cell [m]
+		double resolution;
+		/// Multiplier of social costs in the traversal cost of a cell
+		double social_weight;
+		/// Cells with the social cost not lower than this value (or NaN) are not traversable
+		double lethal_cost;
+		/// Upper bound of the number of sweeps of @ref compute; the field is an upper bound of distances if reached
+		size_t sweeps_max;
+	};
+
+	/**
+	 * @brief Constructor; allocates the storage
+	 *
+	 * @param width number of columns of the grid
+	 * @param height number of rows of the grid
+	 * @param params parameters
+	 */
+	SocialDistanceTransform(size_t width, size_t height, const Parameters& params = Parameters());
+
+	/**
+	 * @brief Computes the field from scratch
+	 *
+	 * @param costs row-major grid of social costs, `width * height` elements; cell (col, row) at `row * width + col`
+	 * @param goal_col column of the goal cell
+	 * @param goal_row row of the goal cell
+	 */
+	void compute(const double* costs, size_t goal_col, size_t goal_row);
+
+	/**
+	 * @brief Repairs the field after the costs have changed within the rectangle of cells
+	 *
+	 * Cells outside of the rectangle must have the same costs as in the previous call. The storage of the
+	 * wavefront is reused, so repairs of extents seen before do not allocate.
+	 *
+	 * @param costs row-major grid of social costs (see @ref compute)
+	 * @param col_begin first column of the rectangle
+	 * @param row_begin first row of the rectangle
+	 * @param col_end end (exclusive) column of the rectangle
+	 * @param row_end end (exclusive) row of the rectangle
+	 */
+	void update(const double* costs, size_t col_begin, size_t row_begin, size_t col_end, size_t row_end);
+
+	/// Returns the cost-to-go from the cell to the goal; infinity if the goal cannot be reached
+	inline double getDistance(size_t col, size_t row) const {
+		return distances_[row * width_ + col];
+	}
+
+	/// Returns the row-major field
+	inline const double* getDistances() const {
+		return distances_.data();
+	}
+
+	inline size_t getWidth() const {
+		return width_;
+	}
+
+	inline size_t getHeight() const {
+		return height_;
+	}
+
+	/// Number of sweeps performed by the last @ref compute
+	inline size_t getSweepsNum() const {
+		return sweeps_num_;
+	}
+
+	/// Number of cells invalidated by the last @ref update
+	inline size_t getRepairedNum() const {
+		return repaired_num_;
+	}
+
+	inline const Parameters& getParameters() const {
+		return params_;
+	}
+
+protected:
+	/// Marks cells without a parent (the goal, unreachable cells)
+	static constexpr uint8_t NO_PARENT = 8;
+
+	/// Entry of the wavefront of @ref update
+	struct Front {
+		double distance;
+		size_t cell;
+
+		inline bool operator>(const Front& other) const {
+			return distance > other.distance;
+		}
+	};
+
+	/// Half of the cost of crossing the cell along its side (infinity if not traversable)
+	double computeHalfCost(double cost) const;
+
+	/// Relaxes each cell from its W, NW, N and NE neighbors in the raster order; returns true if any cell changed
+	bool sweepForward();
+
+	/// Relaxes each cell from its E, SE, S and SW neighbors in the reversed raster order; returns true if any cell changed
+	bool sweepBackward();
+
+	/// Stores the direction towards the neighbor giving the distance of each cell
+	void computeParents();
+
+	Parameters params_;
+	size_t width_;
+	size_t height_;
+	size_t goal_;
+	size_t sweeps_num_;
+	size_t repaired_num_;
+
+	std::vector<double> distances_;
+	std::vector<double> half_costs_;
+	/// Index of the direction (see `DIRECTIONS` in the source) towards the next cell of the shortest path
+	std::vector<uint8_t> parents_;
+
+	// storage of update reused between calls
+	std::vector<size_t> invalidated_;
+	std::vector<Front> front_;
+};
+
+} // namespace social_nav_utils
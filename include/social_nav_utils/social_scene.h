@@ -0,0 +1,197 @@
+#pragma once
+
+#include <social_nav_utils/formation_space_model.h>
+#include <social_nav_utils/gaussian_model.h>
+#include <social_nav_utils/heading_direction_disturbance.h>
+#include <social_nav_utils/memory_arena.h>
+#include <social_nav_utils/personal_space_model.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace social_nav_utils {
+
+// forward declarations due to a circular dependency (see entity_arrays.h)
+class HumanArray;
+class GroupArray;
+
+/**
+ * @brief Per-frame context that ingests all humans, groups and the robot state once and precomputes per-entity models
+ *
+ * All cost functions of this package take raw arguments and recompute person-specific terms (e.g., rotated
+ * covariance matrices) on each call. The scene computes them once per frame so multiple consumers (planners, critics)
+ * may query metrics at the cost of evaluation only.
+ *
+ * Typical usage: @ref clear at the beginning of the frame, then @ref setRobot, @ref addHuman and @ref addGroup
+ * (or @ref addHumans and @ref addGroups for whole crowds), then any number of queries. Storage is reused between
+ * frames.
+ */
+class SocialScene {
+public:
+	/// State of the robot
+	struct RobotState {
+		double x = 0.0;
+		double y = 0.0;
+		double yaw = 0.0;
+		double vx = 0.0;
+		double vy = 0.0;
+		/// Used for normalization of the heading direction disturbance
+		double circumradius = HeadingDirectionDisturbance::CIRCUMRADIUS_DEFAULT;
+		/// Used for normalization of the heading direction disturbance
+		double max_speed = HeadingDirectionDisturbance::MAX_SPEED_DEFAULT;
+	};
+
+	/// State of a human
+	struct HumanState {
+		double x = 0.0;
+		double y = 0.0;
+		double yaw = 0.0;
+		double vx = 0.0;
+		double vy = 0.0;
+		/// Position covariance expressed in the global coordinate system
+		double cov_xx = 0.0;
+		double cov_xy = 0.0;
+		double cov_yy = 0.0;
+		/// Personal space model's variance along the front direction of a person
+		double ps_var_front = 0.0;
+		/// Personal space model's variance along the rear direction of a person
+		double ps_var_rear = 0.0;
+		/// Personal space model's variance along the direction of person side
+		double ps_var_side = 0.0;
+		double occupancy_radius = HeadingDirectionDisturbance::OCCUPANCY_MODEL_RADIUS_DEFAULT;
+		double fov = HeadingDirectionDisturbance::FOV_DEFAULT;
+	};
+
+	/// State of an F-formation's O-space
+	struct GroupState {
+		double x = 0.0;
+		double y = 0.0;
+		double orientation = 0.0;
+		double variance_x = 0.0;
+		double variance_y = 0.0;
+		/// Uncertainty of the O-space center position
+		double cov_xx = 0.0;
+		double cov_xy = 0.0;
+		double cov_yy = 0.0;
+	};
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param unify_asymmetry_scale see @ref PersonalSpaceIntrusion::computePersonalSpaceGaussian
+	 */
+	SocialScene(bool unify_asymmetry_scale = false);
+
+	/// Removes all entities (keeps allocated storage) and rewinds the arena of temporaries; robot state remains untouched
+	void clear();
+
+	void setRobot(const RobotState& robot);
+
+	/// Adds a human to the scene, returns its index
+	size_t addHuman(const HumanState& human);
+
+	/// Adds a group given by the O-space parameters, returns its index
+	size_t addGroup(const GroupState& group);
+
+	/// Adds all humans of the array (in order), returns the index of the first one
+	size_t addHumans(const HumanArray& humans);
+
+	/// Adds all groups of the array (in order), returns the index of the first one
+	size_t addGroups(const GroupArray& groups);
+
+	/**
+	 * @brief Adds a group whose O-space is fitted to the positions of its members, returns group index
+	 *
+	 * O-space is fitted with @ref EllipseFitting, then variances are obtained according to the 2-sigma rule
+	 * applied to the semi-axes. Temporaries of the fitting are taken from the scene's arena that is rewound
+	 * by @ref clear.
+	 */
+	size_t addGroup(
+		const std::vector<double>& members_x,
+		const std::vector<double>& members_y,
+		double pos_center_variance_xx,
+		double pos_center_variance_xyyx,
+		double pos_center_variance_yy
+	);
+
+	inline size_t getHumansNum() const {
+		return humans_.size();
+	}
+
+	inline size_t getGroupsNum() const {
+		return groups_.size();
+	}
+
+	inline const RobotState& getRobot() const {
+		return robot_;
+	}
+
+	inline const HumanState& getHuman(size_t human) const {
+		return humans_.at(human).state;
+	}
+
+	inline const GroupState& getGroup(size_t group) const {
+		return groups_.at(group).state;
+	}
+
+	inline const PersonalSpaceModel& getPersonalSpaceModel(size_t human) const {
+		return humans_.at(human).personal_space;
+	}
+
+	inline const FormationSpaceModel& getFormationSpaceModel(size_t group) const {
+		return groups_.at(group).formation_space;
+	}
+
+	/// Equivalent to @ref PersonalSpaceIntrusion::getScale (optionally, after @ref PersonalSpaceIntrusion::normalize)
+	double computePersonalSpaceIntrusion(size_t human, double x, double y, bool normalize = false) const;
+
+	/// Personal space intrusion evaluated at the robot position
+	double computePersonalSpaceIntrusion(size_t human, bool normalize = false) const;
+
+	/// Equivalent to @ref FormationSpaceIntrusion::getScale (optionally, after @ref FormationSpaceIntrusion::normalize)
+	double computeFormationSpaceIntrusion(size_t group, double x, double y, bool normalize = false) const;
+
+	/// Formation space intrusion evaluated at the robot position
+	double computeFormationSpaceIntrusion(size_t group, bool normalize = false) const;
+
+	/**
+	 * @brief Equivalent to @ref HeadingDirectionDisturbance::getScale of the given human disturbed by the robot
+	 *
+	 * With @ref normalize, robot's circumradius and maximum speed from @ref RobotState are used. The maximum
+	 * of the direction factor is taken directly from the precomputed Gaussian.
+	 */
+	double computeHeadingDirectionDisturbance(size_t human, bool normalize = false) const;
+
+	/// Equivalent to @ref PassingSpeedComfort::getComfort for the current distance and speed of the robot
+	double computePassingSpeedComfort(size_t human) const;
+
+protected:
+	struct HumanEntry {
+		HumanState state;
+		PersonalSpaceModel personal_space;
+		/// Gaussian of the direction factor of the heading direction disturbance
+		GaussianModel direction;
+		/// FOV factor for the 'other' located along the sight axis
+		double fov_scale_max;
+	};
+
+	struct GroupEntry {
+		GroupState state;
+		FormationSpaceModel formation_space;
+	};
+
+	bool unify_asymmetry_scale_;
+
+	RobotState robot_;
+	std::vector<HumanEntry> humans_;
+	std::vector<GroupEntry> groups_;
+
+	/// Temporaries of a single frame (e.g., ellipse fitting buffers)
+	MemoryArena arena_;
+};
+
+} // namespace social_nav_utils
+
+#ifdef SOCIAL_NAV_UTILS_HEADER_ONLY
+#include <social_nav_utils/impl/social_scene.h>
+#endif
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <social_nav_utils/formation_space_model.h>
+#include <social_nav_utils/personal_space_model.h>
+
+#include <cstddef>
+
+/// Number of entity models kept in a block that stays in registers/L1 cache (compile-time tunable)
+#ifndef SOCIAL_NAV_UTILS_KERNEL_TILE_ENTITIES
+#define SOCIAL_NAV_UTILS_KERNEL_TILE_ENTITIES 8
+#endif
+
+/// Number of poses streamed through a block of entity models (compile-time tunable)
+#ifndef SOCIAL_NAV_UTILS_KERNEL_TILE_POSES
+#define SOCIAL_NAV_UTILS_KERNEL_TILE_POSES 128
+#endif
+
+namespace social_nav_utils {
+
+/// Operation applied to costs of all entities to obtain a single cost of a pose
+enum class CostReduction {
+	SUM,
+	MAX
+};
+
+/**
+ * @brief Cache-blocked kernels evaluating dense (entities x poses) cost matrices
+ *
+ * Parameters of a block of @ref TILE_ENTITIES models are packed into a structure-of-arrays that stays
+ * in registers/L1 cache while a block of @ref TILE_POSES poses is streamed through it.
+ * Reductions visit entities in the order of their indices, so the results are equal to the plain sequential loop.
+ */
+class TiledKernel {
+public:
+	static constexpr size_t TILE_ENTITIES = SOCIAL_NAV_UTILS_KERNEL_TILE_ENTITIES;
+	static constexpr size_t TILE_POSES = SOCIAL_NAV_UTILS_KERNEL_TILE_POSES;
+
+	/**
+	 * @brief Computes personal space intrusions of each model at each pose
+	 *
+	 * @param models pointers to models of humans
+	 * @param models_num number of models
+	 * @param poses_x x coordinates of the poses
+	 * @param poses_y y coordinates of the poses
+	 * @param poses_num number of poses
+	 * @param costs output matrix, cost of i-th model at j-th pose is stored at `costs[i * costs_stride + j]`
+	 * @param costs_stride distance between consecutive rows of the output matrix
+	 * @param normalize see @ref PersonalSpaceIntrusion::normalize
+	 */
+	static void fillPersonalSpace(
+		const PersonalSpaceModel* const* models,
+		size_t models_num,
+		const double* poses_x,
+		const double* poses_y,
+		size_t poses_num,
+		double* costs,
+		size_t costs_stride,
+		bool normalize = false
+	);
+
+	/// Computes reduction of personal space intrusions of all models at each pose, @ref costs has @ref poses_num elements
+	static void reducePersonalSpace(
+		const PersonalSpaceModel* const* models,
+		size_t models_num,
+		const double* poses_x,
+		const double* poses_y,
+		size_t poses_num,
+		double* costs,
+		CostReduction reduction = CostReduction::SUM,
+		bool normalize = false
+	);
+
+	/// Computes formation space intrusions of each model at each pose, see @ref fillPersonalSpace
+	static void fillFormationSpace(
+		const FormationSpaceModel* const* models,
+		size_t models_num,
+		const double* poses_x,
+		const double* poses_y,
+		size_t poses_num,
+		double* costs,
+		size_t costs_stride,
+		bool normalize = false
+	);
+
+	/// Computes reduction of formation space intrusions of all models at each pose, see @ref reducePersonalSpace
+	static void reduceFormationSpace(
+		const FormationSpaceModel* const* models,
+		size_t models_num,
+		const double* poses_x,
+		const double* poses_y,
+		size_t poses_num,
+		double* costs,
+		CostReduction reduction = CostReduction::SUM,
+		bool normalize = false
+	);
+};
+
+} // namespace social_nav_utils
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace social_nav_utils {
+
+/**
+ * @brief Read-only view of a single episode stored in a @ref TrajectoryDataset
+ *
+ * Data are stored column-wise. Frame columns have @ref frames_num elements, agent columns have @ref agents_rows_num
+ * elements. Agents observed in frame `f` occupy rows [agents_begin[f], agents_begin[f + 1]).
+ */
+struct TrajectoryEpisode {
+	int64_t id = 0;
+	size_t frames_num = 0;
+	size_t agents_rows_num = 0;
+
+	/// Timestamps of frames [s]
+	const double* time = nullptr;
+	const double* robot_x = nullptr;
+	const double* robot_y = nullptr;
+	const double* robot_yaw = nullptr;
+	const double* robot_vx = nullptr;
+	const double* robot_vy = nullptr;
+	/// Index of the first agent row of each frame; has `frames_num + 1` elements
+	const uint64_t* agents_begin = nullptr;
+
+	const int64_t* agent_id = nullptr;
+	const double* agent_x = nullptr;
+	const double* agent_y = nullptr;
+	const double* agent_yaw = nullptr;
+	const double* agent_vx = nullptr;
+	const double* agent_vy = nullptr;
+	/// Identifier of the F-formation the agent belongs to, @ref TrajectoryDataset::NO_GROUP if none
+	const int64_t* agent_group = nullptr;
+};
+
+/**
+ * @brief Columnar, memory-mapped file of multi-agent trajectories (humans observed by a robot)
+ *
+ * File layout (native byte order, all sections aligned to 8 bytes):
+ * - magic (@ref MAGIC),
+ * - episode blocks; each block stores frame columns followed by agent columns (see @ref TrajectoryEpisode),
+ * - episode index: one entry {offset, id, frames_num, agents_rows_num} per episode,
+ * - number of episodes (uint64) and magic again.
+ *
+ * The file is mapped into memory and episodes are accessed in place, so the dataset does not have to fit
+ * into RAM; pages of already processed episodes may be dropped with @ref releaseEpisode.
+ */
+class TrajectoryDataset {
+public:
+	static constexpr char MAGIC[9] = "SNUTRJ01";
+	static constexpr int64_t NO_GROUP = -1;
+
+	/// Maps the file into memory, throws std::runtime_error if it could not be mapped or is not a valid dataset
+	explicit TrajectoryDataset(const std::string& path);
+
+	~TrajectoryDataset();
+
+	TrajectoryDataset(const TrajectoryDataset&) = delete;
+	TrajectoryDataset& operator=(const TrajectoryDataset&) = delete;
+
+	inline size_t getEpisodesNum() const {
+		return index_num_;
+	}
+
+	/// Returns a view of the episode; valid as long as the dataset exists
+	TrajectoryEpisode getEpisode(size_t episode) const;
+
+	/// Hints the kernel that pages of the episode are no longer needed (they are read again from the file on access)
+	void releaseEpisode(size_t episode) const;
+
+protected:
+	struct IndexEntry {
+		uint64_t offset;
+		int64_t id;
+		uint64_t frames_num;
+		uint64_t agents_rows_num;
+	};
+
+	/// Returns the size of the episode block in bytes
+	static size_t computeBlockSize(size_t frames_num, size_t agents_rows_num);
+
+	friend class TrajectoryDatasetWriter;
+
+	const uint8_t* data_;
+	size_t size_;
+	const IndexEntry* index_;
+	size_t index_num_;
+};
+
+/**
+ * @brief Writes a @ref TrajectoryDataset file episode by episode
+ *
+ * Only the episode being written is kept in memory. Frames must be added in chronological order.
+ */
+class TrajectoryDatasetWriter {
+public:
+	/// Robot state in a frame
+	struct RobotSample {
+		double x = 0.0;
+		double y = 0.0;
+		double yaw = 0.0;
+		double vx = 0.0;
+		double vy = 0.0;
+	};
+
+	/// Agent state in a frame
+	struct AgentSample {
+		int64_t id = 0;
+		double x = 0.0;
+		double y = 0.0;
+		double yaw = 0.0;
+		double vx = 0.0;
+		double vy = 0.0;
+		int64_t group = TrajectoryDataset::NO_GROUP;
+	};
+
+	/// Creates the file (truncates it), throws std::runtime_error if it could not be opened
+	explicit TrajectoryDatasetWriter(const std::string& path);
+
+	/// Calls @ref close; errors are ignored, call @ref close explicitly to detect them
+	~TrajectoryDatasetWriter();
+
+	TrajectoryDatasetWriter(const TrajectoryDatasetWriter&) = delete;
+	TrajectoryDatasetWriter& operator=(const TrajectoryDatasetWriter&) = delete;
+
+	/// Finishes the previous episode (if any) and starts a new one; throws std::runtime_error if a write fails
+	void beginEpisode(int64_t id);
+
+	/// Appends a frame to the current episode; throws std::logic_error if no episode was started
+	void addFrame(double time, const RobotSample& robot, const std::vector<AgentSample>& agents);
+
+	/**
+	 * @brief Writes the current episode, the index and the footer; the writer cannot be used afterwards
+	 *
+	 * Throws std::runtime_error if a write or closing the file fails (e.g., the disk is full); the file is
+	 * closed and incomplete then.
+	 */
+	void close();
+
+protected:
+	/// Writes the current episode block to the file
+	void flushEpisode();
+
+	/// Writes the data to the file; closes it and throws std::runtime_error if the write fails
+	void write(const void* data, size_t size, size_t count);
+
+	std::string path_;
+	std::FILE* file_;
+	uint64_t offset_;
+	bool episode_open_;
+	std::vector<TrajectoryDataset::IndexEntry> index_;
+
+	int64_t episode_id_;
+	std::vector<double> time_;
+	std::vector<RobotSample> robot_;
+	std::vector<uint64_t> agents_begin_;
+	std::vector<AgentSample> agents_;
+};
+
+} // namespace social_nav_utils
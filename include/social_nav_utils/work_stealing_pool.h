@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace social_nav_utils {
+
+/**
+ * @brief Minimal thread pool that executes batches of indexed tasks with work stealing
+ *
+ * Tasks of a batch are distributed evenly among per-worker queues. Each worker takes tasks from the front
+ * of its own queue and, once it is empty, steals from the back of the other queues. The calling thread
+ * participates in the computations as one of the workers.
+ */
+class WorkStealingPool {
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param threads_num total number of threads executing tasks (including the calling thread);
+	 * 0 selects the number of hardware threads
+	 */
+	explicit WorkStealingPool(size_t threads_num = 0);
+
+	~WorkStealingPool();
+
+	WorkStealingPool(const WorkStealingPool&) = delete;
+	WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+	/// Returns total number of threads executing tasks (including the calling thread)
+	inline size_t getThreadsNum() const {
+		return queues_.size();
+	}
+
+	/**
+	 * @brief Executes @ref fun for each task index in [0, tasks_num) and blocks until all tasks are finished
+	 *
+	 * Order of execution is not specified. The first exception thrown by a task is rethrown in the calling thread.
+	 */
+	void run(size_t tasks_num, const std::function<void(size_t)>& fun);
+
+protected:
+	struct TaskQueue {
+		std::mutex mutex;
+		std::deque<size_t> tasks;
+	};
+
+	/// Loop of a spawned thread
+	void work(size_t worker);
+
+	/// Executes tasks until all queues are empty
+	void process(size_t worker);
+
+	/// Takes a task from the own queue of @ref worker or steals one from another queue
+	bool pop(size_t worker, size_t& task);
+
+	std::vector<std::unique_ptr<TaskQueue>> queues_;
+	std::vector<std::thread> threads_;
+
+	std::mutex mutex_;
+	std::condition_variable cv_start_;
+	std::condition_variable cv_done_;
+	size_t generation_;
+	bool stop_;
+
+	const std::function<void(size_t)>* fun_;
+	std::atomic<size_t> pending_;
+	std::exception_ptr exception_;
+};
+
+} // namespace social_nav_utils
@@ -0,0 +1,198 @@
+#include <social_nav_utils/cost_volume.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace social_nav_utils {
+
+namespace {
+
+/// Computes half extents of the bounding box of the k-sigma ellipse of the Gaussian
+void computeHalfExtents(const GaussianModel& gaussian, double sigmas, double& half_extent_x, double& half_extent_y) {
+	// diagonal of the covariance matrix recovered from its inverse
+	Matrix2d cov_inv = gaussian.getCovarianceInverse();
+	double det_inv = cov_inv.determinant();
+	half_extent_x = sigmas * std::sqrt(cov_inv(1, 1) / det_inv);
+	half_extent_y = sigmas * std::sqrt(cov_inv(0, 0) / det_inv);
+}
+
+} // namespace
+
+CostVolume::Parameters::Parameters():
+	origin_x(0.0),
+	origin_y(0.0),
+	resolution(0.05),
+	width(200),
+	height(200),
+	dt(0.1),
+	slices_num(51),
+	cov_growth_xx(0.0),
+	cov_growth_xy(0.0),
+	cov_growth_yy(0.0),
+	sigmas(3.0),
+	unify_asymmetry_scale(false),
+	reduction(CostReduction::MAX),
+	encoding(Encoding::UINT8)
+{}
+
+CostVolume::CostVolume(const Parameters& params):
+	params_(params),
+	cutoff_(GaussianCutoff::fromSigmas(params.sigmas)),
+	cells_num_(params.width * params.height)
+{
+	if (!(params.resolution > 0.0 && params.dt >= 0.0 && params.sigmas > 0.0)
+		|| params.width == 0
+		|| params.height == 0
+		|| params.slices_num == 0
+	) {
+		throw std::invalid_argument("Invalid parameters of the cost volume");
+	}
+	size_t cell_size = params.encoding == Encoding::UINT8 ? sizeof(uint8_t) : sizeof(uint16_t);
+	// each slice begins at a cache line
+	slice_stride_ = (cells_num_ * cell_size + BATCH_ALIGNMENT - 1) / BATCH_ALIGNMENT * BATCH_ALIGNMENT;
+	data_.assign(slice_stride_ * params.slices_num, 0);
+	groups_layer_.assign(cells_num_, 0.0f);
+	slice_layer_.assign(cells_num_, 0.0f);
+}
+
+void CostVolume::rasterize(const HumanArray& humans, const GroupArray& groups) {
+	double half_extent_x = 0.0;
+	double half_extent_y = 0.0;
+
+	// static groups are rasterized once
+	std::fill(groups_layer_.begin(), groups_layer_.end(), 0.0f);
+	for (size_t g = 0; g < groups.size(); g++) {
+		FormationSpaceModel model(
+			groups.x()[g],
+			groups.y()[g],
+			groups.orientation()[g],
+			groups.varianceX()[g],
+			groups.varianceY()[g],
+			groups.covXX()[g],
+			groups.covXY()[g],
+			groups.covYY()[g]
+		);
+		computeHalfExtents(model.getGaussian(), params_.sigmas, half_extent_x, half_extent_y);
+		CellRange range = computeCellRange(groups.x()[g], groups.y()[g], half_extent_x, half_extent_y);
+		rasterizeModel(model, range, groups_layer_.data());
+	}
+
+	for (size_t k = 0; k < params_.slices_num; k++) {
+		const double time = k * params_.dt;
+		const double growth_xx = params_.cov_growth_xx * time;
+		const double growth_xy = params_.cov_growth_xy * time;
+		const double growth_yy = params_.cov_growth_yy * time;
+		std::copy(groups_layer_.begin(), groups_layer_.end(), slice_layer_.begin());
+
+		for (size_t i = 0; i < humans.size(); i++) {
+			double x = humans.x()[i] + humans.vx()[i] * time;
+			double y = humans.y()[i] + humans.vy()[i] * time;
+			PersonalSpaceModel model(
+				x,
+				y,
+				humans.yaw()[i],
+				humans.covXX()[i] + growth_xx,
+				humans.covXY()[i] + growth_xy,
+				humans.covXY()[i] + growth_xy,
+				humans.covYY()[i] + growth_yy,
+				humans.psVarFront()[i],
+				humans.psVarRear()[i],
+				humans.psVarSide()[i],
+				params_.unify_asymmetry_scale
+			);
+			// the box covers both the front and the rear Gaussian
+			double front_x = 0.0;
+			double front_y = 0.0;
+			computeHalfExtents(model.getGaussianFront(), params_.sigmas, front_x, front_y);
+			computeHalfExtents(model.getGaussianRear(), params_.sigmas, half_extent_x, half_extent_y);
+			CellRange range = computeCellRange(
+				x,
+				y,
+				std::max(front_x, half_extent_x),
+				std::max(front_y, half_extent_y)
+			);
+			rasterizeModel(model, range, slice_layer_.data());
+		}
+		encodeSlice(slice_layer_.data(), k);
+	}
+}
+
+double CostVolume::getCost(size_t slice, size_t row, size_t col) const {
+	if (slice >= params_.slices_num || row >= params_.height || col >= params_.width) {
+		throw std::out_of_range("Cell of the cost volume out of range");
+	}
+	size_t cell = row * params_.width + col;
+	if (params_.encoding == Encoding::UINT8) {
+		return getSliceUint8(slice)[cell] / 255.0;
+	}
+	return decodeHalf(getSliceHalf(slice)[cell]);
+}
+
+const uint8_t* CostVolume::getSliceUint8(size_t slice) const {
+	if (params_.encoding != Encoding::UINT8) {
+		return nullptr;
+	}
+	return data_.data() + slice * slice_stride_;
+}
+
+const uint16_t* CostVolume::getSliceHalf(size_t slice) const {
+	if (params_.encoding != Encoding::HALF) {
+		return nullptr;
+	}
+	// slices are aligned to a cache line
+	return reinterpret_cast<const uint16_t*>(data_.data() + slice * slice_stride_);
+}
+
+CostVolume::CellRange CostVolume::computeCellRange(
+	double x,
+	double y,
+	double half_extent_x,
+	double half_extent_y
+) const {
+	// cells whose centers lie within the box; NaN (e.g., of a human without a position) yields an empty range
+	const double scale = 1.0 / params_.resolution;
+	const double width = static_cast<double>(params_.width);
+	const double height = static_cast<double>(params_.height);
+	double col_begin = std::ceil((x - half_extent_x - params_.origin_x) * scale - 0.5);
+	double col_end = std::floor((x + half_extent_x - params_.origin_x) * scale - 0.5) + 1.0;
+	double row_begin = std::ceil((y - half_extent_y - params_.origin_y) * scale - 0.5);
+	double row_end = std::floor((y + half_extent_y - params_.origin_y) * scale - 0.5) + 1.0;
+	CellRange range;
+	range.col_begin = static_cast<size_t>(std::fmin(std::fmax(col_begin, 0.0), width));
+	range.col_end = static_cast<size_t>(std::fmin(std::fmax(col_end, 0.0), width));
+	range.row_begin = static_cast<size_t>(std::fmin(std::fmax(row_begin, 0.0), height));
+	range.row_end = static_cast<size_t>(std::fmin(std::fmax(row_end, 0.0), height));
+	return range;
+}
+
+template <typename Tmodel>
+void CostVolume::rasterizeModel(const Tmodel& model, const CellRange& range, float* layer) const {
+	const double scale = 1.0 / model.getMax();
+	const bool sum = params_.reduction == CostReduction::SUM;
+	for (size_t row = range.row_begin; row < range.row_end; row++) {
+		const double y = params_.origin_y + (row + 0.5) * params_.resolution;
+		float* output = layer + row * params_.width;
+		for (size_t col = range.col_begin; col < range.col_end; col++) {
+			const double x = params_.origin_x + (col + 0.5) * params_.resolution;
+			float cost = static_cast<float>(scale * model.evaluate(x, y, cutoff_));
+			output[col] = sum ? output[col] + cost : std::max(output[col], cost);
+		}
+	}
+}
+
+void CostVolume::encodeSlice(const float* layer, size_t slice) {
+	uint8_t* data = data_.data() + slice * slice_stride_;
+	if (params_.encoding == Encoding::UINT8) {
+		for (size_t i = 0; i < cells_num_; i++) {
+			data[i] = static_cast<uint8_t>(std::min(layer[i], 1.0f) * 255.0f + 0.5f);
+		}
+		return;
+	}
+	uint16_t* data_half = reinterpret_cast<uint16_t*>(data);
+	for (size_t i = 0; i < cells_num_; i++) {
+		data_half[i] = encodeHalf(layer[i]);
+	}
+}
+
+} // namespace social_nav_utils
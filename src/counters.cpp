@@ -0,0 +1,111 @@
+#include <social_nav_utils/counters.h>
+
+#include <mutex>
+#include <set>
+
+namespace social_nav_utils {
+
+namespace {
+
+/// Collects counters of all threads
+struct CountersRegistry {
+	std::mutex mutex;
+	std::set<const std::array<std::atomic<uint64_t>, Counters::EVENTS_NUM>*> threads;
+	/// Values accumulated by threads that already finished
+	Counters::Snapshot retired{};
+	/// Values subtracted from the aggregate (set on reset)
+	Counters::Snapshot offset{};
+};
+
+CountersRegistry& getRegistry() {
+	// never destroyed, so thread-local counters may unregister at any stage of the program termination
+	static CountersRegistry* registry = new CountersRegistry();
+	return *registry;
+}
+
+Counters::Snapshot sumUp(CountersRegistry& registry) {
+	Counters::Snapshot sum = registry.retired;
+	for (const auto* values: registry.threads) {
+		for (size_t i = 0; i < Counters::EVENTS_NUM; i++) {
+			sum[i] += (*values)[i].load(std::memory_order_relaxed);
+		}
+	}
+	return sum;
+}
+
+} // namespace
+
+Counters::ThreadCounters::ThreadCounters() {
+	for (auto& value: values) {
+		value.store(0, std::memory_order_relaxed);
+	}
+	auto& registry = getRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	registry.threads.insert(&values);
+}
+
+Counters::ThreadCounters::~ThreadCounters() {
+	auto& registry = getRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	for (size_t i = 0; i < EVENTS_NUM; i++) {
+		registry.retired[i] += values[i].load(std::memory_order_relaxed);
+	}
+	registry.threads.erase(&values);
+}
+
+Counters::Snapshot Counters::aggregate() {
+	auto& registry = getRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	Snapshot sum = sumUp(registry);
+	for (size_t i = 0; i < EVENTS_NUM; i++) {
+		sum[i] -= registry.offset[i];
+	}
+	return sum;
+}
+
+uint64_t Counters::aggregate(CounterEvent event) {
+	return aggregate()[static_cast<size_t>(event)];
+}
+
+void Counters::reset() {
+	auto& registry = getRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	registry.offset = sumUp(registry);
+}
+
+const char* Counters::getName(CounterEvent event) {
+	switch (event) {
+		case CounterEvent::PERSONAL_SPACE_CALLS:
+			return "personal_space_calls";
+		case CounterEvent::FORMATION_SPACE_CALLS:
+			return "formation_space_calls";
+		case CounterEvent::HEADING_DIRECTION_CALLS:
+			return "heading_direction_calls";
+		case CounterEvent::PASSING_SPEED_COMFORT_CALLS:
+			return "passing_speed_comfort_calls";
+		case CounterEvent::ELLIPSE_FITTING_CALLS:
+			return "ellipse_fitting_calls";
+		case CounterEvent::ELLIPSE_FITTING_FALLBACK:
+			return "ellipse_fitting_fallback";
+		case CounterEvent::LINES_INTERSECTION_CALLS:
+			return "lines_intersection_calls";
+		case CounterEvent::LINES_INTERSECTION_NAN:
+			return "lines_intersection_nan";
+		case CounterEvent::MATRIX_INVERSE_NEAR_SINGULAR:
+			return "matrix_inverse_near_singular";
+		case CounterEvent::GAUSSIAN_CUTOFF:
+			return "gaussian_cutoff";
+		case CounterEvent::PERSONAL_SPACE_ISOTROPIC:
+			return "personal_space_isotropic";
+		case CounterEvent::PERSONAL_SPACE_DIAGONAL:
+			return "personal_space_diagonal";
+		case CounterEvent::FORMATION_SPACE_ISOTROPIC:
+			return "formation_space_isotropic";
+		case CounterEvent::FORMATION_SPACE_DIAGONAL:
+			return "formation_space_diagonal";
+		default:
+			return "unknown";
+	}
+}
+
+} // namespace social_nav_utils
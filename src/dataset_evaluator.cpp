@@ -0,0 +1,157 @@
+#include <social_nav_utils/dataset_evaluator.h>
+#include <social_nav_utils/entity_arrays.h>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace social_nav_utils {
+
+DatasetEvaluator::Parameters::Parameters():
+	group_cov_xx(0.0),
+	group_cov_xy(0.0),
+	group_cov_yy(0.0),
+	unify_asymmetry_scale(false)
+{
+	human.ps_var_front = 3.00;
+	human.ps_var_rear = 0.75;
+	human.ps_var_side = 1.33;
+}
+
+void DatasetEvaluator::Summary::add(double sample) {
+	samples++;
+	if (samples == 1) {
+		mean = sample;
+		min = sample;
+		max = sample;
+		return;
+	}
+	// incremental mean does not depend on the magnitude of the sum
+	mean += (sample - mean) / samples;
+	min = std::min(min, sample);
+	max = std::max(max, sample);
+}
+
+DatasetEvaluator::DatasetEvaluator(const Parameters& params, size_t threads_num):
+	params_(params),
+	pool_(threads_num)
+{}
+
+DatasetEvaluator::EpisodeMetrics DatasetEvaluator::evaluateEpisode(const TrajectoryEpisode& episode) const {
+	EpisodeMetrics metrics;
+	metrics.id = episode.id;
+	metrics.frames_num = episode.frames_num;
+
+	SocialScene scene(params_.unify_asymmetry_scale);
+	HumanArray humans;
+	// pairs of group identifier and agent row
+	std::vector<std::pair<int64_t, size_t>> group_rows;
+	std::vector<double> members_x;
+	std::vector<double> members_y;
+
+	for (size_t f = 0; f < episode.frames_num; f++) {
+		scene.clear();
+
+		SocialScene::RobotState robot = params_.robot;
+		robot.x = episode.robot_x[f];
+		robot.y = episode.robot_y[f];
+		robot.yaw = episode.robot_yaw[f];
+		robot.vx = episode.robot_vx[f];
+		robot.vy = episode.robot_vy[f];
+		scene.setRobot(robot);
+
+		// columns of the dataset are copied directly into the template-filled array
+		size_t rows_begin = episode.agents_begin[f];
+		size_t rows_end = episode.agents_begin[f + 1];
+		humans.resize(rows_end - rows_begin);
+		humans.fill(params_.human);
+		std::copy(episode.agent_x + rows_begin, episode.agent_x + rows_end, humans.x());
+		std::copy(episode.agent_y + rows_begin, episode.agent_y + rows_end, humans.y());
+		std::copy(episode.agent_yaw + rows_begin, episode.agent_yaw + rows_end, humans.yaw());
+		std::copy(episode.agent_vx + rows_begin, episode.agent_vx + rows_end, humans.vx());
+		std::copy(episode.agent_vy + rows_begin, episode.agent_vy + rows_end, humans.vy());
+		scene.addHumans(humans);
+
+		group_rows.clear();
+		for (size_t r = rows_begin; r < rows_end; r++) {
+			if (episode.agent_group[r] != TrajectoryDataset::NO_GROUP) {
+				group_rows.emplace_back(episode.agent_group[r], r);
+			}
+		}
+
+		// agents sharing the identifier form a group once there are at least 2 of them
+		std::sort(group_rows.begin(), group_rows.end());
+		for (size_t begin = 0; begin < group_rows.size(); ) {
+			size_t end = begin;
+			members_x.clear();
+			members_y.clear();
+			while (end < group_rows.size() && group_rows[end].first == group_rows[begin].first) {
+				members_x.push_back(episode.agent_x[group_rows[end].second]);
+				members_y.push_back(episode.agent_y[group_rows[end].second]);
+				end++;
+			}
+			if (members_x.size() >= 2) {
+				scene.addGroup(members_x, members_y, params_.group_cov_xx, params_.group_cov_xy, params_.group_cov_yy);
+			}
+			begin = end;
+		}
+
+		if (scene.getHumansNum() > 0) {
+			double psi_max = 0.0;
+			double hdd_max = 0.0;
+			size_t closest = 0;
+			double closest_dist = std::numeric_limits<double>::infinity();
+			for (size_t i = 0; i < scene.getHumansNum(); i++) {
+				psi_max = std::max(psi_max, scene.computePersonalSpaceIntrusion(i, true));
+				hdd_max = std::max(hdd_max, scene.computeHeadingDirectionDisturbance(i, true));
+				const auto& human = scene.getHuman(i);
+				double dist = std::hypot(human.x - robot.x, human.y - robot.y);
+				if (dist < closest_dist) {
+					closest_dist = dist;
+					closest = i;
+				}
+			}
+			metrics.personal_space.add(psi_max);
+			metrics.heading_direction.add(hdd_max);
+			metrics.passing_comfort.add(scene.computePassingSpeedComfort(closest));
+		}
+
+		if (scene.getGroupsNum() > 0) {
+			double fsi_max = 0.0;
+			for (size_t g = 0; g < scene.getGroupsNum(); g++) {
+				fsi_max = std::max(fsi_max, scene.computeFormationSpaceIntrusion(g, true));
+			}
+			metrics.formation_space.add(fsi_max);
+		}
+	}
+
+	detectPassingEvents(
+		episode,
+		params_.passing,
+		[&metrics](int64_t /* agent_id */, const PassingEventDetector::Event& event) {
+			metrics.passing_events.add(event.comfort);
+		}
+	);
+	return metrics;
+}
+
+void DatasetEvaluator::evaluate(
+	const TrajectoryDataset& dataset,
+	const std::function<void(const EpisodeMetrics&)>& consumer
+) {
+	std::vector<EpisodeMetrics> results(BATCH_EPISODES);
+	for (size_t first = 0; first < dataset.getEpisodesNum(); first += BATCH_EPISODES) {
+		size_t batch_size = std::min(BATCH_EPISODES, dataset.getEpisodesNum() - first);
+		pool_.run(batch_size, [&](size_t task) {
+			size_t episode = first + task;
+			results[task] = evaluateEpisode(dataset.getEpisode(episode));
+			dataset.releaseEpisode(episode);
+		});
+		for (size_t i = 0; i < batch_size; i++) {
+			consumer(results[i]);
+		}
+	}
+}
+
+} // namespace social_nav_utils
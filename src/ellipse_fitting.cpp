@@ -1,4 +1,7 @@
 #include <social_nav_utils/ellipse_fitting.h>
+#include <social_nav_utils/counters.h>
+#include <social_nav_utils/profiling.h>
+#include <social_nav_utils/recording.h>
 
 #include<eigen3/Eigen/Eigenvalues>
 
@@ -11,71 +14,78 @@
 
 namespace social_nav_utils {
 
-// This structure is used to store a point
-// Reference: https://github.com/gopiraj15/OpenCV-journey/blob/master/TaubinEllipseFit.cpp#L13
-struct Point2d {
-	//the cooridinates of the point
-	double x, y;
-	//A constructor to store the point
-	Point2d(double nx, double ny) :x(nx), y(ny){}
-	Point2d() :x(0.0), y(0.0){}
-};
-
-EllipseFitting::EllipseFitting(const std::vector<double>& x, const std::vector<double>& y):
+EllipseFitting::EllipseFitting(
+	const std::vector<double>& x,
+	const std::vector<double>& y,
+	std::pmr::memory_resource* memory
+):
 	params_{NAN},
 	fallback_(false)
 {
 	assert(!x.empty());
 	assert(!y.empty());
 	assert(x.size() == y.size());
+	SOCIAL_NAV_UTILS_PROFILE_SCOPE(ELLIPSE_FITTING);
+	SOCIAL_NAV_UTILS_COUNT(ELLIPSE_FITTING_CALLS);
 
 	// primitive case
 	if (x.size() == 1) {
 		fitFallbackSingle(x.at(0), y.at(0));
-		return;
+	} else if (!fitTaubin(x, y, memory)) {
+		fitFallbackMultiple(x, y, memory);
 	}
-
-	if (fitTaubin(x, y)) {
-		return;
+	SOCIAL_NAV_UTILS_COUNT_IF(fallback_, ELLIPSE_FITTING_FALLBACK);
+
+#ifdef SOCIAL_NAV_UTILS_ENABLE_RECORDING
+	if (Recorder::isActive()) {
+		std::vector<double> inputs(x);
+		inputs.insert(inputs.end(), y.cbegin(), y.cend());
+		std::vector<double> outputs(params_.cbegin(), params_.cend());
+		outputs.push_back(fallback_ ? 1.0 : 0.0);
+		Recorder::write(RecordType::ELLIPSE_FITTING, inputs, outputs);
 	}
-
-	fitFallbackMultiple(x, y);
+#endif
 }
 
 // a.k.a. EllipseFitbyTaubin
 // Reference: https://github.com/gopiraj15/OpenCV-journey/blob/master/TaubinEllipseFit.cpp#L82
-bool EllipseFitting::fitTaubin(const std::vector<double>& x, const std::vector<double>& y) {
-	// prepare inputs
-	std::vector<Point2d> pts;
-	for (size_t i = 0; i < x.size(); i++) {
-		pts.emplace_back(x.at(i), y.at(i));
-	}
+bool EllipseFitting::fitTaubin(
+	const std::vector<double>& x,
+	const std::vector<double>& y,
+	std::pmr::memory_resource* memory
+) {
+	// matrices whose size depends on the number of points are mapped onto the memory resource,
+	// all others have fixed sizes and live on the stack
+	typedef Eigen::Matrix<double, Eigen::Dynamic, 1> ColumnDyn;
+	typedef Eigen::Matrix<double, Eigen::Dynamic, 6, Eigen::ColMajor> Matrix6Dyn;
+	const size_t pts_num = x.size();
+	std::pmr::vector<double> storage(8 * pts_num, memory);
 
 	// compute, external code
 
-	Eigen::MatrixXd A = Eigen::MatrixXd::Constant(6, 1, 0);
+	Eigen::Matrix<double, 6, 1> A = Eigen::Matrix<double, 6, 1>::Zero();
 
-	Eigen::MatrixXd Xm = Eigen::MatrixXd::Constant(pts.size(), 1, 0);
-	Eigen::MatrixXd Ym = Eigen::MatrixXd::Constant(pts.size(), 1, 0);
+	Eigen::Map<ColumnDyn> Xm(storage.data(), pts_num);
+	Eigen::Map<ColumnDyn> Ym(storage.data() + pts_num, pts_num);
 
-	for (int i = 0; i < pts.size(); i++)
+	for (int i = 0; i < pts_num; i++)
 	{
-		Xm(i, 0) = pts[i].x;
-		Ym(i, 0) = pts[i].y;
+		Xm(i, 0) = x[i];
+		Ym(i, 0) = y[i];
 	}
 
 	double meanx = 0, meany = 0;
-	for (int i = 0; i < pts.size(); i++)
+	for (int i = 0; i < pts_num; i++)
 	{
 		meanx += Xm(i, 0);
 		meany += Ym(i, 0);
 	}
-	meanx /= pts.size();
-	meany /= pts.size();
+	meanx /= pts_num;
+	meany /= pts_num;
 
-	Eigen::MatrixXd Zm = Eigen::MatrixXd::Constant(pts.size(), 6, 0);
+	Eigen::Map<Matrix6Dyn> Zm(storage.data() + 2 * pts_num, pts_num, 6);
 
-	for (int i = 0; i < pts.size(); i++)
+	for (int i = 0; i < pts_num; i++)
 	{
 		Zm(i, 0) = pow(Xm(i, 0) - meanx, 2);
 		Zm(i, 1) = pow((Xm(i, 0) - meanx) * (Ym(i, 0) - meany), 1);
@@ -84,11 +94,12 @@ bool EllipseFitting::fitTaubin(const std::vector<double>& x, const std::vector<d
 		Zm(i, 4) = Ym(i, 0) - meany;
 		Zm(i, 5) = 1;
 	}
-	Eigen::MatrixXd Mm = Eigen::MatrixXd::Constant(6, 6, 0);
-
-	Mm = (Zm.transpose() * Zm) / pts.size();
+	Eigen::Matrix<double, 6, 6> Mm;
+	Mm.noalias() = Zm.transpose() * Zm;
+	Mm /= pts_num;
 
-	Eigen::MatrixXd Pm = Eigen::MatrixXd::Constant(5, 5, 0), Qm = Eigen::MatrixXd::Constant(5, 5, 0);
+	Eigen::Matrix<double, 5, 5> Pm = Eigen::Matrix<double, 5, 5>::Zero();
+	Eigen::Matrix<double, 5, 5> Qm = Eigen::Matrix<double, 5, 5>::Zero();
 
 	Pm(0, 0) = Mm(0, 0) - Mm(0, 5)*Mm(0, 5);
 	Pm(0, 1) = Mm(0, 1) - Mm(0, 5)*Mm(1, 5);
@@ -128,9 +139,7 @@ bool EllipseFitting::fitTaubin(const std::vector<double>& x, const std::vector<d
 	Qm(4, 4) = 1;
 
 	//Generalized Eigen value problem solver from the Eigen library
-	Eigen::GeneralizedSelfAdjointEigenSolver<Eigen::MatrixXd> EigSolver(Pm, Qm);
-
-	EigSolver.compute(Pm, Qm);
+	Eigen::GeneralizedSelfAdjointEigenSolver<Eigen::Matrix<double, 5, 5>> EigSolver(Pm, Qm);
 
 	for (int i = 0; i < 5; i++)
 	{
@@ -138,8 +147,8 @@ bool EllipseFitting::fitTaubin(const std::vector<double>& x, const std::vector<d
 	}
 
 
-	Eigen::MatrixXd A13 = Eigen::MatrixXd::Constant(3, 1, 0);
-	Eigen::MatrixXd M = Eigen::MatrixXd::Constant(3, 1, 0);
+	Eigen::Matrix<double, 3, 1> A13;
+	Eigen::Matrix<double, 3, 1> M;
 
 	for (int i = 0; i < 3; i++)
 	{
@@ -147,9 +156,7 @@ bool EllipseFitting::fitTaubin(const std::vector<double>& x, const std::vector<d
 		M(i, 0) = Mm(5, i);
 	}
 
-	Eigen::MatrixXd tmp = -A13.transpose() * M;
-
-	A(5, 0) = tmp(0, 0);
+	A(5, 0) = -A13.dot(M);
 
 
 	double A4 = A(3, 0) - 2 * A(0, 0)*meanx - A(1, 0)*meany;
@@ -158,11 +165,9 @@ bool EllipseFitting::fitTaubin(const std::vector<double>& x, const std::vector<d
 
 	A(3,0) = A4;  A(4,0) = A5;  A(5,0) = A6;
 
-	Eigen::JacobiSVD<Eigen::MatrixXd> svd(A);
-
 	//The largest singular value is given as the sqrt of largest Eigen Value of the Symmetric matrix A.t() * A
-	//  ||A|| = sqrt(Lambda_max (A.t()*A) )
-	double normA = svd.singularValues()[0];
+	//  ||A|| = sqrt(Lambda_max (A.t()*A) ), which for a column vector is its Euclidean norm (no SVD needed)
+	double normA = A.norm();
 
 	A /= (-normA);
 
@@ -179,14 +184,8 @@ bool EllipseFitting::fitTaubin(const std::vector<double>& x, const std::vector<d
 	 * Verify if results obtained using algebraic method are good
 	 */
 	// estimate reasonable bounds of semiaxes for validation
-	std::vector<double> x_segments_from_center;
-	std::vector<double> y_segments_from_center;
-	for (int i = 0; i < Zm.rows(); i++) {
-		x_segments_from_center.push_back(std::abs(Zm(i, 3)));
-		y_segments_from_center.push_back(std::abs(Zm(i, 4)));
-	}
-	double x_half_spread = *std::max_element(x_segments_from_center.cbegin(), x_segments_from_center.cend());
-	double y_half_spread = *std::max_element(y_segments_from_center.cbegin(), y_segments_from_center.cend());
+	double x_half_spread = Zm.col(3).cwiseAbs().maxCoeff();
+	double y_half_spread = Zm.col(4).cwiseAbs().maxCoeff();
 	// apply the margin
 	double x_half_spread_mult = x_half_spread * MARGIN_ALGEBRAIC_VALID;
 	double y_half_spread_mult = y_half_spread * MARGIN_ALGEBRAIC_VALID;
@@ -226,12 +225,11 @@ bool EllipseFitting::fitFallbackSingle(double x, double y) {
 	return true;
 }
 
-bool EllipseFitting::fitFallbackMultiple(const std::vector<double>& x, const std::vector<double>& y) {
-	std::vector<Point2d> pts;
-	for (size_t i = 0; i < x.size(); i++) {
-		pts.emplace_back(x.at(i), y.at(i));
-	}
-
+bool EllipseFitting::fitFallbackMultiple(
+	const std::vector<double>& x,
+	const std::vector<double>& y,
+	std::pmr::memory_resource* memory
+) {
 	// center of gravity
 	std::array<double, 2> cog;
 	cog.at(0) = std::accumulate(x.cbegin(), x.cend(), 0.0) / x.size();
@@ -239,9 +237,9 @@ bool EllipseFitting::fitFallbackMultiple(const std::vector<double>& x, const std
 
 	// find longest vector connecting points + store their directions
 	// map of index and length
-	std::map<std::pair<size_t, size_t>, double> v_lengths;
+	std::pmr::map<std::pair<size_t, size_t>, double> v_lengths(memory);
 	// map of index and direction
-	std::map<std::pair<size_t, size_t>, double> v_dirs;
+	std::pmr::map<std::pair<size_t, size_t>, double> v_dirs(memory);
 	for (size_t i = 0; i < x.size(); i++) {
 		for (size_t j = 0; j < x.size(); j++) {
 			if (i == j) {
@@ -258,7 +256,8 @@ bool EllipseFitting::fitFallbackMultiple(const std::vector<double>& x, const std
 	}
 
 	// sort lengths, easier to use vector container; ref: https://stackoverflow.com/a/19528891
-	std::vector<std::tuple<std::pair<size_t, size_t>, double, double>> v_to_sort;
+	std::pmr::vector<std::tuple<std::pair<size_t, size_t>, double, double>> v_to_sort(memory);
+	v_to_sort.reserve(v_lengths.size());
 	// iterating over lengths and directions
 	for (
 		auto itl = v_lengths.cbegin(), itd = v_dirs.cbegin();
@@ -314,7 +313,8 @@ bool EllipseFitting::fitFallbackMultiple(const std::vector<double>& x, const std
 	 * find 2 longest vector projections onto lines perpendicular to the
 	 * longest; vectors are computed from the COG
 	 */
-	std::vector<std::pair<double, bool>> v_perp_projs;
+	std::pmr::vector<std::pair<double, bool>> v_perp_projs(memory);
+	v_perp_projs.reserve(x.size());
 	for (size_t i = 0; i < x.size(); i++) {
 		std::array<double, 2> vector;
 		vector.at(0) = x.at(i) - cog.at(0);
@@ -374,8 +374,8 @@ bool EllipseFitting::fitFallbackMultiple(const std::vector<double>& x, const std
 }
 
 // refer to @ gopiraj15/OpenCV-journey for original source of this method
-Eigen::MatrixXd EllipseFitting::convertConicToParametric(const Eigen::MatrixXd& par) {
-	Eigen::MatrixXd ell = Eigen::MatrixXd::Constant(5, 1, 0);
+Eigen::Matrix<double, 5, 1> EllipseFitting::convertConicToParametric(const Eigen::Matrix<double, 6, 1>& par) {
+	Eigen::Matrix<double, 5, 1> ell = Eigen::Matrix<double, 5, 1>::Zero();
 
 	double thetarad = 0.5*atan2(par(1,0), par(0,0) - par(2,0));
 	double cost = cos(thetarad);
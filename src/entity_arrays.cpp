@@ -0,0 +1,126 @@
+#include <social_nav_utils/entity_arrays.h>
+
+#include <algorithm>
+
+// in the header-only mode, the header itself provides inline definitions of the SocialScene methods
+#ifndef SOCIAL_NAV_UTILS_HEADER_ONLY
+#include <social_nav_utils/impl/entity_arrays.h>
+#endif
+
+namespace social_nav_utils {
+
+static constexpr SocialScene::HumanState HUMAN_DEFAULT_STATE{};
+static constexpr SocialScene::GroupState GROUP_DEFAULT_STATE{};
+
+static constexpr double HUMAN_DEFAULTS[HumanArray::COLUMNS_NUM] = {
+	HUMAN_DEFAULT_STATE.x,
+	HUMAN_DEFAULT_STATE.y,
+	HUMAN_DEFAULT_STATE.yaw,
+	HUMAN_DEFAULT_STATE.vx,
+	HUMAN_DEFAULT_STATE.vy,
+	HUMAN_DEFAULT_STATE.cov_xx,
+	HUMAN_DEFAULT_STATE.cov_xy,
+	HUMAN_DEFAULT_STATE.cov_yy,
+	HUMAN_DEFAULT_STATE.ps_var_front,
+	HUMAN_DEFAULT_STATE.ps_var_rear,
+	HUMAN_DEFAULT_STATE.ps_var_side,
+	HUMAN_DEFAULT_STATE.occupancy_radius,
+	HUMAN_DEFAULT_STATE.fov
+};
+
+static constexpr double GROUP_DEFAULTS[GroupArray::COLUMNS_NUM] = {
+	GROUP_DEFAULT_STATE.x,
+	GROUP_DEFAULT_STATE.y,
+	GROUP_DEFAULT_STATE.orientation,
+	GROUP_DEFAULT_STATE.variance_x,
+	GROUP_DEFAULT_STATE.variance_y,
+	GROUP_DEFAULT_STATE.cov_xx,
+	GROUP_DEFAULT_STATE.cov_xy,
+	GROUP_DEFAULT_STATE.cov_yy
+};
+
+ColumnArray::ColumnArray(const double* defaults, size_t columns_num):
+	defaults_(defaults),
+	columns_num_(columns_num),
+	size_(0),
+	capacity_(0)
+{}
+
+void ColumnArray::clear() {
+	size_ = 0;
+}
+
+void ColumnArray::reserve(size_t capacity) {
+	if (capacity <= capacity_) {
+		return;
+	}
+	// geometric growth, rounded up so that each column starts at the alignment boundary
+	capacity = std::max(capacity, 2 * capacity_);
+	capacity = (capacity + CAPACITY_STEP - 1) / CAPACITY_STEP * CAPACITY_STEP;
+
+	AlignedVector<double> data(columns_num_ * capacity);
+	for (size_t c = 0; c < columns_num_; c++) {
+		std::copy(column(c), column(c) + size_, data.data() + c * capacity);
+	}
+	data_.swap(data);
+	capacity_ = capacity;
+}
+
+void ColumnArray::resize(size_t size) {
+	reserve(size);
+	for (size_t c = 0; c < columns_num_; c++) {
+		std::fill(column(c) + std::min(size_, size), column(c) + size, defaults_[c]);
+	}
+	size_ = size;
+}
+
+HumanArray::HumanArray():
+	columns_(HUMAN_DEFAULTS, COLUMNS_NUM)
+{}
+
+size_t HumanArray::add(const SocialScene::HumanState& human) {
+	size_t index = size();
+	resize(index + 1);
+	set(index, human);
+	return index;
+}
+
+void HumanArray::fill(const SocialScene::HumanState& human) {
+	std::fill(x(), x() + size(), human.x);
+	std::fill(y(), y() + size(), human.y);
+	std::fill(yaw(), yaw() + size(), human.yaw);
+	std::fill(vx(), vx() + size(), human.vx);
+	std::fill(vy(), vy() + size(), human.vy);
+	std::fill(covXX(), covXX() + size(), human.cov_xx);
+	std::fill(covXY(), covXY() + size(), human.cov_xy);
+	std::fill(covYY(), covYY() + size(), human.cov_yy);
+	std::fill(psVarFront(), psVarFront() + size(), human.ps_var_front);
+	std::fill(psVarRear(), psVarRear() + size(), human.ps_var_rear);
+	std::fill(psVarSide(), psVarSide() + size(), human.ps_var_side);
+	std::fill(occupancyRadius(), occupancyRadius() + size(), human.occupancy_radius);
+	std::fill(fov(), fov() + size(), human.fov);
+}
+
+GroupArray::GroupArray():
+	columns_(GROUP_DEFAULTS, COLUMNS_NUM)
+{}
+
+size_t GroupArray::add(const SocialScene::GroupState& group) {
+	size_t index = size();
+	resize(index + 1);
+	set(index, group);
+	return index;
+}
+
+void GroupArray::fill(const SocialScene::GroupState& group) {
+	std::fill(x(), x() + size(), group.x);
+	std::fill(y(), y() + size(), group.y);
+	std::fill(orientation(), orientation() + size(), group.orientation);
+	std::fill(varianceX(), varianceX() + size(), group.variance_x);
+	std::fill(varianceY(), varianceY() + size(), group.variance_y);
+	std::fill(covXX(), covXX() + size(), group.cov_xx);
+	std::fill(covXY(), covXY() + size(), group.cov_xy);
+	std::fill(covYY(), covYY() + size(), group.cov_yy);
+}
+
+} // namespace social_nav_utils
@@ -0,0 +1,6 @@
+#include <social_nav_utils/formation_space_model.h>
+
+// in the header-only mode, the header itself provides inline definitions
+#ifndef SOCIAL_NAV_UTILS_HEADER_ONLY
+#include <social_nav_utils/impl/formation_space_model.h>
+#endif
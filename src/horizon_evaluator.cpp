@@ -0,0 +1,131 @@
+#include <social_nav_utils/horizon_evaluator.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace social_nav_utils {
+
+HorizonEvaluator::Parameters::Parameters():
+	dt(0.1),
+	cov_growth_xx(0.0),
+	cov_growth_xy(0.0),
+	cov_growth_yy(0.0),
+	unify_asymmetry_scale(false),
+	normalize(false)
+{}
+
+HorizonEvaluator::HorizonEvaluator(const Parameters& params):
+	params_(params),
+	steps_num_(0),
+	humans_num_(0)
+{}
+
+void HorizonEvaluator::predict(const HumanArray& humans, size_t steps_num) {
+	humans_num_ = humans.size();
+	steps_num_ = steps_num;
+	terms_.resize(humans_num_);
+	predictions_.resize(steps_num_ * humans_num_);
+
+	// terms of humans shared by all steps
+	for (size_t i = 0; i < humans_num_; i++) {
+		HumanTerms& terms = terms_[i];
+		double cos_yaw = std::cos(humans.yaw()[i]);
+		double sin_yaw = std::sin(humans.yaw()[i]);
+		terms.heading_x = cos_yaw;
+		terms.heading_y = sin_yaw;
+		// R * diag(var, var_side) * R^T
+		double var_side = humans.psVarSide()[i];
+		double var_front = humans.psVarFront()[i];
+		double var_rear = humans.psVarRear()[i];
+		double cc = cos_yaw * cos_yaw;
+		double ss = sin_yaw * sin_yaw;
+		double cs = cos_yaw * sin_yaw;
+		terms.front_xx = cc * var_front + ss * var_side + humans.covXX()[i];
+		terms.front_xy = cs * (var_front - var_side) + humans.covXY()[i];
+		terms.front_yy = ss * var_front + cc * var_side + humans.covYY()[i];
+		terms.rear_xx = cc * var_rear + ss * var_side + humans.covXX()[i];
+		terms.rear_xy = cs * (var_rear - var_side) + humans.covXY()[i];
+		terms.rear_yy = ss * var_rear + cc * var_side + humans.covYY()[i];
+	}
+
+	for (size_t k = 0; k < steps_num_; k++) {
+		// terms of the step shared by all humans
+		const double time = k * params_.dt;
+		const double growth_xx = params_.cov_growth_xx * time;
+		const double growth_xy = params_.cov_growth_xy * time;
+		const double growth_yy = params_.cov_growth_yy * time;
+
+		Prediction* predictions = predictions_.data() + k * humans_num_;
+		for (size_t i = 0; i < humans_num_; i++) {
+			const HumanTerms& terms = terms_[i];
+			Prediction& prediction = predictions[i];
+			prediction.x = humans.x()[i] + humans.vx()[i] * time;
+			prediction.y = humans.y()[i] + humans.vy()[i] * time;
+			prediction.heading_x = terms.heading_x;
+			prediction.heading_y = terms.heading_y;
+
+			double front_xx = terms.front_xx + growth_xx;
+			double front_xy = terms.front_xy + growth_xy;
+			double front_yy = terms.front_yy + growth_yy;
+			double front_det = front_xx * front_yy - front_xy * front_xy;
+			prediction.front_xx = front_yy / front_det;
+			prediction.front_xy2 = -2.0 * front_xy / front_det;
+			prediction.front_yy = front_xx / front_det;
+
+			double rear_xx = terms.rear_xx + growth_xx;
+			double rear_xy = terms.rear_xy + growth_xy;
+			double rear_yy = terms.rear_yy + growth_yy;
+			double rear_det = rear_xx * rear_yy - rear_xy * rear_xy;
+			prediction.rear_xx = rear_yy / rear_det;
+			prediction.rear_xy2 = -2.0 * rear_xy / rear_det;
+			prediction.rear_yy = rear_xx / rear_det;
+
+			// (2 * pi)^(-n/2) * det^(-1/2), where n = 2
+			double norm_front = 1.0 / (2.0 * M_PI * std::sqrt(front_det));
+			double norm_rear = 1.0 / (2.0 * M_PI * std::sqrt(rear_det));
+			if (params_.unify_asymmetry_scale) {
+				// both Gaussians are scaled to the higher maximum, see PersonalSpaceModel
+				norm_front = std::max(norm_front, norm_rear);
+				norm_rear = norm_front;
+			}
+			prediction.front_scale = norm_front;
+			prediction.rear_scale = norm_rear;
+			if (params_.normalize) {
+				// maximum of the model is located at the mean, i.e., it is given by the front Gaussian
+				prediction.front_scale = 1.0;
+				prediction.rear_scale = norm_rear / norm_front;
+			}
+		}
+	}
+}
+
+double HorizonEvaluator::evaluate(
+	const double* poses_x,
+	const double* poses_y,
+	double* costs,
+	CostReduction reduction
+) const {
+	double total = 0.0;
+	for (size_t k = 0; k < steps_num_; k++) {
+		const Prediction* predictions = predictions_.data() + k * humans_num_;
+		const double robot_x = poses_x[k];
+		const double robot_y = poses_y[k];
+		double cost = 0.0;
+		for (size_t i = 0; i < humans_num_; i++) {
+			const Prediction& prediction = predictions[i];
+			double dx = robot_x - prediction.x;
+			double dy = robot_y - prediction.y;
+			bool front = (dx * prediction.heading_x + dy * prediction.heading_y) >= 0.0;
+			double quadform = front
+				? prediction.front_xx * dx * dx + prediction.front_xy2 * dx * dy + prediction.front_yy * dy * dy
+				: prediction.rear_xx * dx * dx + prediction.rear_xy2 * dx * dy + prediction.rear_yy * dy * dy;
+			double value = (front ? prediction.front_scale : prediction.rear_scale) * std::exp(-0.5 * quadform);
+			cost = reduction == CostReduction::SUM ? cost + value : std::max(cost, value);
+		}
+		costs[k] = cost;
+		total += cost;
+	}
+	return total;
+}
+
+} // namespace social_nav_utils
@@ -0,0 +1,355 @@
+#include <social_nav_utils/kernel_stamp_cache.h>
+#include <social_nav_utils/personal_space_model.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace social_nav_utils {
+
+constexpr char KernelStampCache::MAGIC[9];
+
+namespace {
+
+constexpr size_t MAGIC_LEN = sizeof(KernelStampCache::MAGIC) - 1;
+
+/// Rounds up to the multiple of 8 bytes
+inline size_t alignSize(size_t size) {
+	return (size + sizeof(uint64_t) - 1) / sizeof(uint64_t) * sizeof(uint64_t);
+}
+
+} // namespace
+
+KernelStampCache::KernelStampCache(const Parameters& params):
+	params_(params),
+	radius_(0),
+	side_(0),
+	stamps_(nullptr),
+	mapped_data_(nullptr),
+	mapped_size_(0)
+{
+	bool valid = params_.var_front > 0.0 && params_.var_rear > 0.0 && params_.var_side > 0.0
+		&& params_.resolution > 0.0
+		&& params_.yaw_bins > 0
+		&& params_.sigmas > 0.0 && std::isfinite(params_.sigmas)
+		&& !params_.position_variances.empty();
+	for (double variance: params_.position_variances) {
+		valid = valid && variance >= 0.0 && std::isfinite(variance);
+	}
+	if (!valid) {
+		throw std::invalid_argument("Invalid parameters of the kernel stamp cache");
+	}
+
+	// the largest variance along any direction bounds the extent of all kernels
+	double var_max = std::max({params_.var_front, params_.var_rear, params_.var_side})
+		+ *std::max_element(params_.position_variances.cbegin(), params_.position_variances.cend());
+	radius_ = static_cast<size_t>(std::ceil(params_.sigmas * std::sqrt(var_max) / params_.resolution));
+	// additional sample on the far side allows the bilinear interpolation of the last cell
+	side_ = 2 * radius_ + 2;
+
+	storage_.resize(computeStampsSize());
+	stamps_ = storage_.data();
+
+	const double res = params_.resolution;
+	const size_t stamp_size = side_ * side_;
+	float* output = storage_.data();
+	for (double variance: params_.position_variances) {
+		for (size_t bin = 0; bin < params_.yaw_bins; bin++) {
+			PersonalSpaceModel model(
+				0.0, 0.0, 2.0 * M_PI * bin / params_.yaw_bins,
+				variance, 0.0, 0.0, variance,
+				params_.var_front, params_.var_rear, params_.var_side,
+				params_.unify_asymmetry_scale
+			);
+			if (bin == 0) {
+				peaks_.push_back(model.getMax());
+			}
+			for (size_t row = 0; row < side_; row++) {
+				double y = (static_cast<double>(row) - static_cast<double>(radius_)) * res;
+				for (size_t col = 0; col < side_; col++) {
+					double x = (static_cast<double>(col) - static_cast<double>(radius_)) * res;
+					output[row * side_ + col] = static_cast<float>(model.evaluate(x, y));
+				}
+			}
+			output += stamp_size;
+		}
+	}
+}
+
+KernelStampCache::KernelStampCache(const std::string& path):
+	radius_(0),
+	side_(0),
+	stamps_(nullptr),
+	mapped_data_(nullptr),
+	mapped_size_(0)
+{
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		throw std::runtime_error("Could not open the kernel stamp cache: " + path);
+	}
+	struct stat st;
+	if (::fstat(fd, &st) != 0) {
+		::close(fd);
+		throw std::runtime_error("Could not read the size of the kernel stamp cache: " + path);
+	}
+	size_t size = static_cast<size_t>(st.st_size);
+	if (size < 2 * MAGIC_LEN + sizeof(Header)) {
+		::close(fd);
+		throw std::runtime_error("Not a valid kernel stamp cache: " + path);
+	}
+	void* data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+	// mapping remains valid after closing the descriptor
+	::close(fd);
+	if (data == MAP_FAILED) {
+		throw std::runtime_error("Could not map the kernel stamp cache: " + path);
+	}
+	mapped_data_ = static_cast<const uint8_t*>(data);
+	mapped_size_ = size;
+
+	Header header;
+	std::memcpy(&header, mapped_data_ + MAGIC_LEN, sizeof(header));
+	// sizes are checked before they are multiplied to avoid overflows with corrupted headers
+	bool valid = std::memcmp(mapped_data_, MAGIC, MAGIC_LEN) == 0
+		&& std::memcmp(mapped_data_ + size - MAGIC_LEN, MAGIC, MAGIC_LEN) == 0
+		&& header.yaw_bins > 0 && header.levels_num > 0
+		&& header.radius < size && (2 * header.radius + 2) <= size / (2 * header.radius + 2)
+		&& header.levels_num <= size / ((2 * header.radius + 2) * (2 * header.radius + 2))
+		&& header.yaw_bins <= size / ((2 * header.radius + 2) * (2 * header.radius + 2) * header.levels_num);
+	if (valid) {
+		params_.var_front = header.var_front;
+		params_.var_rear = header.var_rear;
+		params_.var_side = header.var_side;
+		params_.resolution = header.resolution;
+		params_.sigmas = header.sigmas;
+		params_.unify_asymmetry_scale = header.unify_asymmetry_scale != 0;
+		params_.yaw_bins = header.yaw_bins;
+		radius_ = header.radius;
+		side_ = 2 * radius_ + 2;
+
+		const double* levels = reinterpret_cast<const double*>(mapped_data_ + MAGIC_LEN + sizeof(Header));
+		size_t stamps_offset = MAGIC_LEN + sizeof(Header) + 2 * header.levels_num * sizeof(double);
+		valid = stamps_offset < size;
+		if (valid) {
+			params_.position_variances.assign(levels, levels + header.levels_num);
+			peaks_.assign(levels + header.levels_num, levels + 2 * header.levels_num);
+			valid = size == stamps_offset + alignSize(computeStampsSize() * sizeof(float)) + MAGIC_LEN;
+			stamps_ = reinterpret_cast<const float*>(mapped_data_ + stamps_offset);
+		}
+	}
+	if (!valid) {
+		unmap();
+		throw std::runtime_error("Not a valid kernel stamp cache: " + path);
+	}
+}
+
+KernelStampCache::~KernelStampCache() {
+	unmap();
+}
+
+KernelStampCache::KernelStampCache(KernelStampCache&& other) noexcept:
+	params_(std::move(other.params_)),
+	radius_(other.radius_),
+	side_(other.side_),
+	peaks_(std::move(other.peaks_)),
+	storage_(std::move(other.storage_)),
+	stamps_(other.stamps_),
+	mapped_data_(other.mapped_data_),
+	mapped_size_(other.mapped_size_)
+{
+	other.stamps_ = nullptr;
+	other.mapped_data_ = nullptr;
+	other.mapped_size_ = 0;
+}
+
+KernelStampCache& KernelStampCache::operator=(KernelStampCache&& other) noexcept {
+	if (this != &other) {
+		unmap();
+		params_ = std::move(other.params_);
+		radius_ = other.radius_;
+		side_ = other.side_;
+		peaks_ = std::move(other.peaks_);
+		storage_ = std::move(other.storage_);
+		stamps_ = other.stamps_;
+		mapped_data_ = other.mapped_data_;
+		mapped_size_ = other.mapped_size_;
+		other.stamps_ = nullptr;
+		other.mapped_data_ = nullptr;
+		other.mapped_size_ = 0;
+	}
+	return *this;
+}
+
+KernelStampCache KernelStampCache::loadOrCreate(const std::string& path, const Parameters& params) {
+	try {
+		KernelStampCache cache(path);
+		if (cache.isCompatible(params)) {
+			return cache;
+		}
+	} catch (const std::runtime_error&) {
+		// missing or corrupted file is replaced below
+	}
+	KernelStampCache cache(params);
+	try {
+		cache.save(path);
+	} catch (const std::runtime_error&) {
+		// e.g., read-only file system, the cache is computed again at the next start
+	}
+	return cache;
+}
+
+void KernelStampCache::save(const std::string& path) const {
+	// written next to the target and renamed, so processes that have the previous file mapped are not affected
+	const std::string path_tmp = path + ".tmp";
+	std::FILE* file = std::fopen(path_tmp.c_str(), "wb");
+	if (file == nullptr) {
+		throw std::runtime_error("Could not create the kernel stamp cache: " + path);
+	}
+	Header header{
+		params_.var_front,
+		params_.var_rear,
+		params_.var_side,
+		params_.resolution,
+		params_.sigmas,
+		params_.unify_asymmetry_scale ? 1u : 0u,
+		params_.yaw_bins,
+		params_.position_variances.size(),
+		radius_
+	};
+	const size_t stamps_size = computeStampsSize();
+	const size_t padding_size = alignSize(stamps_size * sizeof(float)) - stamps_size * sizeof(float);
+	const uint8_t padding[sizeof(uint64_t)] = {};
+
+	bool ok = std::fwrite(MAGIC, 1, MAGIC_LEN, file) == MAGIC_LEN
+		&& std::fwrite(&header, sizeof(header), 1, file) == 1
+		&& std::fwrite(params_.position_variances.data(), sizeof(double), peaks_.size(), file) == peaks_.size()
+		&& std::fwrite(peaks_.data(), sizeof(double), peaks_.size(), file) == peaks_.size()
+		&& std::fwrite(stamps_, sizeof(float), stamps_size, file) == stamps_size
+		&& std::fwrite(padding, 1, padding_size, file) == padding_size
+		&& std::fwrite(MAGIC, 1, MAGIC_LEN, file) == MAGIC_LEN;
+	ok = (std::fclose(file) == 0) && ok;
+	if (!ok || std::rename(path_tmp.c_str(), path.c_str()) != 0) {
+		std::remove(path_tmp.c_str());
+		throw std::runtime_error("Could not write the kernel stamp cache: " + path);
+	}
+}
+
+bool KernelStampCache::isCompatible(const Parameters& params) const {
+	return params.var_front == params_.var_front
+		&& params.var_rear == params_.var_rear
+		&& params.var_side == params_.var_side
+		&& params.unify_asymmetry_scale == params_.unify_asymmetry_scale
+		&& params.resolution == params_.resolution
+		&& params.yaw_bins == params_.yaw_bins
+		&& params.sigmas == params_.sigmas
+		&& params.position_variances == params_.position_variances;
+}
+
+size_t KernelStampCache::getYawBin(double yaw) const {
+	const double bins = static_cast<double>(params_.yaw_bins);
+	double bin = std::round(yaw / (2.0 * M_PI) * bins);
+	// wrapped to [0, bins)
+	bin -= bins * std::floor(bin / bins);
+	return std::min(static_cast<size_t>(bin), params_.yaw_bins - 1);
+}
+
+size_t KernelStampCache::getLevel(double cov_xx, double cov_yy) const {
+	// isotropic covariance with the same trace
+	const double variance = 0.5 * (cov_xx + cov_yy);
+	size_t level = 0;
+	for (size_t i = 1; i < params_.position_variances.size(); i++) {
+		if (std::abs(params_.position_variances[i] - variance) < std::abs(params_.position_variances[level] - variance)) {
+			level = i;
+		}
+	}
+	return level;
+}
+
+const float* KernelStampCache::getStamp(size_t level, size_t yaw_bin) const {
+	return stamps_ + (level * params_.yaw_bins + yaw_bin) * side_ * side_;
+}
+
+void KernelStampCache::stamp(
+	double person_pos_x,
+	double person_pos_y,
+	double person_orient_yaw,
+	double person_pos_cov_xx,
+	double person_pos_cov_yy,
+	double* grid,
+	size_t width,
+	size_t height,
+	double origin_x,
+	double origin_y,
+	CostReduction reduction,
+	bool normalize
+) const {
+	const double res = params_.resolution;
+	const double side = static_cast<double>(side_);
+	// stamp coordinates of the center of the cell (0, 0)
+	const double ax = (origin_x - person_pos_x) / res + 0.5 + static_cast<double>(radius_);
+	const double ay = (origin_y - person_pos_y) / res + 0.5 + static_cast<double>(radius_);
+	const double base_x_floor = std::floor(ax);
+	const double base_y_floor = std::floor(ay);
+	// also rejects NaNs
+	if (!(base_x_floor < side && base_x_floor + static_cast<double>(width) > 0.0
+		&& base_y_floor < side && base_y_floor + static_cast<double>(height) > 0.0)) {
+		return;
+	}
+
+	// sub-cell offset is the same for all cells, so are the interpolation weights
+	const int64_t base_x = static_cast<int64_t>(base_x_floor);
+	const int64_t base_y = static_cast<int64_t>(base_y_floor);
+	const double fx = ax - base_x_floor;
+	const double fy = ay - base_y_floor;
+	const size_t level = getLevel(person_pos_cov_xx, person_pos_cov_yy);
+	const double scale = normalize ? (1.0 / peaks_[level]) : 1.0;
+	const double w00 = scale * (1.0 - fx) * (1.0 - fy);
+	const double w01 = scale * fx * (1.0 - fy);
+	const double w10 = scale * (1.0 - fx) * fy;
+	const double w11 = scale * fx * fy;
+
+	// cells whose base sample and its neighbours are within the stamp
+	const int64_t last = static_cast<int64_t>(side_) - 1;
+	const int64_t col_begin = std::max<int64_t>(0, -base_x);
+	const int64_t col_end = std::min<int64_t>(static_cast<int64_t>(width), last - base_x);
+	const int64_t row_begin = std::max<int64_t>(0, -base_y);
+	const int64_t row_end = std::min<int64_t>(static_cast<int64_t>(height), last - base_y);
+
+	const float* stamp = getStamp(level, getYawBin(person_orient_yaw));
+	for (int64_t row = row_begin; row < row_end; row++) {
+		const float* samples = stamp + (row + base_y) * side_ + (col_begin + base_x);
+		const float* samples_next = samples + side_;
+		double* costs = grid + row * width + col_begin;
+		const int64_t cols_num = col_end - col_begin;
+		if (reduction == CostReduction::SUM) {
+			for (int64_t i = 0; i < cols_num; i++) {
+				costs[i] += w00 * samples[i] + w01 * samples[i + 1] + w10 * samples_next[i] + w11 * samples_next[i + 1];
+			}
+		} else {
+			for (int64_t i = 0; i < cols_num; i++) {
+				double value = w00 * samples[i] + w01 * samples[i + 1] + w10 * samples_next[i] + w11 * samples_next[i + 1];
+				costs[i] = std::max(costs[i], value);
+			}
+		}
+	}
+}
+
+size_t KernelStampCache::computeStampsSize() const {
+	return params_.position_variances.size() * params_.yaw_bins * side_ * side_;
+}
+
+void KernelStampCache::unmap() {
+	if (mapped_data_ != nullptr) {
+		::munmap(const_cast<uint8_t*>(mapped_data_), mapped_size_);
+		mapped_data_ = nullptr;
+		mapped_size_ = 0;
+	}
+}
+
+} // namespace social_nav_utils
@@ -0,0 +1,113 @@
+#include <social_nav_utils/memory_arena.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+namespace social_nav_utils {
+
+MemoryArena::MemoryArena(size_t block_size, std::pmr::memory_resource* upstream):
+	block_size_(std::max(block_size, size_t(1))),
+	upstream_(upstream),
+	current_(0),
+	offset_(0),
+	bytes_used_(0),
+	bytes_used_peak_(0),
+	bytes_reserved_(0)
+{}
+
+MemoryArena::~MemoryArena() {
+	release();
+}
+
+MemoryArena::MemoryArena(MemoryArena&& other) noexcept:
+	block_size_(other.block_size_),
+	upstream_(other.upstream_),
+	blocks_(std::move(other.blocks_)),
+	current_(other.current_),
+	offset_(other.offset_),
+	bytes_used_(other.bytes_used_),
+	bytes_used_peak_(other.bytes_used_peak_),
+	bytes_reserved_(other.bytes_reserved_)
+{
+	other.blocks_.clear();
+	other.current_ = 0;
+	other.offset_ = 0;
+	other.bytes_used_ = 0;
+	other.bytes_reserved_ = 0;
+}
+
+MemoryArena& MemoryArena::operator=(MemoryArena&& other) noexcept {
+	if (this != &other) {
+		release();
+		block_size_ = other.block_size_;
+		upstream_ = other.upstream_;
+		blocks_ = std::move(other.blocks_);
+		current_ = other.current_;
+		offset_ = other.offset_;
+		bytes_used_ = other.bytes_used_;
+		bytes_used_peak_ = other.bytes_used_peak_;
+		bytes_reserved_ = other.bytes_reserved_;
+		other.blocks_.clear();
+		other.current_ = 0;
+		other.offset_ = 0;
+		other.bytes_used_ = 0;
+		other.bytes_reserved_ = 0;
+	}
+	return *this;
+}
+
+void MemoryArena::reset() {
+	current_ = 0;
+	offset_ = 0;
+	bytes_used_ = 0;
+}
+
+void MemoryArena::release() {
+	for (const auto& block: blocks_) {
+		upstream_->deallocate(block.data, block.size, alignof(std::max_align_t));
+	}
+	blocks_.clear();
+	reset();
+	bytes_reserved_ = 0;
+}
+
+void* MemoryArena::allocateFromCurrent(size_t bytes, size_t alignment) {
+	if (current_ >= blocks_.size()) {
+		return nullptr;
+	}
+	const auto& block = blocks_[current_];
+	uintptr_t begin = reinterpret_cast<uintptr_t>(block.data) + offset_;
+	uintptr_t aligned = (begin + alignment - 1) & ~(uintptr_t(alignment) - 1);
+	size_t padding = aligned - begin;
+	if (offset_ + padding + bytes > block.size) {
+		return nullptr;
+	}
+	offset_ += padding + bytes;
+	bytes_used_ += padding + bytes;
+	bytes_used_peak_ = std::max(bytes_used_peak_, bytes_used_);
+	return reinterpret_cast<void*>(aligned);
+}
+
+void* MemoryArena::do_allocate(size_t bytes, size_t alignment) {
+	void* ptr = allocateFromCurrent(bytes, alignment);
+	// blocks kept from previous cycles are visited in order
+	while (ptr == nullptr && current_ + 1 < blocks_.size()) {
+		current_++;
+		offset_ = 0;
+		ptr = allocateFromCurrent(bytes, alignment);
+	}
+	if (ptr != nullptr) {
+		return ptr;
+	}
+	// worst-case padding is included, so the allocation always fits into the new block
+	size_t size = std::max(block_size_, bytes + alignment);
+	Block block{static_cast<char*>(upstream_->allocate(size, alignof(std::max_align_t))), size};
+	blocks_.push_back(block);
+	bytes_reserved_ += size;
+	current_ = blocks_.size() - 1;
+	offset_ = 0;
+	return allocateFromCurrent(bytes, alignment);
+}
+
+} // namespace social_nav_utils
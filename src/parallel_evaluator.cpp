@@ -0,0 +1,303 @@
+#include <social_nav_utils/parallel_evaluator.h>
+
+#include <algorithm>
+
+namespace social_nav_utils {
+
+ParallelEvaluator::ParallelEvaluator(size_t threads_num, size_t tile_entities, size_t tile_poses):
+	pool_(threads_num),
+	tile_entities_(std::max(tile_entities, size_t(1))),
+	tile_poses_(std::max(tile_poses, size_t(1)))
+{}
+
+template <typename Tfun>
+void ParallelEvaluator::runTiles(size_t entities_num, size_t poses_num, size_t tile_entities, const Tfun& fun) {
+	size_t tiles_entities_num = (entities_num + tile_entities - 1) / tile_entities;
+	size_t tiles_poses_num = (poses_num + tile_poses_ - 1) / tile_poses_;
+	pool_.run(
+		tiles_entities_num * tiles_poses_num,
+		[&](size_t tile) {
+			size_t entity_begin = (tile / tiles_poses_num) * tile_entities;
+			size_t pose_begin = (tile % tiles_poses_num) * tile_poses_;
+			fun(
+				entity_begin,
+				std::min(entity_begin + tile_entities, entities_num),
+				pose_begin,
+				std::min(pose_begin + tile_poses_, poses_num)
+			);
+		}
+	);
+}
+
+void ParallelEvaluator::computePersonalSpaceMatrix(
+	const SocialScene& scene,
+	const double* poses_x,
+	const double* poses_y,
+	size_t poses_num,
+	double* costs,
+	bool normalize
+) {
+	collectPersonalSpaceModels(scene);
+	runPersonalSpaceMatrix(poses_x, poses_y, poses_num, costs, normalize);
+}
+
+void ParallelEvaluator::computePersonalSpaceReduced(
+	const SocialScene& scene,
+	const double* poses_x,
+	const double* poses_y,
+	size_t poses_num,
+	double* costs,
+	Reduction reduction,
+	bool normalize
+) {
+	collectPersonalSpaceModels(scene);
+	runPersonalSpaceReduced(poses_x, poses_y, poses_num, costs, reduction, normalize);
+}
+
+void ParallelEvaluator::computeFormationSpaceMatrix(
+	const SocialScene& scene,
+	const double* poses_x,
+	const double* poses_y,
+	size_t poses_num,
+	double* costs,
+	bool normalize
+) {
+	collectFormationSpaceModels(scene);
+	runFormationSpaceMatrix(poses_x, poses_y, poses_num, costs, normalize);
+}
+
+void ParallelEvaluator::computeFormationSpaceReduced(
+	const SocialScene& scene,
+	const double* poses_x,
+	const double* poses_y,
+	size_t poses_num,
+	double* costs,
+	Reduction reduction,
+	bool normalize
+) {
+	collectFormationSpaceModels(scene);
+	runFormationSpaceReduced(poses_x, poses_y, poses_num, costs, reduction, normalize);
+}
+
+void ParallelEvaluator::computePersonalSpaceMatrix(
+	const HumanArray& humans,
+	const double* poses_x,
+	const double* poses_y,
+	size_t poses_num,
+	double* costs,
+	bool normalize,
+	bool unify_asymmetry_scale
+) {
+	buildPersonalSpaceModels(humans, unify_asymmetry_scale);
+	runPersonalSpaceMatrix(poses_x, poses_y, poses_num, costs, normalize);
+}
+
+void ParallelEvaluator::computePersonalSpaceReduced(
+	const HumanArray& humans,
+	const double* poses_x,
+	const double* poses_y,
+	size_t poses_num,
+	double* costs,
+	Reduction reduction,
+	bool normalize,
+	bool unify_asymmetry_scale
+) {
+	buildPersonalSpaceModels(humans, unify_asymmetry_scale);
+	runPersonalSpaceReduced(poses_x, poses_y, poses_num, costs, reduction, normalize);
+}
+
+void ParallelEvaluator::computeFormationSpaceMatrix(
+	const GroupArray& groups,
+	const double* poses_x,
+	const double* poses_y,
+	size_t poses_num,
+	double* costs,
+	bool normalize
+) {
+	buildFormationSpaceModels(groups);
+	runFormationSpaceMatrix(poses_x, poses_y, poses_num, costs, normalize);
+}
+
+void ParallelEvaluator::computeFormationSpaceReduced(
+	const GroupArray& groups,
+	const double* poses_x,
+	const double* poses_y,
+	size_t poses_num,
+	double* costs,
+	Reduction reduction,
+	bool normalize
+) {
+	buildFormationSpaceModels(groups);
+	runFormationSpaceReduced(poses_x, poses_y, poses_num, costs, reduction, normalize);
+}
+
+void ParallelEvaluator::collectPersonalSpaceModels(const SocialScene& scene) {
+	personal_space_ptrs_.clear();
+	for (size_t i = 0; i < scene.getHumansNum(); i++) {
+		personal_space_ptrs_.push_back(&scene.getPersonalSpaceModel(i));
+	}
+}
+
+void ParallelEvaluator::collectFormationSpaceModels(const SocialScene& scene) {
+	formation_space_ptrs_.clear();
+	for (size_t i = 0; i < scene.getGroupsNum(); i++) {
+		formation_space_ptrs_.push_back(&scene.getFormationSpaceModel(i));
+	}
+}
+
+void ParallelEvaluator::buildPersonalSpaceModels(const HumanArray& humans, bool unify_asymmetry_scale) {
+	personal_space_models_.clear();
+	for (size_t i = 0; i < humans.size(); i++) {
+		personal_space_models_.emplace_back(
+			humans.x()[i],
+			humans.y()[i],
+			humans.yaw()[i],
+			humans.covXX()[i],
+			humans.covXY()[i],
+			humans.covXY()[i],
+			humans.covYY()[i],
+			humans.psVarFront()[i],
+			humans.psVarRear()[i],
+			humans.psVarSide()[i],
+			unify_asymmetry_scale
+		);
+	}
+	// pointers are collected once the storage no longer reallocates
+	personal_space_ptrs_.clear();
+	for (const auto& model: personal_space_models_) {
+		personal_space_ptrs_.push_back(&model);
+	}
+}
+
+void ParallelEvaluator::buildFormationSpaceModels(const GroupArray& groups) {
+	formation_space_models_.clear();
+	for (size_t i = 0; i < groups.size(); i++) {
+		formation_space_models_.emplace_back(
+			groups.x()[i],
+			groups.y()[i],
+			groups.orientation()[i],
+			groups.varianceX()[i],
+			groups.varianceY()[i],
+			groups.covXX()[i],
+			groups.covXY()[i],
+			groups.covYY()[i]
+		);
+	}
+	formation_space_ptrs_.clear();
+	for (const auto& model: formation_space_models_) {
+		formation_space_ptrs_.push_back(&model);
+	}
+}
+
+void ParallelEvaluator::runPersonalSpaceMatrix(
+	const double* poses_x,
+	const double* poses_y,
+	size_t poses_num,
+	double* costs,
+	bool normalize
+) {
+	const auto& models = personal_space_ptrs_;
+	runTiles(
+		models.size(),
+		poses_num,
+		tile_entities_,
+		[&](size_t entity_begin, size_t entity_end, size_t pose_begin, size_t pose_end) {
+			TiledKernel::fillPersonalSpace(
+				models.data() + entity_begin,
+				entity_end - entity_begin,
+				poses_x + pose_begin,
+				poses_y + pose_begin,
+				pose_end - pose_begin,
+				costs + entity_begin * poses_num + pose_begin,
+				poses_num,
+				normalize
+			);
+		}
+	);
+}
+
+void ParallelEvaluator::runPersonalSpaceReduced(
+	const double* poses_x,
+	const double* poses_y,
+	size_t poses_num,
+	double* costs,
+	Reduction reduction,
+	bool normalize
+) {
+	const auto& models = personal_space_ptrs_;
+	// single tile in the entities dimension makes the reduction order independent of scheduling
+	runTiles(
+		1,
+		poses_num,
+		1,
+		[&](size_t /* entity_begin */, size_t /* entity_end */, size_t pose_begin, size_t pose_end) {
+			TiledKernel::reducePersonalSpace(
+				models.data(),
+				models.size(),
+				poses_x + pose_begin,
+				poses_y + pose_begin,
+				pose_end - pose_begin,
+				costs + pose_begin,
+				reduction,
+				normalize
+			);
+		}
+	);
+}
+
+void ParallelEvaluator::runFormationSpaceMatrix(
+	const double* poses_x,
+	const double* poses_y,
+	size_t poses_num,
+	double* costs,
+	bool normalize
+) {
+	const auto& models = formation_space_ptrs_;
+	runTiles(
+		models.size(),
+		poses_num,
+		tile_entities_,
+		[&](size_t entity_begin, size_t entity_end, size_t pose_begin, size_t pose_end) {
+			TiledKernel::fillFormationSpace(
+				models.data() + entity_begin,
+				entity_end - entity_begin,
+				poses_x + pose_begin,
+				poses_y + pose_begin,
+				pose_end - pose_begin,
+				costs + entity_begin * poses_num + pose_begin,
+				poses_num,
+				normalize
+			);
+		}
+	);
+}
+
+void ParallelEvaluator::runFormationSpaceReduced(
+	const double* poses_x,
+	const double* poses_y,
+	size_t poses_num,
+	double* costs,
+	Reduction reduction,
+	bool normalize
+) {
+	const auto& models = formation_space_ptrs_;
+	runTiles(
+		1,
+		poses_num,
+		1,
+		[&](size_t /* entity_begin */, size_t /* entity_end */, size_t pose_begin, size_t pose_end) {
+			TiledKernel::reduceFormationSpace(
+				models.data(),
+				models.size(),
+				poses_x + pose_begin,
+				poses_y + pose_begin,
+				pose_end - pose_begin,
+				costs + pose_begin,
+				reduction,
+				normalize
+			);
+		}
+	);
+}
+
+} // namespace social_nav_utils
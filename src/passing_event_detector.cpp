@@ -0,0 +1,172 @@
+#include <social_nav_utils/passing_event_detector.h>
+#include <social_nav_utils/passing_speed_comfort.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+namespace social_nav_utils {
+
+PassingEventDetector::Parameters::Parameters():
+	distance_max(2.0),
+	distance_hysteresis(0.1)
+{}
+
+PassingEventDetector::PassingEventDetector(const Parameters& params):
+	params_(params)
+{
+	reset();
+}
+
+bool PassingEventDetector::update(
+	double time,
+	double robot_x,
+	double robot_y,
+	double robot_vx,
+	double robot_vy,
+	double human_x,
+	double human_y
+) {
+	double rel_x = human_x - robot_x;
+	double rel_y = human_y - robot_y;
+	double distance = std::hypot(rel_x, rel_y);
+
+	bool completed = false;
+	if (!started_) {
+		started_ = true;
+		approaching_ = true;
+		min_.time = time;
+		min_.distance = distance;
+		min_.robot_speed = std::hypot(robot_vx, robot_vy);
+	} else if (approaching_) {
+		Event closest = computeClosestApproach(time, rel_x, rel_y, robot_vx, robot_vy);
+		if (closest.distance < min_.distance) {
+			min_ = closest;
+		}
+		if (distance >= min_.distance + params_.distance_hysteresis) {
+			completed = min_.distance <= params_.distance_max;
+			if (completed) {
+				emit();
+			}
+			approaching_ = false;
+			max_distance_ = distance;
+		}
+	} else {
+		max_distance_ = std::max(max_distance_, distance);
+		if (distance <= max_distance_ - params_.distance_hysteresis) {
+			approaching_ = true;
+			min_ = computeClosestApproach(time, rel_x, rel_y, robot_vx, robot_vy);
+		}
+	}
+
+	prev_time_ = time;
+	prev_rel_x_ = rel_x;
+	prev_rel_y_ = rel_y;
+	prev_robot_vx_ = robot_vx;
+	prev_robot_vy_ = robot_vy;
+	prev_distance_ = distance;
+	return completed;
+}
+
+bool PassingEventDetector::finish() {
+	bool completed = started_
+		&& approaching_
+		&& min_.distance < prev_distance_
+		&& min_.distance <= params_.distance_max;
+	if (completed) {
+		emit();
+	}
+	reset();
+	return completed;
+}
+
+void PassingEventDetector::reset() {
+	started_ = false;
+	approaching_ = true;
+	min_ = Event();
+	max_distance_ = 0.0;
+	prev_time_ = 0.0;
+	prev_rel_x_ = 0.0;
+	prev_rel_y_ = 0.0;
+	prev_robot_vx_ = 0.0;
+	prev_robot_vy_ = 0.0;
+	prev_distance_ = 0.0;
+}
+
+PassingEventDetector::Event PassingEventDetector::computeClosestApproach(
+	double time,
+	double rel_x,
+	double rel_y,
+	double robot_vx,
+	double robot_vy
+) const {
+	// relative position changes linearly along the segment, so the separation is minimized by a projection
+	double dx = rel_x - prev_rel_x_;
+	double dy = rel_y - prev_rel_y_;
+	double length_sq = dx * dx + dy * dy;
+	double s = 0.0;
+	if (length_sq > 0.0) {
+		s = std::min(std::max(-(prev_rel_x_ * dx + prev_rel_y_ * dy) / length_sq, 0.0), 1.0);
+	}
+	Event closest;
+	closest.time = prev_time_ + s * (time - prev_time_);
+	closest.distance = std::hypot(prev_rel_x_ + s * dx, prev_rel_y_ + s * dy);
+	closest.robot_speed = std::hypot(
+		prev_robot_vx_ + s * (robot_vx - prev_robot_vx_),
+		prev_robot_vy_ + s * (robot_vy - prev_robot_vy_)
+	);
+	return closest;
+}
+
+void PassingEventDetector::emit() {
+	event_ = min_;
+	event_.comfort = PassingSpeedComfort::computeSpeedComfort(event_.distance, event_.robot_speed);
+}
+
+void detectPassingEvents(
+	const TrajectoryEpisode& episode,
+	const PassingEventDetector::Parameters& params,
+	const std::function<void(int64_t, const PassingEventDetector::Event&)>& consumer
+) {
+	struct Track {
+		PassingEventDetector detector;
+		size_t last_frame;
+	};
+	// ordered, so the pending passings are reported deterministically at the end of the episode
+	std::map<int64_t, Track> tracks;
+
+	for (size_t f = 0; f < episode.frames_num; f++) {
+		for (size_t r = episode.agents_begin[f]; r < episode.agents_begin[f + 1]; r++) {
+			int64_t id = episode.agent_id[r];
+			auto it = tracks.find(id);
+			if (it == tracks.end()) {
+				it = tracks.emplace(id, Track{PassingEventDetector(params), f}).first;
+			} else if (it->second.last_frame + 1 != f && it->second.detector.finish()) {
+				// the agent was missing, so its trajectory is not continuous
+				consumer(id, it->second.detector.getEvent());
+			}
+			Track& track = it->second;
+			track.last_frame = f;
+			bool completed = track.detector.update(
+				episode.time[f],
+				episode.robot_x[f],
+				episode.robot_y[f],
+				episode.robot_vx[f],
+				episode.robot_vy[f],
+				episode.agent_x[r],
+				episode.agent_y[r]
+			);
+			if (completed) {
+				consumer(id, track.detector.getEvent());
+			}
+		}
+	}
+
+	for (auto& entry: tracks) {
+		if (entry.second.detector.finish()) {
+			consumer(entry.first, entry.second.detector.getEvent());
+		}
+	}
+}
+
+} // namespace social_nav_utils
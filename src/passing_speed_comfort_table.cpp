@@ -0,0 +1,98 @@
+#include <social_nav_utils/passing_speed_comfort_table.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+namespace social_nav_utils {
+
+constexpr double PassingSpeedComfortTable::SPEED_MAX_DEFAULT;
+constexpr double PassingSpeedComfortTable::SPEED_RESOLUTION_DEFAULT;
+
+namespace {
+
+/// Number of samples per cell used to measure the interpolation error
+constexpr size_t ERROR_SAMPLES_PER_CELL = 16;
+
+} // namespace
+
+PassingSpeedComfortTable::PassingSpeedComfortTable(double speed_max, double speed_resolution):
+	speed_max_(speed_max),
+	speed_resolution_(speed_resolution),
+	speed_scale_(1.0 / speed_resolution),
+	max_error_(0.0)
+{
+	if (!(speed_max > 0.0 && speed_resolution > 0.0 && std::isfinite(speed_max))) {
+		throw std::invalid_argument("Invalid speed range of the passing speed comfort table");
+	}
+	const size_t nodes_num = static_cast<size_t>(std::ceil(speed_max_ * speed_scale_)) + 1;
+	close_.resize(nodes_num + 1);
+	far_.resize(nodes_num + 1);
+	for (size_t i = 0; i < nodes_num; i++) {
+		double speed = i * speed_resolution_;
+		close_[i] = PassingSpeedComfort::computeComfortClose(speed);
+		far_[i] = PassingSpeedComfort::computeComfortFar(speed);
+	}
+	// the additional node repeats the last one, so the upper bound of the range does not need special handling
+	close_[nodes_num] = close_[nodes_num - 1];
+	far_[nodes_num] = far_[nodes_num - 1];
+
+	close_slope_.resize(nodes_num + 1, 0.0);
+	far_slope_.resize(nodes_num + 1, 0.0);
+	for (size_t i = 0; i < nodes_num; i++) {
+		close_slope_[i] = close_[i + 1] - close_[i];
+		far_slope_[i] = far_[i + 1] - far_[i];
+	}
+
+	// the blend of models is a convex combination, so its error is bounded by the errors of the close and far models
+	for (size_t i = 0; i + 1 < nodes_num; i++) {
+		for (size_t j = 1; j < ERROR_SAMPLES_PER_CELL; j++) {
+			double speed = (i + static_cast<double>(j) / ERROR_SAMPLES_PER_CELL) * speed_resolution_;
+			if (speed > speed_max_) {
+				break;
+			}
+			max_error_ = std::max(
+				max_error_,
+				std::max(
+					std::abs(evaluate(0.0, speed) - PassingSpeedComfort::computeComfortClose(speed)),
+					std::abs(evaluate(PassingSpeedComfort::FAR_DIST_THRESHOLD, speed) - PassingSpeedComfort::computeComfortFar(speed))
+				)
+			);
+		}
+	}
+}
+
+const PassingSpeedComfortTable& PassingSpeedComfortTable::getDefault() {
+	static const PassingSpeedComfortTable table;
+	return table;
+}
+
+void PassingSpeedComfortTable::evaluate(
+	const double* distance,
+	const double* robot_speed,
+	size_t num,
+	double* comfort
+) const {
+	// the output never aliases the table, which lets the compiler vectorize the gathers from it
+	double* __restrict output = comfort;
+	const double* __restrict close = close_.data();
+	const double* __restrict close_slope = close_slope_.data();
+	const double* __restrict far = far_.data();
+	const double* __restrict far_slope = far_slope_.data();
+	const double speed_max = speed_max_;
+	const double speed_scale = speed_scale_;
+	const double dist_far = PassingSpeedComfort::FAR_DIST_THRESHOLD;
+	const double dist_range_inv = 1.0 / (PassingSpeedComfort::FAR_DIST_THRESHOLD - PassingSpeedComfort::CLOSE_DIST_THRESHOLD);
+	for (size_t i = 0; i < num; i++) {
+		double index = std::min(std::max(0.0, robot_speed[i]), speed_max) * speed_scale;
+		// 32-bit index, as conversions of doubles to 64-bit integers are not vectorized on most targets
+		int32_t cell = static_cast<int32_t>(index);
+		double frac = index - static_cast<double>(cell);
+		double value_close = close[cell] + frac * close_slope[cell];
+		double value_far = far[cell] + frac * far_slope[cell];
+		double weight = std::min(std::max((dist_far - distance[i]) * dist_range_inv, 0.0), 1.0);
+		output[i] = value_far + weight * (value_close - value_far);
+	}
+}
+
+} // namespace social_nav_utils
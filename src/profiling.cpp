@@ -0,0 +1,343 @@
+#include <social_nav_utils/profiling.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <vector>
+
+namespace social_nav_utils {
+
+LatencyHistogram::LatencyHistogram() {
+	reset();
+}
+
+void LatencyHistogram::record(uint64_t nanoseconds) {
+	buckets_[toBucket(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+	count_.fetch_add(1, std::memory_order_relaxed);
+	sum_.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+	uint64_t min = min_.load(std::memory_order_relaxed);
+	while (nanoseconds < min && !min_.compare_exchange_weak(min, nanoseconds, std::memory_order_relaxed)) {}
+	uint64_t max = max_.load(std::memory_order_relaxed);
+	while (nanoseconds > max && !max_.compare_exchange_weak(max, nanoseconds, std::memory_order_relaxed)) {}
+}
+
+void LatencyHistogram::reset() {
+	for (auto& bucket: buckets_) {
+		bucket.store(0, std::memory_order_relaxed);
+	}
+	count_.store(0, std::memory_order_relaxed);
+	sum_.store(0, std::memory_order_relaxed);
+	min_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+	max_.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getCount() const {
+	return count_.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getMin() const {
+	return getCount() == 0 ? 0 : min_.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getMax() const {
+	return max_.load(std::memory_order_relaxed);
+}
+
+double LatencyHistogram::getMean() const {
+	uint64_t count = getCount();
+	if (count == 0) {
+		return 0.0;
+	}
+	return static_cast<double>(sum_.load(std::memory_order_relaxed)) / count;
+}
+
+uint64_t LatencyHistogram::getPercentile(double percentile) const {
+	uint64_t count = getCount();
+	if (count == 0) {
+		return 0;
+	}
+	percentile = std::min(std::max(percentile, 0.0), 100.0);
+	uint64_t target = std::max(static_cast<uint64_t>(std::ceil(percentile / 100.0 * count)), uint64_t(1));
+	uint64_t cumulative = 0;
+	for (size_t i = 0; i < BUCKETS_NUM; i++) {
+		cumulative += buckets_[i].load(std::memory_order_relaxed);
+		if (cumulative >= target) {
+			// bucket bounds are wider than the actually recorded extremes
+			return std::min(std::max(fromBucket(i), getMin()), getMax());
+		}
+	}
+	return getMax();
+}
+
+size_t LatencyHistogram::toBucket(uint64_t nanoseconds) {
+	if (nanoseconds < LINEAR_BUCKETS) {
+		return static_cast<size_t>(nanoseconds);
+	}
+	// index of the most significant bit, at least 5 here
+	size_t exponent = 63 - __builtin_clzll(nanoseconds);
+	size_t sub_bucket = (nanoseconds >> (exponent - 4)) & (SUB_BUCKETS - 1);
+	return LINEAR_BUCKETS + (exponent - 5) * SUB_BUCKETS + sub_bucket;
+}
+
+uint64_t LatencyHistogram::fromBucket(size_t bucket) {
+	if (bucket < LINEAR_BUCKETS) {
+		return bucket;
+	}
+	size_t exponent = (bucket - LINEAR_BUCKETS) / SUB_BUCKETS + 5;
+	uint64_t sub_bucket = (bucket - LINEAR_BUCKETS) % SUB_BUCKETS;
+	uint64_t lower = (SUB_BUCKETS + sub_bucket) << (exponent - 4);
+	return lower + (uint64_t(1) << (exponent - 4)) - 1;
+}
+
+namespace {
+
+struct TraceEvent {
+	ProfiledFunction function;
+	/// Start time since the profiler epoch [ns]
+	int64_t start;
+	int64_t duration;
+};
+
+/// Trace events recorded by a single thread
+struct ThreadTrace {
+	std::mutex mutex;
+	std::vector<TraceEvent> events;
+	size_t thread_id;
+};
+
+struct ProfilerRegistry {
+	std::array<LatencyHistogram, Profiler::FUNCTIONS_NUM> histograms;
+	std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+	std::atomic<bool> trace_enabled{false};
+	std::mutex mutex;
+	std::string trace_directory;
+	std::string trace_last_path;
+	size_t frame = 0;
+	size_t threads_total = 0;
+	std::set<ThreadTrace*> threads;
+	/// Events of threads that finished during the frame
+	std::vector<std::pair<size_t, TraceEvent>> retired;
+};
+
+ProfilerRegistry& getRegistry() {
+	// never destroyed, so thread-local buffers may unregister at any stage of the program termination
+	static ProfilerRegistry* registry = new ProfilerRegistry();
+	return *registry;
+}
+
+/// Registers the buffer of the calling thread for the lifetime of the thread
+struct ThreadTraceHandle {
+	ThreadTraceHandle() {
+		auto& registry = getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		trace.thread_id = registry.threads_total++;
+		registry.threads.insert(&trace);
+	}
+
+	~ThreadTraceHandle() {
+		auto& registry = getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		std::lock_guard<std::mutex> lock_trace(trace.mutex);
+		for (const auto& event: trace.events) {
+			registry.retired.emplace_back(trace.thread_id, event);
+		}
+		registry.threads.erase(&trace);
+	}
+
+	ThreadTrace trace;
+};
+
+ThreadTrace& getThreadTrace() {
+	static thread_local ThreadTraceHandle handle;
+	return handle.trace;
+}
+
+} // namespace
+
+LatencyHistogram& Profiler::getHistogram(ProfiledFunction function) {
+	return getRegistry().histograms.at(static_cast<size_t>(function));
+}
+
+const char* Profiler::getName(ProfiledFunction function) {
+	switch (function) {
+		case ProfiledFunction::PERSONAL_SPACE_INTRUSION:
+			return "PersonalSpaceIntrusion";
+		case ProfiledFunction::PERSONAL_SPACE_INTRUSION_NORMALIZE:
+			return "PersonalSpaceIntrusion::normalize";
+		case ProfiledFunction::PERSONAL_SPACE_GAUSSIAN:
+			return "PersonalSpaceIntrusion::computePersonalSpaceGaussian";
+		case ProfiledFunction::FORMATION_SPACE_INTRUSION:
+			return "FormationSpaceIntrusion";
+		case ProfiledFunction::FORMATION_SPACE_INTRUSION_NORMALIZE:
+			return "FormationSpaceIntrusion::normalize";
+		case ProfiledFunction::FORMATION_SPACE_GAUSSIAN:
+			return "FormationSpaceIntrusion::computeFormationSpaceGaussian";
+		case ProfiledFunction::HEADING_DIRECTION_DISTURBANCE:
+			return "HeadingDirectionDisturbance";
+		case ProfiledFunction::HEADING_DIRECTION_DISTURBANCE_NORMALIZE:
+			return "HeadingDirectionDisturbance::normalize";
+		case ProfiledFunction::HEADING_DIRECTION_DIRECTION:
+			return "HeadingDirectionDisturbance::computeDirectionDisturbance";
+		case ProfiledFunction::HEADING_DIRECTION_FOV:
+			return "HeadingDirectionDisturbance::computeFovScale";
+		case ProfiledFunction::HEADING_DIRECTION_SPEED:
+			return "HeadingDirectionDisturbance::computeSpeedScale";
+		case ProfiledFunction::HEADING_DIRECTION_DIST:
+			return "HeadingDirectionDisturbance::computeDistScale";
+		case ProfiledFunction::PASSING_SPEED_COMFORT:
+			return "PassingSpeedComfort";
+		case ProfiledFunction::PASSING_SPEED_COMFORT_COMPUTE:
+			return "PassingSpeedComfort::computeSpeedComfort";
+		case ProfiledFunction::ELLIPSE_FITTING:
+			return "EllipseFitting";
+		default:
+			return "unknown";
+	}
+}
+
+void Profiler::reset() {
+	for (auto& histogram: getRegistry().histograms) {
+		histogram.reset();
+	}
+}
+
+std::string Profiler::getReport() {
+	std::ostringstream report;
+	char line[256];
+	std::snprintf(
+		line, sizeof(line), "%-56s %10s %10s %10s %10s %10s\n",
+		"function", "count", "mean [ns]", "p50 [ns]", "p99 [ns]", "max [ns]"
+	);
+	report << line;
+	for (size_t i = 0; i < FUNCTIONS_NUM; i++) {
+		auto function = static_cast<ProfiledFunction>(i);
+		const auto& histogram = getHistogram(function);
+		if (histogram.getCount() == 0) {
+			continue;
+		}
+		std::snprintf(
+			line, sizeof(line), "%-56s %10lu %10.0f %10lu %10lu %10lu\n",
+			getName(function),
+			static_cast<unsigned long>(histogram.getCount()),
+			histogram.getMean(),
+			static_cast<unsigned long>(histogram.getPercentile(50.0)),
+			static_cast<unsigned long>(histogram.getPercentile(99.0)),
+			static_cast<unsigned long>(histogram.getMax())
+		);
+		report << line;
+	}
+	return report.str();
+}
+
+void Profiler::enableTrace(const std::string& output_directory) {
+	auto& registry = getRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	registry.trace_directory = output_directory;
+	registry.trace_enabled = true;
+}
+
+void Profiler::disableTrace() {
+	getRegistry().trace_enabled = false;
+}
+
+bool Profiler::isTraceEnabled() {
+	return getRegistry().trace_enabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::startFrame() {
+	auto& registry = getRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	for (auto* trace: registry.threads) {
+		std::lock_guard<std::mutex> lock_trace(trace->mutex);
+		trace->events.clear();
+	}
+	registry.retired.clear();
+}
+
+bool Profiler::finishFrame() {
+	auto& registry = getRegistry();
+	if (!isTraceEnabled()) {
+		return false;
+	}
+
+	// collect events of all threads
+	std::vector<std::pair<size_t, TraceEvent>> events;
+	std::string path;
+	{
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		events.swap(registry.retired);
+		for (auto* trace: registry.threads) {
+			std::lock_guard<std::mutex> lock_trace(trace->mutex);
+			for (const auto& event: trace->events) {
+				events.emplace_back(trace->thread_id, event);
+			}
+			trace->events.clear();
+		}
+		char filename[64];
+		std::snprintf(filename, sizeof(filename), "frame_%06zu.json", registry.frame++);
+		path = registry.trace_directory + "/" + filename;
+	}
+
+	std::ofstream file(path);
+	if (!file.is_open()) {
+		return false;
+	}
+	file << "{\"traceEvents\":[";
+	for (size_t i = 0; i < events.size(); i++) {
+		const auto& event = events[i].second;
+		char entry[256];
+		// timestamps are expressed in microseconds
+		std::snprintf(
+			entry, sizeof(entry),
+			"%s\n{\"name\":\"%s\",\"cat\":\"social_nav_utils\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%zu}",
+			i == 0 ? "" : ",",
+			getName(event.function),
+			event.start / 1e3,
+			event.duration / 1e3,
+			events[i].first
+		);
+		file << entry;
+	}
+	file << "\n],\"displayTimeUnit\":\"ns\"}\n";
+	file.close();
+	if (file.fail()) {
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	registry.trace_last_path = path;
+	return true;
+}
+
+std::string Profiler::getLastTracePath() {
+	auto& registry = getRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	return registry.trace_last_path;
+}
+
+void Profiler::record(
+	ProfiledFunction function,
+	std::chrono::steady_clock::time_point start,
+	std::chrono::steady_clock::time_point end
+) {
+	auto& registry = getRegistry();
+	auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+	registry.histograms[static_cast<size_t>(function)].record(static_cast<uint64_t>(std::max(duration, int64_t(0))));
+
+	if (!registry.trace_enabled.load(std::memory_order_relaxed)) {
+		return;
+	}
+	auto since_epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(start - registry.epoch).count();
+	auto& trace = getThreadTrace();
+	std::lock_guard<std::mutex> lock(trace.mutex);
+	trace.events.push_back(TraceEvent{function, since_epoch, duration});
+}
+
+} // namespace social_nav_utils
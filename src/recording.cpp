@@ -0,0 +1,285 @@
+#include <social_nav_utils/recording.h>
+
+#include <social_nav_utils/ellipse_fitting.h>
+#include <social_nav_utils/formation_space_intrusion.h>
+#include <social_nav_utils/heading_direction_disturbance.h>
+#include <social_nav_utils/passing_speed_comfort.h>
+#include <social_nav_utils/personal_space_intrusion.h>
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+
+namespace social_nav_utils {
+
+constexpr char Recorder::MAGIC[9];
+
+namespace {
+
+constexpr size_t MAGIC_LEN = sizeof(Recorder::MAGIC) - 1;
+
+struct RecorderState {
+	std::mutex mutex;
+	std::FILE* file = nullptr;
+	std::atomic<bool> active{false};
+	/// Set when a write failed (e.g., a full disk); the log is incomplete then and no more records are written
+	bool write_error = false;
+};
+
+RecorderState& getState() {
+	static RecorderState state;
+	return state;
+}
+
+/// Expected numbers of inputs and outputs; 0 inputs stand for a variable number
+struct RecordLayout {
+	uint32_t inputs_num;
+	uint32_t outputs_num;
+};
+
+RecordLayout getLayout(RecordType type) {
+	switch (type) {
+		case RecordType::PERSONAL_SPACE_GAUSSIAN:
+			return {13, 1};
+		case RecordType::FORMATION_SPACE_GAUSSIAN:
+			return {10, 1};
+		case RecordType::HEADING_DIRECTION_DIRECTION:
+			return {10, 1};
+		case RecordType::HEADING_DIRECTION_FOV:
+			return {2, 1};
+		case RecordType::HEADING_DIRECTION_SPEED:
+			return {2, 1};
+		case RecordType::HEADING_DIRECTION_DIST:
+			return {4, 1};
+		case RecordType::PASSING_SPEED_COMFORT:
+			return {2, 1};
+		case RecordType::ELLIPSE_FITTING:
+			return {0, 6};
+		default:
+			throw std::invalid_argument("Unknown record type");
+	}
+}
+
+/// Appends the record to the log; recording stops at the first failed write (see @ref RecorderState::write_error)
+void writeRecord(
+	RecorderState& state,
+	RecordType type,
+	const double* inputs,
+	uint32_t inputs_num,
+	const double* outputs,
+	uint32_t outputs_num
+) {
+	if (state.file == nullptr || state.write_error) {
+		return;
+	}
+	uint8_t type_id = static_cast<uint8_t>(type);
+	bool ok = std::fwrite(&type_id, sizeof(type_id), 1, state.file) == 1
+		&& std::fwrite(&inputs_num, sizeof(inputs_num), 1, state.file) == 1
+		&& std::fwrite(&outputs_num, sizeof(outputs_num), 1, state.file) == 1
+		&& std::fwrite(inputs, sizeof(double), inputs_num, state.file) == inputs_num
+		&& std::fwrite(outputs, sizeof(double), outputs_num, state.file) == outputs_num;
+	if (!ok) {
+		state.write_error = true;
+		state.active.store(false);
+	}
+}
+
+/// Closes the log, returns false if any write or the close failed
+bool closeLog(RecorderState& state) {
+	if (state.file == nullptr) {
+		return true;
+	}
+	bool ok = !state.write_error && std::ferror(state.file) == 0;
+	ok = (std::fclose(state.file) == 0) && ok;
+	state.file = nullptr;
+	state.write_error = false;
+	return ok;
+}
+
+} // namespace
+
+bool Recorder::start(const std::string& path) {
+	auto& state = getState();
+	std::lock_guard<std::mutex> lock(state.mutex);
+	state.active.store(false);
+	closeLog(state);
+	state.file = std::fopen(path.c_str(), "wb");
+	if (state.file == nullptr) {
+		return false;
+	}
+	if (std::fwrite(MAGIC, 1, MAGIC_LEN, state.file) != MAGIC_LEN) {
+		closeLog(state);
+		return false;
+	}
+	state.active.store(true);
+	return true;
+}
+
+bool Recorder::stop() {
+	auto& state = getState();
+	std::lock_guard<std::mutex> lock(state.mutex);
+	state.active.store(false);
+	return closeLog(state);
+}
+
+bool Recorder::isActive() {
+	return getState().active.load(std::memory_order_relaxed);
+}
+
+void Recorder::write(RecordType type, const std::vector<double>& inputs, const std::vector<double>& outputs) {
+	auto& state = getState();
+	std::lock_guard<std::mutex> lock(state.mutex);
+	writeRecord(state, type, inputs.data(), inputs.size(), outputs.data(), outputs.size());
+}
+
+void Recorder::write(RecordType type, std::initializer_list<double> inputs, std::initializer_list<double> outputs) {
+	auto& state = getState();
+	std::lock_guard<std::mutex> lock(state.mutex);
+	writeRecord(state, type, inputs.begin(), inputs.size(), outputs.begin(), outputs.size());
+}
+
+RecordReader::RecordReader(const std::string& path):
+	file_(std::fopen(path.c_str(), "rb"))
+{
+	if (file_ == nullptr) {
+		throw std::runtime_error("Could not open the log: " + path);
+	}
+	char magic[MAGIC_LEN];
+	if (std::fread(magic, 1, MAGIC_LEN, file_) != MAGIC_LEN || std::memcmp(magic, Recorder::MAGIC, MAGIC_LEN) != 0) {
+		std::fclose(file_);
+		throw std::runtime_error("Not a valid log: " + path);
+	}
+	// size bounds the number of values of a record before they are allocated
+	if (
+		std::fseek(file_, 0, SEEK_END) != 0
+		|| (size_ = std::ftell(file_)) < 0
+		|| std::fseek(file_, MAGIC_LEN, SEEK_SET) != 0
+	) {
+		std::fclose(file_);
+		throw std::runtime_error("Could not read the log: " + path);
+	}
+}
+
+RecordReader::~RecordReader() {
+	std::fclose(file_);
+}
+
+bool RecordReader::next(Record& record) {
+	uint8_t type_id = 0;
+	if (std::fread(&type_id, sizeof(type_id), 1, file_) != 1) {
+		return false;
+	}
+	if (type_id >= static_cast<uint8_t>(RecordType::TYPES_NUM)) {
+		throw std::runtime_error("Log contains an unknown record type");
+	}
+	uint32_t inputs_num = 0;
+	uint32_t outputs_num = 0;
+	if (
+		std::fread(&inputs_num, sizeof(inputs_num), 1, file_) != 1
+		|| std::fread(&outputs_num, sizeof(outputs_num), 1, file_) != 1
+	) {
+		throw std::runtime_error("Log is truncated");
+	}
+	record.type = static_cast<RecordType>(type_id);
+	const auto layout = getLayout(record.type);
+	const long remaining = size_ - std::ftell(file_);
+	if (
+		(layout.inputs_num != 0 && inputs_num != layout.inputs_num)
+		|| outputs_num != layout.outputs_num
+		|| (static_cast<uint64_t>(inputs_num) + outputs_num) * sizeof(double) > static_cast<uint64_t>(remaining)
+	) {
+		throw std::runtime_error("Log is corrupted");
+	}
+	record.inputs.resize(inputs_num);
+	record.outputs.resize(outputs_num);
+	if (
+		std::fread(record.inputs.data(), sizeof(double), inputs_num, file_) != inputs_num
+		|| std::fread(record.outputs.data(), sizeof(double), outputs_num, file_) != outputs_num
+	) {
+		throw std::runtime_error("Log is truncated");
+	}
+	return true;
+}
+
+void replayRecord(const Record& record, std::vector<double>& outputs) {
+	const auto layout = getLayout(record.type);
+	const auto& in = record.inputs;
+	bool inputs_valid = layout.inputs_num == 0
+		? (!in.empty() && in.size() % 2 == 0)
+		: in.size() == layout.inputs_num;
+	if (!inputs_valid) {
+		throw std::invalid_argument("Invalid number of inputs of the record");
+	}
+
+	outputs.resize(layout.outputs_num);
+	switch (record.type) {
+		case RecordType::PERSONAL_SPACE_GAUSSIAN:
+			outputs[0] = PersonalSpaceIntrusion::computePersonalSpaceGaussian(
+				in[0], in[1], in[2], in[3], in[4], in[5], in[6], in[7], in[8], in[9], in[10], in[11], in[12] != 0.0
+			);
+			break;
+		case RecordType::FORMATION_SPACE_GAUSSIAN:
+			outputs[0] = FormationSpaceIntrusion::computeFormationSpaceGaussian(
+				in[0], in[1], in[2], in[3], in[4], in[5], in[6], in[7], in[8], in[9]
+			);
+			break;
+		case RecordType::HEADING_DIRECTION_DIRECTION:
+			outputs[0] = HeadingDirectionDisturbance::computeDirectionDisturbance(
+				in[0], in[1], in[2], in[3], in[4], in[5], in[6], in[7], in[8], in[9]
+			);
+			break;
+		case RecordType::HEADING_DIRECTION_FOV:
+			outputs[0] = HeadingDirectionDisturbance::computeFovScale(in[0], in[1]);
+			break;
+		case RecordType::HEADING_DIRECTION_SPEED:
+			outputs[0] = HeadingDirectionDisturbance::computeSpeedScale(in[0], in[1]);
+			break;
+		case RecordType::HEADING_DIRECTION_DIST:
+			outputs[0] = HeadingDirectionDisturbance::computeDistScale(in[0], in[1], in[2], in[3]);
+			break;
+		case RecordType::PASSING_SPEED_COMFORT:
+			outputs[0] = PassingSpeedComfort::computeSpeedComfort(in[0], in[1]);
+			break;
+		case RecordType::ELLIPSE_FITTING: {
+			size_t points_num = in.size() / 2;
+			std::vector<double> x(in.cbegin(), in.cbegin() + points_num);
+			std::vector<double> y(in.cbegin() + points_num, in.cend());
+			EllipseFitting ellipse(x, y);
+			outputs[0] = ellipse.getCenterX();
+			outputs[1] = ellipse.getCenterY();
+			outputs[2] = ellipse.getSemiAxisMajor();
+			outputs[3] = ellipse.getSemiAxisMinor();
+			outputs[4] = ellipse.getOrientation();
+			outputs[5] = ellipse.usedFallback() ? 1.0 : 0.0;
+			break;
+		}
+		default:
+			throw std::invalid_argument("Unknown record type");
+	}
+}
+
+const char* getRecordTypeName(RecordType type) {
+	switch (type) {
+		case RecordType::PERSONAL_SPACE_GAUSSIAN:
+			return "PersonalSpaceIntrusion::computePersonalSpaceGaussian";
+		case RecordType::FORMATION_SPACE_GAUSSIAN:
+			return "FormationSpaceIntrusion::computeFormationSpaceGaussian";
+		case RecordType::HEADING_DIRECTION_DIRECTION:
+			return "HeadingDirectionDisturbance::computeDirectionDisturbance";
+		case RecordType::HEADING_DIRECTION_FOV:
+			return "HeadingDirectionDisturbance::computeFovScale";
+		case RecordType::HEADING_DIRECTION_SPEED:
+			return "HeadingDirectionDisturbance::computeSpeedScale";
+		case RecordType::HEADING_DIRECTION_DIST:
+			return "HeadingDirectionDisturbance::computeDistScale";
+		case RecordType::PASSING_SPEED_COMFORT:
+			return "PassingSpeedComfort::computeSpeedComfort";
+		case RecordType::ELLIPSE_FITTING:
+			return "EllipseFitting::EllipseFitting";
+		default:
+			return "unknown";
+	}
+}
+
+} // namespace social_nav_utils
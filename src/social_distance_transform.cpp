@@ -0,0 +1,265 @@
+#include <social_nav_utils/social_distance_transform.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+namespace social_nav_utils {
+
+namespace {
+
+constexpr double INF = std::numeric_limits<double>::infinity();
+
+/// 8-connected neighborhood ordered counter-clockwise, so the opposite of direction `d` is `(d + 4) % 8`
+constexpr int DIRECTIONS[8][2] = {{1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}};
+
+/// Length of the move in the direction (in cells)
+constexpr double LENGTHS[8] = {1.0, M_SQRT2, 1.0, M_SQRT2, 1.0, M_SQRT2, 1.0, M_SQRT2};
+
+} // namespace
+
+SocialDistanceTransform::Parameters::Parameters():
+	resolution(0.05),
+	social_weight(10.0),
+	lethal_cost(INF),
+	sweeps_max(1000)
+{}
+
+SocialDistanceTransform::SocialDistanceTransform(size_t width, size_t height, const Parameters& params):
+	params_(params),
+	width_(width),
+	height_(height),
+	goal_(0),
+	sweeps_num_(0),
+	repaired_num_(0)
+{
+	if (!(params.resolution > 0.0 && params.social_weight >= 0.0) || width == 0 || height == 0) {
+		throw std::invalid_argument("Invalid parameters of the social distance transform");
+	}
+	distances_.assign(width * height, INF);
+	half_costs_.assign(width * height, INF);
+	parents_.assign(width * height, NO_PARENT);
+}
+
+void SocialDistanceTransform::compute(const double* costs, size_t goal_col, size_t goal_row) {
+	if (goal_col >= width_ || goal_row >= height_) {
+		throw std::out_of_range("Goal of the social distance transform out of the grid");
+	}
+	goal_ = goal_row * width_ + goal_col;
+	for (size_t i = 0; i < half_costs_.size(); i++) {
+		half_costs_[i] = computeHalfCost(costs[i]);
+	}
+	std::fill(distances_.begin(), distances_.end(), INF);
+	distances_[goal_] = 0.0;
+
+	// each sweep leaves the field consistent with neighbors of its own order, so the field is converged
+	// once a sweep changes nothing after the sweep of the other order
+	sweeps_num_ = 0;
+	while (sweeps_num_ < params_.sweeps_max) {
+		bool changed = (sweeps_num_ % 2 == 0) ? sweepForward() : sweepBackward();
+		sweeps_num_++;
+		if (!changed && sweeps_num_ >= 2) {
+			break;
+		}
+	}
+	computeParents();
+}
+
+void SocialDistanceTransform::update(
+	const double* costs,
+	size_t col_begin,
+	size_t row_begin,
+	size_t col_end,
+	size_t row_end
+) {
+	col_end = std::min(col_end, width_);
+	row_end = std::min(row_end, height_);
+	invalidated_.clear();
+	front_.clear();
+	repaired_num_ = 0;
+	if (col_begin >= col_end || row_begin >= row_end) {
+		return;
+	}
+
+	// changed cells lose their distances, whether their costs rose or fell (the goal keeps zero)
+	for (size_t row = row_begin; row < row_end; row++) {
+		for (size_t col = col_begin; col < col_end; col++) {
+			size_t cell = row * width_ + col;
+			half_costs_[cell] = computeHalfCost(costs[cell]);
+			if (cell != goal_) {
+				distances_[cell] = INF;
+				parents_[cell] = NO_PARENT;
+			}
+			invalidated_.push_back(cell);
+		}
+	}
+	// so do cells whose shortest paths pass through them (descendants in the tree of shortest paths)
+	for (size_t i = 0; i < invalidated_.size(); i++) {
+		const size_t cell = invalidated_[i];
+		const int col = static_cast<int>(cell % width_);
+		const int row = static_cast<int>(cell / width_);
+		for (uint8_t d = 0; d < 8; d++) {
+			int ncol = col + DIRECTIONS[d][0];
+			int nrow = row + DIRECTIONS[d][1];
+			if (ncol < 0 || nrow < 0 || ncol >= static_cast<int>(width_) || nrow >= static_cast<int>(height_)) {
+				continue;
+			}
+			size_t neighbor = nrow * width_ + ncol;
+			if (parents_[neighbor] == (d + 4) % 8) {
+				distances_[neighbor] = INF;
+				parents_[neighbor] = NO_PARENT;
+				invalidated_.push_back(neighbor);
+			}
+		}
+	}
+	repaired_num_ = invalidated_.size();
+
+	// valid cells bordering the invalidated ones seed the wavefront
+	for (size_t cell: invalidated_) {
+		const int col = static_cast<int>(cell % width_);
+		const int row = static_cast<int>(cell / width_);
+		for (uint8_t d = 0; d < 8; d++) {
+			int ncol = col + DIRECTIONS[d][0];
+			int nrow = row + DIRECTIONS[d][1];
+			if (ncol < 0 || nrow < 0 || ncol >= static_cast<int>(width_) || nrow >= static_cast<int>(height_)) {
+				continue;
+			}
+			size_t neighbor = nrow * width_ + ncol;
+			if (distances_[neighbor] < INF) {
+				front_.push_back({distances_[neighbor], neighbor});
+			}
+		}
+	}
+	std::make_heap(front_.begin(), front_.end(), std::greater<Front>());
+
+	// Dijkstra's wavefront; it also lowers valid cells reached through cells whose costs fell
+	while (!front_.empty()) {
+		std::pop_heap(front_.begin(), front_.end(), std::greater<Front>());
+		Front current = front_.back();
+		front_.pop_back();
+		if (current.distance > distances_[current.cell]) {
+			// stale entry
+			continue;
+		}
+		const int col = static_cast<int>(current.cell % width_);
+		const int row = static_cast<int>(current.cell / width_);
+		const double half_cost = half_costs_[current.cell];
+		for (uint8_t d = 0; d < 8; d++) {
+			int ncol = col + DIRECTIONS[d][0];
+			int nrow = row + DIRECTIONS[d][1];
+			if (ncol < 0 || nrow < 0 || ncol >= static_cast<int>(width_) || nrow >= static_cast<int>(height_)) {
+				continue;
+			}
+			size_t neighbor = nrow * width_ + ncol;
+			double distance = current.distance + (half_cost + half_costs_[neighbor]) * LENGTHS[d];
+			if (distance < distances_[neighbor]) {
+				distances_[neighbor] = distance;
+				parents_[neighbor] = static_cast<uint8_t>((d + 4) % 8);
+				front_.push_back({distance, neighbor});
+				std::push_heap(front_.begin(), front_.end(), std::greater<Front>());
+			}
+		}
+	}
+}
+
+double SocialDistanceTransform::computeHalfCost(double cost) const {
+	if (!(cost < params_.lethal_cost)) {
+		return INF;
+	}
+	return 0.5 * params_.resolution * (1.0 + params_.social_weight * std::max(cost, 0.0));
+}
+
+bool SocialDistanceTransform::sweepForward() {
+	bool changed = false;
+	for (size_t row = 0; row < height_; row++) {
+		double* distances = distances_.data() + row * width_;
+		const double* half_costs = half_costs_.data() + row * width_;
+		// the previous row is unavailable for the first one
+		const double* distances_prev = row > 0 ? distances - width_ : nullptr;
+		const double* half_costs_prev = row > 0 ? half_costs - width_ : nullptr;
+		for (size_t col = 0; col < width_; col++) {
+			const double h = half_costs[col];
+			double distance = distances[col];
+			if (col > 0) {
+				distance = std::min(distance, distances[col - 1] + (h + half_costs[col - 1]));
+			}
+			if (distances_prev) {
+				distance = std::min(distance, distances_prev[col] + (h + half_costs_prev[col]));
+				if (col > 0) {
+					distance = std::min(distance, distances_prev[col - 1] + (h + half_costs_prev[col - 1]) * M_SQRT2);
+				}
+				if (col + 1 < width_) {
+					distance = std::min(distance, distances_prev[col + 1] + (h + half_costs_prev[col + 1]) * M_SQRT2);
+				}
+			}
+			if (distance < distances[col]) {
+				distances[col] = distance;
+				changed = true;
+			}
+		}
+	}
+	return changed;
+}
+
+bool SocialDistanceTransform::sweepBackward() {
+	bool changed = false;
+	for (size_t row = height_; row-- > 0;) {
+		double* distances = distances_.data() + row * width_;
+		const double* half_costs = half_costs_.data() + row * width_;
+		// the next row is unavailable for the last one
+		const double* distances_next = row + 1 < height_ ? distances + width_ : nullptr;
+		const double* half_costs_next = row + 1 < height_ ? half_costs + width_ : nullptr;
+		for (size_t col = width_; col-- > 0;) {
+			const double h = half_costs[col];
+			double distance = distances[col];
+			if (col + 1 < width_) {
+				distance = std::min(distance, distances[col + 1] + (h + half_costs[col + 1]));
+			}
+			if (distances_next) {
+				distance = std::min(distance, distances_next[col] + (h + half_costs_next[col]));
+				if (col + 1 < width_) {
+					distance = std::min(distance, distances_next[col + 1] + (h + half_costs_next[col + 1]) * M_SQRT2);
+				}
+				if (col > 0) {
+					distance = std::min(distance, distances_next[col - 1] + (h + half_costs_next[col - 1]) * M_SQRT2);
+				}
+			}
+			if (distance < distances[col]) {
+				distances[col] = distance;
+				changed = true;
+			}
+		}
+	}
+	return changed;
+}
+
+void SocialDistanceTransform::computeParents() {
+	for (size_t row = 0; row < height_; row++) {
+		for (size_t col = 0; col < width_; col++) {
+			const size_t cell = row * width_ + col;
+			parents_[cell] = NO_PARENT;
+			if (cell == goal_ || distances_[cell] == INF) {
+				continue;
+			}
+			// neighbor attaining the distance; it is strictly closer to the goal, so parents form a tree
+			double best = INF;
+			for (uint8_t d = 0; d < 8; d++) {
+				int ncol = static_cast<int>(col) + DIRECTIONS[d][0];
+				int nrow = static_cast<int>(row) + DIRECTIONS[d][1];
+				if (ncol < 0 || nrow < 0 || ncol >= static_cast<int>(width_) || nrow >= static_cast<int>(height_)) {
+					continue;
+				}
+				size_t neighbor = nrow * width_ + ncol;
+				double distance = distances_[neighbor] + (half_costs_[cell] + half_costs_[neighbor]) * LENGTHS[d];
+				if (distance < best) {
+					best = distance;
+					parents_[cell] = d;
+				}
+			}
+		}
+	}
+}
+
+} // namespace social_nav_utils
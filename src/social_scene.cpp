@@ -0,0 +1,6 @@
+#include <social_nav_utils/social_scene.h>
+
+// in the header-only mode, the header itself provides inline definitions
+#ifndef SOCIAL_NAV_UTILS_HEADER_ONLY
+#include <social_nav_utils/impl/social_scene.h>
+#endif
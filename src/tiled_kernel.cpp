@@ -0,0 +1,237 @@
+#include <social_nav_utils/tiled_kernel.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace social_nav_utils {
+
+/**
+ * Structure-of-arrays storage of a block of asymmetric Gaussians (front and rear parts)
+ *
+ * Symmetric Gaussians (e.g., O-space) are stored with a zero heading vector and equal front/rear parameters.
+ */
+struct GaussianBlock {
+	static constexpr size_t SIZE = TiledKernel::TILE_ENTITIES;
+
+	alignas(64) double mean_x[SIZE];
+	alignas(64) double mean_y[SIZE];
+	alignas(64) double heading_x[SIZE];
+	alignas(64) double heading_y[SIZE];
+	// inverse of the covariance matrices and scales (normalization factors)
+	alignas(64) double front_xx[SIZE];
+	alignas(64) double front_xy[SIZE];
+	alignas(64) double front_yx[SIZE];
+	alignas(64) double front_yy[SIZE];
+	alignas(64) double front_scale[SIZE];
+	alignas(64) double rear_xx[SIZE];
+	alignas(64) double rear_xy[SIZE];
+	alignas(64) double rear_yx[SIZE];
+	alignas(64) double rear_yy[SIZE];
+	alignas(64) double rear_scale[SIZE];
+	size_t size;
+
+	void setFront(size_t i, const GaussianModel& gaussian, double scale) {
+		auto cov_inv = gaussian.getCovarianceInverse();
+		mean_x[i] = gaussian.getMeanX();
+		mean_y[i] = gaussian.getMeanY();
+		front_xx[i] = cov_inv(0, 0);
+		front_xy[i] = cov_inv(0, 1);
+		front_yx[i] = cov_inv(1, 0);
+		front_yy[i] = cov_inv(1, 1);
+		front_scale[i] = scale * gaussian.getNormalization();
+	}
+
+	void setRear(size_t i, const GaussianModel& gaussian, double scale) {
+		auto cov_inv = gaussian.getCovarianceInverse();
+		rear_xx[i] = cov_inv(0, 0);
+		rear_xy[i] = cov_inv(0, 1);
+		rear_yx[i] = cov_inv(1, 0);
+		rear_yy[i] = cov_inv(1, 1);
+		rear_scale[i] = scale * gaussian.getNormalization();
+	}
+
+	void pack(const PersonalSpaceModel* const* models, size_t models_num, bool normalize) {
+		size = models_num;
+		for (size_t i = 0; i < size; i++) {
+			const auto& model = *models[i];
+			double scale = normalize ? (1.0 / model.getMax()) : 1.0;
+			setFront(i, model.getGaussianFront(), scale * model.getScaleFront());
+			setRear(i, model.getGaussianRear(), scale * model.getScaleRear());
+			heading_x[i] = model.getClassifier().getHeadingX();
+			heading_y[i] = model.getClassifier().getHeadingY();
+		}
+	}
+
+	void pack(const FormationSpaceModel* const* models, size_t models_num, bool normalize) {
+		size = models_num;
+		for (size_t i = 0; i < size; i++) {
+			const auto& model = *models[i];
+			double scale = normalize ? (1.0 / model.getMax()) : 1.0;
+			setFront(i, model.getGaussian(), scale);
+			setRear(i, model.getGaussian(), scale);
+			heading_x[i] = 0.0;
+			heading_y[i] = 0.0;
+		}
+	}
+};
+
+/**
+ * Streams a range of poses through the i-th Gaussian of the block
+ *
+ * @tparam Top functor that stores the cost computed for the j-th pose
+ */
+template <typename Top>
+static inline void streamPoses(
+	const GaussianBlock& block,
+	size_t i,
+	const double* poses_x,
+	const double* poses_y,
+	size_t pose_begin,
+	size_t pose_end,
+	Top op
+) {
+	// parameters of a single entity are kept in registers
+	const double mean_x = block.mean_x[i];
+	const double mean_y = block.mean_y[i];
+	const double heading_x = block.heading_x[i];
+	const double heading_y = block.heading_y[i];
+	const double front_xx = block.front_xx[i];
+	const double front_xy = block.front_xy[i];
+	const double front_yx = block.front_yx[i];
+	const double front_yy = block.front_yy[i];
+	const double front_scale = block.front_scale[i];
+	const double rear_xx = block.rear_xx[i];
+	const double rear_xy = block.rear_xy[i];
+	const double rear_yx = block.rear_yx[i];
+	const double rear_yy = block.rear_yy[i];
+	const double rear_scale = block.rear_scale[i];
+
+	for (size_t j = pose_begin; j < pose_end; j++) {
+		double dx = poses_x[j] - mean_x;
+		double dy = poses_y[j] - mean_y;
+		bool front = (dx * heading_x + dy * heading_y) >= 0.0;
+		double cxx = front ? front_xx : rear_xx;
+		double cxy = front ? front_xy : rear_xy;
+		double cyx = front ? front_yx : rear_yx;
+		double cyy = front ? front_yy : rear_yy;
+		double scale = front ? front_scale : rear_scale;
+		double quadform = dx * (cxx * dx + cxy * dy) + dy * (cyx * dx + cyy * dy);
+		op(j, scale * std::exp(-0.5 * quadform));
+	}
+}
+
+template <typename Tmodel>
+static void fillTiled(
+	const Tmodel* const* models,
+	size_t models_num,
+	const double* poses_x,
+	const double* poses_y,
+	size_t poses_num,
+	double* costs,
+	size_t costs_stride,
+	bool normalize
+) {
+	GaussianBlock block;
+	for (size_t entity_begin = 0; entity_begin < models_num; entity_begin += TiledKernel::TILE_ENTITIES) {
+		block.pack(models + entity_begin, std::min(TiledKernel::TILE_ENTITIES, models_num - entity_begin), normalize);
+		for (size_t pose_begin = 0; pose_begin < poses_num; pose_begin += TiledKernel::TILE_POSES) {
+			size_t pose_end = std::min(pose_begin + TiledKernel::TILE_POSES, poses_num);
+			for (size_t i = 0; i < block.size; i++) {
+				double* row = costs + (entity_begin + i) * costs_stride;
+				streamPoses(
+					block, i, poses_x, poses_y, pose_begin, pose_end,
+					[row](size_t j, double cost) { row[j] = cost; }
+				);
+			}
+		}
+	}
+}
+
+template <typename Tmodel>
+static void reduceTiled(
+	const Tmodel* const* models,
+	size_t models_num,
+	const double* poses_x,
+	const double* poses_y,
+	size_t poses_num,
+	double* costs,
+	CostReduction reduction,
+	bool normalize
+) {
+	std::fill(costs, costs + poses_num, 0.0);
+	GaussianBlock block;
+	for (size_t entity_begin = 0; entity_begin < models_num; entity_begin += TiledKernel::TILE_ENTITIES) {
+		block.pack(models + entity_begin, std::min(TiledKernel::TILE_ENTITIES, models_num - entity_begin), normalize);
+		for (size_t pose_begin = 0; pose_begin < poses_num; pose_begin += TiledKernel::TILE_POSES) {
+			size_t pose_end = std::min(pose_begin + TiledKernel::TILE_POSES, poses_num);
+			// entities are visited in the order of indices for each pose
+			for (size_t i = 0; i < block.size; i++) {
+				if (reduction == CostReduction::SUM) {
+					streamPoses(
+						block, i, poses_x, poses_y, pose_begin, pose_end,
+						[costs](size_t j, double cost) { costs[j] += cost; }
+					);
+				} else {
+					streamPoses(
+						block, i, poses_x, poses_y, pose_begin, pose_end,
+						[costs](size_t j, double cost) { costs[j] = std::max(costs[j], cost); }
+					);
+				}
+			}
+		}
+	}
+}
+
+void TiledKernel::fillPersonalSpace(
+	const PersonalSpaceModel* const* models,
+	size_t models_num,
+	const double* poses_x,
+	const double* poses_y,
+	size_t poses_num,
+	double* costs,
+	size_t costs_stride,
+	bool normalize
+) {
+	fillTiled(models, models_num, poses_x, poses_y, poses_num, costs, costs_stride, normalize);
+}
+
+void TiledKernel::reducePersonalSpace(
+	const PersonalSpaceModel* const* models,
+	size_t models_num,
+	const double* poses_x,
+	const double* poses_y,
+	size_t poses_num,
+	double* costs,
+	CostReduction reduction,
+	bool normalize
+) {
+	reduceTiled(models, models_num, poses_x, poses_y, poses_num, costs, reduction, normalize);
+}
+
+void TiledKernel::fillFormationSpace(
+	const FormationSpaceModel* const* models,
+	size_t models_num,
+	const double* poses_x,
+	const double* poses_y,
+	size_t poses_num,
+	double* costs,
+	size_t costs_stride,
+	bool normalize
+) {
+	fillTiled(models, models_num, poses_x, poses_y, poses_num, costs, costs_stride, normalize);
+}
+
+void TiledKernel::reduceFormationSpace(
+	const FormationSpaceModel* const* models,
+	size_t models_num,
+	const double* poses_x,
+	const double* poses_y,
+	size_t poses_num,
+	double* costs,
+	CostReduction reduction,
+	bool normalize
+) {
+	reduceTiled(models, models_num, poses_x, poses_y, poses_num, costs, reduction, normalize);
+}
+
+} // namespace social_nav_utils
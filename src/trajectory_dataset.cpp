@@ -0,0 +1,248 @@
+#include <social_nav_utils/trajectory_dataset.h>
+
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace social_nav_utils {
+
+constexpr char TrajectoryDataset::MAGIC[9];
+constexpr int64_t TrajectoryDataset::NO_GROUP;
+
+namespace {
+
+constexpr size_t MAGIC_LEN = sizeof(TrajectoryDataset::MAGIC) - 1;
+/// Number of frame columns storing doubles (time and robot state)
+constexpr size_t FRAME_COLUMNS_NUM = 6;
+/// Number of agent columns (all 8-byte wide)
+constexpr size_t AGENT_COLUMNS_NUM = 7;
+
+} // namespace
+
+TrajectoryDataset::TrajectoryDataset(const std::string& path):
+	data_(nullptr),
+	size_(0),
+	index_(nullptr),
+	index_num_(0)
+{
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		throw std::runtime_error("Could not open the dataset: " + path);
+	}
+	struct stat st;
+	if (::fstat(fd, &st) != 0) {
+		::close(fd);
+		throw std::runtime_error("Could not read the size of the dataset: " + path);
+	}
+	size_ = static_cast<size_t>(st.st_size);
+	// magic, number of episodes, magic
+	if (size_ < 3 * MAGIC_LEN) {
+		::close(fd);
+		throw std::runtime_error("Not a valid dataset: " + path);
+	}
+	void* data = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+	// mapping remains valid after closing the descriptor
+	::close(fd);
+	if (data == MAP_FAILED) {
+		throw std::runtime_error("Could not map the dataset: " + path);
+	}
+	data_ = static_cast<const uint8_t*>(data);
+
+	const uint8_t* footer = data_ + size_ - MAGIC_LEN - sizeof(uint64_t);
+	uint64_t episodes_num = 0;
+	std::memcpy(&episodes_num, footer, sizeof(episodes_num));
+	bool valid = std::memcmp(data_, MAGIC, MAGIC_LEN) == 0
+		&& std::memcmp(footer + sizeof(uint64_t), MAGIC, MAGIC_LEN) == 0
+		&& episodes_num <= (size_ - 3 * MAGIC_LEN) / sizeof(IndexEntry);
+	if (valid) {
+		index_num_ = episodes_num;
+		index_ = reinterpret_cast<const IndexEntry*>(footer - index_num_ * sizeof(IndexEntry));
+		size_t index_offset = reinterpret_cast<const uint8_t*>(index_) - data_;
+		for (size_t i = 0; i < index_num_ && valid; i++) {
+			const auto& entry = index_[i];
+			valid = entry.offset >= MAGIC_LEN
+				&& entry.offset % sizeof(uint64_t) == 0
+				&& entry.offset <= index_offset
+				&& computeBlockSize(entry.frames_num, entry.agents_rows_num) <= index_offset - entry.offset;
+		}
+	}
+	if (!valid) {
+		::munmap(const_cast<uint8_t*>(data_), size_);
+		throw std::runtime_error("Not a valid dataset: " + path);
+	}
+}
+
+TrajectoryDataset::~TrajectoryDataset() {
+	::munmap(const_cast<uint8_t*>(data_), size_);
+}
+
+TrajectoryEpisode TrajectoryDataset::getEpisode(size_t episode) const {
+	const auto& entry = index_[episode];
+	const size_t frames_num = entry.frames_num;
+	const size_t rows_num = entry.agents_rows_num;
+
+	TrajectoryEpisode view;
+	view.id = entry.id;
+	view.frames_num = frames_num;
+	view.agents_rows_num = rows_num;
+
+	const double* frame_columns = reinterpret_cast<const double*>(data_ + entry.offset);
+	view.time = frame_columns;
+	view.robot_x = frame_columns + frames_num;
+	view.robot_y = frame_columns + 2 * frames_num;
+	view.robot_yaw = frame_columns + 3 * frames_num;
+	view.robot_vx = frame_columns + 4 * frames_num;
+	view.robot_vy = frame_columns + 5 * frames_num;
+	view.agents_begin = reinterpret_cast<const uint64_t*>(frame_columns + FRAME_COLUMNS_NUM * frames_num);
+
+	const uint8_t* agent_columns = reinterpret_cast<const uint8_t*>(view.agents_begin + frames_num + 1);
+	const size_t column_size = rows_num * sizeof(double);
+	view.agent_id = reinterpret_cast<const int64_t*>(agent_columns);
+	view.agent_x = reinterpret_cast<const double*>(agent_columns + column_size);
+	view.agent_y = reinterpret_cast<const double*>(agent_columns + 2 * column_size);
+	view.agent_yaw = reinterpret_cast<const double*>(agent_columns + 3 * column_size);
+	view.agent_vx = reinterpret_cast<const double*>(agent_columns + 4 * column_size);
+	view.agent_vy = reinterpret_cast<const double*>(agent_columns + 5 * column_size);
+	view.agent_group = reinterpret_cast<const int64_t*>(agent_columns + 6 * column_size);
+
+	// frames must refer to the existing rows only
+	if (view.agents_begin[0] != 0 || view.agents_begin[frames_num] != rows_num) {
+		throw std::runtime_error("Dataset episode has inconsistent agent rows");
+	}
+	for (size_t f = 0; f < frames_num; f++) {
+		if (view.agents_begin[f] > view.agents_begin[f + 1]) {
+			throw std::runtime_error("Dataset episode has inconsistent agent rows");
+		}
+	}
+	return view;
+}
+
+void TrajectoryDataset::releaseEpisode(size_t episode) const {
+	const auto& entry = index_[episode];
+	const size_t page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+	// only whole pages within the episode block, so the neighbouring episodes remain untouched
+	size_t begin = (entry.offset + page_size - 1) / page_size * page_size;
+	size_t end = (entry.offset + computeBlockSize(entry.frames_num, entry.agents_rows_num)) / page_size * page_size;
+	if (end > begin) {
+		::madvise(const_cast<uint8_t*>(data_) + begin, end - begin, MADV_DONTNEED);
+	}
+}
+
+size_t TrajectoryDataset::computeBlockSize(size_t frames_num, size_t agents_rows_num) {
+	return sizeof(double) * ((FRAME_COLUMNS_NUM + 1) * frames_num + 1 + AGENT_COLUMNS_NUM * agents_rows_num);
+}
+
+TrajectoryDatasetWriter::TrajectoryDatasetWriter(const std::string& path):
+	path_(path),
+	file_(std::fopen(path.c_str(), "wb")),
+	offset_(0),
+	episode_open_(false),
+	episode_id_(0)
+{
+	if (file_ == nullptr) {
+		throw std::runtime_error("Could not create the dataset: " + path);
+	}
+	write(TrajectoryDataset::MAGIC, 1, MAGIC_LEN);
+	offset_ = MAGIC_LEN;
+}
+
+TrajectoryDatasetWriter::~TrajectoryDatasetWriter() {
+	try {
+		close();
+	} catch (const std::runtime_error&) {
+	}
+}
+
+void TrajectoryDatasetWriter::beginEpisode(int64_t id) {
+	if (file_ == nullptr) {
+		throw std::logic_error("Dataset writer is closed");
+	}
+	flushEpisode();
+	episode_open_ = true;
+	episode_id_ = id;
+}
+
+void TrajectoryDatasetWriter::addFrame(double time, const RobotSample& robot, const std::vector<AgentSample>& agents) {
+	if (!episode_open_) {
+		throw std::logic_error("Frame added before the episode was started");
+	}
+	if (agents_begin_.empty()) {
+		agents_begin_.push_back(0);
+	}
+	time_.push_back(time);
+	robot_.push_back(robot);
+	agents_.insert(agents_.end(), agents.cbegin(), agents.cend());
+	agents_begin_.push_back(agents_.size());
+}
+
+void TrajectoryDatasetWriter::close() {
+	if (file_ == nullptr) {
+		return;
+	}
+	flushEpisode();
+	write(index_.data(), sizeof(TrajectoryDataset::IndexEntry), index_.size());
+	uint64_t episodes_num = index_.size();
+	write(&episodes_num, sizeof(episodes_num), 1);
+	write(TrajectoryDataset::MAGIC, 1, MAGIC_LEN);
+	// buffered data are written by fclose
+	bool ok = std::fclose(file_) == 0;
+	file_ = nullptr;
+	if (!ok) {
+		throw std::runtime_error("Could not write the dataset: " + path_);
+	}
+}
+
+void TrajectoryDatasetWriter::write(const void* data, size_t size, size_t count) {
+	if (std::fwrite(data, size, count, file_) != count) {
+		std::fclose(file_);
+		file_ = nullptr;
+		episode_open_ = false;
+		throw std::runtime_error("Could not write the dataset: " + path_);
+	}
+}
+
+void TrajectoryDatasetWriter::flushEpisode() {
+	if (!episode_open_) {
+		return;
+	}
+	if (agents_begin_.empty()) {
+		agents_begin_.push_back(0);
+	}
+
+	// column-wise copy of the row-wise samples
+	auto write_column = [this](const auto& samples, auto member) {
+		for (const auto& sample: samples) {
+			auto value = sample.*member;
+			write(&value, sizeof(value), 1);
+		}
+	};
+	write(time_.data(), sizeof(double), time_.size());
+	write_column(robot_, &RobotSample::x);
+	write_column(robot_, &RobotSample::y);
+	write_column(robot_, &RobotSample::yaw);
+	write_column(robot_, &RobotSample::vx);
+	write_column(robot_, &RobotSample::vy);
+	write(agents_begin_.data(), sizeof(uint64_t), agents_begin_.size());
+	write_column(agents_, &AgentSample::id);
+	write_column(agents_, &AgentSample::x);
+	write_column(agents_, &AgentSample::y);
+	write_column(agents_, &AgentSample::yaw);
+	write_column(agents_, &AgentSample::vx);
+	write_column(agents_, &AgentSample::vy);
+	write_column(agents_, &AgentSample::group);
+
+	index_.push_back(TrajectoryDataset::IndexEntry{offset_, episode_id_, time_.size(), agents_.size()});
+	offset_ += TrajectoryDataset::computeBlockSize(time_.size(), agents_.size());
+
+	time_.clear();
+	robot_.clear();
+	agents_begin_.clear();
+	agents_.clear();
+	episode_open_ = false;
+}
+
+} // namespace social_nav_utils
@@ -0,0 +1,128 @@
+#include <social_nav_utils/work_stealing_pool.h>
+
+#include <algorithm>
+
+namespace social_nav_utils {
+
+WorkStealingPool::WorkStealingPool(size_t threads_num):
+	generation_(0),
+	stop_(false),
+	fun_(nullptr),
+	pending_(0)
+{
+	if (threads_num == 0) {
+		threads_num = std::max(std::thread::hardware_concurrency(), 1U);
+	}
+	for (size_t i = 0; i < threads_num; i++) {
+		queues_.push_back(std::make_unique<TaskQueue>());
+	}
+	// worker 0 is the thread calling `run`
+	for (size_t i = 1; i < threads_num; i++) {
+		threads_.emplace_back(&WorkStealingPool::work, this, i);
+	}
+}
+
+WorkStealingPool::~WorkStealingPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stop_ = true;
+	}
+	cv_start_.notify_all();
+	for (auto& thread: threads_) {
+		thread.join();
+	}
+}
+
+void WorkStealingPool::run(size_t tasks_num, const std::function<void(size_t)>& fun) {
+	if (tasks_num == 0) {
+		return;
+	}
+
+	fun_ = &fun;
+	exception_ = nullptr;
+	pending_ = tasks_num;
+	// distribute contiguous ranges of tasks among workers
+	size_t workers_num = queues_.size();
+	for (size_t worker = 0; worker < workers_num; worker++) {
+		size_t begin = tasks_num * worker / workers_num;
+		size_t end = tasks_num * (worker + 1) / workers_num;
+		std::lock_guard<std::mutex> lock(queues_[worker]->mutex);
+		for (size_t task = begin; task < end; task++) {
+			queues_[worker]->tasks.push_back(task);
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		generation_++;
+	}
+	cv_start_.notify_all();
+
+	process(0);
+
+	std::unique_lock<std::mutex> lock(mutex_);
+	cv_done_.wait(lock, [this]() { return pending_ == 0; });
+	fun_ = nullptr;
+	if (exception_) {
+		std::rethrow_exception(exception_);
+	}
+}
+
+void WorkStealingPool::work(size_t worker) {
+	size_t generation_seen = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			cv_start_.wait(lock, [&]() { return stop_ || generation_ != generation_seen; });
+			if (stop_) {
+				return;
+			}
+			generation_seen = generation_;
+		}
+		process(worker);
+	}
+}
+
+void WorkStealingPool::process(size_t worker) {
+	size_t task = 0;
+	while (pop(worker, task)) {
+		try {
+			(*fun_)(task);
+		} catch (...) {
+			std::lock_guard<std::mutex> lock(mutex_);
+			if (!exception_) {
+				exception_ = std::current_exception();
+			}
+		}
+		if (--pending_ == 0) {
+			std::lock_guard<std::mutex> lock(mutex_);
+			cv_done_.notify_all();
+		}
+	}
+}
+
+bool WorkStealingPool::pop(size_t worker, size_t& task) {
+	// own queue first
+	{
+		auto& queue = *queues_[worker];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.tasks.empty()) {
+			task = queue.tasks.front();
+			queue.tasks.pop_front();
+			return true;
+		}
+	}
+	// steal from the others, starting from the neighbour
+	for (size_t i = 1; i < queues_.size(); i++) {
+		auto& queue = *queues_[(worker + i) % queues_.size()];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.tasks.empty()) {
+			task = queue.tasks.back();
+			queue.tasks.pop_back();
+			return true;
+		}
+	}
+	return false;
+}
+
+} // namespace social_nav_utils
@@ -0,0 +1,219 @@
+#pragma once
+
+/**
+ * Test utility that counts heap allocations performed in a scope
+ *
+ * The header replaces the global `operator new` (all variants) and, with glibc, interposes the `malloc` family
+ * so that allocations made by C code and Eigen (which uses `malloc` directly) are counted as well. Replacement
+ * functions must be defined once per executable, so include this header in a single translation unit of a test.
+ *
+ * Allocations of all threads are counted; the measured code should not run concurrently with other code that
+ * allocates (e.g., gtest assertions of other threads).
+ */
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#ifdef __GLIBC__
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t num, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+}
+#endif
+
+namespace social_nav_utils {
+
+/**
+ * @brief Counts heap allocations made between construction and @ref getAllocations
+ *
+ * Usage:
+ * @code
+ * AllocationCounter counter;
+ * // code under test
+ * EXPECT_EQ(counter.getAllocations(), 0);
+ * @endcode
+ */
+class AllocationCounter {
+public:
+	AllocationCounter():
+		start_(getTotal())
+	{}
+
+	/// Number of allocations since construction (or the last @ref restart)
+	inline size_t getAllocations() const {
+		return getTotal() - start_;
+	}
+
+	inline void restart() {
+		start_ = getTotal();
+	}
+
+	/// Number of allocations since the start of the program
+	static inline size_t getTotal() {
+		return total().load(std::memory_order_relaxed);
+	}
+
+	/// Called by the replaced allocation functions
+	static inline void increment() {
+		total().fetch_add(1, std::memory_order_relaxed);
+	}
+
+	/// Allocates without counting; the memory must be released with @ref deallocate
+	static inline void* allocate(size_t size) {
+#ifdef __GLIBC__
+		return __libc_malloc(size);
+#else
+		return std::malloc(size);
+#endif
+	}
+
+	/// Allocates aligned memory without counting; the memory must be released with @ref deallocate
+	static inline void* allocate(size_t size, size_t alignment) {
+#ifdef __GLIBC__
+		return __libc_memalign(alignment, size);
+#else
+		return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+	}
+
+	/// Releases memory of @ref allocate
+	static inline void deallocate(void* ptr) {
+#ifdef __GLIBC__
+		__libc_free(ptr);
+#else
+		std::free(ptr);
+#endif
+	}
+
+protected:
+	static inline std::atomic<size_t>& total() {
+		static std::atomic<size_t> total(0);
+		return total;
+	}
+
+	size_t start_;
+};
+
+} // namespace social_nav_utils
+
+#ifdef __GLIBC__
+// C allocation functions of the executable take precedence over the ones of libc
+extern "C" {
+
+void* malloc(size_t size) noexcept {
+	social_nav_utils::AllocationCounter::increment();
+	return __libc_malloc(size);
+}
+
+void* calloc(size_t num, size_t size) noexcept {
+	social_nav_utils::AllocationCounter::increment();
+	return __libc_calloc(num, size);
+}
+
+void* realloc(void* ptr, size_t size) noexcept {
+	social_nav_utils::AllocationCounter::increment();
+	return __libc_realloc(ptr, size);
+}
+
+void* memalign(size_t alignment, size_t size) noexcept {
+	social_nav_utils::AllocationCounter::increment();
+	return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept {
+	social_nav_utils::AllocationCounter::increment();
+	return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size) noexcept {
+	social_nav_utils::AllocationCounter::increment();
+	*ptr = __libc_memalign(alignment, size);
+	return *ptr == nullptr ? ENOMEM : 0;
+}
+
+} // extern "C"
+#endif
+
+// global operators call the uncounted allocation directly, so each allocation is counted once
+
+void* operator new(std::size_t size) {
+	social_nav_utils::AllocationCounter::increment();
+	void* ptr = social_nav_utils::AllocationCounter::allocate(size == 0 ? 1 : size);
+	if (ptr == nullptr) {
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void* operator new[](std::size_t size) {
+	return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	social_nav_utils::AllocationCounter::increment();
+	return social_nav_utils::AllocationCounter::allocate(size == 0 ? 1 : size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+	return operator new(size, tag);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+	social_nav_utils::AllocationCounter::increment();
+	void* ptr = social_nav_utils::AllocationCounter::allocate(size == 0 ? 1 : size, static_cast<size_t>(alignment));
+	if (ptr == nullptr) {
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+	return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+	social_nav_utils::AllocationCounter::increment();
+	return social_nav_utils::AllocationCounter::allocate(size == 0 ? 1 : size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t& tag) noexcept {
+	return operator new(size, alignment, tag);
+}
+
+void operator delete(void* ptr) noexcept {
+	social_nav_utils::AllocationCounter::deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+	social_nav_utils::AllocationCounter::deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+	social_nav_utils::AllocationCounter::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+	social_nav_utils::AllocationCounter::deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+	social_nav_utils::AllocationCounter::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+	social_nav_utils::AllocationCounter::deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+	social_nav_utils::AllocationCounter::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+	social_nav_utils::AllocationCounter::deallocate(ptr);
+}
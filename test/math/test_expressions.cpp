@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <social_nav_utils/math/core.h>
+
+using namespace social_nav_utils;
+
+/// Eager evaluation of a product with all intermediate matrices
+static Matrix2d multiply(const Matrix2d& m1, const Matrix2d& m2) {
+	return m1 * m2;
+}
+
+TEST(TestExpressions, rotatedCovariance) {
+	Rotation2Dd r(M_PI / 6.0);
+	Matrix2d cov(0.75, 0.2, 0.2, 0.3);
+	Matrix2d expected = multiply(multiply(r, cov), r.transpose());
+
+	Matrix2d result = r * cov * r.inverse();
+	ASSERT_NEAR(result(0, 0), expected(0, 0), 1e-12);
+	ASSERT_NEAR(result(0, 1), expected(0, 1), 1e-12);
+	ASSERT_NEAR(result(1, 0), expected(1, 0), 1e-12);
+	ASSERT_NEAR(result(1, 1), expected(1, 1), 1e-12);
+
+	Matrix2d congruent = r.congruence(cov);
+	ASSERT_NEAR(congruent(0, 0), expected(0, 0), 1e-12);
+	ASSERT_NEAR(congruent(0, 1), expected(0, 1), 1e-12);
+	ASSERT_NEAR(congruent(1, 0), expected(1, 0), 1e-12);
+	ASSERT_NEAR(congruent(1, 1), expected(1, 1), 1e-12);
+	// symmetric input gives exactly symmetric output
+	ASSERT_EQ(congruent(0, 1), congruent(1, 0));
+
+	// non-symmetric matrix and a different rotation on the right-hand side
+	Rotation2Dd r2(-M_PI / 3.0);
+	Matrix2d m(0.098765, 5.123456, 9.951847623, 2.45623789);
+	Matrix2d expected2 = multiply(multiply(r, m), r2.transpose());
+	Matrix2d result2 = r * m * r2.inverse();
+	ASSERT_NEAR(result2(0, 0), expected2(0, 0), 1e-12);
+	ASSERT_NEAR(result2(0, 1), expected2(0, 1), 1e-12);
+	ASSERT_NEAR(result2(1, 0), expected2(1, 0), 1e-12);
+	ASSERT_NEAR(result2(1, 1), expected2(1, 1), 1e-12);
+
+	Matrix2d expected3 = multiply(multiply(r, m), r.transpose());
+	Matrix2d result3 = r.congruence(m);
+	ASSERT_NEAR(result3(0, 0), expected3(0, 0), 1e-12);
+	ASSERT_NEAR(result3(0, 1), expected3(0, 1), 1e-12);
+	ASSERT_NEAR(result3(1, 0), expected3(1, 0), 1e-12);
+	ASSERT_NEAR(result3(1, 1), expected3(1, 1), 1e-12);
+}
+
+TEST(TestExpressions, quadraticForm) {
+	Matrix2d cov(0.75, 0.2, 0.2, 0.3);
+	Vector2d d(0.4, -1.3);
+	Matrix2d cov_inv = cov.inverse();
+	RowVector2d tmp = d.transpose() * cov_inv;
+	double expected = tmp * d;
+
+	double result = d.transpose() * cov.inverse() * d;
+	ASSERT_NEAR(result, expected, 1e-12);
+	ASSERT_NEAR(cov.inverseLazy().quadraticForm(d), expected, 1e-12);
+	ASSERT_NEAR(d.transpose() * cov.inverseLazy() * d, expected, 1e-12);
+
+	// bilinear form with a different vector
+	Vector2d e(-2.0, 0.5);
+	double expected_bilinear = tmp * e;
+	double result_bilinear = d.transpose() * cov.inverseLazy() * e;
+	ASSERT_NEAR(result_bilinear, expected_bilinear, 1e-12);
+
+	// intermediate nodes keep their operands, so they outlive the expression
+	auto partial = d.transpose() * cov.inverseLazy();
+	ASSERT_NEAR(partial(0), tmp(0), 1e-12);
+	ASSERT_NEAR(partial(1), tmp(1), 1e-12);
+	ASSERT_NEAR(partial * d, expected, 1e-12);
+}
+
+TEST(TestExpressions, conversions) {
+	Matrix2d m(0.098765, 5.123456, 9.951847623, 2.45623789);
+	Vector2d v(1.5, -0.5);
+	Vector2d solved = m.inverseLazy() * v;
+	Vector2d expected = m.inverse() * v;
+	ASSERT_NEAR(solved(0), expected(0), 1e-12);
+	ASSERT_NEAR(solved(1), expected(1), 1e-12);
+
+	Matrix2d identity = m * m.inverseLazy();
+	Matrix2d inverse = m.inverseLazy();
+	ASSERT_NEAR(m.inverseLazy()(0, 1), inverse(0, 1), 1e-12);
+	ASSERT_NEAR(m.inverseLazy()(1, 1), inverse(1, 1), 1e-12);
+	ASSERT_NEAR(identity(0, 0), 1.0, 1e-12);
+	ASSERT_NEAR(identity(0, 1), 0.0, 1e-12);
+	ASSERT_NEAR(identity(1, 0), 0.0, 1e-12);
+	ASSERT_NEAR(identity(1, 1), 1.0, 1e-12);
+
+	Rotation2Dd r(M_PI / 4.0);
+	Rotation2Dd rinv = r.inverse();
+	Matrix2d rr = multiply(r, rinv);
+	ASSERT_NEAR(rr(0, 0), 1.0, 1e-12);
+	ASSERT_NEAR(rr(1, 0), 0.0, 1e-12);
+	Matrix2d rr2 = r.inverse() * r;
+	ASSERT_NEAR(rr2(1, 1), 1.0, 1e-12);
+	ASSERT_NEAR(rr2(0, 1), 0.0, 1e-12);
+}
+
+TEST(TestExpressions, eagerResults) {
+	// eager operations return plain matrices, so they compose with the whole interface of Matrix2
+	Rotation2Dd r(M_PI / 6.0);
+	Matrix2d cov(0.75, 0.2, 0.2, 0.3);
+	Matrix2d m(0.098765, 5.123456, 9.951847623, 2.45623789);
+	Matrix2d sum = r * cov + m;
+	ASSERT_NEAR(sum(1, 0), multiply(r, cov)(1, 0) + m(1, 0), 1e-12);
+	Matrix2d inverse_sum = cov.inverse() + m;
+	ASSERT_NEAR(inverse_sum(0, 0), 0.3 / cov.determinant() + m(0, 0), 1e-12);
+	ASSERT_NEAR(cov.inverse().determinant(), 1.0 / cov.determinant(), 1e-12);
+	Matrix2d product = m * (r * cov);
+	ASSERT_NEAR(product(0, 1), multiply(m, multiply(r, cov))(0, 1), 1e-12);
+}
+
+TEST(TestExpressions, compileTime) {
+	constexpr Matrix2d cov(2.0, 0.0, 0.0, 4.0);
+	constexpr Vector2d d(2.0, 2.0);
+	static_assert(d.transpose() * Matrix2Inverse<double>(cov) * d == 3.0, "bilinear form");
+	static_assert(Matrix2Inverse<double>(cov).quadraticForm(d) == 3.0, "quadratic form");
+	// rotation by 90 degrees swaps the variances
+	constexpr Matrix2d congruent = Rotation2Dd(Matrix2d(0.0, -1.0, 1.0, 0.0)).congruence(cov);
+	static_assert(congruent(0, 0) == 4.0 && congruent(1, 1) == 2.0, "congruent covariance");
+	SUCCEED();
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
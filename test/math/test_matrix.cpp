@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 
 #include <social_nav_utils/math/matrix.h>
+#include <social_nav_utils/math/rotation.h>
+
+#include <cstring>
+#include <vector>
 
 using namespace social_nav_utils;
 
@@ -89,6 +93,37 @@ TEST(TestMatrix, operatorSubtract) {
 	ASSERT_NEAR(mresult(1, 1),  2.059055245000000, 1e-09);
 }
 
+TEST(TestMatrix, compileTime) {
+	constexpr Matrix2d m1(1.0, 2.0, 3.0, 4.0);
+	constexpr Matrix2d m2(0.5, 0.0, 0.0, 2.0);
+	constexpr Vector2d v(1.0, -1.0);
+	static_assert(m1.determinant() == -2.0, "determinant");
+	static_assert(m1.trace() == 5.0, "trace");
+	static_assert(v.squaredNorm() == 2.0, "squared norm");
+	static_assert(m1.transpose()(0, 1) == 3.0, "transpose");
+	static_assert((m1 * m2)(1, 1) == 8.0, "matrix product");
+	static_assert((m1 + m2 - m2)(1, 0) == 3.0, "sum and difference");
+	static_assert((m1 * v)(1) == -1.0, "matrix-vector product");
+	static_assert((v.transpose() * m2 * v) == 2.5, "quadratic form");
+	static_assert(noexcept(m1.inverse()), "inverse must not throw");
+	SUCCEED();
+}
+
+TEST(TestMatrix, layout) {
+	std::vector<Matrix2d> batch{Matrix2d(1.0, 2.0, 3.0, 4.0), Matrix2d(5.0, 6.0, 7.0, 8.0)};
+	ASSERT_EQ(reinterpret_cast<uintptr_t>(batch.data()) % alignof(Matrix2d), 0);
+
+	// storage is a contiguous row-major array, so batches may be copied as raw memory
+	double raw[8];
+	std::memcpy(raw, batch.data(), sizeof(raw));
+	for (size_t i = 0; i < 8; i++) {
+		EXPECT_DOUBLE_EQ(raw[i], static_cast<double>(i + 1));
+	}
+	Matrix2d copies[2];
+	std::memcpy(copies, raw, sizeof(raw));
+	EXPECT_DOUBLE_EQ(copies[1](1, 0), 7.0);
+}
+
 int main(int argc, char** argv) {
 	testing::InitGoogleTest(&argc, argv);
 	return RUN_ALL_TESTS();
@@ -3,6 +3,7 @@
 #include <social_nav_utils/math/vector3.h>
 #include <social_nav_utils/math/row_vector3.h>
 
+#include <cstring>
 #include <math.h>
 
 using namespace social_nav_utils;
@@ -57,6 +58,35 @@ TEST(TestVector3, subtractionRow) {
 	ASSERT_DOUBLE_EQ(vresult(2),  1.570796326794897);
 }
 
+TEST(TestVector3, constOperators) {
+	constexpr Vector3d v1(1.0, 2.0, 3.0);
+	constexpr Vector3d v2(0.5, 0.5, 0.5);
+	static_assert((v1 + v2)(2) == 3.5, "sum of const vectors");
+	static_assert((v1 - v2)(0) == 0.5, "difference of const vectors");
+	constexpr RowVector3d r1(1.0, 2.0, 3.0);
+	static_assert((r1 - r1 + r1)(1) == 2.0, "operations on const row vectors");
+
+	// element types may differ
+	const Vector3f vf(1.0f, 1.0f, 1.0f);
+	Vector3d vresult = v1 + vf;
+	ASSERT_DOUBLE_EQ(vresult(0), 2.0);
+	ASSERT_DOUBLE_EQ(vresult(2), 4.0);
+}
+
+TEST(TestVector3, rawBytes) {
+	// the padding element is zeroed, so raw copies of equal vectors are equal
+	Vector3d v1;
+	Vector3d v2(0.0, 0.0, 0.0);
+	double raw[4] = {1.0, 1.0, 1.0, 1.0};
+	std::memcpy(raw, &v1, sizeof(raw));
+	EXPECT_EQ(raw[3], 0.0);
+	EXPECT_EQ(std::memcmp(&v1, &v2, sizeof(Vector3d)), 0);
+
+	RowVector3f r1(1.0f, 2.0f, 3.0f);
+	RowVector3f r2 = RowVector3f(3.0f, 5.0f, 7.0f) - RowVector3f(2.0f, 3.0f, 4.0f);
+	EXPECT_EQ(std::memcmp(&r1, &r2, sizeof(RowVector3f)), 0);
+}
+
 int main(int argc, char** argv) {
 	testing::InitGoogleTest(&argc, argv);
 	return RUN_ALL_TESTS();
@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include <social_nav_utils/closest_approach.h>
+#include <social_nav_utils/entity_arrays.h>
+#include <social_nav_utils/gaussians.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace social_nav_utils;
+
+TEST(TestClosestApproach, constantVelocities) {
+	// head-on with a lateral offset
+	ClosestApproach head_on(Vector2d(0.0, 0.0), Vector2d(1.0, 0.0), Vector2d(10.0, 0.5), Vector2d(-1.0, 0.0));
+	EXPECT_DOUBLE_EQ(head_on.getTime(), 5.0);
+	EXPECT_DOUBLE_EQ(head_on.getDistance(), 0.5);
+	EXPECT_DOUBLE_EQ(head_on.getMissVector()(0), 0.0);
+	EXPECT_DOUBLE_EQ(head_on.getMissVector()(1), 0.5);
+	EXPECT_TRUE(std::isnan(head_on.getMahalanobisDistance()));
+
+	// crossing paths: the other agent moves along the y axis
+	ClosestApproach crossing(Vector2d(-2.0, 0.0), Vector2d(1.0, 0.0), Vector2d(0.0, -2.0), Vector2d(0.0, 1.0));
+	EXPECT_DOUBLE_EQ(crossing.getTime(), 2.0);
+	EXPECT_NEAR(crossing.getDistance(), 0.0, 1e-12);
+
+	// moving apart: the closest approach is now
+	ClosestApproach apart(Vector2d(0.0, 0.0), Vector2d(-1.0, 0.0), Vector2d(3.0, 4.0), Vector2d(0.5, 0.0));
+	EXPECT_DOUBLE_EQ(apart.getTime(), 0.0);
+	EXPECT_DOUBLE_EQ(apart.getDistance(), 5.0);
+
+	// equal velocities keep the separation
+	ClosestApproach parallel(Vector2d(0.0, 0.0), Vector2d(0.7, 0.2), Vector2d(1.0, 1.0), Vector2d(0.7, 0.2));
+	EXPECT_DOUBLE_EQ(parallel.getTime(), 0.0);
+	EXPECT_DOUBLE_EQ(parallel.getDistance(), std::sqrt(2.0));
+
+	// closest approach beyond the horizon
+	ClosestApproach limited(Vector2d(0.0, 0.0), Vector2d(1.0, 0.0), Vector2d(10.0, 0.5), Vector2d(-1.0, 0.0), 3.0);
+	EXPECT_DOUBLE_EQ(limited.getTime(), 3.0);
+	EXPECT_DOUBLE_EQ(limited.getDistance(), std::hypot(4.0, 0.5));
+}
+
+TEST(TestClosestApproach, mahalanobis) {
+	// isotropic covariance does not change the time, the distance is scaled by the standard deviation
+	ClosestApproach isotropic(
+		Vector2d(0.0, 0.0), Vector2d(1.0, 0.0),
+		Vector2d(10.0, 0.5), Vector2d(-1.0, 0.0),
+		Matrix2d(0.25, 0.0, 0.0, 0.25)
+	);
+	EXPECT_DOUBLE_EQ(isotropic.getTime(), 5.0);
+	EXPECT_DOUBLE_EQ(isotropic.getDistance(), 0.5);
+	EXPECT_DOUBLE_EQ(isotropic.getMahalanobisDistance(), 1.0);
+
+	// anisotropic covariance compared against a dense search over time
+	Vector2d position_ego(0.3, -0.2);
+	Vector2d velocity_ego(0.8, 0.1);
+	Vector2d position_other(4.0, 2.0);
+	Vector2d velocity_other(-0.4, -0.9);
+	Matrix2d cov(0.4, 0.15, 0.15, 0.1);
+	ClosestApproach cpa(position_ego, velocity_ego, position_other, velocity_other, cov);
+
+	double time_best = 0.0;
+	double mahalanobis_best = INFINITY;
+	for (double t = 0.0; t <= 10.0; t += 1e-04) {
+		Vector2d miss = (position_other + velocity_other * t) - (position_ego + velocity_ego * t);
+		double mahalanobis = std::sqrt(calculateMahalanobisSquared(miss, Vector2d(0.0, 0.0), cov));
+		if (mahalanobis < mahalanobis_best) {
+			mahalanobis_best = mahalanobis;
+			time_best = t;
+		}
+	}
+	EXPECT_NEAR(cpa.getTime(), time_best, 1e-04);
+	EXPECT_NEAR(cpa.getMahalanobisDistance(), mahalanobis_best, 1e-06);
+	// Euclidean and Mahalanobis closest approaches differ for the anisotropic covariance
+	ClosestApproach euclidean(position_ego, velocity_ego, position_other, velocity_other);
+	EXPECT_GT(std::abs(euclidean.getTime() - cpa.getTime()), 0.1);
+	EXPECT_DOUBLE_EQ(cpa.getDistance(), std::sqrt(cpa.getMissVector().squaredNorm()));
+}
+
+TEST(TestClosestApproach, batch) {
+	const size_t NUM = 101;
+	const double HORIZON = 8.0;
+	std::mt19937 gen(7);
+	std::uniform_real_distribution<double> position(-10.0, 10.0);
+	std::uniform_real_distribution<double> velocity(-1.5, 1.5);
+	std::uniform_real_distribution<double> variance(0.05, 1.0);
+	std::uniform_real_distribution<double> correlation(-0.9, 0.9);
+
+	std::vector<double> x(NUM), y(NUM), vx(NUM), vy(NUM), cov_xx(NUM), cov_xy(NUM), cov_yy(NUM);
+	for (size_t i = 0; i < NUM; i++) {
+		x[i] = position(gen);
+		y[i] = position(gen);
+		vx[i] = velocity(gen);
+		vy[i] = velocity(gen);
+		cov_xx[i] = variance(gen);
+		cov_yy[i] = variance(gen);
+		cov_xy[i] = correlation(gen) * std::sqrt(cov_xx[i] * cov_yy[i]);
+	}
+	// standing agent with the same velocity as the ego
+	vx.back() = 0.6;
+	vy.back() = -0.3;
+
+	std::vector<double> time(NUM), distance(NUM);
+	ClosestApproach::compute(
+		0.5, -1.0, 0.6, -0.3,
+		x.data(), y.data(), vx.data(), vy.data(), NUM, HORIZON,
+		time.data(), distance.data()
+	);
+	std::vector<double> time_m(NUM), distance_m(NUM), mahalanobis(NUM);
+	ClosestApproach::computeMahalanobis(
+		0.5, -1.0, 0.6, -0.3,
+		x.data(), y.data(), vx.data(), vy.data(), cov_xx.data(), cov_xy.data(), cov_yy.data(), NUM, HORIZON,
+		time_m.data(), distance_m.data(), mahalanobis.data()
+	);
+
+	for (size_t i = 0; i < NUM; i++) {
+		Vector2d position_ego(0.5, -1.0);
+		Vector2d velocity_ego(0.6, -0.3);
+		ClosestApproach cpa(position_ego, velocity_ego, Vector2d(x[i], y[i]), Vector2d(vx[i], vy[i]), HORIZON);
+		EXPECT_NEAR(time[i], cpa.getTime(), 1e-12);
+		EXPECT_NEAR(distance[i], cpa.getDistance(), 1e-12);
+
+		ClosestApproach cpa_m(
+			position_ego, velocity_ego,
+			Vector2d(x[i], y[i]), Vector2d(vx[i], vy[i]),
+			Matrix2d(cov_xx[i], cov_xy[i], cov_xy[i], cov_yy[i]),
+			HORIZON
+		);
+		EXPECT_NEAR(time_m[i], cpa_m.getTime(), 1e-09);
+		EXPECT_NEAR(distance_m[i], cpa_m.getDistance(), 1e-09);
+		EXPECT_NEAR(mahalanobis[i], cpa_m.getMahalanobisDistance(), 1e-09);
+		EXPECT_LE(time[i], HORIZON);
+		EXPECT_GE(time[i], 0.0);
+	}
+	EXPECT_EQ(time.back(), 0.0);
+	EXPECT_EQ(time_m.back(), 0.0);
+}
+
+TEST(TestClosestApproach, humanArray) {
+	const double HORIZON = 8.0;
+	HumanArray humans;
+	// x, y, yaw, vx, vy, cov_xx, cov_xy, cov_yy, ps_var_front, ps_var_rear, ps_var_side
+	humans.add({3.0, 1.0, M_PI, -1.0, 0.0, 0.2, 0.05, 0.4, 1.2, 0.6, 0.8});
+	humans.add({-2.0, 4.0, -M_PI_2, 0.1, -0.9, 0.5, -0.1, 0.3, 1.2, 0.6, 0.8});
+	humans.add({6.0, -5.0, M_PI_4, 0.6, -0.3, 0.1, 0.0, 0.1, 1.2, 0.6, 0.8});
+
+	double time[3], distance[3], mahalanobis[3];
+	ClosestApproach::computeMahalanobis(0.5, -1.0, 0.6, -0.3, humans, HORIZON, time, distance, mahalanobis);
+	double time_euclidean[3], distance_euclidean[3];
+	ClosestApproach::compute(0.5, -1.0, 0.6, -0.3, humans, HORIZON, time_euclidean, distance_euclidean);
+
+	for (size_t i = 0; i < humans.size(); i++) {
+		auto human = humans.get(i);
+		Vector2d position_ego(0.5, -1.0);
+		Vector2d velocity_ego(0.6, -0.3);
+		Vector2d position(human.x, human.y);
+		Vector2d velocity(human.vx, human.vy);
+		ClosestApproach cpa(position_ego, velocity_ego, position, velocity, HORIZON);
+		EXPECT_NEAR(time_euclidean[i], cpa.getTime(), 1e-12);
+		EXPECT_NEAR(distance_euclidean[i], cpa.getDistance(), 1e-12);
+
+		ClosestApproach cpa_m(
+			position_ego, velocity_ego, position, velocity,
+			Matrix2d(human.cov_xx, human.cov_xy, human.cov_xy, human.cov_yy),
+			HORIZON
+		);
+		EXPECT_NEAR(time[i], cpa_m.getTime(), 1e-09);
+		EXPECT_NEAR(distance[i], cpa_m.getDistance(), 1e-09);
+		EXPECT_NEAR(mahalanobis[i], cpa_m.getMahalanobisDistance(), 1e-09);
+	}
+	// the last human moves with the ego's velocity
+	EXPECT_EQ(time[2], 0.0);
+	EXPECT_EQ(time_euclidean[2], 0.0);
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
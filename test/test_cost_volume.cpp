@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <social_nav_utils/cost_volume.h>
+#include <social_nav_utils/formation_space_model.h>
+#include <social_nav_utils/personal_space_model.h>
+
+#include "allocation_counter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace social_nav_utils;
+
+TEST(TestCostVolume, halfConversion) {
+	EXPECT_EQ(encodeHalf(0.0f), 0x0000);
+	EXPECT_EQ(encodeHalf(-0.0f), 0x8000);
+	EXPECT_EQ(encodeHalf(1.0f), 0x3c00);
+	EXPECT_EQ(encodeHalf(-2.0f), 0xc000);
+	EXPECT_EQ(encodeHalf(0.1f), 0x2e66);
+	EXPECT_EQ(encodeHalf(65504.0f), 0x7bff);
+	EXPECT_EQ(encodeHalf(65520.0f), 0x7c00);
+	EXPECT_EQ(encodeHalf(std::numeric_limits<float>::infinity()), 0x7c00);
+	EXPECT_EQ(encodeHalf(std::ldexp(1.0f, -24)), 0x0001);
+	EXPECT_EQ(encodeHalf(std::ldexp(1.0f, -26)), 0x0000);
+	// ties are rounded to even
+	EXPECT_EQ(encodeHalf(1.0f + std::ldexp(1.0f, -11)), 0x3c00);
+	EXPECT_EQ(encodeHalf(1.0f + 3.0f * std::ldexp(1.0f, -11)), 0x3c02);
+	EXPECT_EQ(encodeHalf(std::ldexp(3.0f, -25)), 0x0002);
+	EXPECT_TRUE(std::isnan(decodeHalf(encodeHalf(std::nanf("")))));
+
+	// every finite half survives the round trip
+	for (uint32_t bits = 0; bits <= 0xffff; bits++) {
+		uint16_t half = static_cast<uint16_t>(bits);
+		if ((half & 0x7c00) == 0x7c00 && (half & 0x03ff) != 0) {
+			continue;
+		}
+		ASSERT_EQ(encodeHalf(decodeHalf(half)), half);
+	}
+	EXPECT_EQ(decodeHalf(0x3555), 0.333251953125f);
+}
+
+TEST(TestCostVolume, rasterize) {
+	HumanArray humans;
+	// x, y, yaw, vx, vy, cov_xx, cov_xy, cov_yy, ps_var_front, ps_var_rear, ps_var_side
+	humans.add({-1.0, 0.2, 0.3, 0.8, -0.1, 0.02, 0.005, 0.03, 0.4, 0.1, 0.2});
+	humans.add({1.2, -0.8, 2.0, -0.3, 0.4, 0.02, 0.005, 0.03, 0.4, 0.1, 0.2});
+	GroupArray groups;
+	// x, y, orientation, variance_x, variance_y, cov_xx, cov_xy, cov_yy
+	groups.add({0.5, 0.6, 0.7, 0.15, 0.08, 0.01, 0.0, 0.01});
+
+	CostVolume::Parameters params;
+	params.origin_x = -2.0;
+	params.origin_y = -1.5;
+	params.resolution = 0.1;
+	params.width = 43;
+	params.height = 31;
+	params.dt = 0.5;
+	params.slices_num = 5;
+	params.cov_growth_xx = 0.04;
+	params.cov_growth_yy = 0.02;
+	GaussianCutoff cutoff(params.sigmas);
+
+	for (auto encoding: {CostVolume::Encoding::UINT8, CostVolume::Encoding::HALF}) {
+		params.encoding = encoding;
+		CostVolume volume(params);
+		volume.rasterize(humans, groups);
+
+		size_t nonzero = 0;
+		for (size_t k = 0; k < params.slices_num; k++) {
+			// normalized costs of the models predicted for the slice, reduced with maximum
+			double t = k * params.dt;
+			std::vector<double> expected(params.width * params.height, 0.0);
+			for (size_t cell = 0; cell < expected.size(); cell++) {
+				double x = params.origin_x + (cell % params.width + 0.5) * params.resolution;
+				double y = params.origin_y + (cell / params.width + 0.5) * params.resolution;
+				for (size_t i = 0; i < humans.size(); i++) {
+					auto human = humans.get(i);
+					PersonalSpaceModel model(
+						human.x + human.vx * t, human.y + human.vy * t, human.yaw,
+						human.cov_xx + params.cov_growth_xx * t, human.cov_xy, human.cov_xy, human.cov_yy + params.cov_growth_yy * t,
+						human.ps_var_front, human.ps_var_rear, human.ps_var_side
+					);
+					expected[cell] = std::max(expected[cell], model.evaluate(x, y, cutoff) / model.getMax());
+				}
+				auto group = groups.get(0);
+				FormationSpaceModel model(
+					group.x, group.y, group.orientation, group.variance_x, group.variance_y,
+					group.cov_xx, group.cov_xy, group.cov_yy
+				);
+				expected[cell] = std::max(expected[cell], model.evaluate(x, y, cutoff) / model.getMax());
+			}
+
+			for (size_t cell = 0; cell < expected.size(); cell++) {
+				double cost = volume.getCost(k, cell / params.width, cell % params.width);
+				// rear of the personal space may exceed the normalized peak, 8-bit values saturate then
+				if (encoding == CostVolume::Encoding::UINT8) {
+					ASSERT_NEAR(cost, std::min(expected[cell], 1.0), 0.5 / 255.0 + 1e-06);
+				} else {
+					ASSERT_NEAR(cost, expected[cell], std::ldexp(expected[cell], -11) + 1e-07);
+				}
+				nonzero += expected[cell] > 0.0;
+			}
+		}
+		// culled cells are exact zeros, but the supports do not vanish
+		EXPECT_GT(nonzero, params.slices_num * 20);
+		EXPECT_LT(nonzero, params.slices_num * params.width * params.height);
+
+		// the storage is allocated once, in the constructor
+		AllocationCounter counter;
+		volume.rasterize(humans, groups);
+		EXPECT_EQ(counter.getAllocations(), 0);
+	}
+}
+
+TEST(TestCostVolume, reductionAndLayout) {
+	HumanArray humans;
+	// x, y, yaw, vx, vy, cov_xx, cov_xy, cov_yy, ps_var_front, ps_var_rear, ps_var_side
+	humans.add({0.4, 0.3, 0.3, 0.8, -0.1, 0.02, 0.005, 0.03, 0.4, 0.1, 0.2});
+	humans.add({1.2, 0.8, 2.0, -0.3, 0.4, 0.02, 0.005, 0.03, 0.4, 0.1, 0.2});
+	GroupArray groups;
+
+	CostVolume::Parameters params;
+	params.resolution = 0.1;
+	params.width = 21;
+	params.height = 15;
+	params.dt = 0.5;
+	params.slices_num = 4;
+	params.encoding = CostVolume::Encoding::HALF;
+	params.sigmas = std::numeric_limits<double>::infinity();
+	CostVolume volume_max(params);
+	params.reduction = CostReduction::SUM;
+	CostVolume volume_sum(params);
+	volume_max.rasterize(humans, groups);
+	volume_sum.rasterize(humans, groups);
+	for (size_t k = 0; k < params.slices_num; k++) {
+		for (size_t row = 0; row < params.height; row++) {
+			for (size_t col = 0; col < params.width; col++) {
+				ASSERT_GE(volume_sum.getCost(k, row, col), volume_max.getCost(k, row, col));
+				// no cutoff: nothing is culled
+				ASSERT_GT(volume_max.getCost(k, row, col), 0.0);
+			}
+		}
+	}
+	EXPECT_GT(volume_sum.getCost(0, 5, 8), volume_max.getCost(0, 5, 8));
+
+	// slices are aligned to cache lines and stored one after another
+	EXPECT_EQ(volume_max.getSliceStride() % BATCH_ALIGNMENT, 0);
+	EXPECT_GE(volume_max.getSliceStride(), 21 * 15 * sizeof(uint16_t));
+	EXPECT_EQ(volume_max.getMemorySize(), 4 * volume_max.getSliceStride());
+	EXPECT_EQ(volume_max.getSliceUint8(0), nullptr);
+	ASSERT_NE(volume_max.getSliceHalf(1), nullptr);
+	EXPECT_EQ(
+		reinterpret_cast<const uint8_t*>(volume_max.getSliceHalf(1))
+			- reinterpret_cast<const uint8_t*>(volume_max.getSliceHalf(0)),
+		volume_max.getSliceStride()
+	);
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(volume_max.getSliceHalf(3)) % BATCH_ALIGNMENT, 0);
+	EXPECT_EQ(decodeHalf(volume_max.getSliceHalf(2)[7 * 21 + 11]), volume_max.getCost(2, 7, 11));
+
+	EXPECT_THROW(volume_max.getCost(4, 0, 0), std::out_of_range);
+	params.width = 0;
+	EXPECT_THROW(CostVolume volume(params), std::invalid_argument);
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
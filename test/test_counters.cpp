@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <social_nav_utils/counters.h>
+#include <social_nav_utils/ellipse_fitting.h>
+#include <social_nav_utils/formation_space_intrusion.h>
+#include <social_nav_utils/gaussians.h>
+#include <social_nav_utils/lines_intersection.h>
+#include <social_nav_utils/personal_space_intrusion.h>
+#include <social_nav_utils/math/matrix.h>
+
+#include <thread>
+#include <vector>
+
+using namespace social_nav_utils;
+
+TEST(TestCounters, aggregateThreads) {
+	Counters::reset();
+	const size_t THREADS_NUM = 4;
+	const size_t INCREMENTS_NUM = 1000;
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < THREADS_NUM; i++) {
+		threads.emplace_back([&]() {
+			for (size_t j = 0; j < INCREMENTS_NUM; j++) {
+				Counters::increment(CounterEvent::PASSING_SPEED_COMFORT_CALLS);
+			}
+		});
+	}
+	for (auto& thread: threads) {
+		thread.join();
+	}
+	// finished threads are still included
+	EXPECT_EQ(Counters::aggregate(CounterEvent::PASSING_SPEED_COMFORT_CALLS), THREADS_NUM * INCREMENTS_NUM);
+
+	Counters::increment(CounterEvent::PASSING_SPEED_COMFORT_CALLS);
+	EXPECT_EQ(Counters::aggregate(CounterEvent::PASSING_SPEED_COMFORT_CALLS), THREADS_NUM * INCREMENTS_NUM + 1);
+
+	Counters::reset();
+	EXPECT_EQ(Counters::aggregate(CounterEvent::PASSING_SPEED_COMFORT_CALLS), 0);
+}
+
+TEST(TestCounters, names) {
+	for (size_t i = 0; i < Counters::EVENTS_NUM; i++) {
+		EXPECT_STRNE(Counters::getName(static_cast<CounterEvent>(i)), "unknown");
+	}
+}
+
+TEST(TestCounters, nearSingular) {
+	EXPECT_TRUE(Counters::isNearSingular(0.0, 1.0, 2.0, 2.0, 4.0));
+	EXPECT_FALSE(Counters::isNearSingular(1.0, 1.0, 0.0, 0.0, 1.0));
+}
+
+#ifdef SOCIAL_NAV_UTILS_ENABLE_COUNTERS
+TEST(TestCounters, libraryEvents) {
+	Counters::reset();
+
+	// single point - fallback
+	EllipseFitting ellipse1(std::vector<double>{1.0}, std::vector<double>{2.0});
+	// solver succeeds
+	EllipseFitting ellipse2(std::vector<double>{1.0, 2.0, 3.0, 2.0}, std::vector<double>{3.0, 4.5, 3.0, 1.0});
+	EXPECT_EQ(Counters::aggregate(CounterEvent::ELLIPSE_FITTING_CALLS), 2);
+	EXPECT_EQ(Counters::aggregate(CounterEvent::ELLIPSE_FITTING_FALLBACK), 1);
+
+	// parallel lines
+	LinesIntersection intsec1({0.0, 1.0}, {0.0, 0.0}, {0.0, 1.0}, {1.0, 1.0});
+	LinesIntersection intsec2({0.0, 1.0}, {0.0, 1.0}, {0.0, 1.0}, {1.0, 0.0});
+	EXPECT_EQ(Counters::aggregate(CounterEvent::LINES_INTERSECTION_CALLS), 2);
+	EXPECT_EQ(Counters::aggregate(CounterEvent::LINES_INTERSECTION_NAN), 1);
+
+	Matrix2d singular(1.0, 2.0, 2.0, 4.0);
+	singular.inverse();
+	EXPECT_EQ(Counters::aggregate(CounterEvent::MATRIX_INVERSE_NEAR_SINGULAR), 1);
+
+	PersonalSpaceIntrusion psi(0.0, 0.0, 0.0, 0.1, 0.0, 0.0, 0.1, 2.0, 0.5, 1.0, 1.0, 1.0);
+	psi.normalize();
+	EXPECT_EQ(Counters::aggregate(CounterEvent::PERSONAL_SPACE_CALLS), 2);
+	EXPECT_EQ(Counters::aggregate(CounterEvent::PERSONAL_SPACE_ISOTROPIC), 2);
+
+	// diagonal, then correlated (general path) uncertainty
+	PersonalSpaceIntrusion::computePersonalSpaceGaussian(0.0, 0.0, 0.0, 0.1, 0.0, 0.0, 0.2, 2.0, 0.5, 1.0, 1.0, 1.0);
+	PersonalSpaceIntrusion::computePersonalSpaceGaussian(0.0, 0.0, 0.0, 0.1, 0.05, 0.05, 0.2, 2.0, 0.5, 1.0, 1.0, 1.0);
+	EXPECT_EQ(Counters::aggregate(CounterEvent::PERSONAL_SPACE_DIAGONAL), 1);
+	EXPECT_EQ(Counters::aggregate(CounterEvent::PERSONAL_SPACE_CALLS), 4);
+
+	FormationSpaceIntrusion::computeFormationSpaceGaussian(0.0, 0.0, 0.0, 0.3, 0.2, 0.1, 0.0, 0.1, 1.0, 1.0);
+	FormationSpaceIntrusion::computeFormationSpaceGaussian(0.0, 0.0, 0.0, 0.3, 0.2, 0.1, 0.0, 0.2, 1.0, 1.0);
+	FormationSpaceIntrusion::computeFormationSpaceGaussian(0.0, 0.0, 0.0, 0.3, 0.2, 0.1, 0.05, 0.2, 1.0, 1.0);
+	EXPECT_EQ(Counters::aggregate(CounterEvent::FORMATION_SPACE_ISOTROPIC), 1);
+	EXPECT_EQ(Counters::aggregate(CounterEvent::FORMATION_SPACE_DIAGONAL), 1);
+	EXPECT_EQ(Counters::aggregate(CounterEvent::FORMATION_SPACE_CALLS), 3);
+
+	// beyond and within the 3-sigma support
+	calculateGaussian(10.0, 0.0, 1.0, false, GaussianCutoff::fromSigmas(3.0));
+	calculateGaussian(1.0, 0.0, 1.0, false, GaussianCutoff::fromSigmas(3.0));
+	EXPECT_EQ(Counters::aggregate(CounterEvent::GAUSSIAN_CUTOFF), 1);
+}
+#else
+TEST(TestCounters, disabled) {
+	Counters::reset();
+	SOCIAL_NAV_UTILS_COUNT(PERSONAL_SPACE_CALLS);
+	PersonalSpaceIntrusion psi(0.0, 0.0, 0.0, 0.1, 0.0, 0.0, 0.1, 2.0, 0.5, 1.0, 1.0, 1.0);
+	EXPECT_EQ(Counters::aggregate(CounterEvent::PERSONAL_SPACE_CALLS), 0);
+}
+#endif
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
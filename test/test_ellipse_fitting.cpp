@@ -2,6 +2,9 @@
 
 #include <social_nav_utils/ellipse_fitting.h>
 
+#include "allocation_counter.h"
+#include <social_nav_utils/memory_arena.h>
+
 #include <vector>
 
 #include <ctime>
@@ -179,6 +182,33 @@ TEST(EllipseFitting, fallbackMultiple6) {
 	ASSERT_NEAR(ellip.getOrientation(), 1.57079633, 1e-03);
 }
 
+TEST(EllipseFitting, zeroAllocationsWithArena) {
+	// solver and fallback cases
+	std::vector<std::pair<std::vector<double>, std::vector<double>>> cases{
+		{{1.0, 2.0, 3.0, 2.0}, {3.0, 4.5, 3.0, 1.0}},
+		{{1.0, 3.0, 2.0}, {3.0, 3.0, 1.0}},
+		{{1.0, 2.0}, {3.0, 1.0}}
+	};
+	MemoryArena arena;
+	// the first cycle grows the arena to the peak demand
+	for (const auto& points: cases) {
+		EllipseFitting ellip(points.first, points.second, &arena);
+	}
+	arena.reset();
+
+	AllocationCounter counter;
+	double sum = 0.0;
+	for (size_t cycle = 0; cycle < 10; cycle++) {
+		for (const auto& points: cases) {
+			EllipseFitting ellip(points.first, points.second, &arena);
+			sum += ellip.getSemiAxisMajor();
+		}
+		arena.reset();
+	}
+	EXPECT_EQ(counter.getAllocations(), 0);
+	EXPECT_GT(sum, 0.0);
+}
+
 int main(int argc, char** argv) {
 	testing::InitGoogleTest(&argc, argv);
 	return RUN_ALL_TESTS();
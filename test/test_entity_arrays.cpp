@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include <social_nav_utils/entity_arrays.h>
+#include <social_nav_utils/parallel_evaluator.h>
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace social_nav_utils;
+
+static bool isAligned(const double* ptr) {
+	return reinterpret_cast<uintptr_t>(ptr) % BATCH_ALIGNMENT == 0;
+}
+
+TEST(TestHumanArray, addGetAndGrowth) {
+	HumanArray humans;
+	ASSERT_EQ(humans.size(), 0);
+	// enough elements to grow the storage a few times, each with distinct values
+	for (size_t i = 0; i < 37; i++) {
+		// x, y, yaw, vx, vy, cov_xx, cov_xy, cov_yy, ps_var_front, ps_var_rear, ps_var_side
+		ASSERT_EQ(humans.add({0.1 * i, -0.2 * i, 0.05 * i, 1.0, 0.0, 0.02 + i, 0.0, 0.03, 2.0, 0.5 + i, 1.0}), i);
+	}
+	ASSERT_EQ(humans.size(), 37);
+	for (size_t i = 0; i < humans.size(); i++) {
+		auto human = humans.get(i);
+		EXPECT_DOUBLE_EQ(human.x, 0.1 * i);
+		EXPECT_DOUBLE_EQ(human.y, -0.2 * i);
+		EXPECT_DOUBLE_EQ(human.yaw, 0.05 * i);
+		EXPECT_DOUBLE_EQ(human.vx, 1.0);
+		EXPECT_DOUBLE_EQ(human.cov_xx, 0.02 + i);
+		EXPECT_DOUBLE_EQ(human.ps_var_rear, 0.5 + i);
+		EXPECT_DOUBLE_EQ(human.fov, SocialScene::HumanState().fov);
+	}
+	for (auto column: {HumanArray::X, HumanArray::YAW, HumanArray::PS_VAR_SIDE, HumanArray::FOV}) {
+		EXPECT_TRUE(isAligned(humans.column(column)));
+	}
+	EXPECT_THROW(humans.get(37), std::out_of_range);
+	EXPECT_THROW(humans.set(37, SocialScene::HumanState()), std::out_of_range);
+}
+
+TEST(TestHumanArray, refillKeepsStorage) {
+	HumanArray humans;
+	humans.resize(20);
+	const double* x = humans.x();
+	// new elements take the defaults of the state structure
+	SocialScene::HumanState defaults;
+	EXPECT_DOUBLE_EQ(humans.occupancyRadius()[19], defaults.occupancy_radius);
+	EXPECT_DOUBLE_EQ(humans.fov()[0], defaults.fov);
+
+	for (size_t frame = 0; frame < 5; frame++) {
+		humans.clear();
+		humans.resize(10 + frame);
+		// x, y, yaw
+		humans.fill({0.5 * frame, 2.0, -0.1 * frame});
+		humans.x()[0] = -1.0;
+		EXPECT_EQ(humans.x(), x);
+		EXPECT_DOUBLE_EQ(humans.x()[0], -1.0);
+		EXPECT_DOUBLE_EQ(humans.x()[1], 0.5 * frame);
+		EXPECT_DOUBLE_EQ(humans.yaw()[9], -0.1 * frame);
+	}
+	// shrinking and growing again resets the elements to the defaults
+	humans.resize(1);
+	humans.resize(3);
+	EXPECT_DOUBLE_EQ(humans.x()[2], defaults.x);
+	EXPECT_DOUBLE_EQ(humans.fov()[2], defaults.fov);
+}
+
+TEST(TestGroupArray, addGetFill) {
+	GroupArray groups;
+	for (size_t i = 0; i < 10; i++) {
+		// x, y, orientation, variance_x, variance_y, cov_xx, cov_xy, cov_yy
+		groups.add({1.5 * i, -1.0, 0.3 * i, 0.25, 0.0625, 0.1, 0.02 * i, 0.1});
+	}
+	auto group = groups.get(7);
+	EXPECT_DOUBLE_EQ(group.x, 1.5 * 7);
+	EXPECT_DOUBLE_EQ(group.orientation, 0.3 * 7);
+	EXPECT_DOUBLE_EQ(group.cov_xy, 0.02 * 7);
+	EXPECT_TRUE(isAligned(groups.x()));
+	EXPECT_TRUE(isAligned(groups.covYY()));
+
+	groups.fill({3.0, 2.0, 0.4, 0.25, 0.09});
+	EXPECT_DOUBLE_EQ(groups.x()[9], 3.0);
+	EXPECT_DOUBLE_EQ(groups.varianceY()[0], 0.09);
+	EXPECT_THROW(groups.get(10), std::out_of_range);
+}
+
+TEST(TestEntityArrays, matchScene) {
+	SocialScene scene(true);
+	HumanArray humans;
+	GroupArray groups;
+	// humans standing on a grid around the poses, with varying orientations and uncertainties
+	for (size_t i = 0; i < 23; i++) {
+		// x, y, yaw, vx, vy, cov_xx, cov_xy, cov_yy, ps_var_front, ps_var_rear, ps_var_side
+		SocialScene::HumanState human{
+			0.4 * (i % 6), -1.0 + 0.6 * (i / 6), 0.3 * i - 3.0, 0.0, 0.0,
+			0.04 + 0.01 * (i % 4), 0.005, 0.05, 2.0, 0.5, 1.0
+		};
+		scene.addHuman(human);
+		humans.add(human);
+	}
+	for (size_t i = 0; i < 5; i++) {
+		// x, y, orientation, variance_x, variance_y, cov_xx, cov_xy, cov_yy
+		SocialScene::GroupState group{1.2 * i, -0.8, 0.5 * i, 0.2, 0.08, 0.05, 0.01, 0.06};
+		scene.addGroup(group);
+		groups.add(group);
+	}
+	// arrays are appended after the humans already in the scene
+	SocialScene scene_arrays(true);
+	scene_arrays.addHuman({-5.0, 5.0, 1.0, 0.0, 0.0, 0.1, 0.0, 0.1, 2.0, 0.5, 1.0});
+	ASSERT_EQ(scene_arrays.addHumans(humans), 1);
+	ASSERT_EQ(scene_arrays.addGroups(groups), 0);
+	ASSERT_EQ(scene_arrays.getHumansNum(), 24);
+	ASSERT_EQ(scene_arrays.getGroupsNum(), 5);
+	for (size_t i = 0; i < humans.size(); i++) {
+		EXPECT_EQ(
+			scene_arrays.computePersonalSpaceIntrusion(i + 1, 0.3, 0.2),
+			scene.computePersonalSpaceIntrusion(i, 0.3, 0.2)
+		);
+	}
+
+	std::vector<double> poses_x;
+	std::vector<double> poses_y;
+	for (size_t j = 0; j < 300; j++) {
+		poses_x.push_back(-1.0 + 0.013 * j);
+		poses_y.push_back(3.0 * std::sin(0.1 * j));
+	}
+	ParallelEvaluator evaluator(3);
+	std::vector<double> costs_scene(humans.size() * poses_x.size());
+	std::vector<double> costs_arrays(humans.size() * poses_x.size());
+	evaluator.computePersonalSpaceMatrix(scene, poses_x.data(), poses_y.data(), poses_x.size(), costs_scene.data(), true);
+	evaluator.computePersonalSpaceMatrix(
+		humans,
+		poses_x.data(),
+		poses_y.data(),
+		poses_x.size(),
+		costs_arrays.data(),
+		true,
+		true
+	);
+	EXPECT_EQ(costs_scene, costs_arrays);
+
+	std::vector<double> reduced_scene(poses_x.size());
+	std::vector<double> reduced_arrays(poses_x.size());
+	evaluator.computeFormationSpaceReduced(
+		scene,
+		poses_x.data(),
+		poses_y.data(),
+		poses_x.size(),
+		reduced_scene.data(),
+		CostReduction::MAX
+	);
+	evaluator.computeFormationSpaceReduced(
+		groups,
+		poses_x.data(),
+		poses_y.data(),
+		poses_x.size(),
+		reduced_arrays.data(),
+		CostReduction::MAX
+	);
+	EXPECT_EQ(reduced_scene, reduced_arrays);
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
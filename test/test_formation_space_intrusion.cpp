@@ -2,6 +2,12 @@
 
 #include <social_nav_utils/formation_space_intrusion.h>
 
+#include "allocation_counter.h"
+#include <social_nav_utils/formation_space_model.h>
+
+#include <utility>
+#include <vector>
+
 using namespace social_nav_utils;
 
 TEST(TestMetricGaussian, formationSpaceGaussian) {
@@ -59,6 +65,130 @@ TEST(TestMetricGaussian, formationSpaceGaussian) {
 	EXPECT_NEAR(gaussian3, 0.141921, 1e-05);
 }
 
+TEST(TestMetricGaussian, formationSpaceZeroAllocations) {
+	auto compute = [](double robot_x, double robot_y) {
+		FormationSpaceIntrusion fsi(
+			2.0, 2.75, 0.0,
+			0.255208333333333, 0.765625,
+			0.427649644158897, 0.0, 0.487649597818208,
+			robot_x, robot_y
+		);
+		fsi.normalize();
+		FormationSpaceModel model(
+			2.0, 2.75, 0.0,
+			0.255208333333333, 0.765625,
+			0.427649644158897, 0.0, 0.487649597818208
+		);
+		return fsi.getScale() + model.evaluate(robot_x, robot_y) / model.getMax();
+	};
+	// the first call may initialize static state of the enabled instrumentation
+	double sum = compute(2.1, 2.85);
+
+	AllocationCounter counter;
+	for (size_t i = 0; i < 100; i++) {
+		sum += compute(1.5 + 0.01 * i, 2.0 + 0.02 * i);
+	}
+	EXPECT_EQ(counter.getAllocations(), 0);
+	EXPECT_GT(sum, 0.0);
+}
+
+TEST(TestMetricGaussian, formationSpaceLogAndMahalanobis) {
+	FormationSpaceModel model(
+		2.0, 2.75, 0.0,
+		0.255208333333333, 0.765625,
+		0.427649644158897, 0.0, 0.487649597818208
+	);
+	for (double robot_x: {1.0, 2.1, 3.3}) {
+		for (double robot_y: {2.85, 4.05}) {
+			double gaussian = FormationSpaceIntrusion::computeFormationSpaceGaussian(
+				2.0, 2.75, 0.0,
+				0.255208333333333, 0.765625,
+				0.427649644158897, 0.0, 0.487649597818208,
+				robot_x, robot_y
+			);
+			double log_density = FormationSpaceIntrusion::computeFormationSpaceGaussianLog(
+				2.0, 2.75, 0.0,
+				0.255208333333333, 0.765625,
+				0.427649644158897, 0.0, 0.487649597818208,
+				robot_x, robot_y
+			);
+			double mahalanobis_sq = FormationSpaceIntrusion::computeFormationSpaceMahalanobisSquared(
+				2.0, 2.75, 0.0,
+				0.255208333333333, 0.765625,
+				0.427649644158897, 0.0, 0.487649597818208,
+				robot_x, robot_y
+			);
+			EXPECT_NEAR(log_density, std::log(gaussian), 1e-12);
+			EXPECT_NEAR(model.evaluateLog(robot_x, robot_y), log_density, 1e-12);
+			EXPECT_NEAR(log_density, model.getMaxLog() - 0.5 * mahalanobis_sq, 1e-12);
+		}
+	}
+}
+
+TEST(TestMetricGaussian, formationSpaceCutoff) {
+	FormationSpaceModel model(
+		2.0, 2.75, 0.3,
+		0.255208333333333, 0.765625,
+		0.427649644158897, 0.1, 0.487649597818208
+	);
+	for (const auto& cutoff: {GaussianCutoff::fromSigmas(2.5), GaussianCutoff::fromFloor(1e-03)}) {
+		double error_max = cutoff.getMaxError(model.getMax());
+		size_t zeros = 0;
+		for (double dx = -6.0; dx <= 6.0; dx += 0.5) {
+			for (double dy = -6.0; dy <= 6.0; dy += 0.5) {
+				double robot_x = 2.0 + dx;
+				double robot_y = 2.75 + dy;
+				double exact = FormationSpaceIntrusion::computeFormationSpaceGaussian(
+					2.0, 2.75, 0.3,
+					0.255208333333333, 0.765625,
+					0.427649644158897, 0.1, 0.487649597818208,
+					robot_x, robot_y
+				);
+				double culled = FormationSpaceIntrusion::computeFormationSpaceGaussian(
+					2.0, 2.75, 0.3,
+					0.255208333333333, 0.765625,
+					0.427649644158897, 0.1, 0.487649597818208,
+					robot_x, robot_y,
+					cutoff
+				);
+				EXPECT_EQ(culled, model.evaluate(robot_x, robot_y, cutoff));
+				if (culled == 0.0) {
+					zeros++;
+					EXPECT_LE(exact, error_max);
+				} else {
+					EXPECT_DOUBLE_EQ(culled, exact);
+				}
+			}
+		}
+		EXPECT_GT(zeros, 0);
+	}
+}
+
+TEST(TestMetricGaussian, formationSpaceDiagonalUncertainty) {
+	for (const auto& cov: std::vector<std::pair<double, double>>{{0.1, 0.1}, {0.2, 0.05}, {0.0, 0.0}}) {
+		for (double orientation = -M_PI; orientation < M_PI; orientation += 0.37) {
+			// the general path evaluated by the model
+			FormationSpaceModel model(
+				2.0, 2.75, orientation,
+				0.255208333333333, 0.765625,
+				cov.first, 0.0, cov.second
+			);
+			for (double dx = -2.0; dx <= 2.0; dx += 0.35) {
+				for (double dy = -2.0; dy <= 2.0; dy += 0.45) {
+					double expected = model.evaluate(2.0 + dx, 2.75 + dy);
+					double actual = FormationSpaceIntrusion::computeFormationSpaceGaussian(
+						2.0, 2.75, orientation,
+						0.255208333333333, 0.765625,
+						cov.first, 0.0, cov.second,
+						2.0 + dx, 2.75 + dy
+					);
+					ASSERT_NEAR(actual, expected, 1e-12 * expected);
+				}
+			}
+		}
+	}
+}
+
 int main(int argc, char** argv) {
 	testing::InitGoogleTest(&argc, argv);
 	return RUN_ALL_TESTS();
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 
 #include <social_nav_utils/gaussians.h>
+#include <social_nav_utils/asymmetric_gaussian_model.h>
+
+#include <vector>
 
 using namespace social_nav_utils;
 
@@ -35,6 +38,73 @@ TEST(TestGaussians, calculateGaussianAsymmetrical) {
 	ASSERT_DOUBLE_EQ(g, 1.0);
 }
 
+TEST(TestGaussians, calculateGaussianAsymmetricalFrontRear) {
+	// person facing +y, head variance much bigger than the rear one
+	const double VAR_H = 2.0;
+	const double VAR_R = 0.5;
+	const double VAR_S = 1.0;
+	// along the heading direction, the side variance does not matter
+	auto g_front = calculateGaussianAsymmetrical(0.0, 1.0, 0.0, 0.0, M_PI_2, VAR_H, VAR_R, VAR_S);
+	ASSERT_NEAR(g_front, std::exp(-1.0 / (2.0 * VAR_H)), 1e-09);
+	auto g_rear = calculateGaussianAsymmetrical(0.0, -1.0, 0.0, 0.0, M_PI_2, VAR_H, VAR_R, VAR_S);
+	ASSERT_NEAR(g_rear, std::exp(-1.0 / (2.0 * VAR_R)), 1e-09);
+	// rear-right location must also use the rear variance
+	auto g_rear_right = calculateGaussianAsymmetrical(1.0, -1.0, 0.0, 0.0, M_PI_2, VAR_H, VAR_R, VAR_S);
+	ASSERT_NEAR(g_rear_right, std::exp(-1.0 / (2.0 * VAR_R) - 1.0 / (2.0 * VAR_S)), 1e-09);
+
+	// matrix form; heading vector of the person facing +y
+	Vector2d mean(0.0, 0.0);
+	Matrix2d cov_front(VAR_S, 0.0, 0.0, VAR_H);
+	Matrix2d cov_rear(VAR_S, 0.0, 0.0, VAR_R);
+	Vector2d front(0.0, 1.0);
+	Vector2d rear(1.0, -1.0);
+	double g_front_heading = calculateGaussianAsymmetrical(front, mean, 0.0, 1.0, cov_front, cov_rear, true);
+	ASSERT_DOUBLE_EQ(g_front_heading, calculateGaussianAsymmetrical(front, mean, M_PI_2, cov_front, cov_rear, true));
+	ASSERT_NEAR(g_front_heading / calculateGaussian(mean, mean, cov_rear), g_front, 1e-09);
+	double g_rear_heading = calculateGaussianAsymmetrical(rear, mean, 0.0, 1.0, cov_front, cov_rear, true);
+	ASSERT_DOUBLE_EQ(g_rear_heading, calculateGaussianAsymmetrical(rear, mean, M_PI_2, cov_front, cov_rear, true));
+	ASSERT_NEAR(g_rear_heading / calculateGaussian(mean, mean, cov_rear), g_rear_right, 1e-09);
+}
+
+TEST(TestGaussians, asymmetricalModel) {
+	const double X = 1.3;
+	const double Y = -0.4;
+	const double VAR_H = 2.0;
+	const double VAR_R = 0.5;
+	const double VAR_S = 1.0;
+	for (double yaw: {0.0, 0.7, M_PI_2, -2.1, M_PI}) {
+		AsymmetricGaussianModel model(X, Y, yaw, VAR_H, VAR_R, VAR_S);
+		EXPECT_DOUBLE_EQ(model.evaluate(X, Y), 1.0);
+
+		// grid around the center covering front, rear and the boundary between them
+		const size_t WIDTH = 41;
+		const size_t HEIGHT = 37;
+		const double ORIGIN_X = X - 2.05;
+		const double ORIGIN_Y = Y - 1.85;
+		const double RESOLUTION = 0.1;
+		std::vector<double> grid(WIDTH * HEIGHT);
+		model.evaluateGrid(ORIGIN_X, ORIGIN_Y, RESOLUTION, WIDTH, HEIGHT, grid.data());
+
+		std::vector<double> x;
+		std::vector<double> y;
+		for (size_t row = 0; row < HEIGHT; row++) {
+			for (size_t col = 0; col < WIDTH; col++) {
+				x.push_back(ORIGIN_X + (col + 0.5) * RESOLUTION);
+				y.push_back(ORIGIN_Y + (row + 0.5) * RESOLUTION);
+			}
+		}
+		std::vector<double> batch(x.size());
+		model.evaluate(x.data(), y.data(), x.size(), batch.data());
+
+		for (size_t i = 0; i < x.size(); i++) {
+			double expected = calculateGaussianAsymmetrical(x[i], y[i], X, Y, yaw, VAR_H, VAR_R, VAR_S);
+			ASSERT_NEAR(model.evaluate(x[i], y[i]), expected, 1e-12);
+			ASSERT_NEAR(batch[i], expected, 1e-12);
+			ASSERT_NEAR(grid[i], expected, 1e-12);
+		}
+	}
+}
+
 // Ref: http://blog.sarantop.com/notes/mvn
 TEST(TestGaussians, multivariateMatrixForm) {
 	// Define the covariance matrix, the mean and test state
@@ -52,6 +122,96 @@ TEST(TestGaussians, multivariateMatrixForm) {
 	EXPECT_NEAR(calculateGaussian(test, mean, cov), 0.1153, 1e-4);
 }
 
+TEST(TestGaussians, logAndMahalanobis) {
+	for (double x: {-3.0, -0.5, 0.0, 1.25, 4.0}) {
+		EXPECT_NEAR(calculateGaussianLog(x, 0.5, 2.0), std::log(calculateGaussian(x, 0.5, 2.0)), 1e-12);
+		EXPECT_NEAR(calculateGaussianLog(x, 0.5, 2.0, true), std::log(calculateGaussian(x, 0.5, 2.0, true)), 1e-12);
+		EXPECT_DOUBLE_EQ(calculateMahalanobisSquared(x, 0.5, 2.0), std::pow(x - 0.5, 2) / 2.0);
+	}
+
+	Matrix2d cov(1.2, 0.3, 0.3, 0.8);
+	Vector2d mean(1.0, -1.0);
+	Eigen::MatrixXd cov_eigen(2, 2);
+	cov_eigen << 1.2, 0.3, 0.3, 0.8;
+	Eigen::VectorXd mean_eigen(2);
+	mean_eigen << 1.0, -1.0;
+	for (double dx = -2.0; dx <= 2.0; dx += 0.5) {
+		Vector2d x(mean(0) + dx, mean(1) + 0.3 * dx);
+		Eigen::VectorXd x_eigen(2);
+		x_eigen << x(0), x(1);
+		double gaussian = calculateGaussian(x, mean, cov);
+		double mahalanobis_sq = calculateMahalanobisSquared(x, mean, cov);
+		EXPECT_NEAR(calculateGaussianLog(x, mean, cov), std::log(gaussian), 1e-12);
+		EXPECT_NEAR(calculateGaussianLog(x_eigen, mean_eigen, cov_eigen), std::log(gaussian), 1e-12);
+		EXPECT_NEAR(mahalanobis_sq, calculateMahalanobisSquared(x_eigen, mean_eigen, cov_eigen), 1e-12);
+		// exponent of the Gaussian
+		EXPECT_NEAR(gaussian, calculateGaussian(mean, mean, cov) * std::exp(-0.5 * mahalanobis_sq), 1e-12);
+	}
+
+	// 2D metrics go through the quadratic form kernel, which only needs the sum of the off-diagonal elements
+	Matrix2d cov_upper(1.2, 0.5, 0.1, 0.8);
+	Matrix2d cov_lower(1.2, 0.1, 0.5, 0.8);
+	for (double dx = -2.0; dx <= 2.0; dx += 0.5) {
+		Vector2d x(mean(0) + dx, mean(1) - 0.7 * dx);
+		double mahalanobis_sq = calculateMahalanobisSquared(x, mean, cov_upper);
+		EXPECT_EQ(mahalanobis_sq, cov_upper.inverseLazy().quadraticForm(x - mean));
+		EXPECT_EQ(mahalanobis_sq, calculateMahalanobisSquared(x, mean, cov_lower));
+		EXPECT_EQ(calculateGaussian(x, mean, cov_upper), calculateGaussian(x, mean, cov_lower));
+		EXPECT_EQ(calculateGaussianLog(x, mean, cov_upper), calculateGaussianLog(x, mean, cov_lower));
+	}
+}
+
+TEST(TestGaussians, cutoff) {
+	// no cutoff by default
+	EXPECT_FALSE(GaussianCutoff().isEnabled());
+	EXPECT_DOUBLE_EQ(calculateGaussian(20.0, 0.0, 1.0, false, GaussianCutoff()), calculateGaussian(20.0, 0.0, 1.0));
+
+	// 1D: exact k-sigma boundary
+	auto cutoff = GaussianCutoff::fromSigmas(3.0);
+	EXPECT_DOUBLE_EQ(calculateGaussian(2.9 * 2.0, 0.0, 4.0, false, cutoff), calculateGaussian(2.9 * 2.0, 0.0, 4.0));
+	EXPECT_EQ(calculateGaussian(3.1 * 2.0, 0.0, 4.0, false, cutoff), 0.0);
+
+	// value floor
+	auto floor = GaussianCutoff::fromFloor(1e-03);
+	EXPECT_EQ(calculateGaussian(5.0, 0.0, 1.0, false, floor), 0.0);
+	EXPECT_DOUBLE_EQ(calculateGaussian(1.0, 0.0, 1.0, false, floor), calculateGaussian(1.0, 0.0, 1.0));
+
+	// 2D: values are either exact or zeroed with an error below the documented bound
+	Matrix2d cov(1.2, 0.9, 0.9, 0.8);
+	Vector2d mean(1.0, -1.0);
+	double peak = calculateGaussian(mean, mean, cov);
+	for (const auto& c: {GaussianCutoff::fromSigmas(2.0), GaussianCutoff::fromSigmas(4.0), GaussianCutoff(3.0, 1e-02)}) {
+		double error_max = c.getMaxError(peak);
+		size_t zeros = 0;
+		for (double dx = -6.0; dx <= 6.0; dx += 0.25) {
+			for (double dy = -6.0; dy <= 6.0; dy += 0.25) {
+				Vector2d x(mean(0) + dx, mean(1) + dy);
+				double exact = calculateGaussian(x, mean, cov);
+				double culled = calculateGaussian(x, mean, cov, c);
+				if (culled == 0.0) {
+					zeros++;
+					EXPECT_LE(exact, error_max);
+				} else {
+					EXPECT_DOUBLE_EQ(culled, exact);
+				}
+			}
+		}
+		EXPECT_GT(zeros, 0);
+	}
+	EXPECT_NEAR(GaussianCutoff::fromSigmas(5.0).getMaxError(1.0), 3.7267e-06, 1e-09);
+	EXPECT_DOUBLE_EQ(GaussianCutoff::fromFloor(1e-04).getMaxError(1.0), 1e-04);
+
+	Eigen::MatrixXd cov_eigen(2, 2);
+	cov_eigen << 1.2, 0.9, 0.9, 0.8;
+	Eigen::VectorXd mean_eigen(2);
+	mean_eigen << 1.0, -1.0;
+	Eigen::VectorXd x_eigen(2);
+	x_eigen << 1.5, -0.5;
+	EXPECT_DOUBLE_EQ(calculateGaussian(x_eigen, mean_eigen, cov_eigen, cutoff), calculateGaussian(x_eigen, mean_eigen, cov_eigen));
+	x_eigen << 10.0, -10.0;
+	EXPECT_EQ(calculateGaussian(x_eigen, mean_eigen, cov_eigen, cutoff), 0.0);
+}
+
 int main(int argc, char** argv) {
 	testing::InitGoogleTest(&argc, argv);
 	return RUN_ALL_TESTS();
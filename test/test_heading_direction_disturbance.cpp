@@ -1,6 +1,12 @@
 #include <gtest/gtest.h>
 
 #include <social_nav_utils/heading_direction_disturbance.h>
+#include <social_nav_utils/gaussians.h>
+
+#include "allocation_counter.h"
+
+#include <cmath>
+#include <limits>
 
 using namespace social_nav_utils;
 
@@ -105,6 +111,84 @@ TEST(TestHeadingDirection, scales) {
 	EXPECT_NEAR(hdd3.getDirectionScale(), 0.09096, 1e-03);
 }
 
+TEST(TestHeadingDirection, zeroAllocations) {
+	auto compute = [](double x_robot, double y_robot) {
+		HeadingDirectionDisturbance hdd(
+			0.05, -0.95, 0.3491,
+			0.0856, 0.0298, 0.0145,
+			x_robot, y_robot, -1.6232,
+			0.55, 0.00,
+			0.28,
+			3.6652
+		);
+		hdd.normalize(0.275, 0.55);
+		return hdd.getScale();
+	};
+	// the first call may initialize static state of the enabled instrumentation
+	double sum = compute(0.0, 0.1);
+
+	AllocationCounter counter;
+	for (size_t i = 0; i < 100; i++) {
+		sum += compute(-0.5 + 0.01 * i, 0.1 + 0.01 * i);
+	}
+	EXPECT_EQ(counter.getAllocations(), 0);
+	EXPECT_GE(sum, 0.0);
+}
+
+TEST(TestHeadingDirection, directionLogAndMahalanobis) {
+	for (double yaw_robot: {-1.6232, -1.2, -2.0}) {
+		double direction = HeadingDirectionDisturbance::computeDirectionDisturbance(
+			0.05, -0.95, 0.3491, 0.0856, 0.0298, 0.0145, 0.0, 0.1, yaw_robot
+		);
+		double log_density = HeadingDirectionDisturbance::computeDirectionDisturbanceLog(
+			0.05, -0.95, 0.3491, 0.0856, 0.0298, 0.0145, 0.0, 0.1, yaw_robot
+		);
+		double mahalanobis_sq = HeadingDirectionDisturbance::computeDirectionMahalanobisSquared(
+			0.05, -0.95, 0.3491, 0.0856, 0.0298, 0.0145, 0.0, 0.1, yaw_robot
+		);
+		EXPECT_NEAR(log_density, std::log(direction), 1e-12);
+		EXPECT_GE(mahalanobis_sq, 0.0);
+	}
+	// robot moving parallel to the line through the human center - direction axes do not intersect
+	double yaw_parallel = std::atan2(-0.95 - 0.1, 0.05 - 0.0) + M_PI_2;
+	EXPECT_EQ(
+		HeadingDirectionDisturbance::computeDirectionDisturbanceLog(
+			0.05, -0.95, 0.3491, 0.0856, 0.0298, 0.0145, 0.0, 0.1, yaw_parallel
+		),
+		-std::numeric_limits<double>::infinity()
+	);
+	EXPECT_EQ(
+		HeadingDirectionDisturbance::computeDirectionMahalanobisSquared(
+			0.05, -0.95, 0.3491, 0.0856, 0.0298, 0.0145, 0.0, 0.1, yaw_parallel
+		),
+		std::numeric_limits<double>::infinity()
+	);
+}
+
+TEST(TestHeadingDirection, directionCutoff) {
+	auto cutoff = GaussianCutoff::fromSigmas(2.0);
+	Matrix2d cov = HeadingDirectionDisturbance::computeDirectionCovariance(0.0856, 0.0298, 0.0145);
+	double error_max = cutoff.getMaxError(calculateGaussian(Vector2d(0.0, 0.0), Vector2d(0.0, 0.0), cov));
+	size_t zeros = 0;
+	for (double yaw_robot = -M_PI; yaw_robot < M_PI; yaw_robot += 0.05) {
+		double exact = HeadingDirectionDisturbance::computeDirectionDisturbance(
+			0.05, -0.95, 0.3491, 0.0856, 0.0298, 0.0145, 0.0, 0.1, yaw_robot
+		);
+		double culled = HeadingDirectionDisturbance::computeDirectionDisturbance(
+			0.05, -0.95, 0.3491, 0.0856, 0.0298, 0.0145, 0.0, 0.1, yaw_robot,
+			HeadingDirectionDisturbance::OCCUPANCY_MODEL_RADIUS_DEFAULT,
+			cutoff
+		);
+		if (culled == 0.0) {
+			zeros++;
+			EXPECT_LE(exact, error_max);
+		} else {
+			EXPECT_DOUBLE_EQ(culled, exact);
+		}
+	}
+	EXPECT_GT(zeros, 0);
+}
+
 int main(int argc, char** argv) {
 	testing::InitGoogleTest(&argc, argv);
 	return RUN_ALL_TESTS();
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <social_nav_utils/horizon_evaluator.h>
+#include <social_nav_utils/personal_space_model.h>
+
+#include "allocation_counter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace social_nav_utils;
+
+TEST(TestHorizonEvaluator, predictAndEvaluate) {
+	HumanArray humans;
+	// x, y, yaw, vx, vy, cov_xx, cov_xy, cov_yy, ps_var_front, ps_var_rear, ps_var_side
+	humans.add({-1.5, 0.5, 0.4, 0.6, -0.2, 0.05, 0.01, 0.08, 2.0, 0.5, 1.0});
+	humans.add({2.0, -1.0, 2.8, -0.7, 0.3, 0.12, -0.03, 0.04, 2.0, 0.5, 1.0});
+	humans.add({0.3, 2.5, -1.9, 0.1, -0.9, 0.02, 0.0, 0.02, 2.0, 0.5, 1.0});
+	humans.add({-3.2, -2.4, -0.6, 0.9, 0.8, 0.18, 0.05, 0.15, 2.0, 0.5, 1.0});
+	// robot moving diagonally through the area
+	const size_t STEPS_NUM = 20;
+	std::vector<double> poses_x(STEPS_NUM), poses_y(STEPS_NUM);
+	for (size_t k = 0; k < STEPS_NUM; k++) {
+		poses_x[k] = -3.0 + 0.3 * k;
+		poses_y[k] = -2.0 + 0.2 * k;
+	}
+
+	for (bool unify: {false, true}) {
+		for (bool normalize: {false, true}) {
+			HorizonEvaluator::Parameters params;
+			params.dt = 0.2;
+			params.cov_growth_xx = 0.1;
+			params.cov_growth_xy = 0.02;
+			params.cov_growth_yy = 0.05;
+			params.unify_asymmetry_scale = unify;
+			params.normalize = normalize;
+			HorizonEvaluator evaluator(params);
+			evaluator.predict(humans, STEPS_NUM);
+			ASSERT_EQ(evaluator.getStepsNum(), STEPS_NUM);
+			ASSERT_EQ(evaluator.getHumansNum(), 4);
+
+			std::vector<double> costs_sum(STEPS_NUM), costs_max(STEPS_NUM);
+			double total = evaluator.evaluate(poses_x.data(), poses_y.data(), costs_sum.data());
+			evaluator.evaluate(poses_x.data(), poses_y.data(), costs_max.data(), CostReduction::MAX);
+
+			// each step recomputed with models built for the extrapolated humans
+			double total_expected = 0.0;
+			for (size_t k = 0; k < STEPS_NUM; k++) {
+				double t = k * params.dt;
+				double sum = 0.0;
+				double max = 0.0;
+				for (size_t i = 0; i < humans.size(); i++) {
+					auto human = humans.get(i);
+					double x = human.x + human.vx * t;
+					double y = human.y + human.vy * t;
+					EXPECT_DOUBLE_EQ(evaluator.getPredictedX(k, i), x);
+					EXPECT_DOUBLE_EQ(evaluator.getPredictedY(k, i), y);
+					PersonalSpaceModel model(
+						x, y, human.yaw,
+						human.cov_xx + params.cov_growth_xx * t,
+						human.cov_xy + params.cov_growth_xy * t,
+						human.cov_xy + params.cov_growth_xy * t,
+						human.cov_yy + params.cov_growth_yy * t,
+						human.ps_var_front, human.ps_var_rear, human.ps_var_side,
+						unify
+					);
+					double cost = model.evaluate(poses_x[k], poses_y[k]);
+					if (normalize) {
+						cost /= model.getMax();
+					}
+					sum += cost;
+					max = std::max(max, cost);
+				}
+				EXPECT_NEAR(costs_sum[k], sum, 1e-12 * std::max(1.0, sum));
+				EXPECT_NEAR(costs_max[k], max, 1e-12 * std::max(1.0, max));
+				total_expected += sum;
+			}
+			EXPECT_NEAR(total, total_expected, 1e-12 * std::max(1.0, total_expected));
+			EXPECT_GT(total, 0.0);
+
+			// storage is reused by the following cycles
+			AllocationCounter counter;
+			evaluator.predict(humans, STEPS_NUM);
+			evaluator.evaluate(poses_x.data(), poses_y.data(), costs_sum.data());
+			EXPECT_EQ(counter.getAllocations(), 0);
+		}
+	}
+}
+
+TEST(TestHorizonEvaluator, covarianceGrowthFlattensCost) {
+	// standing human with the robot passing nearby at each step
+	HumanArray humans;
+	SocialScene::HumanState human;
+	human.ps_var_front = 1.0;
+	human.ps_var_rear = 1.0;
+	human.ps_var_side = 1.0;
+	humans.add(human);
+
+	HorizonEvaluator::Parameters params;
+	params.cov_growth_xx = 0.5;
+	params.cov_growth_yy = 0.5;
+	HorizonEvaluator evaluator(params);
+	evaluator.predict(humans, 10);
+	std::vector<double> poses_x(10, 0.0), poses_y(10, 0.0), costs(10);
+	evaluator.evaluate(poses_x.data(), poses_y.data(), costs.data());
+	// the peak decreases as the uncertainty grows
+	for (size_t k = 1; k < costs.size(); k++) {
+		EXPECT_LT(costs[k], costs[k - 1]);
+	}
+	EXPECT_DOUBLE_EQ(costs[0], 1.0 / (2.0 * M_PI));
+
+	// no humans, no costs
+	evaluator.predict(HumanArray(), 5);
+	EXPECT_EQ(evaluator.evaluate(poses_x.data(), poses_y.data(), costs.data()), 0.0);
+	EXPECT_EQ(costs[4], 0.0);
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
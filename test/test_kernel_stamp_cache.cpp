@@ -0,0 +1,232 @@
+#include <gtest/gtest.h>
+
+#include <social_nav_utils/kernel_stamp_cache.h>
+#include <social_nav_utils/personal_space_model.h>
+
+#include "allocation_counter.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace social_nav_utils;
+
+static const char* CACHE_PATH = "/tmp/social_nav_utils_test_stamps.snk";
+
+TEST(TestKernelStampCache, binsAndLevels) {
+	KernelStampCache::Parameters params;
+	params.var_front = 2.0;
+	params.var_rear = 0.5;
+	params.var_side = 1.0;
+	params.unify_asymmetry_scale = true;
+	params.position_variances = {0.0, 0.05};
+	KernelStampCache cache(params);
+	EXPECT_FALSE(cache.isMapped());
+	EXPECT_EQ(cache.getSide(), 2 * cache.getRadius() + 2);
+	EXPECT_EQ(cache.getRadius(), static_cast<size_t>(std::ceil(4.0 * std::sqrt(2.05) / 0.05)));
+
+	const double deg = M_PI / 180.0;
+	EXPECT_EQ(cache.getYawBin(0.0), 0);
+	EXPECT_EQ(cache.getYawBin(2.4 * deg), 0);
+	EXPECT_EQ(cache.getYawBin(2.6 * deg), 1);
+	EXPECT_EQ(cache.getYawBin(-5.0 * deg), 71);
+	EXPECT_EQ(cache.getYawBin(2.0 * M_PI), 0);
+	EXPECT_EQ(cache.getYawBin(-M_PI), 36);
+	EXPECT_EQ(cache.getYawBin(7.0 * M_PI + 10.0 * deg), 38);
+
+	EXPECT_EQ(cache.getLevel(0.0, 0.0), 0);
+	EXPECT_EQ(cache.getLevel(0.01, 0.02), 0);
+	EXPECT_EQ(cache.getLevel(0.04, 0.06), 1);
+	EXPECT_EQ(cache.getLevel(1.0, 1.0), 1);
+
+	EXPECT_THROW(KernelStampCache(KernelStampCache::Parameters()), std::invalid_argument);
+}
+
+TEST(TestKernelStampCache, stamp) {
+	KernelStampCache::Parameters params;
+	params.var_front = 2.0;
+	params.var_rear = 0.5;
+	params.var_side = 1.0;
+	params.unify_asymmetry_scale = true;
+	params.position_variances = {0.0, 0.05};
+	KernelStampCache cache(params);
+	const size_t WIDTH = 200;
+	const size_t HEIGHT = 180;
+	const double ORIGIN_X = -5.0;
+	const double ORIGIN_Y = -4.0;
+
+	// orientations exactly at the bins and covariances exactly at the levels, so only interpolation contributes
+	for (const auto& person: std::vector<std::vector<double>>{
+		{0.013, -0.027, 10.0, 0.0},
+		{-1.234, 0.871, 45.0, 0.05},
+		{0.5, 0.5, 71.0, 0.05}
+	}) {
+		double yaw = person[2] * 2.0 * M_PI / params.yaw_bins;
+		PersonalSpaceModel model(
+			person[0], person[1], yaw,
+			person[3], 0.0, 0.0, person[3],
+			params.var_front, params.var_rear, params.var_side,
+			params.unify_asymmetry_scale
+		);
+		std::vector<double> grid(WIDTH * HEIGHT, 0.0);
+		cache.stamp(
+			person[0], person[1], yaw, person[3], person[3],
+			grid.data(), WIDTH, HEIGHT, ORIGIN_X, ORIGIN_Y,
+			CostReduction::MAX, true
+		);
+		for (size_t row = 0; row < HEIGHT; row++) {
+			for (size_t col = 0; col < WIDTH; col++) {
+				double x = ORIGIN_X + (col + 0.5) * params.resolution;
+				double y = ORIGIN_Y + (row + 0.5) * params.resolution;
+				ASSERT_NEAR(grid[row * WIDTH + col], model.evaluate(x, y) / model.getMax(), 3e-03);
+			}
+		}
+		// peak is hit within the interpolation error
+		size_t col = static_cast<size_t>((person[0] - ORIGIN_X) / params.resolution);
+		size_t row = static_cast<size_t>((person[1] - ORIGIN_Y) / params.resolution);
+		EXPECT_GT(grid[row * WIDTH + col], 0.99);
+	}
+}
+
+TEST(TestKernelStampCache, reductionAndClipping) {
+	KernelStampCache::Parameters params;
+	params.var_front = 2.0;
+	params.var_rear = 0.5;
+	params.var_side = 1.0;
+	params.yaw_bins = 8;
+	KernelStampCache cache(params);
+	const size_t WIDTH = 120;
+	const size_t HEIGHT = 100;
+	const double ORIGIN_X = -3.0;
+	const double ORIGIN_Y = -2.5;
+
+	std::vector<double> max(WIDTH * HEIGHT, 0.0);
+	std::vector<double> sum(WIDTH * HEIGHT, 1.0);
+	cache.stamp(0.31, -0.17, 0.6, 0.0, 0.0, max.data(), WIDTH, HEIGHT, ORIGIN_X, ORIGIN_Y);
+	cache.stamp(0.31, -0.17, 0.6, 0.0, 0.0, sum.data(), WIDTH, HEIGHT, ORIGIN_X, ORIGIN_Y, CostReduction::SUM);
+	cache.stamp(0.31, -0.17, 0.6, 0.0, 0.0, sum.data(), WIDTH, HEIGHT, ORIGIN_X, ORIGIN_Y, CostReduction::SUM);
+	for (size_t i = 0; i < max.size(); i++) {
+		ASSERT_NEAR(sum[i], 1.0 + 2.0 * max[i], 1e-12);
+	}
+
+	// window of the grid placed over the corner of the stamp
+	const size_t COL_BEGIN = 70;
+	const size_t ROW_BEGIN = 20;
+	const size_t WINDOW_WIDTH = 50;
+	const size_t WINDOW_HEIGHT = 30;
+	std::vector<double> window(WINDOW_WIDTH * WINDOW_HEIGHT, 0.0);
+	cache.stamp(
+		0.31, -0.17, 0.6, 0.0, 0.0,
+		window.data(), WINDOW_WIDTH, WINDOW_HEIGHT,
+		ORIGIN_X + COL_BEGIN * params.resolution, ORIGIN_Y + ROW_BEGIN * params.resolution
+	);
+	for (size_t row = 0; row < WINDOW_HEIGHT; row++) {
+		for (size_t col = 0; col < WINDOW_WIDTH; col++) {
+			ASSERT_NEAR(window[row * WINDOW_WIDTH + col], max[(ROW_BEGIN + row) * WIDTH + COL_BEGIN + col], 1e-09);
+		}
+	}
+
+	// human far from the grid leaves it untouched
+	std::vector<double> untouched(WIDTH * HEIGHT, -1.0);
+	for (double x: {-50.0, 50.0, 0.0, std::nan("")}) {
+		cache.stamp(x, x == 0.0 ? 1e+20 : 0.0, 0.0, 0.0, 0.0, untouched.data(), WIDTH, HEIGHT, ORIGIN_X, ORIGIN_Y);
+	}
+	for (double cost: untouched) {
+		ASSERT_EQ(cost, -1.0);
+	}
+
+	// stamps are read in place
+	AllocationCounter counter;
+	cache.stamp(0.31, -0.17, 0.6, 0.0, 0.0, sum.data(), WIDTH, HEIGHT, ORIGIN_X, ORIGIN_Y, CostReduction::SUM, true);
+	cache.stamp(-1.2, 0.4, -2.5, 0.0, 0.0, max.data(), WIDTH, HEIGHT, ORIGIN_X, ORIGIN_Y);
+	EXPECT_EQ(counter.getAllocations(), 0);
+}
+
+TEST(TestKernelStampCache, saveAndMap) {
+	KernelStampCache::Parameters params;
+	params.var_front = 2.0;
+	params.var_rear = 0.5;
+	params.var_side = 1.0;
+	params.unify_asymmetry_scale = true;
+	params.resolution = 0.1;
+	params.yaw_bins = 16;
+	params.position_variances = {0.0, 0.05};
+	KernelStampCache computed(params);
+	computed.save(CACHE_PATH);
+
+	KernelStampCache mapped(CACHE_PATH);
+	EXPECT_TRUE(mapped.isMapped());
+	EXPECT_TRUE(mapped.isCompatible(params));
+	EXPECT_EQ(mapped.getRadius(), computed.getRadius());
+	for (size_t level = 0; level < params.position_variances.size(); level++) {
+		EXPECT_EQ(mapped.getPeak(level), computed.getPeak(level));
+		for (size_t bin = 0; bin < params.yaw_bins; bin++) {
+			ASSERT_EQ(
+				std::memcmp(
+					mapped.getStamp(level, bin),
+					computed.getStamp(level, bin),
+					computed.getSide() * computed.getSide() * sizeof(float)
+				),
+				0
+			);
+		}
+	}
+
+	// moved cache keeps the mapping
+	KernelStampCache moved(std::move(mapped));
+	EXPECT_TRUE(moved.isMapped());
+	std::vector<double> grid_computed(60 * 60, 0.0);
+	std::vector<double> grid_moved(60 * 60, 0.0);
+	computed.stamp(0.2, 0.1, 1.0, 0.04, 0.05, grid_computed.data(), 60, 60, -3.0, -3.0);
+	moved.stamp(0.2, 0.1, 1.0, 0.04, 0.05, grid_moved.data(), 60, 60, -3.0, -3.0);
+	EXPECT_EQ(grid_computed, grid_moved);
+
+	auto other = params;
+	other.var_side = 0.8;
+	EXPECT_FALSE(moved.isCompatible(other));
+	std::remove(CACHE_PATH);
+}
+
+TEST(TestKernelStampCache, loadOrCreate) {
+	KernelStampCache::Parameters params;
+	params.var_front = 2.0;
+	params.var_rear = 0.5;
+	params.var_side = 1.0;
+	params.resolution = 0.1;
+	params.yaw_bins = 8;
+	std::remove(CACHE_PATH);
+
+	// computed and saved at the first start, mapped at the following ones
+	EXPECT_FALSE(KernelStampCache::loadOrCreate(CACHE_PATH, params).isMapped());
+	EXPECT_TRUE(KernelStampCache::loadOrCreate(CACHE_PATH, params).isMapped());
+
+	// file of other parameters is replaced
+	auto other = params;
+	other.yaw_bins = 12;
+	auto recomputed = KernelStampCache::loadOrCreate(CACHE_PATH, other);
+	EXPECT_FALSE(recomputed.isMapped());
+	EXPECT_TRUE(recomputed.isCompatible(other));
+	EXPECT_TRUE(KernelStampCache(CACHE_PATH).isCompatible(other));
+
+	// truncated file is rejected and replaced
+	{
+		std::ifstream input(CACHE_PATH, std::ios::binary);
+		std::vector<char> content((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+		std::ofstream output(CACHE_PATH, std::ios::binary | std::ios::trunc);
+		output.write(content.data(), content.size() / 2);
+	}
+	EXPECT_THROW(KernelStampCache cache(CACHE_PATH), std::runtime_error);
+	EXPECT_FALSE(KernelStampCache::loadOrCreate(CACHE_PATH, params).isMapped());
+	EXPECT_TRUE(KernelStampCache::loadOrCreate(CACHE_PATH, params).isMapped());
+	std::remove(CACHE_PATH);
+
+	EXPECT_THROW(KernelStampCache cache("/tmp/social_nav_utils_missing_stamps.snk"), std::runtime_error);
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <social_nav_utils/memory_arena.h>
+#include <social_nav_utils/ellipse_fitting.h>
+#include <social_nav_utils/gaussians.h>
+#include <social_nav_utils/social_scene.h>
+
+#include "allocation_counter.h"
+
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+using namespace social_nav_utils;
+
+TEST(TestMemoryArena, reuseAfterReset) {
+	MemoryArena arena(1024);
+	void* first = nullptr;
+	for (size_t cycle = 0; cycle < 10; cycle++) {
+		std::pmr::vector<double> a(50, 1.0, &arena);
+		std::pmr::vector<int> b(20, 2, &arena);
+		if (cycle == 0) {
+			first = a.data();
+		}
+		// once grown, the same memory is given out in each cycle
+		EXPECT_EQ(static_cast<void*>(a.data()), first);
+		EXPECT_GE(arena.getBytesUsed(), 50 * sizeof(double) + 20 * sizeof(int));
+		arena.reset();
+		EXPECT_EQ(arena.getBytesUsed(), 0);
+	}
+	EXPECT_EQ(arena.getBlocksNum(), 1);
+	EXPECT_EQ(arena.getBytesReserved(), 1024);
+}
+
+TEST(TestMemoryArena, allocationCounter) {
+	AllocationCounter counter;
+	std::vector<double> heap(10);
+	Eigen::MatrixXd eigen_heap(3, 3);
+	EXPECT_EQ(counter.getAllocations(), 2);
+
+	// upstream is asked for the block only once (the other allocation holds the list of blocks)
+	MemoryArena arena;
+	counter.restart();
+	for (size_t cycle = 0; cycle < 10; cycle++) {
+		std::pmr::vector<double> temporary(100, &arena);
+		arena.reset();
+	}
+	EXPECT_EQ(counter.getAllocations(), 2);
+}
+
+TEST(TestMemoryArena, alignmentAndLargeAllocations) {
+	MemoryArena arena(256);
+	for (size_t alignment: {1, 2, 8, 16, 64}) {
+		void* ptr = arena.allocate(3, alignment);
+		EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignment, 0);
+	}
+	// allocation bigger than the block gets a dedicated block
+	void* big = arena.allocate(4096, 64);
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(big) % 64, 0);
+	EXPECT_EQ(arena.getBlocksNum(), 2);
+
+	// after reset, all blocks are visited in order before asking upstream for more
+	arena.reset();
+	EXPECT_NE(arena.allocate(200, 8), nullptr);
+	EXPECT_NE(arena.allocate(1000, 8), nullptr);
+	EXPECT_EQ(arena.getBlocksNum(), 2);
+	EXPECT_GE(arena.getBytesUsedPeak(), 4096);
+
+	arena.release();
+	EXPECT_EQ(arena.getBlocksNum(), 0);
+	EXPECT_EQ(arena.getBytesReserved(), 0);
+}
+
+TEST(TestMemoryArena, ellipseFittingMatchesDefault) {
+	auto x = std::vector<double>{1.0, 2.0, 3.0, 2.0, 1.2, 2.7};
+	auto y = std::vector<double>{3.0, 4.5, 3.0, 1.0, 1.8, 1.5};
+
+	MemoryArena arena;
+	EllipseFitting ellipse(x, y);
+	for (size_t cycle = 0; cycle < 3; cycle++) {
+		EllipseFitting ellipse_arena(x, y, &arena);
+		EXPECT_EQ(ellipse_arena.usedFallback(), ellipse.usedFallback());
+		EXPECT_DOUBLE_EQ(ellipse_arena.getCenterX(), ellipse.getCenterX());
+		EXPECT_DOUBLE_EQ(ellipse_arena.getCenterY(), ellipse.getCenterY());
+		EXPECT_DOUBLE_EQ(ellipse_arena.getSemiAxisMajor(), ellipse.getSemiAxisMajor());
+		EXPECT_DOUBLE_EQ(ellipse_arena.getSemiAxisMinor(), ellipse.getSemiAxisMinor());
+		EXPECT_DOUBLE_EQ(ellipse_arena.getOrientation(), ellipse.getOrientation());
+		arena.reset();
+	}
+	EXPECT_EQ(arena.getBlocksNum(), 1);
+}
+
+TEST(TestMemoryArena, gaussianMatchesDefault) {
+	Eigen::VectorXd mean(2);
+	mean << 1.0, -0.5;
+	Eigen::MatrixXd cov_front(2, 2);
+	cov_front << 0.8, 0.1, 0.1, 0.3;
+	Eigen::MatrixXd cov_rear(2, 2);
+	cov_rear << 0.2, 0.0, 0.0, 0.3;
+
+	MemoryArena arena;
+	for (double dx = -2.0; dx <= 2.0; dx += 0.25) {
+		Eigen::VectorXd x(2);
+		x << mean(0) + dx, mean(1) - 0.5 * dx;
+		EXPECT_NEAR(calculateGaussian(x, mean, cov_front, &arena), calculateGaussian(x, mean, cov_front), 1e-12);
+		EXPECT_NEAR(
+			calculateGaussianAsymmetrical(x, mean, 0.3, cov_front, cov_rear, true, &arena),
+			calculateGaussianAsymmetrical(x, mean, 0.3, cov_front, cov_rear, true),
+			1e-12
+		);
+		arena.reset();
+	}
+	// not positive definite covariance falls back to the generic computation
+	Eigen::MatrixXd cov_indef(2, 2);
+	cov_indef << 1.0, 0.0, 0.0, -1.0;
+	Eigen::VectorXd x(2);
+	x << 0.0, 0.0;
+	double expected = calculateGaussian(x, mean, cov_indef);
+	double actual = calculateGaussian(x, mean, cov_indef, &arena);
+	EXPECT_TRUE((std::isnan(expected) && std::isnan(actual)) || expected == actual);
+}
+
+TEST(TestMemoryArena, sceneReusesArena) {
+	SocialScene scene;
+	for (size_t frame = 0; frame < 5; frame++) {
+		scene.clear();
+		size_t g = scene.addGroup({3.0, 3.0, 4.0}, {0.5, -0.5, 0.0}, 0.1, 0.0, 0.1);
+		EXPECT_NEAR(scene.getGroup(g).x, 3.4, 0.5);
+	}
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
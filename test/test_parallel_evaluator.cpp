@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <social_nav_utils/parallel_evaluator.h>
+
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace social_nav_utils;
+
+// Crowd of humans and groups arranged on a grid with varying orientations and uncertainties
+static SocialScene createScene(size_t humans_num, size_t groups_num) {
+	SocialScene scene(true);
+	for (size_t i = 0; i < humans_num; i++) {
+		SocialScene::HumanState human;
+		human.x = 0.5 * (i % 10);
+		human.y = 0.7 * (i / 10);
+		human.yaw = -M_PI + 0.37 * i;
+		human.cov_xx = 0.05 + 0.01 * (i % 3);
+		human.cov_xy = 0.01;
+		human.cov_yy = 0.04;
+		human.ps_var_front = 2.0;
+		human.ps_var_rear = 0.5;
+		human.ps_var_side = 1.0;
+		scene.addHuman(human);
+	}
+	for (size_t i = 0; i < groups_num; i++) {
+		SocialScene::GroupState group;
+		group.x = 1.5 * i;
+		group.y = -1.0;
+		group.orientation = 0.3 * i;
+		group.variance_x = 0.25;
+		group.variance_y = 0.0625;
+		group.cov_xx = 0.1;
+		group.cov_xy = 0.02;
+		group.cov_yy = 0.1;
+		scene.addGroup(group);
+	}
+	return scene;
+}
+
+static void createPoses(size_t poses_num, std::vector<double>& x, std::vector<double>& y) {
+	x.clear();
+	y.clear();
+	for (size_t j = 0; j < poses_num; j++) {
+		x.push_back(-1.0 + 0.013 * j);
+		y.push_back(3.0 * std::sin(0.1 * j));
+	}
+}
+
+TEST(TestWorkStealingPool, allTasksExecutedOnce) {
+	WorkStealingPool pool(4);
+	ASSERT_EQ(pool.getThreadsNum(), 4);
+	std::vector<std::atomic<int>> counters(1000);
+	for (int rep = 0; rep < 3; rep++) {
+		pool.run(counters.size(), [&](size_t task) { counters[task]++; });
+	}
+	for (const auto& counter: counters) {
+		EXPECT_EQ(counter.load(), 3);
+	}
+}
+
+TEST(TestWorkStealingPool, exception) {
+	WorkStealingPool pool(3);
+	EXPECT_THROW(
+		pool.run(100, [](size_t task) { if (task == 42) { throw std::runtime_error("task failed"); } }),
+		std::runtime_error
+	);
+	// pool remains usable
+	std::atomic<size_t> sum(0);
+	pool.run(10, [&](size_t task) { sum += task; });
+	EXPECT_EQ(sum.load(), 45);
+}
+
+TEST(TestParallelEvaluator, matrixMatchesScene) {
+	auto scene = createScene(37, 5);
+	std::vector<double> x;
+	std::vector<double> y;
+	createPoses(517, x, y);
+
+	ParallelEvaluator evaluator(4, 8, 64);
+	std::vector<double> psi(scene.getHumansNum() * x.size());
+	evaluator.computePersonalSpaceMatrix(scene, x.data(), y.data(), x.size(), psi.data(), true);
+	for (size_t i = 0; i < scene.getHumansNum(); i++) {
+		for (size_t j = 0; j < x.size(); j++) {
+			ASSERT_DOUBLE_EQ(psi[i * x.size() + j], scene.computePersonalSpaceIntrusion(i, x[j], y[j], true));
+		}
+	}
+
+	std::vector<double> fsi(scene.getGroupsNum() * x.size());
+	evaluator.computeFormationSpaceMatrix(scene, x.data(), y.data(), x.size(), fsi.data());
+	for (size_t i = 0; i < scene.getGroupsNum(); i++) {
+		for (size_t j = 0; j < x.size(); j++) {
+			ASSERT_DOUBLE_EQ(fsi[i * x.size() + j], scene.computeFormationSpaceIntrusion(i, x[j], y[j]));
+		}
+	}
+}
+
+TEST(TestParallelEvaluator, deterministicReduction) {
+	auto scene = createScene(53, 7);
+	std::vector<double> x;
+	std::vector<double> y;
+	createPoses(1001, x, y);
+
+	std::vector<double> sum_ref(x.size());
+	std::vector<double> max_ref(x.size());
+	ParallelEvaluator evaluator_ref(1);
+	evaluator_ref.computePersonalSpaceReduced(scene, x.data(), y.data(), x.size(), sum_ref.data());
+	evaluator_ref.computeFormationSpaceReduced(
+		scene, x.data(), y.data(), x.size(), max_ref.data(), ParallelEvaluator::Reduction::MAX
+	);
+
+	for (size_t threads: {2, 3, 8}) {
+		ParallelEvaluator evaluator(threads, 5, 17);
+		std::vector<double> sum(x.size());
+		std::vector<double> max(x.size());
+		evaluator.computePersonalSpaceReduced(scene, x.data(), y.data(), x.size(), sum.data());
+		evaluator.computeFormationSpaceReduced(
+			scene, x.data(), y.data(), x.size(), max.data(), ParallelEvaluator::Reduction::MAX
+		);
+		for (size_t j = 0; j < x.size(); j++) {
+			// bitwise equality is expected
+			ASSERT_EQ(sum[j], sum_ref[j]);
+			ASSERT_EQ(max[j], max_ref[j]);
+		}
+	}
+
+	// plain sequential sum
+	double sum_seq = 0.0;
+	for (size_t i = 0; i < scene.getHumansNum(); i++) {
+		sum_seq += scene.computePersonalSpaceIntrusion(i, x[500], y[500]);
+	}
+	EXPECT_DOUBLE_EQ(sum_ref[500], sum_seq);
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
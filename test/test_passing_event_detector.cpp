@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <social_nav_utils/passing_event_detector.h>
+#include <social_nav_utils/passing_speed_comfort.h>
+
+#include "allocation_counter.h"
+
+#include <cmath>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+using namespace social_nav_utils;
+
+static const char* DATASET_PATH = "/tmp/social_nav_utils_test_passings.snt";
+
+/// Robot moves along the x axis with a constant speed; returns events reported by the detector (including finish)
+static std::vector<PassingEventDetector::Event> passStandingHuman(
+	PassingEventDetector& detector,
+	double human_x,
+	double human_y,
+	double speed,
+	double dt,
+	double x_begin,
+	double x_end
+) {
+	std::vector<PassingEventDetector::Event> events;
+	for (double t = 0.0; x_begin + speed * t <= x_end; t += dt) {
+		if (detector.update(t, x_begin + speed * t, 0.0, speed, 0.0, human_x, human_y)) {
+			events.push_back(detector.getEvent());
+		}
+	}
+	if (detector.finish()) {
+		events.push_back(detector.getEvent());
+	}
+	return events;
+}
+
+TEST(TestPassingEventDetector, closestApproachBetweenSamples) {
+	PassingEventDetector detector;
+	// samples do not hit the closest approach, which is found on the segment
+	auto events = passStandingHuman(detector, 0.37, 0.7, 1.2, 0.3, -5.0, 5.0);
+	ASSERT_EQ(events.size(), 1);
+	EXPECT_NEAR(events[0].distance, 0.7, 1e-12);
+	EXPECT_NEAR(events[0].time, 5.37 / 1.2, 1e-12);
+	EXPECT_NEAR(events[0].robot_speed, 1.2, 1e-12);
+	EXPECT_DOUBLE_EQ(events[0].comfort, PassingSpeedComfort::computeSpeedComfort(events[0].distance, 1.2));
+
+	// human too far to be passed
+	EXPECT_TRUE(passStandingHuman(detector, 0.0, 2.5, 1.0, 0.1, -5.0, 5.0).empty());
+}
+
+TEST(TestPassingEventDetector, hysteresis) {
+	PassingEventDetector::Parameters params;
+	params.distance_hysteresis = 0.2;
+	PassingEventDetector detector(params);
+
+	// lateral noise of trajectory smaller than the hysteresis does not split the passing
+	std::vector<PassingEventDetector::Event> events;
+	for (size_t i = 0; i <= 100; i++) {
+		double t = 0.1 * i;
+		double noise = (i % 2 == 0) ? 0.05 : -0.05;
+		if (detector.update(t, -5.0 + t, noise, 1.0, 0.0, 0.0, 1.0)) {
+			events.push_back(detector.getEvent());
+		}
+	}
+	EXPECT_FALSE(detector.finish());
+	ASSERT_EQ(events.size(), 1);
+	EXPECT_NEAR(events[0].distance, 0.95, 1e-09);
+	EXPECT_NEAR(events[0].time, 5.0, 0.1 + 1e-09);
+
+	// robot going back and forth passes the human twice
+	events.clear();
+	for (size_t i = 0; i <= 200; i++) {
+		double t = 0.1 * i;
+		double x = i <= 100 ? -5.0 + t : 15.0 - t;
+		double vx = i <= 100 ? 1.0 : -1.0;
+		if (detector.update(t, x, 0.0, vx, 0.0, 0.0, 0.5)) {
+			events.push_back(detector.getEvent());
+		}
+	}
+	EXPECT_FALSE(detector.finish());
+	ASSERT_EQ(events.size(), 2);
+	EXPECT_NEAR(events[0].time, 5.0, 1e-09);
+	EXPECT_NEAR(events[1].time, 15.0, 1e-09);
+	EXPECT_NEAR(events[1].distance, 0.5, 1e-12);
+}
+
+TEST(TestPassingEventDetector, finish) {
+	PassingEventDetector detector;
+	// trajectories end right after the closest approach, before the separation grows by the hysteresis
+	EXPECT_FALSE(detector.update(0.0, -1.0, 0.0, 1.0, 0.0, 0.0, 0.6));
+	EXPECT_FALSE(detector.update(1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.6));
+	EXPECT_FALSE(detector.update(1.1, 0.1, 0.0, 1.0, 0.0, 0.0, 0.6));
+	ASSERT_TRUE(detector.finish());
+	EXPECT_NEAR(detector.getEvent().distance, 0.6, 1e-12);
+	EXPECT_NEAR(detector.getEvent().time, 1.0, 1e-12);
+
+	// trajectories end while approaching
+	EXPECT_FALSE(detector.update(0.0, -1.0, 0.0, 1.0, 0.0, 0.0, 0.6));
+	EXPECT_FALSE(detector.update(0.5, -0.5, 0.0, 1.0, 0.0, 0.0, 0.6));
+	EXPECT_FALSE(detector.finish());
+	EXPECT_FALSE(detector.finish());
+}
+
+TEST(TestPassingEventDetector, episode) {
+	// agent 1 is passed twice (it is missing in the middle frames), agent 2 is passed once, agent 3 is far
+	TrajectoryDatasetWriter writer(DATASET_PATH);
+	writer.beginEpisode(5);
+	for (size_t f = 0; f <= 100; f++) {
+		TrajectoryDatasetWriter::RobotSample robot;
+		robot.x = -5.0 + 0.1 * f;
+		robot.vx = 1.0;
+		std::vector<TrajectoryDatasetWriter::AgentSample> agents;
+		if (f <= 40 || f >= 60) {
+			TrajectoryDatasetWriter::AgentSample agent;
+			agent.id = 1;
+			agent.x = f <= 40 ? -2.0 : 2.0;
+			agent.y = 0.5;
+			agents.push_back(agent);
+		}
+		TrajectoryDatasetWriter::AgentSample agent;
+		agent.id = 2;
+		agent.x = 0.0;
+		agent.y = -0.9;
+		agents.push_back(agent);
+		agent.id = 3;
+		agent.y = 4.0;
+		agents.push_back(agent);
+		writer.addFrame(0.1 * f, robot, agents);
+	}
+	writer.close();
+
+	TrajectoryDataset dataset(DATASET_PATH);
+	std::vector<std::pair<int64_t, PassingEventDetector::Event>> events;
+	detectPassingEvents(
+		dataset.getEpisode(0),
+		PassingEventDetector::Parameters(),
+		[&events](int64_t id, const PassingEventDetector::Event& event) {
+			events.emplace_back(id, event);
+		}
+	);
+	ASSERT_EQ(events.size(), 3);
+	EXPECT_EQ(events[0].first, 1);
+	EXPECT_NEAR(events[0].second.time, 3.0, 1e-09);
+	EXPECT_EQ(events[1].first, 2);
+	EXPECT_NEAR(events[1].second.time, 5.0, 1e-09);
+	EXPECT_NEAR(events[1].second.distance, 0.9, 1e-12);
+	EXPECT_EQ(events[2].first, 1);
+	EXPECT_NEAR(events[2].second.time, 7.0, 1e-09);
+	EXPECT_NEAR(events[2].second.distance, 0.5, 1e-12);
+	std::remove(DATASET_PATH);
+}
+
+TEST(TestPassingEventDetector, zeroAllocations) {
+	PassingEventDetector detector;
+	size_t events = 0;
+	AllocationCounter counter;
+	for (size_t i = 0; i <= 1000; i++) {
+		double t = 0.01 * i;
+		events += detector.update(t, -5.0 + t, 0.0, 1.0, 0.0, 0.0, 0.5);
+	}
+	events += detector.finish();
+	EXPECT_EQ(counter.getAllocations(), 0);
+	EXPECT_EQ(events, 1);
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
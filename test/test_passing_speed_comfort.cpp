@@ -1,6 +1,12 @@
 #include <gtest/gtest.h>
 
 #include <social_nav_utils/passing_speed_comfort.h>
+#include <social_nav_utils/passing_speed_comfort_table.h>
+
+#include "allocation_counter.h"
+
+#include <cmath>
+#include <vector>
 
 using namespace social_nav_utils;
 
@@ -20,6 +26,77 @@ TEST(TestPassingSpeedComfort, closeDistances) {
 	EXPECT_NEAR(PassingSpeedComfort::computeSpeedComfort(DIST_CLOSE, 0.90), 4.6429, 1e-03);
 }
 
+TEST(TestPassingSpeedComfort, blendedDistances) {
+	const double SPEED = 0.5;
+	double close = PassingSpeedComfort::computeComfortClose(SPEED);
+	double far = PassingSpeedComfort::computeComfortFar(SPEED);
+	EXPECT_DOUBLE_EQ(PassingSpeedComfort::computeSpeedComfort(PassingSpeedComfort::CLOSE_DIST_THRESHOLD, SPEED), close);
+	EXPECT_DOUBLE_EQ(PassingSpeedComfort::computeSpeedComfort(PassingSpeedComfort::FAR_DIST_THRESHOLD, SPEED), far);
+	// models are blended linearly between the thresholds
+	EXPECT_NEAR(PassingSpeedComfort::computeSpeedComfort(0.7, SPEED), 0.5 * (close + far), 1e-12);
+	EXPECT_NEAR(PassingSpeedComfort::computeSpeedComfort(0.65, SPEED), 0.75 * close + 0.25 * far, 1e-12);
+}
+
+TEST(TestPassingSpeedComfort, table) {
+	const auto& table = PassingSpeedComfortTable::getDefault();
+	EXPECT_EQ(&table, &PassingSpeedComfortTable::getDefault());
+	// documented bound: 2.6 * h^2
+	EXPECT_GT(table.getMaxError(), 0.0);
+	EXPECT_LT(table.getMaxError(), 2.6 * std::pow(table.getSpeedResolution(), 2));
+
+	std::vector<double> distance;
+	std::vector<double> speed;
+	for (double d = 0.0; d <= 1.5; d += 0.0125) {
+		for (double v = 0.0; v <= table.getSpeedMax(); v += 0.0173) {
+			distance.push_back(d);
+			speed.push_back(v);
+		}
+	}
+	// upper bound of the speed range
+	distance.push_back(0.7);
+	speed.push_back(table.getSpeedMax());
+
+	std::vector<double> batch(distance.size());
+	table.evaluate(distance.data(), speed.data(), distance.size(), batch.data());
+	for (size_t i = 0; i < distance.size(); i++) {
+		double expected = PassingSpeedComfort::computeSpeedComfort(distance[i], speed[i]);
+		ASSERT_NEAR(table.evaluate(distance[i], speed[i]), expected, table.getMaxError() + 1e-12);
+		ASSERT_NEAR(batch[i], table.evaluate(distance[i], speed[i]), 1e-12);
+	}
+
+	// speeds outside of the range are clamped
+	EXPECT_DOUBLE_EQ(table.evaluate(1.0, -1.0), table.evaluate(1.0, 0.0));
+	EXPECT_DOUBLE_EQ(table.evaluate(1.0, 10.0), table.evaluate(1.0, table.getSpeedMax()));
+	EXPECT_DOUBLE_EQ(table.evaluate(1.0, NAN), table.evaluate(1.0, 0.0));
+
+	// coarse table
+	PassingSpeedComfortTable coarse(1.0, 0.1);
+	EXPECT_EQ(coarse.getNodesNum(), 11);
+	EXPECT_LT(coarse.getMaxError(), 2.6 * 0.1 * 0.1);
+	EXPECT_GT(coarse.getMaxError(), table.getMaxError());
+}
+
+TEST(TestPassingSpeedComfort, zeroAllocations) {
+	// the first call may initialize static state of the enabled instrumentation
+	double sum = PassingSpeedComfort::computeSpeedComfort(1.0, 0.35);
+
+	AllocationCounter counter;
+	for (size_t i = 0; i < 100; i++) {
+		sum += PassingSpeedComfort::computeSpeedComfort(0.3 + 0.02 * i, 0.1 + 0.01 * i);
+	}
+	EXPECT_EQ(counter.getAllocations(), 0);
+	EXPECT_GT(sum, 0.0);
+
+	const auto& table = PassingSpeedComfortTable::getDefault();
+	double distance[4] = {0.3, 0.65, 0.75, 1.2};
+	double speed[4] = {0.1, 0.4, 0.8, 1.6};
+	double comfort[4];
+	counter.restart();
+	table.evaluate(distance, speed, 4, comfort);
+	sum = table.evaluate(0.7, 0.5);
+	EXPECT_EQ(counter.getAllocations(), 0);
+}
+
 int main(int argc, char** argv) {
 	testing::InitGoogleTest(&argc, argv);
 	return RUN_ALL_TESTS();
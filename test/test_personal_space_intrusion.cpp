@@ -2,6 +2,12 @@
 
 #include <social_nav_utils/personal_space_intrusion.h>
 
+#include "allocation_counter.h"
+#include <social_nav_utils/personal_space_model.h>
+
+#include <utility>
+#include <vector>
+
 using namespace social_nav_utils;
 
 TEST(TestMetricGaussian, personalSpaceGaussian) {
@@ -69,6 +75,149 @@ TEST(TestMetricGaussian, personalSpaceGaussian) {
 	EXPECT_NEAR(gaussian3, 0.0956295, 1e-05);
 }
 
+TEST(TestMetricGaussian, personalSpaceZeroAllocations) {
+	auto compute = [](double robot_x, double robot_y) {
+		PersonalSpaceIntrusion psi(
+			1.123, 7.321, 0.345678938849738,
+			1.321654, 0.456321, 0.456321, 0.321654,
+			2.00, 0.50, 1.00,
+			robot_x, robot_y,
+			true
+		);
+		psi.normalize();
+		PersonalSpaceModel model(
+			1.123, 7.321, 0.345678938849738,
+			1.321654, 0.456321, 0.456321, 0.321654,
+			2.00, 0.50, 1.00,
+			true
+		);
+		return psi.getScale() + model.evaluate(robot_x, robot_y) / model.getMax();
+	};
+	// the first call may initialize static state of the enabled instrumentation
+	double sum = compute(1.173, 7.821);
+
+	AllocationCounter counter;
+	for (size_t i = 0; i < 100; i++) {
+		sum += compute(1.0 + 0.01 * i, 7.0 - 0.02 * i);
+	}
+	EXPECT_EQ(counter.getAllocations(), 0);
+	EXPECT_GT(sum, 0.0);
+}
+
+TEST(TestMetricGaussian, personalSpaceLogAndMahalanobis) {
+	PersonalSpaceModel model(
+		1.123, 7.321, 0.345678938849738,
+		1.321654, 0.456321, 0.456321, 0.321654,
+		2.00, 0.50, 1.00,
+		true
+	);
+	for (double robot_x: {0.5, 1.173, 2.0}) {
+		for (double robot_y: {6.5, 7.821}) {
+			double gaussian = PersonalSpaceIntrusion::computePersonalSpaceGaussian(
+				1.123, 7.321, 0.345678938849738,
+				1.321654, 0.456321, 0.456321, 0.321654,
+				2.00, 0.50, 1.00,
+				robot_x, robot_y,
+				true
+			);
+			double log_density = PersonalSpaceIntrusion::computePersonalSpaceGaussianLog(
+				1.123, 7.321, 0.345678938849738,
+				1.321654, 0.456321, 0.456321, 0.321654,
+				2.00, 0.50, 1.00,
+				robot_x, robot_y,
+				true
+			);
+			double mahalanobis_sq = PersonalSpaceIntrusion::computePersonalSpaceMahalanobisSquared(
+				1.123, 7.321, 0.345678938849738,
+				1.321654, 0.456321, 0.456321, 0.321654,
+				2.00, 0.50, 1.00,
+				robot_x, robot_y
+			);
+			EXPECT_NEAR(log_density, std::log(gaussian), 1e-12);
+			EXPECT_NEAR(model.evaluateLog(robot_x, robot_y), log_density, 1e-12);
+			EXPECT_DOUBLE_EQ(model.computeMahalanobisSquared(robot_x, robot_y), mahalanobis_sq);
+			// normalized intrusion only needs the Mahalanobis distance within the same half-plane
+			if (model.getClassifier().isFront(robot_x, robot_y)) {
+				EXPECT_NEAR(gaussian / model.getMax(), std::exp(-0.5 * mahalanobis_sq), 1e-12);
+			}
+		}
+	}
+	EXPECT_NEAR(model.getMaxLog(), std::log(model.getMax()), 1e-12);
+}
+
+TEST(TestMetricGaussian, personalSpaceCutoff) {
+	PersonalSpaceModel model(
+		1.123, 7.321, 0.345678938849738,
+		1.321654, 0.456321, 0.456321, 0.321654,
+		2.00, 0.50, 1.00,
+		true
+	);
+	for (const auto& cutoff: {GaussianCutoff::fromSigmas(2.5), GaussianCutoff::fromFloor(1e-03)}) {
+		double error_max = cutoff.getMaxError(model.getMax());
+		size_t zeros = 0;
+		for (double dx = -8.0; dx <= 8.0; dx += 0.5) {
+			for (double dy = -8.0; dy <= 8.0; dy += 0.5) {
+				double robot_x = 1.123 + dx;
+				double robot_y = 7.321 + dy;
+				double exact = PersonalSpaceIntrusion::computePersonalSpaceGaussian(
+					1.123, 7.321, 0.345678938849738,
+					1.321654, 0.456321, 0.456321, 0.321654,
+					2.00, 0.50, 1.00,
+					robot_x, robot_y,
+					true
+				);
+				double culled = PersonalSpaceIntrusion::computePersonalSpaceGaussian(
+					1.123, 7.321, 0.345678938849738,
+					1.321654, 0.456321, 0.456321, 0.321654,
+					2.00, 0.50, 1.00,
+					robot_x, robot_y,
+					true,
+					cutoff
+				);
+				EXPECT_EQ(culled, model.evaluate(robot_x, robot_y, cutoff));
+				if (culled == 0.0) {
+					zeros++;
+					EXPECT_LE(exact, error_max);
+				} else {
+					// the model and the closed form differ in rounding only
+					EXPECT_NEAR(culled, exact, 1e-12 * exact);
+				}
+			}
+		}
+		EXPECT_GT(zeros, 0);
+	}
+}
+
+TEST(TestMetricGaussian, personalSpaceDiagonalUncertainty) {
+	// isotropic, diagonal and degenerate (no uncertainty) position covariances
+	for (const auto& cov: std::vector<std::pair<double, double>>{{0.05, 0.05}, {0.3, 0.02}, {0.0, 0.0}}) {
+		for (bool unify: {false, true}) {
+			for (double yaw = -M_PI; yaw < M_PI; yaw += 0.37) {
+				// the general path evaluated by the model
+				PersonalSpaceModel model(
+					1.5, -0.5, yaw,
+					cov.first, 0.0, 0.0, cov.second,
+					2.0, 0.5, 1.0,
+					unify
+				);
+				for (double dx = -2.0; dx <= 2.0; dx += 0.35) {
+					for (double dy = -2.0; dy <= 2.0; dy += 0.45) {
+						double expected = model.evaluate(1.5 + dx, -0.5 + dy);
+						double actual = PersonalSpaceIntrusion::computePersonalSpaceGaussian(
+							1.5, -0.5, yaw,
+							cov.first, 0.0, 0.0, cov.second,
+							2.0, 0.5, 1.0,
+							1.5 + dx, -0.5 + dy,
+							unify
+						);
+						ASSERT_NEAR(actual, expected, 1e-12 * expected);
+					}
+				}
+			}
+		}
+	}
+}
+
 int main(int argc, char** argv) {
 	testing::InitGoogleTest(&argc, argv);
 	return RUN_ALL_TESTS();
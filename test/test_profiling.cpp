@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <social_nav_utils/profiling.h>
+#include <social_nav_utils/personal_space_intrusion.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace social_nav_utils;
+
+TEST(TestLatencyHistogram, buckets) {
+	for (uint64_t value: {0UL, 1UL, 31UL, 32UL, 33UL, 1000UL, 123456789UL, 1UL << 62}) {
+		size_t bucket = LatencyHistogram::toBucket(value);
+		ASSERT_LT(bucket, LatencyHistogram::BUCKETS_NUM);
+		uint64_t upper = LatencyHistogram::fromBucket(bucket);
+		EXPECT_GE(upper, value);
+		// relative error bound
+		EXPECT_LE(upper - value, value / LatencyHistogram::SUB_BUCKETS);
+	}
+	EXPECT_EQ(LatencyHistogram::toBucket(~0UL), LatencyHistogram::BUCKETS_NUM - 1);
+}
+
+TEST(TestLatencyHistogram, percentiles) {
+	LatencyHistogram histogram;
+	EXPECT_EQ(histogram.getPercentile(50.0), 0);
+	for (uint64_t i = 1; i <= 1000; i++) {
+		histogram.record(i * 100);
+	}
+	EXPECT_EQ(histogram.getCount(), 1000);
+	EXPECT_EQ(histogram.getMin(), 100);
+	EXPECT_EQ(histogram.getMax(), 100000);
+	EXPECT_DOUBLE_EQ(histogram.getMean(), 50050.0);
+	EXPECT_NEAR(histogram.getPercentile(50.0), 50000, 50000 / LatencyHistogram::SUB_BUCKETS);
+	EXPECT_NEAR(histogram.getPercentile(99.0), 99000, 99000 / LatencyHistogram::SUB_BUCKETS);
+	EXPECT_EQ(histogram.getPercentile(100.0), 100000);
+
+	histogram.reset();
+	EXPECT_EQ(histogram.getCount(), 0);
+}
+
+TEST(TestLatencyHistogram, concurrent) {
+	LatencyHistogram histogram;
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < 4; t++) {
+		threads.emplace_back([&histogram]() {
+			for (uint64_t i = 0; i < 10000; i++) {
+				histogram.record(i);
+			}
+		});
+	}
+	for (auto& thread: threads) {
+		thread.join();
+	}
+	EXPECT_EQ(histogram.getCount(), 40000);
+	EXPECT_EQ(histogram.getMax(), 9999);
+}
+
+TEST(TestProfiler, traceFile) {
+	Profiler::reset();
+	Profiler::enableTrace("/tmp");
+	Profiler::startFrame();
+	{
+		ScopedTimer timer(ProfiledFunction::ELLIPSE_FITTING);
+	}
+	std::thread thread([]() {
+		ScopedTimer timer(ProfiledFunction::PASSING_SPEED_COMFORT);
+	});
+	thread.join();
+	ASSERT_TRUE(Profiler::finishFrame());
+	Profiler::disableTrace();
+	EXPECT_FALSE(Profiler::finishFrame());
+
+	EXPECT_EQ(Profiler::getHistogram(ProfiledFunction::ELLIPSE_FITTING).getCount(), 1);
+	EXPECT_NE(Profiler::getReport().find("EllipseFitting"), std::string::npos);
+
+	std::ifstream file(Profiler::getLastTracePath());
+	ASSERT_TRUE(file.is_open());
+	std::stringstream content;
+	content << file.rdbuf();
+	EXPECT_EQ(content.str().find("{\"traceEvents\":["), 0);
+	EXPECT_NE(content.str().find("\"name\":\"EllipseFitting\""), std::string::npos);
+	// events of finished threads are included
+	EXPECT_NE(content.str().find("\"name\":\"PassingSpeedComfort\""), std::string::npos);
+	std::remove(Profiler::getLastTracePath().c_str());
+}
+
+#ifdef SOCIAL_NAV_UTILS_ENABLE_PROFILING
+TEST(TestProfiler, libraryEntryPoints) {
+	Profiler::reset();
+	PersonalSpaceIntrusion psi(0.0, 0.0, 0.0, 0.1, 0.0, 0.0, 0.1, 2.0, 0.5, 1.0, 1.0, 1.0);
+	psi.normalize();
+	EXPECT_EQ(Profiler::getHistogram(ProfiledFunction::PERSONAL_SPACE_INTRUSION).getCount(), 1);
+	EXPECT_EQ(Profiler::getHistogram(ProfiledFunction::PERSONAL_SPACE_INTRUSION_NORMALIZE).getCount(), 1);
+	EXPECT_EQ(Profiler::getHistogram(ProfiledFunction::PERSONAL_SPACE_GAUSSIAN).getCount(), 2);
+}
+#endif
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+
+#include <social_nav_utils/recording.h>
+#include <social_nav_utils/ellipse_fitting.h>
+#include <social_nav_utils/heading_direction_disturbance.h>
+#include <social_nav_utils/passing_speed_comfort.h>
+#include <social_nav_utils/personal_space_intrusion.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace social_nav_utils;
+
+static const char* LOG_PATH = "/tmp/social_nav_utils_test_recording.bin";
+
+static std::vector<Record> readAll(const std::string& path) {
+	std::vector<Record> records;
+	RecordReader reader(path);
+	Record record;
+	while (reader.next(record)) {
+		records.push_back(record);
+	}
+	return records;
+}
+
+TEST(TestRecording, writeRead) {
+	ASSERT_TRUE(Recorder::start(LOG_PATH));
+	EXPECT_TRUE(Recorder::isActive());
+	Recorder::write(RecordType::PASSING_SPEED_COMFORT, {0.5, 1.0}, {3.0});
+	Recorder::write(RecordType::ELLIPSE_FITTING, std::vector<double>{1.0, 2.0, 3.0, 4.0}, std::vector<double>(6, 0.5));
+	EXPECT_TRUE(Recorder::stop());
+	EXPECT_FALSE(Recorder::isActive());
+	// ignored after stop
+	Recorder::write(RecordType::PASSING_SPEED_COMFORT, {0.5, 1.0}, {3.0});
+
+	auto records = readAll(LOG_PATH);
+	ASSERT_EQ(records.size(), 2);
+	EXPECT_EQ(records[0].type, RecordType::PASSING_SPEED_COMFORT);
+	EXPECT_EQ(records[0].inputs, (std::vector<double>{0.5, 1.0}));
+	EXPECT_EQ(records[0].outputs, (std::vector<double>{3.0}));
+	EXPECT_EQ(records[1].type, RecordType::ELLIPSE_FITTING);
+	EXPECT_EQ(records[1].inputs, (std::vector<double>{1.0, 2.0, 3.0, 4.0}));
+	EXPECT_EQ(records[1].outputs, std::vector<double>(6, 0.5));
+	std::remove(LOG_PATH);
+}
+
+TEST(TestRecording, invalidLog) {
+	EXPECT_THROW(RecordReader("/nonexistent/social_nav_utils.bin"), std::runtime_error);
+
+	{
+		std::ofstream file(LOG_PATH, std::ios::binary);
+		file << "NOTALOG!";
+	}
+	EXPECT_THROW(RecordReader reader(LOG_PATH), std::runtime_error);
+
+	// valid magic, record cut in the middle
+	{
+		std::ofstream file(LOG_PATH, std::ios::binary);
+		file.write(Recorder::MAGIC, 8);
+		file.put(static_cast<char>(RecordType::PASSING_SPEED_COMFORT));
+		file.put(2);
+	}
+	RecordReader reader(LOG_PATH);
+	Record record;
+	EXPECT_THROW(reader.next(record), std::runtime_error);
+
+	// counts not matching the type or the size of the file are rejected before the values are allocated
+	for (uint32_t inputs_num: {3u, 0xffffffffu}) {
+		{
+			std::ofstream file(LOG_PATH, std::ios::binary);
+			file.write(Recorder::MAGIC, 8);
+			file.put(static_cast<char>(RecordType::PASSING_SPEED_COMFORT));
+			uint32_t outputs_num = 1;
+			file.write(reinterpret_cast<const char*>(&inputs_num), sizeof(inputs_num));
+			file.write(reinterpret_cast<const char*>(&outputs_num), sizeof(outputs_num));
+			std::vector<double> values(4, 0.5);
+			file.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(double));
+		}
+		RecordReader corrupted(LOG_PATH);
+		EXPECT_THROW(corrupted.next(record), std::runtime_error);
+	}
+	{
+		std::ofstream file(LOG_PATH, std::ios::binary);
+		file.write(Recorder::MAGIC, 8);
+		file.put(static_cast<char>(RecordType::ELLIPSE_FITTING));
+		uint32_t inputs_num = 0x10000000;
+		uint32_t outputs_num = 6;
+		file.write(reinterpret_cast<const char*>(&inputs_num), sizeof(inputs_num));
+		file.write(reinterpret_cast<const char*>(&outputs_num), sizeof(outputs_num));
+	}
+	RecordReader oversized(LOG_PATH);
+	EXPECT_THROW(oversized.next(record), std::runtime_error);
+	std::remove(LOG_PATH);
+
+	// failed writes (full disk) are reported when the log is closed
+	ASSERT_TRUE(Recorder::start("/dev/full"));
+	for (size_t i = 0; i < 1000; i++) {
+		Recorder::write(RecordType::PASSING_SPEED_COMFORT, {0.5, 1.0}, {3.0});
+	}
+	EXPECT_FALSE(Recorder::stop());
+	EXPECT_FALSE(Recorder::isActive());
+}
+
+TEST(TestRecording, replay) {
+	Record record;
+	std::vector<double> outputs;
+
+	record.type = RecordType::PERSONAL_SPACE_GAUSSIAN;
+	record.inputs = {0.0, 0.0, 0.0, 0.1, 0.0, 0.0, 0.1, 2.0, 0.5, 1.0, 1.0, 1.0, 0.0};
+	replayRecord(record, outputs);
+	ASSERT_EQ(outputs.size(), 1);
+	EXPECT_DOUBLE_EQ(
+		outputs[0],
+		PersonalSpaceIntrusion::computePersonalSpaceGaussian(0.0, 0.0, 0.0, 0.1, 0.0, 0.0, 0.1, 2.0, 0.5, 1.0, 1.0, 1.0)
+	);
+
+	record.type = RecordType::HEADING_DIRECTION_DIRECTION;
+	record.inputs = {0.0, 0.0, 0.0, 0.1, 0.0, 0.1, 2.0, 1.0, M_PI, 0.3};
+	replayRecord(record, outputs);
+	ASSERT_EQ(outputs.size(), 1);
+	EXPECT_DOUBLE_EQ(
+		outputs[0],
+		HeadingDirectionDisturbance::computeDirectionDisturbance(0.0, 0.0, 0.0, 0.1, 0.0, 0.1, 2.0, 1.0, M_PI, 0.3)
+	);
+
+	record.type = RecordType::PASSING_SPEED_COMFORT;
+	record.inputs = {0.7, 1.2};
+	replayRecord(record, outputs);
+	ASSERT_EQ(outputs.size(), 1);
+	EXPECT_DOUBLE_EQ(outputs[0], PassingSpeedComfort::computeSpeedComfort(0.7, 1.2));
+
+	record.type = RecordType::ELLIPSE_FITTING;
+	record.inputs = {0.0, 1.0, 2.0, 1.0, 0.0, 1.0, 0.0, -1.0};
+	replayRecord(record, outputs);
+	ASSERT_EQ(outputs.size(), 6);
+	EllipseFitting ellipse({0.0, 1.0, 2.0, 1.0}, {0.0, 1.0, 0.0, -1.0});
+	EXPECT_DOUBLE_EQ(outputs[0], ellipse.getCenterX());
+	EXPECT_DOUBLE_EQ(outputs[1], ellipse.getCenterY());
+	EXPECT_DOUBLE_EQ(outputs[2], ellipse.getSemiAxisMajor());
+	EXPECT_DOUBLE_EQ(outputs[3], ellipse.getSemiAxisMinor());
+	EXPECT_DOUBLE_EQ(outputs[4], ellipse.getOrientation());
+	EXPECT_DOUBLE_EQ(outputs[5], ellipse.usedFallback() ? 1.0 : 0.0);
+
+	// wrong number of inputs
+	record.type = RecordType::PASSING_SPEED_COMFORT;
+	record.inputs = {0.7};
+	EXPECT_THROW(replayRecord(record, outputs), std::invalid_argument);
+}
+
+#ifdef SOCIAL_NAV_UTILS_ENABLE_RECORDING
+TEST(TestRecording, libraryCalls) {
+	ASSERT_TRUE(Recorder::start(LOG_PATH));
+	PersonalSpaceIntrusion psi(0.0, 0.0, 0.0, 0.1, 0.0, 0.0, 0.1, 2.0, 0.5, 1.0, 1.0, 1.0);
+	psi.normalize();
+	PassingSpeedComfort psc(0.7, 1.2);
+	EllipseFitting ellipse({0.0, 1.0, 2.0, 1.0}, {0.0, 1.0, 0.0, -1.0});
+	EXPECT_TRUE(Recorder::stop());
+
+	auto records = readAll(LOG_PATH);
+	ASSERT_EQ(records.size(), 4);
+	EXPECT_EQ(records[0].type, RecordType::PERSONAL_SPACE_GAUSSIAN);
+	EXPECT_EQ(records[1].type, RecordType::PERSONAL_SPACE_GAUSSIAN);
+	EXPECT_EQ(records[2].type, RecordType::PASSING_SPEED_COMFORT);
+	EXPECT_EQ(records[3].type, RecordType::ELLIPSE_FITTING);
+	EXPECT_DOUBLE_EQ(records[2].outputs.at(0), psc.getComfort());
+
+	// replay through the same build reproduces results exactly
+	std::vector<double> outputs;
+	for (const auto& record: records) {
+		replayRecord(record, outputs);
+		EXPECT_EQ(outputs, record.outputs);
+	}
+	std::remove(LOG_PATH);
+}
+#endif
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -18,6 +18,41 @@ TEST(TestRelativeLocation, example2) {
 	ASSERT_TRUE(rl.isLeftSide());
 }
 
+TEST(TestRelativeLocation, rearRight) {
+	RelativeLocation rl(2.0, 2.0, M_PI_2, 3.0, 1.0);
+	ASSERT_DOUBLE_EQ(rl.getAngle(), -3.0 * M_PI_4);
+	ASSERT_FALSE(rl.isFront());
+	ASSERT_FALSE(rl.isLeftSide());
+}
+
+TEST(TestRelativeLocationClassifier, consistency) {
+	const double X_EGO = 1.25;
+	const double Y_EGO = -0.75;
+	for (double yaw = -M_PI; yaw < M_PI; yaw += M_PI / 7.0) {
+		RelativeLocationClassifier rlc(X_EGO, Y_EGO, yaw);
+		// directions are shifted to avoid ambiguous, exactly collinear arrangements
+		for (double dir = -M_PI + 0.05; dir < M_PI; dir += M_PI / 11.0) {
+			double x_other = X_EGO + 2.0 * std::cos(dir);
+			double y_other = Y_EGO + 2.0 * std::sin(dir);
+			RelativeLocation rl(X_EGO, Y_EGO, yaw, x_other, y_other);
+			EXPECT_EQ(rlc.isFront(x_other, y_other), rl.isFront());
+			EXPECT_EQ(rlc.isLeftSide(x_other, y_other), rl.isLeftSide());
+		}
+	}
+}
+
+TEST(TestRelativeLocationClassifier, batch) {
+	RelativeLocationClassifier rlc(2.0, 2.0, M_PI_2);
+	const double x_other[] = {3.0, 1.0, 1.0, 3.0};
+	const double y_other[] = {3.0, 3.0, 1.0, 1.0};
+	uint8_t masks[4] = {0xff, 0xff, 0xff, 0xff};
+	rlc.classify(x_other, y_other, 4, masks);
+	EXPECT_EQ(masks[0], RelativeLocationClassifier::MASK_FRONT);
+	EXPECT_EQ(masks[1], RelativeLocationClassifier::MASK_FRONT | RelativeLocationClassifier::MASK_LEFT);
+	EXPECT_EQ(masks[2], RelativeLocationClassifier::MASK_LEFT);
+	EXPECT_EQ(masks[3], 0);
+}
+
 int main(int argc, char** argv) {
 	testing::InitGoogleTest(&argc, argv);
 	return RUN_ALL_TESTS();
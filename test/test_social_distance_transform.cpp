@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+
+#include <social_nav_utils/personal_space_model.h>
+#include <social_nav_utils/social_distance_transform.h>
+
+#include "allocation_counter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace social_nav_utils;
+
+static constexpr size_t WIDTH = 60;
+static constexpr size_t HEIGHT = 45;
+
+TEST(TestSocialDistanceTransform, freeSpace) {
+	SocialDistanceTransform::Parameters params;
+	params.resolution = 0.1;
+	params.social_weight = 0.0;
+	SocialDistanceTransform transform(WIDTH, HEIGHT, params);
+	std::vector<double> costs(WIDTH * HEIGHT, 0.3);
+	transform.compute(costs.data(), 10, 20);
+	// octile distances; the first two sweeps find them up to rounding of equally long paths
+	EXPECT_LE(transform.getSweepsNum(), 5);
+	EXPECT_DOUBLE_EQ(transform.getDistance(10, 20), 0.0);
+	EXPECT_NEAR(transform.getDistance(50, 20), 4.0, 1e-12);
+	EXPECT_NEAR(transform.getDistance(0, 0), (10 * std::sqrt(2.0) + 10) * 0.1, 1e-12);
+	EXPECT_NEAR(transform.getDistance(59, 44), (24 * std::sqrt(2.0) + 25) * 0.1, 1e-12);
+
+	EXPECT_THROW(transform.compute(costs.data(), WIDTH, 0), std::out_of_range);
+	params.resolution = 0.0;
+	EXPECT_THROW(SocialDistanceTransform(WIDTH, HEIGHT, params), std::invalid_argument);
+}
+
+TEST(TestSocialDistanceTransform, matchesDijkstra) {
+	SocialDistanceTransform::Parameters params;
+	params.resolution = 0.1;
+	params.social_weight = 20.0;
+	SocialDistanceTransform transform(WIDTH, HEIGHT, params);
+
+	// normalized personal space cut off at 3 sigmas, a wall (lethal cells) with a gap at the top
+	PersonalSpaceModel model(3.0, 2.0, 0.5, 0.01, 0.0, 0.0, 0.01, 0.1, 0.03, 0.05);
+	GaussianCutoff cutoff(3.0);
+	std::vector<double> costs(WIDTH * HEIGHT);
+	for (size_t cell = 0; cell < costs.size(); cell++) {
+		double x = (cell % WIDTH + 0.5) * params.resolution;
+		double y = (cell / WIDTH + 0.5) * params.resolution;
+		costs[cell] = (cell % WIDTH == 40 && cell / WIDTH >= 5)
+			? std::numeric_limits<double>::infinity()
+			: model.evaluate(x, y, cutoff) / model.getMax();
+	}
+
+	for (bool walled_off: {false, true}) {
+		if (walled_off) {
+			std::fill(costs.begin() + 4 * WIDTH, costs.begin() + 5 * WIDTH, std::numeric_limits<double>::infinity());
+		}
+		transform.compute(costs.data(), 55, 30);
+
+		// Dijkstra's algorithm over the 8-connected grid
+		std::vector<double> expected(costs.size(), std::numeric_limits<double>::infinity());
+		using Entry = std::pair<double, size_t>;
+		std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+		expected[30 * WIDTH + 55] = 0.0;
+		queue.push({0.0, 30 * WIDTH + 55});
+		while (!queue.empty()) {
+			auto [distance, cell] = queue.top();
+			queue.pop();
+			if (distance > expected[cell]) {
+				continue;
+			}
+			int col = static_cast<int>(cell % WIDTH);
+			int row = static_cast<int>(cell / WIDTH);
+			for (int dy = -1; dy <= 1; dy++) {
+				for (int dx = -1; dx <= 1; dx++) {
+					int ncol = col + dx;
+					int nrow = row + dy;
+					if ((dx == 0 && dy == 0) || ncol < 0 || nrow < 0 || ncol >= int(WIDTH) || nrow >= int(HEIGHT)) {
+						continue;
+					}
+					size_t neighbor = nrow * WIDTH + ncol;
+					double length = (dx != 0 && dy != 0) ? std::sqrt(2.0) : 1.0;
+					// infinite costs give infinite traversal
+					double next = distance + 0.5 * params.resolution * length
+						* (2.0 + params.social_weight * (costs[cell] + costs[neighbor]));
+					if (next < expected[neighbor]) {
+						expected[neighbor] = next;
+						queue.push({next, neighbor});
+					}
+				}
+			}
+		}
+
+		for (size_t cell = 0; cell < costs.size(); cell++) {
+			if (std::isinf(expected[cell])) {
+				ASSERT_TRUE(std::isinf(transform.getDistances()[cell])) << cell;
+			} else {
+				ASSERT_NEAR(transform.getDistances()[cell], expected[cell], 1e-09 * (1.0 + expected[cell])) << cell;
+			}
+		}
+	}
+	// walled off cells
+	EXPECT_TRUE(std::isinf(transform.getDistance(0, 0)));
+	EXPECT_TRUE(std::isinf(transform.getDistance(40, 10)));
+	// paths bend around the wall, so more sweeps are needed
+	EXPECT_GT(transform.getSweepsNum(), 3);
+}
+
+TEST(TestSocialDistanceTransform, update) {
+	SocialDistanceTransform::Parameters params;
+	params.resolution = 0.1;
+	params.social_weight = 20.0;
+	SocialDistanceTransform transform(WIDTH, HEIGHT, params);
+
+	// the human moves, so the costs change within the union of its old and new supports (cut off at 3 sigmas)
+	PersonalSpaceModel model(3.0, 2.0, 0.5, 0.01, 0.0, 0.0, 0.01, 0.1, 0.03, 0.05);
+	PersonalSpaceModel model_moved(3.4, 2.3, 0.5, 0.01, 0.0, 0.0, 0.01, 0.1, 0.03, 0.05);
+	GaussianCutoff cutoff(3.0);
+	std::vector<double> costs(WIDTH * HEIGHT), costs_moved(WIDTH * HEIGHT);
+	for (size_t cell = 0; cell < costs.size(); cell++) {
+		double x = (cell % WIDTH + 0.5) * params.resolution;
+		double y = (cell / WIDTH + 0.5) * params.resolution;
+		costs[cell] = model.evaluate(x, y, cutoff) / model.getMax();
+		costs_moved[cell] = model_moved.evaluate(x, y, cutoff) / model_moved.getMax();
+		if (cell % WIDTH < 18 || cell % WIDTH >= 48 || cell / WIDTH < 8 || cell / WIDTH >= 36) {
+			ASSERT_EQ(costs[cell], costs_moved[cell]);
+		}
+	}
+	// repaired field matches the one computed from scratch
+	SocialDistanceTransform recomputed(WIDTH, HEIGHT, params);
+	auto expectRecomputed = [&]() {
+		recomputed.compute(costs_moved.data(), 55, 30);
+		for (size_t cell = 0; cell < WIDTH * HEIGHT; cell++) {
+			double expected = recomputed.getDistances()[cell];
+			if (std::isinf(expected)) {
+				ASSERT_TRUE(std::isinf(transform.getDistances()[cell])) << cell;
+			} else {
+				ASSERT_NEAR(transform.getDistances()[cell], expected, 1e-09 * (1.0 + expected)) << cell;
+			}
+		}
+	};
+
+	transform.compute(costs.data(), 55, 30);
+	transform.update(costs_moved.data(), 18, 8, 48, 36);
+	expectRecomputed();
+	EXPECT_GT(transform.getRepairedNum(), 30 * 28);
+	EXPECT_LT(transform.getRepairedNum(), WIDTH * HEIGHT);
+
+	// a wall (lethal cells) raises cells beyond the changed ones, opening it lowers them again
+	for (size_t row = 5; row < HEIGHT; row++) {
+		costs_moved[row * WIDTH + 40] = std::numeric_limits<double>::infinity();
+	}
+	transform.update(costs_moved.data(), 40, 5, 41, HEIGHT);
+	expectRecomputed();
+	EXPECT_TRUE(std::isinf(transform.getDistance(40, 20)));
+	costs_moved[20 * WIDTH + 40] = 0.0;
+	transform.update(costs_moved.data(), 40, 20, 41, 21);
+	expectRecomputed();
+
+	// costs around the goal, a clipped rectangle
+	costs_moved[30 * WIDTH + 55] = 0.5;
+	costs_moved[31 * WIDTH + 54] = 0.8;
+	costs_moved[44 * WIDTH + 59] = 0.9;
+	transform.update(costs_moved.data(), 54, 30, 56, 32);
+	transform.update(costs_moved.data(), 59, 44, 100, 100);
+	expectRecomputed();
+
+	// empty rectangle
+	transform.update(costs_moved.data(), 10, 10, 10, 20);
+	EXPECT_EQ(transform.getRepairedNum(), 0);
+
+	// storage of the repairs is reused once grown
+	costs_moved[20 * WIDTH + 40] = std::numeric_limits<double>::infinity();
+	transform.update(costs_moved.data(), 40, 20, 41, 21);
+	costs_moved[20 * WIDTH + 40] = 0.0;
+	transform.update(costs_moved.data(), 40, 20, 41, 21);
+	AllocationCounter counter;
+	costs_moved[20 * WIDTH + 40] = std::numeric_limits<double>::infinity();
+	transform.update(costs_moved.data(), 40, 20, 41, 21);
+	costs_moved[20 * WIDTH + 40] = 0.0;
+	transform.update(costs_moved.data(), 40, 20, 41, 21);
+	EXPECT_EQ(counter.getAllocations(), 0);
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
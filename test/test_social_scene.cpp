@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+
+#include <social_nav_utils/social_scene.h>
+#include <social_nav_utils/personal_space_intrusion.h>
+#include <social_nav_utils/formation_space_intrusion.h>
+#include <social_nav_utils/heading_direction_disturbance.h>
+#include <social_nav_utils/passing_speed_comfort.h>
+
+#include "allocation_counter.h"
+
+using namespace social_nav_utils;
+
+class TestSocialScene: public ::testing::Test {
+protected:
+	void SetUp() override {
+		robot.x = 0.00;
+		robot.y = 0.10;
+		robot.yaw = -1.6232;
+		robot.vx = 0.55;
+		robot.vy = 0.00;
+
+		human1.x = 0.05;
+		human1.y = -0.95;
+		human1.yaw = 0.3491;
+		human1.cov_xx = 0.0856;
+		human1.cov_xy = 0.0298;
+		human1.cov_yy = 0.0145;
+		human1.ps_var_front = 2.00;
+		human1.ps_var_rear = 0.50;
+		human1.ps_var_side = 1.00;
+
+		human2 = human1;
+		human2.x = 1.123;
+		human2.y = 0.321;
+		human2.yaw = -2.5;
+
+		group.x = 4.0;
+		group.y = 2.0;
+		group.orientation = -0.523598775598299;
+		group.variance_x = 0.25;
+		group.variance_y = 0.0625;
+		group.cov_xx = 0.87654;
+		group.cov_xy = 0.67892;
+		group.cov_yy = 1.09876;
+	}
+
+	SocialScene::RobotState robot;
+	SocialScene::HumanState human1;
+	SocialScene::HumanState human2;
+	SocialScene::GroupState group;
+};
+
+TEST_F(TestSocialScene, personalSpace) {
+	for (bool unify: {false, true}) {
+		SocialScene scene(unify);
+		scene.setRobot(robot);
+		scene.addHuman(human1);
+		scene.addHuman(human2);
+		ASSERT_EQ(scene.getHumansNum(), 2);
+
+		for (size_t i = 0; i < scene.getHumansNum(); i++) {
+			const auto& h = scene.getHuman(i);
+			PersonalSpaceIntrusion psi(
+				h.x, h.y, h.yaw,
+				h.cov_xx, h.cov_xy, h.cov_xy, h.cov_yy,
+				h.ps_var_front, h.ps_var_rear, h.ps_var_side,
+				robot.x, robot.y,
+				unify
+			);
+			EXPECT_NEAR(scene.computePersonalSpaceIntrusion(i), psi.getScale(), 1e-09);
+			psi.normalize();
+			EXPECT_NEAR(scene.computePersonalSpaceIntrusion(i, true), psi.getScale(), 1e-09);
+		}
+	}
+}
+
+TEST_F(TestSocialScene, formationSpace) {
+	SocialScene scene;
+	scene.setRobot(robot);
+	scene.addGroup(group);
+
+	// the same arrangement as in the formation space intrusion test
+	EXPECT_NEAR(scene.computeFormationSpaceIntrusion(0, 3.45, 1.75), 0.141921, 1e-05);
+
+	FormationSpaceIntrusion fsi(
+		group.x, group.y, group.orientation,
+		group.variance_x, group.variance_y,
+		group.cov_xx, group.cov_xy, group.cov_yy,
+		robot.x, robot.y
+	);
+	EXPECT_NEAR(scene.computeFormationSpaceIntrusion(0), fsi.getScale(), 1e-09);
+	fsi.normalize();
+	EXPECT_NEAR(scene.computeFormationSpaceIntrusion(0, true), fsi.getScale(), 1e-09);
+}
+
+TEST_F(TestSocialScene, formationSpaceFitted) {
+	SocialScene scene;
+	scene.setRobot(robot);
+	scene.addGroup(
+		std::vector<double>{1.0, 2.0, 3.0, 2.0},
+		std::vector<double>{3.0, 4.5, 3.0, 1.0},
+		0.427649644158897,
+		0.0,
+		0.487649597818208
+	);
+	ASSERT_EQ(scene.getGroupsNum(), 1);
+	// the same arrangement as in the formation space intrusion test (O-space fitted to these points)
+	EXPECT_NEAR(scene.computeFormationSpaceIntrusion(0, 2.10, 2.85), 0.170105832109089, 1e-05);
+	EXPECT_NEAR(scene.computeFormationSpaceIntrusion(0, 3.30, 4.05), 0.0254331283458186, 1e-05);
+}
+
+TEST_F(TestSocialScene, headingDirectionAndPassing) {
+	SocialScene scene;
+	scene.setRobot(robot);
+	scene.addHuman(human1);
+	scene.addHuman(human2);
+
+	for (size_t i = 0; i < scene.getHumansNum(); i++) {
+		const auto& h = scene.getHuman(i);
+		HeadingDirectionDisturbance hdd(
+			h.x, h.y, h.yaw,
+			h.cov_xx, h.cov_xy, h.cov_yy,
+			robot.x, robot.y, robot.yaw,
+			robot.vx, robot.vy,
+			h.occupancy_radius,
+			h.fov
+		);
+		EXPECT_NEAR(scene.computeHeadingDirectionDisturbance(i), hdd.getScale(), 1e-09);
+		hdd.normalize(robot.circumradius, robot.max_speed);
+		EXPECT_NEAR(scene.computeHeadingDirectionDisturbance(i, true), hdd.getScale(), 1e-06);
+
+		double dist = std::hypot(robot.x - h.x, robot.y - h.y);
+		EXPECT_DOUBLE_EQ(
+			scene.computePassingSpeedComfort(i),
+			PassingSpeedComfort::computeSpeedComfort(dist, std::hypot(robot.vx, robot.vy))
+		);
+	}
+}
+
+TEST_F(TestSocialScene, clear) {
+	SocialScene scene;
+	scene.addHuman(human1);
+	scene.addGroup(group);
+	scene.clear();
+	EXPECT_EQ(scene.getHumansNum(), 0);
+	EXPECT_EQ(scene.getGroupsNum(), 0);
+}
+
+TEST_F(TestSocialScene, zeroAllocations) {
+	const std::vector<double> members_x{1.0, 2.0, 3.0, 2.0};
+	const std::vector<double> members_y{3.0, 4.5, 3.0, 1.0};
+	SocialScene scene;
+	scene.setRobot(robot);
+	auto fill = [&]() {
+		scene.clear();
+		scene.addHuman(human1);
+		scene.addHuman(human2);
+		scene.addGroup(group);
+		scene.addGroup(members_x, members_y, 0.427649644158897, 0.0, 0.487649597818208);
+	};
+	// the first frame reserves the storage of the scene
+	fill();
+
+	AllocationCounter counter;
+	double sum = 0.0;
+	for (size_t frame = 0; frame < 10; frame++) {
+		fill();
+		for (size_t i = 0; i < scene.getHumansNum(); i++) {
+			sum += scene.computePersonalSpaceIntrusion(i, true);
+			sum += scene.computeHeadingDirectionDisturbance(i, true);
+			sum += scene.computePassingSpeedComfort(i);
+		}
+		for (size_t g = 0; g < scene.getGroupsNum(); g++) {
+			sum += scene.computeFormationSpaceIntrusion(g, true);
+		}
+	}
+	EXPECT_EQ(counter.getAllocations(), 0);
+	EXPECT_GT(sum, 0.0);
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <social_nav_utils/tiled_kernel.h>
+
+#include "allocation_counter.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace social_nav_utils;
+
+// sizes that are not multiples of tile sizes
+static const size_t HUMANS_NUM = 2 * TiledKernel::TILE_ENTITIES + 3;
+static const size_t POSES_NUM = 3 * TiledKernel::TILE_POSES + 11;
+
+class TestTiledKernel: public ::testing::Test {
+protected:
+	void SetUp() override {
+		for (size_t i = 0; i < HUMANS_NUM; i++) {
+			personal_spaces.emplace_back(
+				0.4 * (i % 7), 0.6 * (i / 7), -M_PI + 0.41 * i,
+				0.05, 0.01 * (i % 2), 0.01 * (i % 2), 0.07,
+				2.0, 0.5, 1.0,
+				i % 3 == 0
+			);
+			formation_spaces.emplace_back(
+				0.9 * i, -0.5, 0.2 * i,
+				0.25, 0.0625,
+				0.1, 0.02, 0.15
+			);
+		}
+		for (size_t i = 0; i < HUMANS_NUM; i++) {
+			personal_space_ptrs.push_back(&personal_spaces.at(i));
+			formation_space_ptrs.push_back(&formation_spaces.at(i));
+		}
+		for (size_t j = 0; j < POSES_NUM; j++) {
+			x.push_back(-1.0 + 0.021 * j);
+			y.push_back(2.0 * std::cos(0.07 * j));
+		}
+	}
+
+	std::vector<PersonalSpaceModel> personal_spaces;
+	std::vector<FormationSpaceModel> formation_spaces;
+	std::vector<const PersonalSpaceModel*> personal_space_ptrs;
+	std::vector<const FormationSpaceModel*> formation_space_ptrs;
+	std::vector<double> x;
+	std::vector<double> y;
+};
+
+TEST_F(TestTiledKernel, fillPersonalSpace) {
+	// extra column checks that the stride is respected
+	const size_t STRIDE = POSES_NUM + 1;
+	std::vector<double> costs(HUMANS_NUM * STRIDE, -1.0);
+	TiledKernel::fillPersonalSpace(
+		personal_space_ptrs.data(), HUMANS_NUM, x.data(), y.data(), POSES_NUM, costs.data(), STRIDE, true
+	);
+	for (size_t i = 0; i < HUMANS_NUM; i++) {
+		const auto& model = personal_spaces.at(i);
+		for (size_t j = 0; j < POSES_NUM; j++) {
+			ASSERT_NEAR(costs[i * STRIDE + j], model.evaluate(x[j], y[j]) / model.getMax(), 1e-12);
+		}
+		ASSERT_EQ(costs[i * STRIDE + POSES_NUM], -1.0);
+	}
+}
+
+TEST_F(TestTiledKernel, fillFormationSpace) {
+	std::vector<double> costs(HUMANS_NUM * POSES_NUM);
+	TiledKernel::fillFormationSpace(
+		formation_space_ptrs.data(), HUMANS_NUM, x.data(), y.data(), POSES_NUM, costs.data(), POSES_NUM
+	);
+	for (size_t i = 0; i < HUMANS_NUM; i++) {
+		for (size_t j = 0; j < POSES_NUM; j++) {
+			ASSERT_NEAR(costs[i * POSES_NUM + j], formation_spaces.at(i).evaluate(x[j], y[j]), 1e-12);
+		}
+	}
+}
+
+TEST_F(TestTiledKernel, reduce) {
+	std::vector<double> sum(POSES_NUM);
+	std::vector<double> max(POSES_NUM);
+	TiledKernel::reducePersonalSpace(
+		personal_space_ptrs.data(), HUMANS_NUM, x.data(), y.data(), POSES_NUM, sum.data()
+	);
+	TiledKernel::reduceFormationSpace(
+		formation_space_ptrs.data(), HUMANS_NUM, x.data(), y.data(), POSES_NUM, max.data(), CostReduction::MAX
+	);
+	for (size_t j = 0; j < POSES_NUM; j++) {
+		double sum_ref = 0.0;
+		double max_ref = 0.0;
+		for (size_t i = 0; i < HUMANS_NUM; i++) {
+			sum_ref += personal_spaces.at(i).evaluate(x[j], y[j]);
+			max_ref = std::max(max_ref, formation_spaces.at(i).evaluate(x[j], y[j]));
+		}
+		ASSERT_NEAR(sum[j], sum_ref, 1e-12);
+		ASSERT_NEAR(max[j], max_ref, 1e-12);
+	}
+}
+
+TEST_F(TestTiledKernel, zeroAllocations) {
+	std::vector<double> costs(HUMANS_NUM * POSES_NUM);
+	std::vector<double> reduced(POSES_NUM);
+
+	AllocationCounter counter;
+	TiledKernel::fillPersonalSpace(
+		personal_space_ptrs.data(), HUMANS_NUM, x.data(), y.data(), POSES_NUM, costs.data(), POSES_NUM, true
+	);
+	TiledKernel::fillFormationSpace(
+		formation_space_ptrs.data(), HUMANS_NUM, x.data(), y.data(), POSES_NUM, costs.data(), POSES_NUM
+	);
+	TiledKernel::reducePersonalSpace(
+		personal_space_ptrs.data(), HUMANS_NUM, x.data(), y.data(), POSES_NUM, reduced.data()
+	);
+	TiledKernel::reduceFormationSpace(
+		formation_space_ptrs.data(), HUMANS_NUM, x.data(), y.data(), POSES_NUM, reduced.data(), CostReduction::MAX
+	);
+	EXPECT_EQ(counter.getAllocations(), 0);
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
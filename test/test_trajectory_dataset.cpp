@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+
+#include <social_nav_utils/dataset_evaluator.h>
+#include <social_nav_utils/trajectory_dataset.h>
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace social_nav_utils;
+
+static const char* DATASET_PATH = "/tmp/social_nav_utils_test_dataset.snt";
+
+/// Episode `e` has `e + 1` frames; in each frame the robot approaches a standing pair of humans and a lone one
+static void writeDataset(size_t episodes_num) {
+	TrajectoryDatasetWriter writer(DATASET_PATH);
+	for (size_t e = 0; e < episodes_num; e++) {
+		writer.beginEpisode(100 + e);
+		for (size_t f = 0; f <= e; f++) {
+			TrajectoryDatasetWriter::RobotSample robot;
+			robot.x = 0.2 * f;
+			robot.y = 0.1 * e;
+			robot.vx = 0.5;
+			std::vector<TrajectoryDatasetWriter::AgentSample> agents(3);
+			agents[0].id = 1;
+			agents[0].x = 3.0;
+			agents[0].y = 0.5;
+			agents[0].yaw = M_PI;
+			agents[0].group = 7;
+			agents[1].id = 2;
+			agents[1].x = 3.0;
+			agents[1].y = -0.5;
+			agents[1].yaw = M_PI;
+			agents[1].group = 7;
+			agents[2].id = 3;
+			agents[2].x = 1.0 + 0.1 * e;
+			agents[2].y = 1.5;
+			agents[2].yaw = -M_PI_2;
+			agents[2].vy = -0.3;
+			// the lone human leaves the scene in the last frame
+			if (f == e && e > 0) {
+				agents.pop_back();
+			}
+			writer.addFrame(0.1 * f, robot, agents);
+		}
+	}
+	writer.close();
+}
+
+TEST(TestTrajectoryDataset, writeRead) {
+	writeDataset(5);
+	TrajectoryDataset dataset(DATASET_PATH);
+	ASSERT_EQ(dataset.getEpisodesNum(), 5);
+	for (size_t e = 0; e < dataset.getEpisodesNum(); e++) {
+		auto episode = dataset.getEpisode(e);
+		EXPECT_EQ(episode.id, 100 + e);
+		ASSERT_EQ(episode.frames_num, e + 1);
+		EXPECT_EQ(episode.agents_rows_num, 3 * (e + 1) - (e > 0 ? 1 : 0));
+		EXPECT_EQ(episode.agents_begin[0], 0);
+		EXPECT_EQ(episode.agents_begin[episode.frames_num], episode.agents_rows_num);
+		for (size_t f = 0; f < episode.frames_num; f++) {
+			EXPECT_DOUBLE_EQ(episode.time[f], 0.1 * f);
+			EXPECT_DOUBLE_EQ(episode.robot_x[f], 0.2 * f);
+			EXPECT_DOUBLE_EQ(episode.robot_y[f], 0.1 * e);
+			EXPECT_DOUBLE_EQ(episode.robot_vx[f], 0.5);
+			size_t first = episode.agents_begin[f];
+			EXPECT_EQ(episode.agent_id[first], 1);
+			EXPECT_EQ(episode.agent_group[first + 1], 7);
+			EXPECT_DOUBLE_EQ(episode.agent_y[first + 1], -0.5);
+		}
+		dataset.releaseEpisode(e);
+		// data are still accessible after release
+		EXPECT_DOUBLE_EQ(episode.robot_y[0], 0.1 * e);
+	}
+	std::remove(DATASET_PATH);
+}
+
+TEST(TestTrajectoryDataset, invalidFile) {
+	EXPECT_THROW(TrajectoryDataset("/nonexistent/social_nav_utils.snt"), std::runtime_error);
+	{
+		std::ofstream file(DATASET_PATH, std::ios::binary);
+		file << "definitely not a trajectory dataset";
+	}
+	EXPECT_THROW(TrajectoryDataset dataset(DATASET_PATH), std::runtime_error);
+
+	TrajectoryDatasetWriter writer(DATASET_PATH);
+	EXPECT_THROW(writer.addFrame(0.0, TrajectoryDatasetWriter::RobotSample(), {}), std::logic_error);
+	writer.close();
+	TrajectoryDataset empty(DATASET_PATH);
+	EXPECT_EQ(empty.getEpisodesNum(), 0);
+	std::remove(DATASET_PATH);
+
+	// writes to a full disk fail
+	TrajectoryDatasetWriter full("/dev/full");
+	full.beginEpisode(1);
+	full.addFrame(0.0, TrajectoryDatasetWriter::RobotSample(), {});
+	EXPECT_THROW(full.close(), std::runtime_error);
+	EXPECT_THROW(full.beginEpisode(2), std::logic_error);
+}
+
+TEST(TestDatasetEvaluator, matchesScene) {
+	writeDataset(3);
+	TrajectoryDataset dataset(DATASET_PATH);
+	DatasetEvaluator::Parameters params;
+	DatasetEvaluator evaluator(params, 1);
+
+	auto metrics = evaluator.evaluateEpisode(dataset.getEpisode(2));
+	EXPECT_EQ(metrics.id, 102);
+	EXPECT_EQ(metrics.frames_num, 3);
+	EXPECT_EQ(metrics.personal_space.samples, 3);
+	EXPECT_EQ(metrics.formation_space.samples, 3);
+	EXPECT_EQ(metrics.passing_comfort.samples, 3);
+	EXPECT_LE(metrics.personal_space.min, metrics.personal_space.mean);
+	EXPECT_LE(metrics.personal_space.mean, metrics.personal_space.max);
+
+	// single-frame episode recomputed manually
+	auto episode = dataset.getEpisode(0);
+	auto single = evaluator.evaluateEpisode(episode);
+	EXPECT_EQ(single.personal_space.samples, 1);
+
+	SocialScene scene(params.unify_asymmetry_scale);
+	SocialScene::RobotState robot = params.robot;
+	robot.vx = 0.5;
+	scene.setRobot(robot);
+	double psi_max = 0.0;
+	double hdd_max = 0.0;
+	for (size_t r = 0; r < 3; r++) {
+		SocialScene::HumanState human = params.human;
+		human.x = episode.agent_x[r];
+		human.y = episode.agent_y[r];
+		human.yaw = episode.agent_yaw[r];
+		human.vy = episode.agent_vy[r];
+		size_t i = scene.addHuman(human);
+		psi_max = std::max(psi_max, scene.computePersonalSpaceIntrusion(i, true));
+		hdd_max = std::max(hdd_max, scene.computeHeadingDirectionDisturbance(i, true));
+	}
+	size_t g = scene.addGroup({3.0, 3.0}, {0.5, -0.5}, params.group_cov_xx, params.group_cov_xy, params.group_cov_yy);
+
+	EXPECT_DOUBLE_EQ(single.personal_space.mean, psi_max);
+	EXPECT_DOUBLE_EQ(single.personal_space.min, psi_max);
+	EXPECT_DOUBLE_EQ(single.personal_space.max, psi_max);
+	EXPECT_DOUBLE_EQ(single.heading_direction.mean, hdd_max);
+	EXPECT_DOUBLE_EQ(single.formation_space.mean, scene.computeFormationSpaceIntrusion(g, true));
+	// lone human is the closest one
+	EXPECT_DOUBLE_EQ(single.passing_comfort.mean, scene.computePassingSpeedComfort(2));
+	std::remove(DATASET_PATH);
+}
+
+TEST(TestDatasetEvaluator, parallelOrderAndDeterminism) {
+	const size_t episodes_num = DatasetEvaluator::BATCH_EPISODES + 13;
+	writeDataset(episodes_num);
+	TrajectoryDataset dataset(DATASET_PATH);
+
+	DatasetEvaluator evaluator_single(DatasetEvaluator::Parameters(), 1);
+	DatasetEvaluator evaluator_multi(DatasetEvaluator::Parameters(), 4);
+	std::vector<DatasetEvaluator::EpisodeMetrics> results_single;
+	std::vector<DatasetEvaluator::EpisodeMetrics> results_multi;
+	evaluator_single.evaluate(dataset, [&](const DatasetEvaluator::EpisodeMetrics& m) { results_single.push_back(m); });
+	evaluator_multi.evaluate(dataset, [&](const DatasetEvaluator::EpisodeMetrics& m) { results_multi.push_back(m); });
+
+	ASSERT_EQ(results_single.size(), episodes_num);
+	ASSERT_EQ(results_multi.size(), episodes_num);
+	for (size_t e = 0; e < episodes_num; e++) {
+		EXPECT_EQ(results_multi[e].id, 100 + e);
+		EXPECT_EQ(results_multi[e].frames_num, e + 1);
+		EXPECT_EQ(results_multi[e].personal_space.mean, results_single[e].personal_space.mean);
+		EXPECT_EQ(results_multi[e].formation_space.max, results_single[e].formation_space.max);
+		EXPECT_EQ(results_multi[e].heading_direction.min, results_single[e].heading_direction.min);
+		EXPECT_EQ(results_multi[e].passing_comfort.mean, results_single[e].passing_comfort.mean);
+		EXPECT_EQ(results_multi[e].passing_events.samples, results_single[e].passing_events.samples);
+		if (results_single[e].passing_events.samples > 0) {
+			EXPECT_EQ(results_multi[e].passing_events.mean, results_single[e].passing_events.mean);
+		}
+	}
+	std::remove(DATASET_PATH);
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
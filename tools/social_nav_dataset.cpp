@@ -0,0 +1,190 @@
+/*
+ * Converts trajectory CSV files into the memory-mapped dataset format and evaluates social metrics of datasets.
+ *
+ * Usage:
+ *   social_nav_dataset convert <input.csv> <output.snt>
+ *   social_nav_dataset evaluate <input.snt> <output.csv> [threads]
+ *
+ * Input CSV columns: episode,time,agent,x,y,yaw,vx,vy,group
+ * Rows must be sorted by episode and time. Agent -1 denotes the robot (exactly one per frame), group -1 denotes
+ * an agent outside any F-formation. Lines that do not start with a number (e.g., a header) are skipped.
+ *
+ * Output CSV contains one row per episode with the number of frames and samples, mean, min and max of each metric
+ * (see DatasetEvaluator).
+ */
+#include <social_nav_utils/dataset_evaluator.h>
+#include <social_nav_utils/trajectory_dataset.h>
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace social_nav_utils;
+
+static constexpr int64_t ROBOT_AGENT_ID = -1;
+
+struct CsvRow {
+	int64_t episode;
+	double time;
+	TrajectoryDatasetWriter::AgentSample agent;
+};
+
+static bool parseRow(const std::string& line, CsvRow& row) {
+	if (line.empty() || !(std::isdigit(line[0]) || line[0] == '-' || line[0] == '+')) {
+		return false;
+	}
+	std::istringstream stream(line);
+	char sep = 0;
+	stream >> row.episode >> sep >> row.time >> sep >> row.agent.id
+		>> sep >> row.agent.x >> sep >> row.agent.y >> sep >> row.agent.yaw
+		>> sep >> row.agent.vx >> sep >> row.agent.vy >> sep >> row.agent.group;
+	if (stream.fail()) {
+		throw std::runtime_error("Malformed line: " + line);
+	}
+	return true;
+}
+
+static int convert(const std::string& input, const std::string& output) {
+	std::ifstream file(input);
+	if (!file) {
+		throw std::runtime_error("Could not open the CSV file: " + input);
+	}
+	TrajectoryDatasetWriter writer(output);
+
+	bool frame_open = false;
+	bool robot_found = false;
+	int64_t episode = 0;
+	double time = 0.0;
+	TrajectoryDatasetWriter::RobotSample robot;
+	std::vector<TrajectoryDatasetWriter::AgentSample> agents;
+	size_t episodes_num = 0;
+	size_t frames_num = 0;
+
+	auto flush_frame = [&]() {
+		if (!frame_open) {
+			return;
+		}
+		if (!robot_found) {
+			std::ostringstream msg;
+			msg << "Robot state missing in episode " << episode << " at time " << time;
+			throw std::runtime_error(msg.str());
+		}
+		writer.addFrame(time, robot, agents);
+		frames_num++;
+		agents.clear();
+		robot_found = false;
+		frame_open = false;
+	};
+
+	std::string line;
+	CsvRow row;
+	while (std::getline(file, line)) {
+		if (!parseRow(line, row)) {
+			continue;
+		}
+		bool new_episode = episodes_num == 0 || row.episode != episode;
+		if (new_episode || row.time != time) {
+			flush_frame();
+		}
+		if (new_episode) {
+			writer.beginEpisode(row.episode);
+			episodes_num++;
+		}
+		episode = row.episode;
+		time = row.time;
+		frame_open = true;
+		if (row.agent.id == ROBOT_AGENT_ID) {
+			robot.x = row.agent.x;
+			robot.y = row.agent.y;
+			robot.yaw = row.agent.yaw;
+			robot.vx = row.agent.vx;
+			robot.vy = row.agent.vy;
+			robot_found = true;
+		} else {
+			agents.push_back(row.agent);
+		}
+	}
+	flush_frame();
+	writer.close();
+	std::printf("Converted %zu episodes, %zu frames\n", episodes_num, frames_num);
+	return 0;
+}
+
+static void printSummary(std::FILE* file, const DatasetEvaluator::Summary& summary) {
+	std::fprintf(file, ",%zu,%.9g,%.9g,%.9g", summary.samples, summary.mean, summary.min, summary.max);
+}
+
+static int evaluate(const std::string& input, const std::string& output, size_t threads_num) {
+	TrajectoryDataset dataset(input);
+	std::FILE* file = std::fopen(output.c_str(), "w");
+	if (file == nullptr) {
+		throw std::runtime_error("Could not create the output file: " + output);
+	}
+	std::fprintf(file, "episode,frames");
+	for (const char* metric: {"psi", "fsi", "hdd", "comfort", "passing"}) {
+		std::fprintf(file, ",%s_samples,%s_mean,%s_min,%s_max", metric, metric, metric, metric);
+	}
+	std::fprintf(file, "\n");
+
+	DatasetEvaluator evaluator(DatasetEvaluator::Parameters(), threads_num);
+	try {
+		evaluator.evaluate(dataset, [file](const DatasetEvaluator::EpisodeMetrics& metrics) {
+			std::fprintf(file, "%lld,%zu", static_cast<long long>(metrics.id), metrics.frames_num);
+			printSummary(file, metrics.personal_space);
+			printSummary(file, metrics.formation_space);
+			printSummary(file, metrics.heading_direction);
+			printSummary(file, metrics.passing_comfort);
+			printSummary(file, metrics.passing_events);
+			std::fprintf(file, "\n");
+		});
+	} catch (...) {
+		std::fclose(file);
+		throw;
+	}
+	bool ok = std::ferror(file) == 0;
+	// buffered output is written by fclose
+	ok = (std::fclose(file) == 0) && ok;
+	if (!ok) {
+		throw std::runtime_error("Could not write the output file: " + output);
+	}
+	std::printf(
+		"Evaluated %zu episodes using %zu threads\n",
+		dataset.getEpisodesNum(),
+		evaluator.getThreadsNum()
+	);
+	return 0;
+}
+
+int main(int argc, char** argv) {
+	if (argc >= 4 && std::strcmp(argv[1], "convert") == 0) {
+		try {
+			return convert(argv[2], argv[3]);
+		} catch (const std::exception& e) {
+			std::fprintf(stderr, "%s\n", e.what());
+			return 1;
+		}
+	}
+	if (argc >= 4 && std::strcmp(argv[1], "evaluate") == 0) {
+		size_t threads_num = argc > 4 ? std::atoi(argv[4]) : 0;
+		try {
+			return evaluate(argv[2], argv[3], threads_num);
+		} catch (const std::exception& e) {
+			std::fprintf(stderr, "%s\n", e.what());
+			return 1;
+		}
+	}
+	std::fprintf(
+		stderr,
+		"Usage:\n  %s convert <input.csv> <output.snt>\n  %s evaluate <input.snt> <output.csv> [threads]\n",
+		argv[0],
+		argv[0]
+	);
+	return 2;
+}
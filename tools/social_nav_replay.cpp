@@ -0,0 +1,136 @@
+/*
+ * Replays a binary log written by the Recorder through the current build of the library.
+ * Prints per-function latencies and reports calls whose results differ from the recorded ones.
+ *
+ * Usage: social_nav_replay <log> [tolerance] [repetitions]
+ *
+ * Returns 0 if all results match within the absolute tolerance (default 1e-9), 1 otherwise.
+ */
+#include <social_nav_utils/profiling.h>
+#include <social_nav_utils/recording.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <vector>
+
+using namespace social_nav_utils;
+
+static constexpr size_t TYPES_NUM = static_cast<size_t>(RecordType::TYPES_NUM);
+
+struct ReplayStats {
+	LatencyHistogram latency;
+	size_t calls = 0;
+	size_t mismatches = 0;
+	double max_error = 0.0;
+};
+
+/// Returns the largest absolute difference between outputs; NaNs at the same positions are considered equal
+static double computeError(const std::vector<double>& expected, const std::vector<double>& actual) {
+	if (expected.size() != actual.size()) {
+		return INFINITY;
+	}
+	double error = 0.0;
+	for (size_t i = 0; i < expected.size(); i++) {
+		if (std::isnan(expected[i]) && std::isnan(actual[i])) {
+			continue;
+		}
+		double diff = std::abs(expected[i] - actual[i]);
+		// NaN vs number or infinities of different signs
+		if (std::isnan(diff)) {
+			return INFINITY;
+		}
+		error = std::max(error, diff);
+	}
+	return error;
+}
+
+int main(int argc, char** argv) {
+	if (argc < 2) {
+		std::fprintf(stderr, "Usage: %s <log> [tolerance] [repetitions]\n", argv[0]);
+		return 2;
+	}
+	double tolerance = argc > 2 ? std::atof(argv[2]) : 1e-9;
+	size_t repetitions = argc > 3 ? std::max(1, std::atoi(argv[3])) : 1;
+
+	std::vector<Record> records;
+	try {
+		RecordReader reader(argv[1]);
+		Record record;
+		while (reader.next(record)) {
+			records.push_back(record);
+		}
+	} catch (const std::exception& e) {
+		std::fprintf(stderr, "%s\n", e.what());
+		return 2;
+	}
+
+	std::array<std::unique_ptr<ReplayStats>, TYPES_NUM> stats;
+	for (auto& s: stats) {
+		s.reset(new ReplayStats());
+	}
+
+	std::vector<double> outputs;
+	for (size_t r = 0; r < repetitions; r++) {
+		for (size_t i = 0; i < records.size(); i++) {
+			const auto& record = records[i];
+			auto& s = *stats[static_cast<size_t>(record.type)];
+			try {
+				auto start = std::chrono::steady_clock::now();
+				replayRecord(record, outputs);
+				auto end = std::chrono::steady_clock::now();
+				s.latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+			} catch (const std::exception& e) {
+				std::fprintf(stderr, "Record %zu could not be replayed: %s\n", i, e.what());
+				return 2;
+			}
+			s.calls++;
+			// results are deterministic, compare only once
+			if (r != 0) {
+				continue;
+			}
+			double error = computeError(record.outputs, outputs);
+			s.max_error = std::max(s.max_error, error);
+			if (error > tolerance) {
+				s.mismatches++;
+				std::printf("Mismatch in record %zu (%s): max error %g\n", i, getRecordTypeName(record.type), error);
+			}
+		}
+	}
+
+	size_t mismatches = 0;
+	std::printf(
+		"%-56s %10s %10s %10s %10s %10s %10s\n",
+		"function",
+		"calls",
+		"mean[ns]",
+		"p50[ns]",
+		"p99[ns]",
+		"mismatch",
+		"max_err"
+	);
+	for (size_t t = 0; t < TYPES_NUM; t++) {
+		const auto& s = *stats[t];
+		if (s.calls == 0) {
+			continue;
+		}
+		std::printf(
+			"%-56s %10zu %10.0f %10llu %10llu %10zu %10.3g\n",
+			getRecordTypeName(static_cast<RecordType>(t)),
+			s.calls,
+			s.latency.getMean(),
+			static_cast<unsigned long long>(s.latency.getPercentile(50.0)),
+			static_cast<unsigned long long>(s.latency.getPercentile(99.0)),
+			s.mismatches,
+			s.max_error
+		);
+		mismatches += s.mismatches;
+	}
+	std::printf("%zu records replayed %zu time(s), %zu mismatch(es)\n", records.size(), repetitions, mismatches);
+	return mismatches == 0 ? 0 : 1;
+}